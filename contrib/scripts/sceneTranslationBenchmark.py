@@ -0,0 +1,70 @@
+#! /usr/bin/env python
+
+import inspect
+import argparse
+
+import GafferSceneTest
+
+parser = argparse.ArgumentParser(
+	description = inspect.cleandoc(
+	"""
+	Measures the throughput of translating synthetic scenes to a
+	renderer via RendererAlgo and RenderController, reporting
+	per-phase timings, locations per second and peak process memory.
+
+	Should be run using `gaffer env`, for example :
+
+	> gaffer env python contrib/scripts/sceneTranslationBenchmark.py -shape wide -size 1000000
+	""" ),
+	formatter_class = argparse.RawTextHelpFormatter
+)
+
+parser.add_argument(
+	"-shape",
+	help = "The shape of the scene to generate.",
+	choices = GafferSceneTest.SceneTranslationBenchmark.Shapes,
+	default = "wide",
+)
+
+parser.add_argument(
+	"-size",
+	help = "The approximate number of leaf locations to generate.",
+	type = int,
+	default = 100000,
+)
+
+parser.add_argument(
+	"-renderer",
+	help = "The renderer to output to. The default captures the scene in memory.",
+	default = "Capturing",
+)
+
+parser.add_argument(
+	"-numSets",
+	help = "The number of render sets to generate, for the `sets` shape.",
+	type = int,
+	default = 50,
+)
+
+parser.add_argument(
+	"-numAttributes",
+	help = "The number of attributes to generate, for the `attributes` shape.",
+	type = int,
+	default = 50,
+)
+
+parser.add_argument(
+	"-depth",
+	help = "The number of levels of nested instancing, for the `deep` shape.",
+	type = int,
+	default = 4,
+)
+
+args = parser.parse_args()
+
+benchmark = GafferSceneTest.SceneTranslationBenchmark(
+	args.shape, args.size, args.renderer,
+	numSets = args.numSets, numAttributes = args.numAttributes, depth = args.depth
+)
+
+print( GafferSceneTest.SceneTranslationBenchmark.format( benchmark.run() ) )
@@ -171,6 +171,12 @@ class GAFFER_API ValuePlug : public Plug
 		static size_t cacheMemoryUsage();
 		/// Clears the cache.
 		static void clearCache();
+		/// Signal emitted by `clearCache()`. Caches of computed results that
+		/// are maintained outside of ValuePlug should be cleared in response,
+		/// so that they don't hold on to memory after the main cache has been
+		/// cleared.
+		using CacheClearedSignal = Signals::Signal<void (), Signals::CatchingCombiner<void>>;
+		static CacheClearedSignal &cacheClearedSignal();
 		//@}
 
 		/// @name Hash cache management
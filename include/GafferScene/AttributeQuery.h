@@ -69,6 +69,17 @@ struct GAFFERSCENE_API AttributeQuery : Gaffer::ComputeNode
 	Gaffer::BoolPlug* existsPlug();
 	const Gaffer::BoolPlug* existsPlug() const;
 
+	/// Batch query : `valueVectorPlug()` outputs the attribute value for each
+	/// of `locationsPlug()` in turn, computed in parallel as a single value.
+	/// Locations without the attribute have a NullObject value, and are
+	/// reported by `existsVectorPlug()`. The default plug is not used.
+	Gaffer::StringVectorDataPlug* locationsPlug();
+	const Gaffer::StringVectorDataPlug* locationsPlug() const;
+	Gaffer::BoolVectorDataPlug* existsVectorPlug();
+	const Gaffer::BoolVectorDataPlug* existsVectorPlug() const;
+	Gaffer::ObjectVectorPlug* valueVectorPlug();
+	const Gaffer::ObjectVectorPlug* valueVectorPlug() const;
+
 	bool isSetup() const;
 	bool canSetup( const Gaffer::ValuePlug* plug ) const;
 	void setup( const Gaffer::ValuePlug* plug );
@@ -89,6 +100,9 @@ protected:
 	void hash( const Gaffer::ValuePlug* output, const Gaffer::Context* context, IECore::MurmurHash& h ) const override;
 	void compute( Gaffer::ValuePlug* output, const Gaffer::Context* context ) const override;
 
+	Gaffer::ValuePlug::CachePolicy hashCachePolicy( const Gaffer::ValuePlug* output ) const override;
+	Gaffer::ValuePlug::CachePolicy computeCachePolicy( const Gaffer::ValuePlug* output ) const override;
+
 private:
 
 	IECore::InternedString valuePlugName() const;
@@ -45,6 +45,7 @@
 #include "Gaffer/CompoundNumericPlug.h"
 #include "Gaffer/ComputeNode.h"
 #include "Gaffer/StringPlug.h"
+#include "Gaffer/TypedObjectPlug.h"
 #include "Gaffer/TypedPlug.h"
 
 #include <string>
@@ -81,6 +82,16 @@ struct GAFFERSCENE_API BoundQuery : Gaffer::ComputeNode
 	Gaffer::V3fPlug* sizePlug();
 	Gaffer::V3fPlug const* sizePlug() const;
 
+	/// Batch query : `centerVectorPlug()` and `sizeVectorPlug()` output the
+	/// bound for each of `locationsPlug()` in turn, computed in parallel as
+	/// a single value.
+	Gaffer::StringVectorDataPlug* locationsPlug();
+	Gaffer::StringVectorDataPlug const* locationsPlug() const;
+	Gaffer::V3fVectorDataPlug* centerVectorPlug();
+	Gaffer::V3fVectorDataPlug const* centerVectorPlug() const;
+	Gaffer::V3fVectorDataPlug* sizeVectorPlug();
+	Gaffer::V3fVectorDataPlug const* sizeVectorPlug() const;
+
 	void affects( Gaffer::Plug const* input, AffectedPlugsContainer& outputs ) const override;
 
 protected:
@@ -88,10 +99,15 @@ protected:
 	void hash( Gaffer::ValuePlug const* output, Gaffer::Context const* context, IECore::MurmurHash& hash ) const override;
 	void compute( Gaffer::ValuePlug* output, Gaffer::Context const* context ) const override;
 
+	Gaffer::ValuePlug::CachePolicy hashCachePolicy( Gaffer::ValuePlug const* output ) const override;
+	Gaffer::ValuePlug::CachePolicy computeCachePolicy( Gaffer::ValuePlug const* output ) const override;
+
 private:
 
 	Gaffer::AtomicBox3fPlug* internalBoundPlug();
 	Gaffer::AtomicBox3fPlug const* internalBoundPlug() const;
+	Gaffer::ObjectPlug* internalBoundVectorPlug();
+	Gaffer::ObjectPlug const* internalBoundVectorPlug() const;
 
 	static size_t g_firstPlugIndex;
 };
@@ -139,6 +139,17 @@ class GAFFERSCENE_API BranchCreator : public FilteredSceneProcessor
 		virtual bool affectsBranchBound( const Gaffer::Plug *input ) const;
 		virtual void hashBranchBound( const ScenePath &sourcePath, const ScenePath &branchPath, const Gaffer::Context *context, IECore::MurmurHash &h ) const = 0;
 		virtual Imath::Box3f computeBranchBound( const ScenePath &sourcePath, const ScenePath &branchPath, const Gaffer::Context *context ) const = 0;
+		/// Called to determine if `computeBranchesBound()` is implemented. If it returns true, the
+		/// bound of a destination is computed from the input bound and `computeBranchesBound()`
+		/// for each source, rather than by computing the bound and transform of every child. This
+		/// is beneficial when branches have very many children. The default implementation
+		/// returns false.
+		virtual bool providesBranchesBound() const;
+		virtual bool affectsBranchesBound( const Gaffer::Plug *input ) const;
+		virtual void hashBranchesBound( const ScenePath &sourcePath, const Gaffer::Context *context, IECore::MurmurHash &h ) const;
+		/// Must return the union of the bounds of all the children created by the branch for
+		/// `sourcePath`, each transformed by its own branch transform followed by `transform`.
+		virtual Imath::Box3f computeBranchesBound( const ScenePath &sourcePath, const Imath::M44f &transform, const Gaffer::Context *context ) const;
 
 		virtual bool affectsBranchTransform( const Gaffer::Plug *input ) const;
 		virtual void hashBranchTransform( const ScenePath &sourcePath, const ScenePath &branchPath, const Gaffer::Context *context, IECore::MurmurHash &h ) const = 0;
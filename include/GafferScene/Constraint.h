@@ -94,6 +94,10 @@ class GAFFERSCENE_API Constraint : public SceneElementProcessor
 
 	protected :
 
+		void hash( const Gaffer::ValuePlug *output, const Gaffer::Context *context, IECore::MurmurHash &h ) const override;
+		void compute( Gaffer::ValuePlug *output, const Gaffer::Context *context ) const override;
+		Gaffer::ValuePlug::CachePolicy computeCachePolicy( const Gaffer::ValuePlug *output ) const override;
+
 		/// Reimplemented from SceneElementProcessor to call the constraint functions below.
 		bool processesTransform() const override;
 		void hashProcessedTransform( const ScenePath &path, const Gaffer::Context *context, IECore::MurmurHash &h ) const override;
@@ -116,6 +120,15 @@ class GAFFERSCENE_API Constraint : public SceneElementProcessor
 		};
 
 		std::optional<Target> target() const;
+		const ScenePlug *targetScene() const;
+
+		// Computes the full transform of the target, including any
+		// `targetMode` adjustments but excluding `targetOffset`. This
+		// is evaluated with `scene:path` set to the target path, so
+		// that a single computation is shared by all locations
+		// constrained to the same target.
+		Gaffer::M44fPlug *targetTransformPlug();
+		const Gaffer::M44fPlug *targetTransformPlug() const;
 
 		static size_t g_firstPlugIndex;
 
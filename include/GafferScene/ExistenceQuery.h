@@ -43,6 +43,7 @@
 
 #include "Gaffer/ComputeNode.h"
 #include "Gaffer/StringPlug.h"
+#include "Gaffer/TypedObjectPlug.h"
 #include "Gaffer/TypedPlug.h"
 
 #include <string>
@@ -66,6 +67,13 @@ struct GAFFERSCENE_API ExistenceQuery : Gaffer::ComputeNode
 	Gaffer::StringPlug* closestAncestorPlug();
 	const Gaffer::StringPlug* closestAncestorPlug() const;
 
+	/// Batch query : `existsVectorPlug()` outputs the existence of each of
+	/// `locationsPlug()` in turn, computed in parallel as a single value.
+	Gaffer::StringVectorDataPlug* locationsPlug();
+	const Gaffer::StringVectorDataPlug* locationsPlug() const;
+	Gaffer::BoolVectorDataPlug* existsVectorPlug();
+	const Gaffer::BoolVectorDataPlug* existsVectorPlug() const;
+
 	void affects( const Gaffer::Plug* input, AffectedPlugsContainer& outputs ) const override;
 
 protected:
@@ -73,6 +81,9 @@ protected:
 	void hash( const Gaffer::ValuePlug* output, const Gaffer::Context* context, IECore::MurmurHash& h ) const override;
 	void compute( Gaffer::ValuePlug* output, const Gaffer::Context* context ) const override;
 
+	Gaffer::ValuePlug::CachePolicy hashCachePolicy( const Gaffer::ValuePlug* output ) const override;
+	Gaffer::ValuePlug::CachePolicy computeCachePolicy( const Gaffer::ValuePlug* output ) const override;
+
 private:
 
 	static size_t g_firstPlugIndex;
@@ -90,6 +90,13 @@ class GAFFERSCENE_API FilterResults : public Gaffer::ComputeNode
 		Gaffer::PathMatcherDataPlug *internalOutPlug();
 		const Gaffer::PathMatcherDataPlug *internalOutPlug() const;
 
+		// Evaluated with `scene:path` set to a location, providing the
+		// matches in the subtree below it, relative to that location.
+		// Results are cached per subtree, so that edits to one branch
+		// of the scene only require that branch to be filtered again.
+		Gaffer::PathMatcherDataPlug *subtreeMatchesPlug();
+		const Gaffer::PathMatcherDataPlug *subtreeMatchesPlug() const;
+
 		static size_t g_firstPlugIndex;
 
 };
@@ -0,0 +1,119 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2022, Cinesite VFX Ltd. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#ifndef GAFFERSCENE_INSTANCEARRAY_H
+#define GAFFERSCENE_INSTANCEARRAY_H
+
+#include "GafferScene/Capsule.h"
+
+#include "IECore/CompoundData.h"
+#include "IECore/VectorTypedData.h"
+
+namespace GafferScene
+{
+
+/// A Capsule which represents an entire group of instances of a single
+/// prototype in a compact form. Rather than storing a location per
+/// instance, the array holds packed per-instance transforms, names and
+/// attributes. At render time the prototype subtree is evaluated just
+/// once, and the resulting objects are shared between all instances so
+/// that renderers may instance them natively.
+///
+/// The `scene` and `root` are used exactly as for a regular Capsule,
+/// and must describe the fully expanded instances so that the array
+/// may still be unencapsulated.
+class GAFFERSCENE_API InstanceArray : public Capsule
+{
+
+	public :
+
+		InstanceArray();
+		/// `names` and `transforms` must have one element per instance.
+		/// `attributes` contains vector data, indexed via `attributeIndices`,
+		/// which provides per-instance attributes. Both may be null if there
+		/// are no such attributes.
+		InstanceArray(
+			const ScenePlug *scene,
+			const ScenePlug::ScenePath &root,
+			const Gaffer::Context &context,
+			const IECore::MurmurHash &hash,
+			const Imath::Box3f &bound,
+			const ScenePlug *prototypes,
+			const ScenePlug::ScenePath &prototypeRoot,
+			const IECore::InternedStringVectorData *names,
+			const IECore::M44fVectorData *transforms,
+			const IECore::UInt64VectorData *attributeIndices = nullptr,
+			const IECore::CompoundData *attributes = nullptr
+		);
+		~InstanceArray() override;
+
+		IE_CORE_DECLAREEXTENSIONOBJECT( GafferScene::InstanceArray, GafferScene::InstanceArrayTypeId, GafferScene::Capsule );
+
+		/// Outputs one location per instance and prototype location.
+		/// Per-instance attributes take precedence over any attributes
+		/// authored within the prototype, and instance transforms are
+		/// not motion blurred.
+		void render( IECoreScenePreview::Renderer *renderer ) const override;
+
+		size_t numInstances() const;
+
+		const ScenePlug *prototypes() const;
+		const ScenePlug::ScenePath &prototypeRoot() const;
+		const IECore::InternedStringVectorData *names() const;
+		const IECore::M44fVectorData *transforms() const;
+		const IECore::UInt64VectorData *attributeIndices() const;
+		const IECore::CompoundData *attributes() const;
+
+	private :
+
+		// As for the Capsule scene, we don't own a reference to the
+		// prototypes plug. It is expected to belong to the same node
+		// as the capsule scene, so will remain valid for as long as
+		// that does.
+		const ScenePlug *m_prototypes;
+		ScenePlug::ScenePath m_prototypeRoot;
+		IECore::ConstInternedStringVectorDataPtr m_names;
+		IECore::ConstM44fVectorDataPtr m_transforms;
+		IECore::ConstUInt64VectorDataPtr m_attributeIndices;
+		IECore::ConstCompoundDataPtr m_attributes;
+
+};
+
+IE_CORE_DECLAREPTR( InstanceArray )
+
+} // namespace GafferScene
+
+#endif // GAFFERSCENE_INSTANCEARRAY_H
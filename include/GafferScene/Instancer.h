@@ -136,6 +136,9 @@ class GAFFERSCENE_API Instancer : public BranchCreator
 		Gaffer::BoolPlug *encapsulateInstanceGroupsPlug();
 		const Gaffer::BoolPlug *encapsulateInstanceGroupsPlug() const;
 
+		Gaffer::BoolPlug *compactInstanceGroupsPlug();
+		const Gaffer::BoolPlug *compactInstanceGroupsPlug() const;
+
 		Gaffer::BoolPlug *seedEnabledPlug();
 		const Gaffer::BoolPlug *seedEnabledPlug() const;
 
@@ -212,10 +215,23 @@ class GAFFERSCENE_API Instancer : public BranchCreator
 	private :
 
 		IE_CORE_FORWARDDECLARE( EngineData );
+		IE_CORE_FORWARDDECLARE( TopologyData );
 
 		Gaffer::ObjectPlug *enginePlug();
 		const Gaffer::ObjectPlug *enginePlug() const;
 
+		// Provides the part of the engine which depends only on the point
+		// count, ids and prototype indices. This is reused by the engine
+		// when other primitive variables change.
+		Gaffer::ObjectPlug *topologyPlug();
+		const Gaffer::ObjectPlug *topologyPlug() const;
+
+		// Provides a hash of just the primitive variables that the topology
+		// depends on, so that `topologyPlug()` can be hashed without
+		// computing the input object.
+		Gaffer::ObjectPlug *topologyHashPlug();
+		const Gaffer::ObjectPlug *topologyHashPlug() const;
+
 		Gaffer::AtomicCompoundDataPlug *prototypeChildNamesPlug();
 		const Gaffer::AtomicCompoundDataPlug *prototypeChildNamesPlug() const;
 
@@ -231,9 +247,15 @@ class GAFFERSCENE_API Instancer : public BranchCreator
 		ConstEngineDataPtr engine( const ScenePath &sourcePath, const Gaffer::Context *context ) const;
 		void engineHash( const ScenePath &sourcePath, const Gaffer::Context *context, IECore::MurmurHash &h ) const;
 
+		ConstTopologyDataPtr topology( const ScenePath &sourcePath, const Gaffer::Context *context ) const;
+		void topologyHash( const ScenePath &sourcePath, const Gaffer::Context *context, IECore::MurmurHash &h ) const;
+
 		IECore::ConstCompoundDataPtr prototypeChildNames( const ScenePath &sourcePath, const Gaffer::Context *context ) const;
 		void prototypeChildNamesHash( const ScenePath &sourcePath, const Gaffer::Context *context, IECore::MurmurHash &h ) const;
 
+		// Returns an InstanceArray representing all the instances of the prototype at `branchPath`.
+		IECore::ConstObjectPtr compactInstanceGroup( const EngineData *engine, const ScenePath &sourcePath, const ScenePath &branchPath, const Gaffer::Context *context ) const;
+
 		struct PrototypeScope : public Gaffer::Context::EditableScope
 		{
 			PrototypeScope( const Gaffer::ObjectPlug *enginePlug, const Gaffer::Context *context, const ScenePath *parentPath, const ScenePath *branchPath );
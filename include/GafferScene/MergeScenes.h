@@ -39,7 +39,9 @@
 
 #include "GafferScene/SceneProcessor.h"
 
-#include <bitset>
+#include "Gaffer/TypedObjectPlug.h"
+
+#include <vector>
 
 namespace GafferScene
 {
@@ -82,6 +84,8 @@ class GAFFERSCENE_API MergeScenes : public SceneProcessor
 
 		void hash( const Gaffer::ValuePlug *output, const Gaffer::Context *context, IECore::MurmurHash &h ) const override;
 		void compute( Gaffer::ValuePlug *output, const Gaffer::Context *context ) const override;
+		Gaffer::ValuePlug::CachePolicy hashCachePolicy( const Gaffer::ValuePlug *output ) const override;
+		Gaffer::ValuePlug::CachePolicy computeCachePolicy( const Gaffer::ValuePlug *output ) const override;
 
 		void hashBound( const ScenePath &path, const Gaffer::Context *context, const ScenePlug *parent, IECore::MurmurHash &h ) const override;
 		Imath::Box3f computeBound( const ScenePath &path, const Gaffer::Context *context, const ScenePlug *parent ) const override;
@@ -109,20 +113,23 @@ class GAFFERSCENE_API MergeScenes : public SceneProcessor
 
 	private :
 
-		using InputMask = std::bitset<32>;
+		// Indices of a subset of inputs, in ascending order.
+		// Using indices rather than a mask means that the cost
+		// of visiting the active inputs at a location is
+		// independent of the total number of inputs.
+		using InputIndices = std::vector<int>;
 
 		// Plugs used to track which inputs are valid
-		// at the current location. The value can be
-		// converted directly to an `InputMask` for use
-		// with `visit()`.
-		Gaffer::IntPlug *activeInputsPlug();
-		const Gaffer::IntPlug *activeInputsPlug() const;
+		// at the current location. The value holds
+		// `InputIndices` for use with `visit()`.
+		Gaffer::IntVectorDataPlug *activeInputsPlug();
+		const Gaffer::IntVectorDataPlug *activeInputsPlug() const;
 
 		Gaffer::AtomicBox3fPlug *mergedDescendantsBoundPlug();
 		const Gaffer::AtomicBox3fPlug *mergedDescendantsBoundPlug() const;
 
 		void hashActiveInputs( const Gaffer::Context *context, IECore::MurmurHash &h ) const;
-		int computeActiveInputs( const Gaffer::Context *context ) const;
+		IECore::ConstIntVectorDataPtr computeActiveInputs( const Gaffer::Context *context ) const;
 
 		void hashMergedDescendantsBound( const Gaffer::Context *context, IECore::MurmurHash &h ) const;
 		const Imath::Box3f computeMergedDescendantsBound( const Gaffer::Context *context ) const;
@@ -143,12 +150,12 @@ class GAFFERSCENE_API MergeScenes : public SceneProcessor
 		};
 
 		VisitOrder visitOrder( Mode mode, VisitOrder replaceOrder = VisitOrder::LastOnly ) const;
-		InputMask connectedInputs() const;
+		InputIndices connectedInputs() const;
 
-		// Calls `visitor( inputType, inputIndex, input )` for all inputs specified by `inputMask`.
+		// Calls `visitor( inputType, inputIndex, input )` for all inputs specified by `inputs`.
 		// Visitor may return `true` to continue to subsequent inputs or `false` to stop iteration.
 		template<typename Visitor>
-		void visit( InputMask inputMask, Visitor &&visitor, VisitOrder order = VisitOrder::Forwards ) const;
+		void visit( const InputIndices &inputs, Visitor &&visitor, VisitOrder order = VisitOrder::Forwards ) const;
 
 		static size_t g_firstPlugIndex;
 
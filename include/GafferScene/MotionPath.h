@@ -99,6 +99,9 @@ class GAFFERSCENE_API MotionPath : public FilteredSceneProcessor
 		void hashSetNames( const Gaffer::Context *context, const ScenePlug *parent, IECore::MurmurHash &h ) const override;
 		void hashSet( const IECore::InternedString &setName, const Gaffer::Context *context, const ScenePlug *parent, IECore::MurmurHash &h ) const override;
 
+		Gaffer::ValuePlug::CachePolicy hashCachePolicy( const Gaffer::ValuePlug *output ) const override;
+		Gaffer::ValuePlug::CachePolicy computeCachePolicy( const Gaffer::ValuePlug *output ) const override;
+
 		Imath::Box3f computeBound( const ScenePath &path, const Gaffer::Context *context, const ScenePlug *parent ) const override;
 		Imath::M44f computeTransform( const ScenePath &path, const Gaffer::Context *context, const ScenePlug *parent ) const override;
 		IECore::ConstCompoundObjectPtr computeAttributes( const ScenePath &path, const Gaffer::Context *context, const ScenePlug *parent ) const override;
@@ -111,6 +114,10 @@ class GAFFERSCENE_API MotionPath : public FilteredSceneProcessor
 		ScenePlug *isolatedInPlug();
 		const ScenePlug *isolatedInPlug() const;
 
+		// Returns the frames at which the transform should be sampled,
+		// or an empty vector if the frame range is empty.
+		std::vector<float> sampleFrames( const Gaffer::Context *context ) const;
+
 		static size_t g_firstPlugIndex;
 
 };
@@ -40,6 +40,7 @@
 #include "GafferScene/Deformer.h"
 
 #include "Gaffer/StringPlug.h"
+#include "Gaffer/TypedObjectPlug.h"
 
 #include "IECoreScene/PrimitiveEvaluator.h"
 
@@ -72,10 +73,16 @@ class GAFFERSCENE_API PrimitiveSampler : public Deformer
 		Gaffer::StringPlug *statusPlug();
 		const Gaffer::StringPlug *statusPlug() const;
 
+		void affects( const Gaffer::Plug *input, AffectedPlugsContainer &outputs ) const override;
+
 	protected :
 
 		PrimitiveSampler( const std::string &name = defaultName<PrimitiveSampler>() );
 
+		void hash( const Gaffer::ValuePlug *output, const Gaffer::Context *context, IECore::MurmurHash &h ) const override;
+		void compute( Gaffer::ValuePlug *output, const Gaffer::Context *context ) const override;
+		Gaffer::ValuePlug::CachePolicy computeCachePolicy( const Gaffer::ValuePlug *output ) const override;
+
 		/// SamplingFunction
 		/// ================
 		///
@@ -116,6 +123,15 @@ class GAFFERSCENE_API PrimitiveSampler : public Deformer
 
 	private :
 
+		IE_CORE_FORWARDDECLARE( EvaluatorData );
+
+		// Provides the preprocessed source primitive and its `PrimitiveEvaluator`,
+		// evaluated with `scene:path` set to the source location. The hash depends
+		// only on the source object, so the evaluator is shared between all
+		// destination locations, and between frames when the source is static.
+		Gaffer::ObjectPlug *evaluatorPlug();
+		const Gaffer::ObjectPlug *evaluatorPlug() const;
+
 		bool affectsProcessedObject( const Gaffer::Plug *input ) const final;
 		void hashProcessedObject( const ScenePath &path, const Gaffer::Context *context, IECore::MurmurHash &h ) const final;
 		IECore::ConstObjectPtr computeProcessedObject( const ScenePath &path, const Gaffer::Context *context, const IECore::Object *inputObject ) const final;
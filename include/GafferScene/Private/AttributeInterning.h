@@ -0,0 +1,90 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2022, Cinesite VFX Ltd. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#ifndef GAFFERSCENE_PRIVATE_ATTRIBUTEINTERNING_H
+#define GAFFERSCENE_PRIVATE_ATTRIBUTEINTERNING_H
+
+#include "GafferScene/Export.h"
+
+#include "IECore/CompoundObject.h"
+
+namespace GafferScene
+{
+
+namespace Private
+{
+
+namespace AttributeInterning
+{
+
+/// Returns an instance equal to `attributes`, shared with any previous
+/// result with the same contents. ShaderNetworks within the attributes
+/// are interned individually, so they may be shared even when the attributes
+/// as a whole differ. Used by AttributeProcessor so that the many locations
+/// receiving identical attributes don't each hold their own copy in the
+/// compute cache. Shared instances are released by `Gaffer::ValuePlug::clearCache()`.
+GAFFERSCENE_API IECore::ConstCompoundObjectPtr intern( const IECore::ConstCompoundObjectPtr &attributes );
+
+struct Statistics
+{
+	/// Number of objects stored for sharing.
+	uint64_t internedObjects = 0;
+	/// Number of objects replaced by an existing shared instance.
+	uint64_t sharedObjects = 0;
+	/// Approximate number of bytes saved by sharing instances.
+	uint64_t memorySaved = 0;
+};
+
+/// Process-wide statistics, intended to help diagnose the memory
+/// usage of the compute cache.
+GAFFERSCENE_API Statistics statistics();
+GAFFERSCENE_API void resetStatistics();
+
+/// Releases all shared instances. Existing results remain valid,
+/// but will no longer be shared with subsequent ones.
+GAFFERSCENE_API void clear();
+
+/// Manage the maximum memory in bytes used to hold shared instances.
+GAFFERSCENE_API size_t getMemoryLimit();
+GAFFERSCENE_API void setMemoryLimit( size_t bytes );
+
+} // namespace AttributeInterning
+
+} // namespace Private
+
+} // namespace GafferScene
+
+#endif // GAFFERSCENE_PRIVATE_ATTRIBUTEINTERNING_H
@@ -37,14 +37,13 @@
 #ifndef GAFFERSCENE_PRIVATE_CHILDNAMESMAP_H
 #define GAFFERSCENE_PRIVATE_CHILDNAMESMAP_H
 
+#include "GafferScene/Export.h"
+
 #include "IECore/Data.h"
 #include "IECore/PathMatcherData.h"
 #include "IECore/VectorTypedData.h"
 
-#include "boost/multi_index/hashed_index.hpp"
-#include "boost/multi_index/member.hpp"
-#include "boost/multi_index_container.hpp"
-
+#include <atomic>
 #include <vector>
 
 namespace GafferScene
@@ -55,7 +54,7 @@ namespace Private
 
 /// Utility class to merge `childNames` from multiple
 /// input scenes, renaming children to preserve uniqueness.
-class ChildNamesMap : public IECore::Data
+class GAFFERSCENE_API ChildNamesMap : public IECore::Data
 {
 
 	public :
@@ -78,23 +77,26 @@ class ChildNamesMap : public IECore::Data
 
 	private :
 
-		const IECore::InternedStringVectorDataPtr m_childNames;
-
-		struct Child
-		{
-			const Input input;
-			const IECore::InternedString output;
-		};
+		void renameClashes( const std::vector<uint32_t> &clashes );
+		// Returns the output position for `input`, or `-1` if there is none.
+		int64_t outputPosition( const Input &input ) const;
 
-		using Map = boost::multi_index::multi_index_container<
-			Child,
-			boost::multi_index::indexed_by<
-				boost::multi_index::hashed_unique<boost::multi_index::member<Child, const IECore::InternedString, &Child::output>>,
-				boost::multi_index::hashed_unique<boost::multi_index::member<Child, const Input, &Child::input>>
-			>
-		>;
-
-		Map m_map;
+		const IECore::InternedStringVectorDataPtr m_childNames;
+		// The input for each child in `m_childNames`.
+		std::vector<Input> m_inputs;
+
+		// Open-addressed hash tables of positions in `m_childNames` and
+		// `m_inputs`, stored with an offset of one so that zero denotes an
+		// empty slot. Keys are not stored in the tables because they can be
+		// retrieved from the positions themselves, which keeps the tables
+		// small enough to build quickly for millions of children.
+
+		using IndexTable = std::vector<std::atomic<uint32_t>>;
+		// Maps from output name to position.
+		IndexTable m_outputTable;
+		// Maps from `Input` to position, but only for the renamed
+		// children. All others can be found via `m_outputTable`.
+		IndexTable m_renamedTable;
 
 };
 
@@ -0,0 +1,83 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2022, Cinesite VFX Ltd. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#ifndef GAFFERSCENE_PRIVATE_MERGEALGO_H
+#define GAFFERSCENE_PRIVATE_MERGEALGO_H
+
+#include "IECore/PathMatcherData.h"
+#include "IECore/VectorTypedData.h"
+
+#include <vector>
+
+namespace GafferScene
+{
+
+namespace Private
+{
+
+/// Utilities for merging values from many input scenes, shared by
+/// MergeScenes and CollectScenes. Input values are fetched concurrently
+/// with `parallelFor()` and then combined with the functions below, so
+/// that the cost of a merge is not dominated by serial upstream evaluation.
+namespace MergeAlgo
+{
+
+/// Calls `functor( i )` for each `i` in `[0, size)`, concurrently when
+/// `size` is large enough to make it worthwhile. The calling thread's
+/// ThreadState is in place for each call, so plug values may be queried
+/// directly. Exceptions are propagated to the caller.
+template<typename Functor>
+void parallelFor( size_t size, Functor &&functor );
+
+/// Merges names in a single ordered pass, keeping the first occurrence
+/// of each. Null inputs are ignored. When only one input contributes any
+/// names, it is returned as-is without copying.
+IECore::ConstInternedStringVectorDataPtr mergeNames( const std::vector<IECore::ConstInternedStringVectorDataPtr> &names );
+
+/// Returns the union of `sets`, computed as a parallel reduction.
+/// Null inputs are ignored. When only one input is non-empty, it is
+/// returned as-is without copying.
+IECore::ConstPathMatcherDataPtr unionSets( const std::vector<IECore::ConstPathMatcherDataPtr> &sets );
+
+} // namespace MergeAlgo
+
+} // namespace Private
+
+} // namespace GafferScene
+
+#include "GafferScene/Private/MergeAlgo.inl"
+
+#endif // GAFFERSCENE_PRIVATE_MERGEALGO_H
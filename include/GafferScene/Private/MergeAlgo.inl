@@ -0,0 +1,85 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2022, Cinesite VFX Ltd. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#include "Gaffer/ThreadState.h"
+
+#include "tbb/blocked_range.h"
+#include "tbb/parallel_for.h"
+
+namespace GafferScene
+{
+
+namespace Private
+{
+
+namespace MergeAlgo
+{
+
+template<typename Functor>
+void parallelFor( size_t size, Functor &&functor )
+{
+	// Fetching from just a couple of inputs is
+	// cheaper than spawning tasks to do it.
+	if( size < 4 )
+	{
+		for( size_t i = 0; i < size; ++i )
+		{
+			functor( i );
+		}
+		return;
+	}
+
+	const Gaffer::ThreadState &threadState = Gaffer::ThreadState::current();
+	tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+
+	tbb::parallel_for(
+		tbb::blocked_range<size_t>( 0, size ),
+		[&] ( const tbb::blocked_range<size_t> &range ) {
+			Gaffer::ThreadState::Scope threadStateScope( threadState );
+			for( size_t i = range.begin(); i != range.end(); ++i )
+			{
+				functor( i );
+			}
+		},
+		taskGroupContext
+	);
+}
+
+} // namespace MergeAlgo
+
+} // namespace Private
+
+} // namespace GafferScene
@@ -0,0 +1,80 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2022, Cinesite VFX Ltd. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#ifndef GAFFERSCENE_PRIVATE_QUERYALGO_H
+#define GAFFERSCENE_PRIVATE_QUERYALGO_H
+
+#include "GafferScene/ScenePlug.h"
+
+#include "IECore/MurmurHash.h"
+
+#include <string>
+#include <vector>
+
+namespace GafferScene
+{
+
+namespace Private
+{
+
+/// Utilities shared by the query nodes, for evaluating a query for a whole
+/// list of locations in a single compute. Locations are processed
+/// concurrently, rather than paying the overhead of a separate process and
+/// cache entry for each one.
+namespace QueryAlgo
+{
+
+/// Calls `functor( path, i )` for each non-empty location in `locations`,
+/// concurrently. The calling thread's ThreadState is in place for each call,
+/// so plug values may be queried directly. Exceptions are propagated to the
+/// caller.
+template<typename Functor>
+void parallelForLocations( const std::vector<std::string> &locations, Functor &&functor );
+
+/// Calls `functor( path, h )` for each non-empty location in `locations`,
+/// concurrently, and returns the per-location hashes combined in order.
+template<typename Functor>
+IECore::MurmurHash parallelLocationsHash( const std::vector<std::string> &locations, Functor &&functor );
+
+} // namespace QueryAlgo
+
+} // namespace Private
+
+} // namespace GafferScene
+
+#include "GafferScene/Private/QueryAlgo.inl"
+
+#endif // GAFFERSCENE_PRIVATE_QUERYALGO_H
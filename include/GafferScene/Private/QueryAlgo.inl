@@ -0,0 +1,97 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2022, Cinesite VFX Ltd. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#include "Gaffer/ThreadState.h"
+
+#include "tbb/blocked_range.h"
+#include "tbb/parallel_for.h"
+
+namespace GafferScene
+{
+
+namespace Private
+{
+
+namespace QueryAlgo
+{
+
+template<typename Functor>
+void parallelForLocations( const std::vector<std::string> &locations, Functor &&functor )
+{
+	const Gaffer::ThreadState &threadState = Gaffer::ThreadState::current();
+	tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+
+	tbb::parallel_for(
+		tbb::blocked_range<size_t>( 0, locations.size() ),
+		[&] ( const tbb::blocked_range<size_t> &range ) {
+			Gaffer::ThreadState::Scope threadStateScope( threadState );
+			for( size_t i = range.begin(); i != range.end(); ++i )
+			{
+				if( !locations[i].empty() )
+				{
+					functor( ScenePlug::stringToPath( locations[i] ), i );
+				}
+			}
+		},
+		taskGroupContext
+	);
+}
+
+template<typename Functor>
+IECore::MurmurHash parallelLocationsHash( const std::vector<std::string> &locations, Functor &&functor )
+{
+	std::vector<IECore::MurmurHash> hashes( locations.size() );
+	parallelForLocations(
+		locations,
+		[&] ( const ScenePlug::ScenePath &path, size_t i ) {
+			functor( path, hashes[i] );
+		}
+	);
+
+	IECore::MurmurHash result;
+	for( const auto &h : hashes )
+	{
+		result.append( h );
+	}
+	result.append( (uint64_t)hashes.size() );
+	return result;
+}
+
+} // namespace QueryAlgo
+
+} // namespace Private
+
+} // namespace GafferScene
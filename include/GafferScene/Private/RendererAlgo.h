@@ -75,7 +75,8 @@ GAFFERSCENE_API bool deformationMotionTimes( bool motionBlur, const Imath::V2f &
 
 /// Samples the local transform from the current location in preparation for output to the renderer.
 /// "samples" will be set to contain one sample for each sampleTime, unless the samples are all identical,
-/// in which case just one sample is output.
+/// in which case just one sample is output. Samples are hashed and computed concurrently, and if all
+/// sample hashes match then only a single sample is computed.
 /// If "hash" is passed in, then the hash will be set a value characterizing the samples.  If "hash" is
 /// already at this value, this function will do nothing and return false.  Returns true if hash is not
 /// passed in or the hash does not match.
@@ -86,6 +87,12 @@ GAFFERSCENE_API bool transformSamples( const Gaffer::M44fPlug *transformPlug, co
 /// Primitives and Cameras, since other object types cannot be interpolated anyway.
 GAFFERSCENE_API bool objectSamples( const Gaffer::ObjectPlug *objectPlug, const std::vector<float> &sampleTimes, std::vector<IECore::ConstObjectPtr> &samples, IECore::MurmurHash *hash = nullptr );
 
+/// Returns the total number of samples that have been collapsed by `transformSamples()` and
+/// `objectSamples()` because they were identical to the first sample. This is a process-wide
+/// statistic, intended to help diagnose the cost of motion blur in a render.
+GAFFERSCENE_API uint64_t collapsedMotionSamples();
+GAFFERSCENE_API void resetCollapsedMotionSamples();
+
 GAFFERSCENE_API void outputOptions( const IECore::CompoundObject *globals, IECoreScenePreview::Renderer *renderer );
 GAFFERSCENE_API void outputOptions( const IECore::CompoundObject *globals, const IECore::CompoundObject *previousGlobals, IECoreScenePreview::Renderer *renderer );
 
@@ -207,7 +214,10 @@ class GAFFERSCENE_API LightLinks : boost::noncopyable
 		void addFilterLink( const IECoreScenePreview::Renderer::ObjectInterfacePtr &lightFilter, const std::string &filteredLightsExpression );
 		void removeFilterLink( const IECoreScenePreview::Renderer::ObjectInterfacePtr &lightFilter, const std::string &filteredLightsExpression );
 		std::string filteredLightsExpression( const IECore::CompoundObject *attributes ) const;
-		IECoreScenePreview::Renderer::ConstObjectSetPtr linkedLights( const std::string &linkedLightsExpression, const ScenePlug *scene ) const;
+		IECoreScenePreview::Renderer::ConstObjectSetPtr linkedLights( const std::string &linkedLightsExpression, const ScenePlug *scene, IECore::MurmurHash &hash ) const;
+		/// Returns false if `linkedLightsExpression` hasn't been evaluated since sets
+		/// were last dirtied, in which case `linkedLights()` must be called instead.
+		bool cachedLinkedLightsHash( const std::string &linkedLightsExpression, IECore::MurmurHash &hash ) const;
 		void outputLightFilterLinks( const std::string &lightName, IECoreScenePreview::Renderer::ObjectInterface *light ) const;
 		void clearLightLinks();
 
@@ -223,11 +233,23 @@ class GAFFERSCENE_API LightLinks : boost::noncopyable
 		/// ===========================
 		///
 		/// This maps from `linkedLights` expressions to ObjectSets containing
-		/// the relevant lights.
+		/// the relevant lights. We also store the hash of each expression, so
+		/// that when sets are dirtied we only need to reevaluate the expressions
+		/// that actually changed.
+
+		struct LightLink
+		{
+			IECoreScenePreview::Renderer::ObjectSetPtr lights;
+			IECore::MurmurHash hash;
+			bool dirty = true;
+		};
 
-		using LightLinkMap = tbb::concurrent_hash_map<std::string, IECoreScenePreview::Renderer::ObjectSetPtr>;
+		using LightLinkMap = tbb::concurrent_hash_map<std::string, LightLink>;
 		mutable LightLinkMap m_lightLinks;
 		tbb::spin_mutex m_lightLinksClearMutex;
+		/// Incremented whenever lights are added or removed, invalidating
+		/// all existing links.
+		std::atomic<uint64_t> m_lightsVersion;
 
 		/// Storage for links between lights and light filters
 		/// ==================================================
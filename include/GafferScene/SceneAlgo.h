@@ -49,6 +49,8 @@
 #include "IECore/Export.h"
 
 IECORE_PUSH_DEFAULT_VISIBILITY
+#include "OpenEXR/ImathFrustum.h"
+#include "OpenEXR/ImathLine.h"
 #include "OpenEXR/ImathVec.h"
 IECORE_POP_DEFAULT_VISIBILITY
 
@@ -166,7 +168,9 @@ GAFFERSCENE_API IECore::ConstCompoundDataPtr sets( const ScenePlug *scene, const
 /// =======
 ///
 /// Methods to query the tree of upstream computations involved in computing
-/// a property of the scene.
+/// a property of the scene. Where the same upstream computation contributes
+/// to several branches of the tree, a single History item is shared between
+/// them. All methods may be cancelled via the canceller of the current context.
 
 struct History : public IECore::RefCounted
 {
@@ -249,6 +253,34 @@ GAFFERSCENE_API IECore::PathMatcher linkedLights( const ScenePlug *scene, const
 /// Returns the paths to all lights which are linked to at least one of the specified objects.
 GAFFERSCENE_API IECore::PathMatcher linkedLights( const ScenePlug *scene, const IECore::PathMatcher &objects );
 
+/// Bounds queries
+/// ==============
+///
+/// These queries use `ScenePlug::bound()` to prune the traversal of any
+/// subtree that cannot contribute to the result, so their cost is
+/// proportional to the number of locations returned rather than to
+/// the size of the scene. Locations with many children are accelerated
+/// by a bounding volume hierarchy built from the child bounds. This is
+/// cached and reused by subsequent queries until the child bounds change.
+///
+/// Tests are made using the world space bounding box of each location,
+/// and are therefore conservative : a location may be returned even
+/// though its contents don't quite intersect the query.
+
+/// Returns all locations at or below `root` whose bounds intersect the
+/// frustum. The frustum is specified in camera space, and `cameraTransform`
+/// positions the camera in world space.
+GAFFERSCENE_API IECore::PathMatcher findInFrustum( const ScenePlug *scene, const Imath::Frustumf &frustum, const Imath::M44f &cameraTransform, const ScenePlug::ScenePath &root = ScenePlug::ScenePath() );
+/// Returns all locations at or below `root` whose bounds are intersected by
+/// the world space ray starting at `ray.pos` and travelling in the direction
+/// `ray.dir`.
+GAFFERSCENE_API IECore::PathMatcher findIntersecting( const ScenePlug *scene, const Imath::Line3f &ray, const ScenePlug::ScenePath &root = ScenePlug::ScenePath() );
+/// The bounding volume hierarchies used by the bounds queries are cached
+/// separately from the ValuePlug compute cache, and are cleared along with
+/// it. These functions manage the memory limit for that cache.
+GAFFERSCENE_API size_t getBoundsQueryCacheMemoryLimit();
+GAFFERSCENE_API void setBoundsQueryCacheMemoryLimit( size_t bytes );
+
 /// Miscellaneous
 /// =============
 
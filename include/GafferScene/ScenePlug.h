@@ -238,6 +238,8 @@ class GAFFERSCENE_API ScenePlug : public Gaffer::ValuePlug
 		/// Returns just the attributes set at the specific scene path.
 		IECore::ConstCompoundObjectPtr attributes( const ScenePath &scenePath ) const;
 		/// Returns the full set of inherited attributes at the specified scene path.
+		/// Results are cached, and computed incrementally from the cached result for
+		/// the parent location, so the cost doesn't grow with the depth of the path.
 		IECore::CompoundObjectPtr fullAttributes( const ScenePath &scenePath ) const;
 		IECore::ConstObjectPtr object( const ScenePath &scenePath ) const;
 		IECore::ConstInternedStringVectorDataPtr childNames( const ScenePath &scenePath ) const;
@@ -283,6 +285,16 @@ class GAFFERSCENE_API ScenePlug : public Gaffer::ValuePlug
 		static void pathToString( const ScenePlug::ScenePath &path, std::string &s );
 		static std::string pathToString( const ScenePlug::ScenePath &path );
 
+		/// Cache management
+		/// ================
+
+		/// `fullAttributes()` caches its results separately from the ValuePlug
+		/// compute cache, and they are cleared along with it. These functions
+		/// manage the memory limit for that cache, which is shared between the
+		/// cached hashes (one third) and the cached attributes (the remainder).
+		static size_t getFullAttributesCacheMemoryLimit();
+		static void setFullAttributesCacheMemoryLimit( size_t bytes );
+
 		/// Deprecated methods
 		/// ==================
 
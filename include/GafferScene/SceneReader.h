@@ -43,11 +43,14 @@
 
 #include "tbb/enumerable_thread_specific.h"
 
+#include <memory>
+
 namespace Gaffer
 {
 
 IE_CORE_FORWARDDECLARE( StringPlug )
 IE_CORE_FORWARDDECLARE( TransformPlug )
+IE_CORE_FORWARDDECLARE( ObjectPlug )
 
 } // namespace Gaffer
 
@@ -78,12 +81,37 @@ class GAFFERSCENE_API SceneReader : public SceneNode
 		Gaffer::TransformPlug *transformPlug();
 		const Gaffer::TransformPlug *transformPlug() const;
 
+		/// When on, computing the child names for a location schedules
+		/// background reads of the bounds, transforms and objects of the
+		/// children, so that they are already loaded by the time a traversal
+		/// reaches them. This can be of great benefit when reading from
+		/// storage with high latency. The reads are performed by a small
+		/// number of dedicated threads per node, so they never occupy the
+		/// threads used for computation.
+		///
+		/// Prefetching never changes the output. Prefetched values are read
+		/// from the same file, location and time as the regular computes, and
+		/// are keyed by everything those computes hash. So this plug is not
+		/// hashed, and does not affect any outputs.
+		Gaffer::BoolPlug *prefetchPlug();
+		const Gaffer::BoolPlug *prefetchPlug() const;
+
 		void affects( const Gaffer::Plug *input, AffectedPlugsContainer &outputs ) const override;
 
 		static size_t supportedExtensions( std::vector<std::string> &extensions );
 
+		/// Prefetched values are held in a cache shared by all SceneReaders,
+		/// separate from the ValuePlug compute cache, and cleared along with
+		/// it. These methods manage the memory limit for that cache.
+		static size_t getPrefetchCacheMemoryLimit();
+		static void setPrefetchCacheMemoryLimit( size_t bytes );
+
 	protected :
 
+		void hash( const Gaffer::ValuePlug *output, const Gaffer::Context *context, IECore::MurmurHash &h ) const override;
+		void compute( Gaffer::ValuePlug *output, const Gaffer::Context *context ) const override;
+		Gaffer::ValuePlug::CachePolicy computeCachePolicy( const Gaffer::ValuePlug *output ) const override;
+
 		/// \todo These methods defer to SceneInterface::hash() to do most of the work, but we could go further.
 		/// Currently we still hash in fileNamePlug() and refreshCountPlug() because we don't trust the current
 		/// implementation of SceneCache::hash() - it should hash the filename and modification time, but instead
@@ -111,6 +139,12 @@ class GAFFERSCENE_API SceneReader : public SceneNode
 
 		void plugSet( Gaffer::Plug *plug );
 
+		// Holds a CompoundObject containing all the sets in the file,
+		// loaded in a single walk of the hierarchy and shared by
+		// `computeSetNames()` and `computeSet()`.
+		Gaffer::ObjectPlug *setsPlug();
+		const Gaffer::ObjectPlug *setsPlug() const;
+
 		// The typical access patterns for the SceneReader include accessing
 		// the same file repeatedly, and also the same path within the file
 		// repeatedly (to hash a value then compute it for instance, or to get
@@ -130,6 +164,10 @@ class GAFFERSCENE_API SceneReader : public SceneNode
 		// and specified path, using m_lastScene to accelerate the lookups.
 		IECoreScene::ConstSceneInterfacePtr scene( const ScenePath &path ) const;
 
+		// Performs the background reads scheduled by `prefetchPlug()`.
+		class Prefetcher;
+		std::unique_ptr<Prefetcher> m_prefetcher;
+
 		static const double g_frameRate;
 		static size_t g_firstPlugIndex;
 
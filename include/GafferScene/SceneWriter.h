@@ -69,6 +69,12 @@ class GAFFERSCENE_API SceneWriter : public GafferDispatch::TaskNode
 		ScenePlug *outPlug();
 		const ScenePlug *outPlug() const;
 
+		/// The number of frames computed concurrently by `executeSequence()`.
+		/// When greater than one, frames are computed in parallel while
+		/// previously computed locations are written to the file.
+		Gaffer::IntPlug *concurrentFramesPlug();
+		const Gaffer::IntPlug *concurrentFramesPlug() const;
+
 		IECore::MurmurHash hash( const Gaffer::Context *context ) const override;
 
 	protected :
@@ -85,6 +91,7 @@ class GAFFERSCENE_API SceneWriter : public GafferDispatch::TaskNode
 	private :
 
 		void createDirectories( const std::string &fileName ) const;
+		void executePipelined( const ScenePlug *scene, const std::vector<float> &frames, int concurrentFrames ) const;
 
 		static size_t g_firstPlugIndex;
 
@@ -56,6 +56,12 @@ GAFFERSCENE_API void setExpressionHash( const std::string &setExpression, const
 
 GAFFERSCENE_API bool affectsSetExpression( const Gaffer::Plug *scenePlugChild );
 
+/// The results of set expression operations are cached separately from the
+/// ValuePlug compute cache, and are cleared along with it. These functions
+/// manage the memory limit for that cache.
+GAFFERSCENE_API size_t getCacheMemoryLimit();
+GAFFERSCENE_API void setCacheMemoryLimit( size_t bytes );
+
 } // namespace SetAlgo
 
 } // namespace Gaffer
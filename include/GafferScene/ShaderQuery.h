@@ -75,6 +75,13 @@ class GAFFERSCENE_API ShaderQuery : public Gaffer::ComputeNode
 		Gaffer::ArrayPlug *outPlug();
 		const Gaffer::ArrayPlug *outPlug() const;
 
+		/// Batch query : the `existsVector` and `valueVector` children of each
+		/// output provide the result of the query for each of `locationsPlug()`
+		/// in turn. Locations without the parameter have a NullObject value.
+		/// The default value is not used.
+		Gaffer::StringVectorDataPlug *locationsPlug();
+		const Gaffer::StringVectorDataPlug *locationsPlug() const;
+
 		/// Adds a query for parameter, with a type and default value specified by plug.
 		/// The returned NameValuePlug is parented to queriesPlug() and may be edited
 		/// subsequently to modify the parameter name and default. Corresponding children
@@ -97,6 +104,9 @@ class GAFFERSCENE_API ShaderQuery : public Gaffer::ComputeNode
 		const Gaffer::BoolPlug *existsPlugFromQuery( const Gaffer::NameValuePlug *queryPlug ) const;
 		const Gaffer::ValuePlug *valuePlugFromQuery( const Gaffer::NameValuePlug *queryPlug ) const;
 		const Gaffer::ValuePlug *outPlugFromQuery( const Gaffer::NameValuePlug *queryPlug ) const;
+		/// As above, but for the batch query outputs.
+		const Gaffer::BoolVectorDataPlug *existsVectorPlugFromQuery( const Gaffer::NameValuePlug *queryPlug ) const;
+		const Gaffer::ObjectVectorPlug *valueVectorPlugFromQuery( const Gaffer::NameValuePlug *queryPlug ) const;
 
 		/// Returns the child of `queryPlug` or `outPlug` corresponding to the `outputPlug`.
 		/// `outputPlug` can be any descendant of the desired ancestor.
@@ -116,6 +126,9 @@ class GAFFERSCENE_API ShaderQuery : public Gaffer::ComputeNode
 		Gaffer::ObjectPlug *intermediateObjectPlug();
 		const Gaffer::ObjectPlug *intermediateObjectPlug() const;
 
+		Gaffer::ObjectVectorPlug *intermediateObjectVectorPlug();
+		const Gaffer::ObjectVectorPlug *intermediateObjectVectorPlug() const;
+
 		const IECore::Data *parameterData( const IECore::Object *object, const std::string &parameterName ) const;
 
 		static size_t g_firstPlugIndex;
@@ -44,6 +44,7 @@
 #include "Gaffer/ComputeNode.h"
 #include "Gaffer/StringPlug.h"
 #include "Gaffer/CompoundNumericPlug.h"
+#include "Gaffer/TypedObjectPlug.h"
 #include "Gaffer/TypedPlug.h"
 
 #include <string>
@@ -84,6 +85,13 @@ struct GAFFERSCENE_API TransformQuery : Gaffer::ComputeNode
 	Gaffer::V3fPlug* scalePlug();
 	Gaffer::V3fPlug const* scalePlug() const;
 
+	/// Batch query : `matrixVectorPlug()` outputs the matrix for each of
+	/// `locationsPlug()` in turn, computed in parallel as a single value.
+	Gaffer::StringVectorDataPlug* locationsPlug();
+	Gaffer::StringVectorDataPlug const* locationsPlug() const;
+	Gaffer::M44fVectorDataPlug* matrixVectorPlug();
+	Gaffer::M44fVectorDataPlug const* matrixVectorPlug() const;
+
 	void affects( Gaffer::Plug const* input, AffectedPlugsContainer& outputs ) const override;
 
 protected:
@@ -91,6 +99,9 @@ protected:
 	void hash( Gaffer::ValuePlug const* output, Gaffer::Context const* context, IECore::MurmurHash& hash ) const override;
 	void compute( Gaffer::ValuePlug* output, Gaffer::Context const* context ) const override;
 
+	Gaffer::ValuePlug::CachePolicy hashCachePolicy( Gaffer::ValuePlug const* output ) const override;
+	Gaffer::ValuePlug::CachePolicy computeCachePolicy( Gaffer::ValuePlug const* output ) const override;
+
 	static size_t g_firstPlugIndex;
 };
 
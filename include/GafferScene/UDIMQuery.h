@@ -45,6 +45,7 @@
 
 #include "Gaffer/ComputeNode.h"
 #include "Gaffer/StringPlug.h"
+#include "Gaffer/TypedObjectPlug.h"
 
 namespace GafferScene
 {
@@ -86,6 +87,12 @@ class GAFFERSCENE_API UDIMQuery : public Gaffer::ComputeNode
 
 	private :
 
+		// Holds the UDIMs used by the mesh at the current location, so
+		// that they are cached per object and only recomputed for
+		// locations whose objects have changed.
+		Gaffer::IntVectorDataPlug *udimsPlug();
+		const Gaffer::IntVectorDataPlug *udimsPlug() const;
+
 		static size_t g_firstPlugIndex;
 
 };
@@ -0,0 +1,62 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2022, Cinesite VFX Ltd. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#ifndef GAFFERSCENETEST_CHILDNAMESMAPTEST_H
+#define GAFFERSCENETEST_CHILDNAMESMAPTEST_H
+
+#include "GafferSceneTest/Export.h"
+
+#include "IECore/ObjectVector.h"
+
+namespace GafferSceneTest
+{
+
+/// Checks that `GafferScene::Private::ChildNamesMap` renames children in
+/// exactly the same way as a simple serial implementation, for inputs large
+/// enough to be processed in parallel. Throws if a discrepancy is found.
+GAFFERSCENETEST_API void testChildNamesMap();
+
+/// Returns `numInputs` InternedStringVectorData, each containing `childrenPerInput`
+/// names. If `clashing` is true, all inputs contain the same names, otherwise all
+/// names are unique.
+GAFFERSCENETEST_API IECore::ObjectVectorPtr childNamesMapBenchmarkInputs( size_t numInputs, size_t childrenPerInput, bool clashing );
+/// Builds a ChildNamesMap from the InternedStringVectorData in `inputs`, returning
+/// the number of output names.
+GAFFERSCENETEST_API size_t childNamesMapBenchmark( const IECore::ObjectVector *inputs );
+
+} // namespace GafferSceneTest
+
+#endif // GAFFERSCENETEST_CHILDNAMESMAPTEST_H
@@ -0,0 +1,132 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2022, Cinesite VFX Ltd. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#ifndef GAFFERSCENETEST_LATENCYSCENEINTERFACE_H
+#define GAFFERSCENETEST_LATENCYSCENEINTERFACE_H
+
+#include "GafferSceneTest/Export.h"
+#include "GafferSceneTest/TypeIds.h"
+
+#include "IECoreScene/SceneInterface.h"
+
+namespace GafferSceneTest
+{
+
+/// A SceneInterface which simulates high-latency storage, by wrapping
+/// another SceneInterface and sleeping before every read of bounds,
+/// transforms, attributes and objects. Files are opened by appending
+/// ".latency" to the name of a regular file, for instance
+/// "/path/to/file.scc.latency". Only reading is supported.
+class GAFFERSCENETEST_API LatencySceneInterface : public IECoreScene::SceneInterface
+{
+
+	public :
+
+		LatencySceneInterface( const std::string &fileName, IECore::IndexedIO::OpenMode mode );
+		~LatencySceneInterface() override;
+
+		IE_CORE_DECLARERUNTIMETYPEDEXTENSION( GafferSceneTest::LatencySceneInterface, LatencySceneInterfaceTypeId, IECoreScene::SceneInterface );
+
+		/// The latency added to each read, in seconds.
+		static void setLatency( double latency );
+		static double getLatency();
+
+		/// The number of reads performed since the last call to
+		/// `resetReadCount()`.
+		static size_t readCount();
+		static void resetReadCount();
+
+		std::string fileName() const override;
+
+		Name name() const override;
+		void path( Path &p ) const override;
+
+		bool hasBound() const override;
+		Imath::Box3d readBound( double time ) const override;
+		void writeBound( const Imath::Box3d &bound, double time ) override;
+
+		IECore::ConstDataPtr readTransform( double time ) const override;
+		Imath::M44d readTransformAsMatrix( double time ) const override;
+		void writeTransform( const IECore::Data *transform, double time ) override;
+
+		bool hasAttribute( const Name &name ) const override;
+		void attributeNames( NameList &attrs ) const override;
+		IECore::ConstObjectPtr readAttribute( const Name &name, double time ) const override;
+		void writeAttribute( const Name &name, const IECore::Object *attribute, double time ) override;
+
+		bool hasTag( const Name &name, int filter = SceneInterface::LocalTag ) const override;
+		void readTags( NameList &tags, int filter = SceneInterface::LocalTag ) const override;
+		void writeTags( const NameList &tags ) override;
+
+		NameList setNames( bool includeDescendantSets = true ) const override;
+		IECore::PathMatcher readSet( const Name &name, bool includeDescendantSets = true, const IECore::Canceller *canceller = nullptr ) const override;
+		void writeSet( const Name &name, const IECore::PathMatcher &set ) override;
+		void hashSet( const Name &setName, IECore::MurmurHash &h ) const override;
+
+		bool hasObject() const override;
+		IECore::ConstObjectPtr readObject( double time, const IECore::Canceller *canceller = nullptr ) const override;
+		IECoreScene::PrimitiveVariableMap readObjectPrimitiveVariables( const std::vector<IECore::InternedString> &primVarNames, double time ) const override;
+		void writeObject( const IECore::Object *object, double time ) override;
+
+		bool hasChild( const Name &name ) const override;
+		void childNames( NameList &childNames ) const override;
+		IECoreScene::SceneInterfacePtr child( const Name &name, MissingBehaviour missingBehaviour = SceneInterface::ThrowIfMissing ) override;
+		IECoreScene::ConstSceneInterfacePtr child( const Name &name, MissingBehaviour missingBehaviour = SceneInterface::ThrowIfMissing ) const override;
+		IECoreScene::SceneInterfacePtr createChild( const Name &name ) override;
+
+		IECoreScene::SceneInterfacePtr scene( const Path &path, MissingBehaviour missingBehaviour = SceneInterface::ThrowIfMissing ) override;
+		IECoreScene::ConstSceneInterfacePtr scene( const Path &path, MissingBehaviour missingBehaviour = SceneInterface::ThrowIfMissing ) const override;
+
+		void hash( HashType hashType, double time, IECore::MurmurHash &h ) const override;
+
+	private :
+
+		LatencySceneInterface( const std::string &fileName, const IECoreScene::SceneInterfacePtr &scene );
+
+		// Returns a wrapper for `scene`, or null if `scene` is null.
+		IECoreScene::SceneInterfacePtr wrap( const IECoreScene::SceneInterfacePtr &scene ) const;
+		void simulateLatency() const;
+
+		const std::string m_fileName;
+		IECoreScene::SceneInterfacePtr m_scene;
+
+};
+
+IE_CORE_DECLAREPTR( LatencySceneInterface )
+
+} // namespace GafferSceneTest
+
+#endif // GAFFERSCENETEST_LATENCYSCENEINTERFACE_H
@@ -0,0 +1,71 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2022, Cinesite VFX Ltd. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#ifndef GAFFERSCENETEST_SCENETRANSLATIONBENCHMARK_H
+#define GAFFERSCENETEST_SCENETRANSLATIONBENCHMARK_H
+
+#include "GafferSceneTest/Export.h"
+
+#include "GafferScene/ScenePlug.h"
+
+#include "GafferScene/Private/IECoreScenePreview/Procedural.h"
+#include "GafferScene/Private/IECoreScenePreview/Renderer.h"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace GafferSceneTest
+{
+
+/// Returns the number of locations in the scene, counted using a parallel traversal.
+GAFFERSCENETEST_API size_t countLocations( const GafferScene::ScenePlug *scene );
+
+using PhaseTimings = std::vector<std::pair<std::string, double>>;
+
+/// Outputs the scene to the renderer using the same RendererAlgo calls as the Render
+/// node, returning the wall clock time in seconds taken by each phase of the output.
+/// Phases are listed in the order in which they were performed.
+GAFFERSCENETEST_API PhaseTimings outputScene( const GafferScene::ScenePlug *scene, IECoreScenePreview::Renderer *renderer );
+
+/// Expands the procedurals concurrently, each rendering into the renderer
+/// with the same index. This mimics the way renderers expand procedurals
+/// on many threads at once.
+GAFFERSCENETEST_API void expandProcedurals( const std::vector<const IECoreScenePreview::Procedural *> &procedurals, const std::vector<IECoreScenePreview::Renderer *> &renderers );
+
+} // namespace GafferSceneTest
+
+#endif // GAFFERSCENETEST_SCENETRANSLATIONBENCHMARK_H
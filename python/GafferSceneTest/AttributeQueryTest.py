@@ -1334,6 +1334,47 @@ class AttributeQueryTest( GafferSceneTest.SceneTestCase ):
 
 		self.assertEqual( q["value"].getValue(), v.attributes()["test:shader"] )
 
+	def testLocations( self ) :
+
+		sphere = GafferScene.Sphere()
+
+		group = GafferScene.Group()
+		group["in"][0].setInput( sphere["out"] )
+		group["in"][1].setInput( sphere["out"] )
+
+		pathFilter = GafferScene.PathFilter()
+		pathFilter["paths"].setValue( IECore.StringVectorData( [ "/group", "/group/sphere1" ] ) )
+
+		attributes = GafferScene.CustomAttributes()
+		attributes["in"].setInput( group["out"] )
+		attributes["filter"].setInput( pathFilter["out"] )
+		attributes["attributes"].addChild( Gaffer.NameValuePlug( "test", Gaffer.IntPlug( defaultValue = 10 ) ) )
+
+		locations = [ "/group/sphere", "/group/sphere1", "", "/iDontExist", "/", "/group" ]
+
+		query = GafferScene.AttributeQuery()
+		query["scene"].setInput( attributes["out"] )
+		query["locations"].setValue( IECore.StringVectorData( locations ) )
+		query["attribute"].setValue( "test" )
+		query.setup( Gaffer.ObjectPlug( defaultValue = IECore.NullObject() ) )
+
+		for inherit in ( False, True ) :
+			query["inherit"].setValue( inherit )
+
+			expectedExists = IECore.BoolVectorData()
+			expectedValue = IECore.ObjectVector()
+			for location in locations :
+				query["location"].setValue( location )
+				expectedExists.append( query["exists"].getValue() )
+				expectedValue.append( query["value"].getValue() )
+
+			self.assertEqual( query["existsVector"].getValue(), expectedExists )
+			self.assertEqual( query["valueVector"].getValue(), expectedValue )
+
+		self.assertEqual( expectedExists, IECore.BoolVectorData( [ True, True, False, False, False, True ] ) )
+		self.assertEqual( query["valueVector"].getValue()[0], IECore.IntData( 10 ) )
+
+
 
 if __name__ == "__main__":
 	unittest.main()
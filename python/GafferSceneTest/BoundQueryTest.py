@@ -482,5 +482,38 @@ class BoundQueryTest( GafferSceneTest.SceneTestCase ):
 		self.assertTrue( bq["center"].getValue().equalWithAbsError( b.center(), 0.000001 ) )
 		self.assertTrue( bq["size"].getValue().equalWithAbsError( b.size(), 0.000001 ) )
 
+	def testLocations( self ):
+
+		sphere = GafferScene.Sphere()
+		sphere["transform"]["translate"].setValue( imath.V3f( 1, 2, 3 ) )
+
+		cube = GafferScene.Cube()
+		cube["dimensions"].setValue( imath.V3f( 1, 2, 3 ) )
+
+		group = GafferScene.Group()
+		group["in"][0].setInput( sphere["out"] )
+		group["in"][1].setInput( cube["out"] )
+		group["transform"]["rotate"].setValue( imath.V3f( 0, 90, 0 ) )
+
+		locations = [ "/group/sphere", "/group/cube", "", "/iDontExist", "/", "/group" ]
+
+		query = GafferScene.BoundQuery()
+		query["scene"].setInput( group["out"] )
+		query["locations"].setValue( IECore.StringVectorData( locations ) )
+		query["relativeLocation"].setValue( "/group/cube" )
+
+		for space in GafferScene.BoundQuery.Space.values.values() :
+			query["space"].setValue( space )
+
+			expectedCenter = IECore.V3fVectorData()
+			expectedSize = IECore.V3fVectorData()
+			for location in locations :
+				query["location"].setValue( location )
+				expectedCenter.append( query["center"].getValue() )
+				expectedSize.append( query["size"].getValue() )
+
+			self.assertEqual( query["centerVector"].getValue(), expectedCenter )
+			self.assertEqual( query["sizeVector"].getValue(), expectedSize )
+
 if __name__ == "__main__":
 	unittest.main()
\ No newline at end of file
@@ -41,6 +41,7 @@ import six
 import IECore
 
 import Gaffer
+import GafferTest
 import GafferScene
 import GafferSceneTest
 
@@ -77,5 +78,119 @@ class CapsuleTest( GafferSceneTest.SceneTestCase ) :
 
 		six.assertRaisesRegex( self, RuntimeError, "Source scene plug no longer valid.", capsule.scene )
 
+	def __encapsulatedGroups( self, numGroups, numSets = 1 ) :
+
+		script = Gaffer.ScriptNode()
+
+		script["sphere"] = GafferScene.Sphere()
+
+		script["group"] = GafferScene.Group()
+		script["group"]["in"][0].setInput( script["sphere"]["out"] )
+
+		script["groupFilter"] = GafferScene.PathFilter()
+		script["groupFilter"]["paths"].setValue( IECore.StringVectorData( [ "/group" ] ) )
+
+		script["duplicate"] = GafferScene.Duplicate()
+		script["duplicate"]["in"].setInput( script["group"]["out"] )
+		script["duplicate"]["filter"].setInput( script["groupFilter"]["out"] )
+		script["duplicate"]["copies"].setValue( numGroups - 1 )
+
+		script["sphereFilter"] = GafferScene.PathFilter()
+		script["sphereFilter"]["paths"].setValue( IECore.StringVectorData( [ "/*/sphere" ] ) )
+
+		previous = script["duplicate"]["out"]
+		for i in range( 0, numSets ) :
+			setNode = GafferScene.Set( "set{}".format( i ) )
+			setNode["name"].setValue( "render:set{}".format( i ) )
+			setNode["in"].setInput( previous )
+			setNode["filter"].setInput( script["sphereFilter"]["out"] )
+			script.addChild( setNode )
+			previous = setNode["out"]
+
+		script["encapsulateFilter"] = GafferScene.PathFilter()
+		script["encapsulateFilter"]["paths"].setValue( IECore.StringVectorData( [ "/*" ] ) )
+
+		script["encapsulate"] = GafferScene.Encapsulate()
+		script["encapsulate"]["in"].setInput( previous )
+		script["encapsulate"]["filter"].setInput( script["encapsulateFilter"]["out"] )
+
+		return script
+
+	def __capsules( self, scene ) :
+
+		return [
+			scene.object( "/" + str( n ) )
+			for n in scene.childNames( "/" )
+		]
+
+	def __renderers( self, count ) :
+
+		return [
+			GafferScene.Private.IECoreScenePreview.CapturingRenderer(
+				GafferScene.Private.IECoreScenePreview.Renderer.RenderType.Batch
+			)
+			for i in range( 0, count )
+		]
+
+	def testConcurrentExpansion( self ) :
+
+		script = self.__encapsulatedGroups( 20, numSets = 3 )
+		capsules = self.__capsules( script["encapsulate"]["out"] )
+		self.assertEqual( len( capsules ), 20 )
+		for capsule in capsules :
+			self.assertIsInstance( capsule, GafferScene.Capsule )
+
+		serialRenderers = self.__renderers( len( capsules ) )
+		for capsule, renderer in zip( capsules, serialRenderers ) :
+			capsule.render( renderer )
+
+		concurrentRenderers = self.__renderers( len( capsules ) )
+		GafferSceneTest.expandProcedurals( capsules, concurrentRenderers )
+
+		for serialRenderer, concurrentRenderer in zip( serialRenderers, concurrentRenderers ) :
+			serialObject = serialRenderer.capturedObject( "/sphere" )
+			concurrentObject = concurrentRenderer.capturedObject( "/sphere" )
+			self.assertIsNotNone( concurrentObject )
+			self.assertEqual( concurrentObject.capturedSamples(), serialObject.capturedSamples() )
+			self.assertEqual( concurrentObject.capturedTransforms(), serialObject.capturedTransforms() )
+			self.assertEqual( concurrentObject.capturedAttributes().attributes(), serialObject.capturedAttributes().attributes() )
+			self.assertEqual(
+				concurrentObject.capturedAttributes().attributes()["sets"],
+				IECore.InternedStringVectorData( [ "set0", "set1", "set2" ] )
+			)
+
+	def testExpansionAfterSetEdit( self ) :
+
+		# The render sets are cached by hash, so edits must
+		# be reflected in subsequent expansions.
+
+		script = self.__encapsulatedGroups( 2 )
+
+		renderer = self.__renderers( 1 )[0]
+		self.__capsules( script["encapsulate"]["out"] )[0].render( renderer )
+		self.assertEqual(
+			renderer.capturedObject( "/sphere" ).capturedAttributes().attributes()["sets"],
+			IECore.InternedStringVectorData( [ "set0" ] )
+		)
+
+		script["set0"]["name"].setValue( "render:renamed" )
+
+		renderer = self.__renderers( 1 )[0]
+		self.__capsules( script["encapsulate"]["out"] )[0].render( renderer )
+		self.assertEqual(
+			renderer.capturedObject( "/sphere" ).capturedAttributes().attributes()["sets"],
+			IECore.InternedStringVectorData( [ "renamed" ] )
+		)
+
+	@GafferTest.TestRunner.PerformanceTestMethod()
+	def testConcurrentExpansionPerformance( self ) :
+
+		script = self.__encapsulatedGroups( 1000, numSets = 20 )
+		capsules = self.__capsules( script["encapsulate"]["out"] )
+		renderers = self.__renderers( len( capsules ) )
+
+		with GafferTest.TestRunner.PerformanceScope() :
+			GafferSceneTest.expandProcedurals( capsules, renderers )
+
 if __name__ == "__main__":
 	unittest.main()
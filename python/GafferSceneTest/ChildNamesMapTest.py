@@ -0,0 +1,67 @@
+##########################################################################
+#
+#  Copyright (c) 2022, Cinesite VFX Ltd. All rights reserved.
+#
+#  Redistribution and use in source and binary forms, with or without
+#  modification, are permitted provided that the following conditions are
+#  met:
+#
+#      * Redistributions of source code must retain the above
+#        copyright notice, this list of conditions and the following
+#        disclaimer.
+#
+#      * Redistributions in binary form must reproduce the above
+#        copyright notice, this list of conditions and the following
+#        disclaimer in the documentation and/or other materials provided with
+#        the distribution.
+#
+#      * Neither the name of John Haddon nor the names of
+#        any other contributors to this software may be used to endorse or
+#        promote products derived from this software without specific prior
+#        written permission.
+#
+#  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+#  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+#  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+#  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+#  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+#  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+#  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+#  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+#  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+#  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+#  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+##########################################################################
+
+import unittest
+
+import GafferTest
+import GafferSceneTest
+
+class ChildNamesMapTest( GafferSceneTest.SceneTestCase ) :
+
+	def test( self ) :
+
+		GafferSceneTest.testChildNamesMap()
+
+	@GafferTest.TestRunner.PerformanceTestMethod()
+	def testUniqueNamesPerformance( self ) :
+
+		inputs = GafferSceneTest.childNamesMapBenchmarkInputs( 10, 1000000, False )
+		with GafferTest.TestRunner.PerformanceScope() :
+			numChildren = GafferSceneTest.childNamesMapBenchmark( inputs )
+
+		self.assertEqual( numChildren, 10000000 )
+
+	@GafferTest.TestRunner.PerformanceTestMethod()
+	def testClashingNamesPerformance( self ) :
+
+		inputs = GafferSceneTest.childNamesMapBenchmarkInputs( 10, 1000000, True )
+		with GafferTest.TestRunner.PerformanceScope() :
+			numChildren = GafferSceneTest.childNamesMapBenchmark( inputs )
+
+		self.assertEqual( numChildren, 10000000 )
+
+if __name__ == "__main__":
+	unittest.main()
@@ -39,6 +39,7 @@ import imath
 import IECore
 import IECoreScene
 
+import Gaffer
 import GafferTest
 import GafferScene
 import GafferSceneTest
@@ -263,6 +264,82 @@ class ClosestPointSamplerTest( GafferSceneTest.SceneTestCase ) :
 		with GafferTest.TestRunner.PerformanceScope() :
 			sampler["out"].object( "/plane" )
 
+	@GafferTest.TestRunner.PerformanceTestMethod()
+	def testMillionPointPerformance( self ) :
+
+		sphere = GafferScene.Sphere()
+		sphere["divisions"].setValue( imath.V2i( 200, 400 ) )
+
+		plane = GafferScene.Plane()
+		plane["divisions"].setValue( imath.V2i( 999 ) )
+
+		planeFilter = GafferScene.PathFilter()
+		planeFilter["paths"].setValue( IECore.StringVectorData( [ "/plane" ] ) )
+
+		sampler = GafferScene.ClosestPointSampler()
+		sampler["in"].setInput( plane["out"] )
+		sampler["source"].setInput( sphere["out"] )
+		sampler["filter"].setInput( planeFilter["out"] )
+		sampler["sourceLocation"].setValue( "/sphere" )
+		sampler["primitiveVariables"].setValue( "uv" )
+		sampler["status"].setValue( "sampled" )
+
+		# Precache the input object and the evaluator, so we
+		# measure only the queries themselves.
+		self.assertEqual( sampler["in"].object( "/plane" )["P"].data.size(), 1000000 )
+		with Gaffer.Context() as c :
+			c["scene:path"] = IECore.InternedStringVectorData( [ "sphere" ] )
+			sampler["__evaluator"].getValue()
+
+		with GafferTest.TestRunner.PerformanceScope() :
+			sampler["out"].object( "/plane" )
+
+	def testEvaluatorSharedBetweenLocationsAndFrames( self ) :
+
+		sphere = GafferScene.Sphere()
+
+		plane1 = GafferScene.Plane()
+		plane2 = GafferScene.Plane()
+		plane2["transform"]["translate"]["x"].setValue( 2 )
+
+		group = GafferScene.Group()
+		group["in"][0].setInput( plane1["out"] )
+		group["in"][1].setInput( plane2["out"] )
+
+		planeFilter = GafferScene.PathFilter()
+		planeFilter["paths"].setValue( IECore.StringVectorData( [ "/group/*" ] ) )
+
+		sampler = GafferScene.ClosestPointSampler()
+		sampler["in"].setInput( group["out"] )
+		sampler["source"].setInput( sphere["out"] )
+		sampler["filter"].setInput( planeFilter["out"] )
+		sampler["sourceLocation"].setValue( "/sphere" )
+		sampler["primitiveVariables"].setValue( "P" )
+		sampler["prefix"].setValue( "sampled:" )
+		sampler["status"].setValue( "sampled" )
+
+		with Gaffer.PerformanceMonitor() as monitor :
+			for frame in ( 1, 2 ) :
+				with Gaffer.Context() as context :
+					context.setFrame( frame )
+					for path in ( "/group/plane", "/group/plane1" ) :
+						mesh = sampler["out"].object( path )
+						self.assertIn( "sampled:P", mesh )
+						self.assertEqual( mesh["sampled"].data, IECore.BoolVectorData( [ True ] * 4 ) )
+
+		self.assertEqual( monitor.plugStatistics( sampler["__evaluator"] ).computeCount, 1 )
+
+		# Editing the source must produce a new evaluator.
+
+		sphere["radius"].setValue( 2 )
+		with Gaffer.PerformanceMonitor() as monitor :
+			mesh = sampler["out"].object( "/group/plane" )
+
+		for p in mesh["sampled:P"].data :
+			self.assertGreater( p.length(), 1.9 )
+
+		self.assertEqual( monitor.plugStatistics( sampler["__evaluator"] ).computeCount, 1 )
+
 	def testPruneSourceLocation( self ) :
 
 		plane = GafferScene.Plane()
@@ -43,6 +43,7 @@ import six
 import IECore
 
 import Gaffer
+import GafferTest
 import GafferScene
 import GafferSceneTest
 
@@ -510,5 +511,45 @@ class CollectScenesTest( GafferSceneTest.SceneTestCase ) :
 			{ "frame", "framesPerSecond", "scene:path", "image:viewName" }
 		)
 
+	def testSetsFromManyRoots( self ) :
+
+		sphere = GafferScene.Sphere()
+		sphere["sets"].setValue( "all ${collect:rootName}" )
+
+		rootNames = [ "root{}".format( i ) for i in range( 0, 100 ) ]
+
+		collect = GafferScene.CollectScenes()
+		collect["in"].setInput( sphere["out"] )
+		collect["rootNames"].setValue( IECore.StringVectorData( rootNames ) )
+
+		self.assertEqual( list( collect["out"].setNames() ), [ "all" ] + rootNames )
+		self.assertEqual(
+			collect["out"].set( "all" ).value,
+			IECore.PathMatcher( [ "/{}/sphere".format( r ) for r in rootNames ] )
+		)
+		for rootName in rootNames :
+			self.assertEqual(
+				collect["out"].set( rootName ).value,
+				IECore.PathMatcher( [ "/{}/sphere".format( rootName ) ] )
+			)
+
+	@GafferTest.TestRunner.PerformanceTestMethod()
+	def testSetPerformance( self ) :
+
+		sphere = GafferScene.Sphere()
+		sphere["sets"].setValue( "spheres" )
+
+		duplicate = GafferScene.Duplicate()
+		duplicate["in"].setInput( sphere["out"] )
+		duplicate["target"].setValue( "/sphere" )
+		duplicate["copies"].setValue( 1000 )
+
+		collect = GafferScene.CollectScenes()
+		collect["in"].setInput( duplicate["out"] )
+		collect["rootNames"].setValue( IECore.StringVectorData( [ "root{}".format( i ) for i in range( 0, 1000 ) ] ) )
+
+		with GafferTest.TestRunner.PerformanceScope() :
+			collect["out"].set( "spheres" )
+
 if __name__ == "__main__":
 	unittest.main()
@@ -38,6 +38,7 @@ import imath
 
 import IECore
 import IECoreScene
+import GafferTest
 import GafferScene
 import GafferSceneTest
 
@@ -167,5 +168,103 @@ class DeleteFacesTest( GafferSceneTest.SceneTestCase ) :
 		deleteFaces["ignoreMissingVariable"].setValue( True )
 		self.assertEqual( deleteFaces["in"].object( "/object" ), deleteFaces["out"].object( "/object" ) )
 
+	def testMatchesMeshAlgo( self ) :
+
+		mesh = IECoreScene.MeshPrimitive.createPlane(
+			imath.Box2f( imath.V2f( -1 ), imath.V2f( 1 ) ),
+			imath.V2i( 10 )
+		)
+		numFaces = mesh.numFaces()
+		numVertices = mesh.variableSize( IECoreScene.PrimitiveVariable.Interpolation.Vertex )
+		numFaceVertices = mesh.variableSize( IECoreScene.PrimitiveVariable.Interpolation.FaceVarying )
+
+		mesh["constant"] = IECoreScene.PrimitiveVariable( IECoreScene.PrimitiveVariable.Interpolation.Constant, IECore.IntData( 10 ) )
+		mesh["uniform"] = IECoreScene.PrimitiveVariable( IECoreScene.PrimitiveVariable.Interpolation.Uniform, IECore.IntVectorData( range( 0, numFaces ) ) )
+		mesh["vertex"] = IECoreScene.PrimitiveVariable( IECoreScene.PrimitiveVariable.Interpolation.Vertex, IECore.FloatVectorData( range( 0, numVertices ) ) )
+		mesh["varying"] = IECoreScene.PrimitiveVariable( IECoreScene.PrimitiveVariable.Interpolation.Varying, IECore.V3fVectorData( [ imath.V3f( i ) for i in range( 0, numVertices ) ], IECore.GeometricData.Interpretation.Normal ) )
+		mesh["faceVarying"] = IECoreScene.PrimitiveVariable( IECoreScene.PrimitiveVariable.Interpolation.FaceVarying, IECore.BoolVectorData( [ i % 3 == 0 for i in range( 0, numFaceVertices ) ] ) )
+		mesh["indexedVertex"] = IECoreScene.PrimitiveVariable(
+			IECoreScene.PrimitiveVariable.Interpolation.Vertex,
+			IECore.StringVectorData( [ "a", "b" ] ),
+			IECore.IntVectorData( [ i % 2 for i in range( 0, numVertices ) ] )
+		)
+
+		mesh["deleteInt"] = IECoreScene.PrimitiveVariable( IECoreScene.PrimitiveVariable.Interpolation.Uniform, IECore.IntVectorData( [ i % 3 == 0 for i in range( 0, numFaces ) ] ) )
+		mesh["deleteBool"] = IECoreScene.PrimitiveVariable( IECoreScene.PrimitiveVariable.Interpolation.Uniform, IECore.BoolVectorData( [ i < 30 for i in range( 0, numFaces ) ] ) )
+		mesh["deleteFloat"] = IECoreScene.PrimitiveVariable( IECoreScene.PrimitiveVariable.Interpolation.Uniform, IECore.FloatVectorData( [ ( i % 7 ) * 0.5 for i in range( 0, numFaces ) ] ) )
+		self.assertTrue( mesh.arePrimitiveVariablesValid() )
+
+		objectToScene = GafferScene.ObjectToScene()
+		objectToScene["object"].setValue( mesh )
+
+		pathFilter = GafferScene.PathFilter()
+		pathFilter["paths"].setValue( IECore.StringVectorData( [ "/object" ] ) )
+
+		deleteFaces = GafferScene.DeleteFaces()
+		deleteFaces["in"].setInput( objectToScene["out"] )
+		deleteFaces["filter"].setInput( pathFilter["out"] )
+
+		for name in [ "deleteInt", "deleteBool", "deleteFloat" ] :
+			for invert in ( False, True ) :
+				with self.subTest( name = name, invert = invert ) :
+					deleteFaces["faces"].setValue( name )
+					deleteFaces["invert"].setValue( invert )
+					result = deleteFaces["out"].object( "/object" )
+					self.assertTrue( result.arePrimitiveVariablesValid() )
+					self.assertEqual( result, IECoreScene.MeshAlgo.deleteFaces( mesh, mesh[name], invert ) )
+
+	def testCornersAndCreases( self ) :
+
+		mesh = self.makeRectangleFromTwoSquaresScene()["object"].getValue()
+		mesh.setCorners( IECore.IntVectorData( [ 0, 2, 4 ] ), IECore.FloatVectorData( [ 1, 2, 3 ] ) )
+		mesh.setCreases( IECore.IntVectorData( [ 3, 2 ] ), IECore.IntVectorData( [ 0, 1, 2, 4, 5 ] ), IECore.FloatVectorData( [ 4, 5 ] ) )
+
+		objectToScene = GafferScene.ObjectToScene()
+		objectToScene["object"].setValue( mesh )
+
+		pathFilter = GafferScene.PathFilter()
+		pathFilter["paths"].setValue( IECore.StringVectorData( [ "/object" ] ) )
+
+		deleteFaces = GafferScene.DeleteFaces()
+		deleteFaces["in"].setInput( objectToScene["out"] )
+		deleteFaces["filter"].setInput( pathFilter["out"] )
+
+		# Vertices 2 and 5 are removed, so the corner on 2 is removed, the
+		# first crease is shortened and the second crease is removed.
+
+		result = deleteFaces["out"].object( "/object" )
+		self.assertEqual( result.cornerIds(), IECore.IntVectorData( [ 0, 3 ] ) )
+		self.assertEqual( result.cornerSharpnesses(), IECore.FloatVectorData( [ 1, 3 ] ) )
+		self.assertEqual( result.creaseLengths(), IECore.IntVectorData( [ 2 ] ) )
+		self.assertEqual( result.creaseIds(), IECore.IntVectorData( [ 0, 1 ] ) )
+		self.assertEqual( result.creaseSharpnesses(), IECore.FloatVectorData( [ 4 ] ) )
+
+	@GafferTest.TestRunner.PerformanceTestMethod()
+	def testPerformance( self ) :
+
+		mesh = IECoreScene.MeshPrimitive.createPlane(
+			imath.Box2f( imath.V2f( -1 ), imath.V2f( 1 ) ),
+			imath.V2i( 1000 )
+		)
+		mesh["deleteFaces"] = IECoreScene.PrimitiveVariable(
+			IECoreScene.PrimitiveVariable.Interpolation.Uniform,
+			IECore.IntVectorData( [ 1 if i % 3 == 0 else 0 for i in range( 0, mesh.numFaces() ) ] )
+		)
+
+		objectToScene = GafferScene.ObjectToScene()
+		objectToScene["object"].setValue( mesh )
+
+		pathFilter = GafferScene.PathFilter()
+		pathFilter["paths"].setValue( IECore.StringVectorData( [ "/object" ] ) )
+
+		deleteFaces = GafferScene.DeleteFaces()
+		deleteFaces["in"].setInput( objectToScene["out"] )
+		deleteFaces["filter"].setInput( pathFilter["out"] )
+
+		deleteFaces["in"].object( "/object" )
+
+		with GafferTest.TestRunner.PerformanceScope() :
+			deleteFaces["out"].object( "/object" )
+
 if __name__ == "__main__":
 	unittest.main()
@@ -314,5 +314,112 @@ class DuplicateTest( GafferSceneTest.SceneTestCase ) :
 			imath.M44f().translate( imath.V3f( 5, 0, 0 ) )
 		)
 
+	def testManyCopiesTransforms( self ) :
+
+		cube = GafferScene.Cube()
+
+		duplicate = GafferScene.Duplicate()
+		duplicate["in"].setInput( cube["out"] )
+		duplicate["target"].setValue( "/cube" )
+		duplicate["copies"].setValue( 1000 )
+		duplicate["transform"]["translate"].setValue( imath.V3f( 1, 2, 3 ) )
+		duplicate["transform"]["rotate"].setValue( imath.V3f( 1, 2, 3 ) )
+		duplicate["transform"]["scale"].setValue( imath.V3f( 1.001 ) )
+
+		# Transforms are generated on demand, but must match
+		# the result of accumulating the transform copy by copy.
+
+		matrix = duplicate["transform"].matrix()
+		expected = matrix
+		for i in range( 1, 1001 ) :
+			self.assertEqual( duplicate["out"].transform( "/cube{}".format( i ) ), expected )
+			expected = expected * matrix
+
+		self.assertEqual(
+			duplicate["out"].childNames( "/" ),
+			IECore.InternedStringVectorData( [ "cube" ] + [ "cube{}".format( i ) for i in range( 1, 1001 ) ] )
+		)
+
+		duplicate["name"].setValue( "copy10" )
+		self.assertEqual( duplicate["out"].transform( "/copy10" ), matrix )
+		self.assertEqual( duplicate["out"].transform( "/copy74" ), duplicate["out"].transform( "/cube65" ) )
+		self.assertFalse( duplicate["out"].exists( "/copy9" ) )
+		self.assertFalse( duplicate["out"].exists( "/copy1010" ) )
+
+	def testBoundMatchesUnionOfChildBounds( self ) :
+
+		sphere = GafferScene.Sphere()
+		sphere["transform"]["translate"].setValue( imath.V3f( 1, 2, 3 ) )
+
+		group = GafferScene.Group()
+		group["in"][0].setInput( sphere["out"] )
+		group["transform"]["rotate"].setValue( imath.V3f( 10, 20, 30 ) )
+
+		duplicate = GafferScene.Duplicate()
+		duplicate["in"].setInput( group["out"] )
+		duplicate["target"].setValue( "/group/sphere" )
+		duplicate["copies"].setValue( 300 )
+		duplicate["transform"]["translate"].setValue( imath.V3f( 1, 0.5, 0 ) )
+		duplicate["transform"]["rotate"].setValue( imath.V3f( 0, 3, 7 ) )
+		duplicate["transform"]["scale"].setValue( imath.V3f( 1.002 ) )
+
+		def assertBoundMatches( path ) :
+
+			# The bound at the destination is computed analytically, but must
+			# match the union of the input bound and the bounds of all the
+			# children, as computed individually.
+			expected = duplicate["in"].bound( path ) if duplicate["in"].exists( path ) else imath.Box3f()
+			expected.extendBy( duplicate["out"].childBounds( path ) )
+			self.assertEqual( duplicate["out"].bound( path ), expected )
+
+		assertBoundMatches( "/group" )
+		self.assertSceneValid( duplicate["out"] )
+
+		# Copies into a location that doesn't exist in the input.
+
+		duplicate["destination"].setValue( "/copies" )
+		assertBoundMatches( "/copies" )
+		self.assertSceneValid( duplicate["out"] )
+
+		# Several sources copied to the same destination.
+
+		cube = GafferScene.Cube()
+		group["in"][1].setInput( cube["out"] )
+
+		filter = GafferScene.PathFilter()
+		filter["paths"].setValue( IECore.StringVectorData( [ "/group/*" ] ) )
+		duplicate["filter"].setInput( filter["out"] )
+		duplicate["destination"].setToDefault()
+		duplicate["copies"].setValue( 100 )
+
+		assertBoundMatches( "/group" )
+		self.assertSceneValid( duplicate["out"] )
+
+		# Dirtying.
+
+		duplicate["transform"]["translate"]["y"].setValue( 2 )
+		assertBoundMatches( "/group" )
+		sphere["radius"].setValue( 3 )
+		assertBoundMatches( "/group" )
+		group["transform"]["translate"]["x"].setValue( 5 )
+		assertBoundMatches( "/group" )
+
+		duplicate["copies"].setValue( 0 )
+		assertBoundMatches( "/group" )
+
+	@GafferTest.TestRunner.PerformanceTestMethod()
+	def testManyCopiesPerformance( self ) :
+
+		cube = GafferScene.Cube()
+		duplicate = GafferScene.Duplicate()
+		duplicate["in"].setInput( cube["out"] )
+		duplicate["target"].setValue( "/cube" )
+		duplicate["transform"]["translate"]["x"].setValue( 2 )
+		duplicate["transform"]["rotate"]["y"].setValue( 1 )
+		duplicate["copies"].setValue( 1000000 )
+
+		with GafferTest.TestRunner.PerformanceScope() :
+			GafferSceneTest.traverseScene( duplicate["out"] )
+
 if __name__ == "__main__":
 	unittest.main()
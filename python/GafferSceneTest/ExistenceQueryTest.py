@@ -37,6 +37,8 @@
 import unittest
 import imath
 
+import IECore
+
 import Gaffer
 import GafferScene
 import GafferSceneTest
@@ -313,5 +315,29 @@ class ExistenceQueryTest( GafferSceneTest.SceneTestCase ):
 		q["location"].setValue( "/iDontExist" )
 		self.assertEqual( q["closestAncestor"].getValue(), "/" )
 
+	def testLocations( self ) :
+
+		sphere = GafferScene.Sphere()
+
+		group = GafferScene.Group()
+		group["in"][0].setInput( sphere["out"] )
+
+		locations = [ "/group/sphere", "", "/iDontExist", "/", "/group", "/group/sphere/iDontExist" ]
+
+		query = GafferScene.ExistenceQuery()
+		query["locations"].setValue( IECore.StringVectorData( locations ) )
+
+		self.assertEqual( query["existsVector"].getValue(), IECore.BoolVectorData( [ False ] * len( locations ) ) )
+
+		query["scene"].setInput( group["out"] )
+
+		expected = IECore.BoolVectorData()
+		for location in locations :
+			query["location"].setValue( location )
+			expected.append( query["exists"].getValue() )
+
+		self.assertEqual( query["existsVector"].getValue(), expected )
+		self.assertEqual( expected, IECore.BoolVectorData( [ True, False, False, True, True, False ] ) )
+
 if __name__ == "__main__":
 	unittest.main()
@@ -253,6 +253,90 @@ class FilterResultsTest( GafferSceneTest.SceneTestCase ) :
 		pathFilter["paths"].setValue( IECore.StringVectorData( [ "/" ] ) )
 		self.assertEqual( filterResults["outStrings"].getValue(), IECore.StringVectorData( [ "/" ] ) )
 
+	def testOnlyChangedBranchesRefiltered( self ) :
+
+		# /group
+		#    /groupA
+		#        /sphere
+		#    /groupB
+		#        /cube
+
+		sphere = GafferScene.Sphere()
+		groupA = GafferScene.Group()
+		groupA["name"].setValue( "groupA" )
+		groupA["in"][0].setInput( sphere["out"] )
+
+		cube = GafferScene.Cube()
+		groupB = GafferScene.Group()
+		groupB["name"].setValue( "groupB" )
+		groupB["in"][0].setInput( cube["out"] )
+
+		group = GafferScene.Group()
+		group["in"][0].setInput( groupA["out"] )
+		group["in"][1].setInput( groupB["out"] )
+
+		pathFilter = GafferScene.PathFilter()
+		pathFilter["paths"].setValue( IECore.StringVectorData( [ "/..." ] ) )
+
+		filterResults = GafferScene.FilterResults()
+		filterResults["scene"].setInput( group["out"] )
+		filterResults["filter"].setInput( pathFilter["out"] )
+
+		with Gaffer.PerformanceMonitor() as monitor :
+			self.assertEqual(
+				filterResults["out"].getValue().value,
+				GafferScene.SceneAlgo.matchingPaths( pathFilter, group["out"] )
+			)
+
+		# Results are relative to the subtree root, so the two leaf
+		# locations share a single compute.
+		self.assertEqual( monitor.plugStatistics( filterResults["__subtreeMatches"] ).computeCount, 5 )
+
+		# Renaming the sphere only affects the subtrees containing it.
+		# The results for `/group/groupB` and the leaf are reused from
+		# the cache.
+
+		sphere["name"].setValue( "ball" )
+		with Gaffer.PerformanceMonitor() as monitor :
+			self.assertEqual(
+				filterResults["out"].getValue().value,
+				IECore.PathMatcher( [
+					"/", "/group", "/group/groupA", "/group/groupA/ball",
+					"/group/groupB", "/group/groupB/cube",
+				] )
+			)
+
+		self.assertEqual( monitor.plugStatistics( filterResults["__subtreeMatches"] ).computeCount, 3 )
+
+	def testRootWithinCachedSubtrees( self ) :
+
+		sphere = GafferScene.Sphere()
+
+		duplicate = GafferScene.Duplicate()
+		duplicate["in"].setInput( sphere["out"] )
+		duplicate["target"].setValue( "/sphere" )
+		duplicate["copies"].setValue( 10 )
+
+		group = GafferScene.Group()
+		group["in"][0].setInput( duplicate["out"] )
+
+		pathFilter = GafferScene.PathFilter()
+		pathFilter["paths"].setValue( IECore.StringVectorData( [ "/group/sphere*" ] ) )
+
+		filterResults = GafferScene.FilterResults()
+		filterResults["scene"].setInput( group["out"] )
+		filterResults["filter"].setInput( pathFilter["out"] )
+
+		for root in [ "/", "/group", "/group/sphere3", "/group/sphere3/missing" ] :
+			filterResults["root"].setValue( root )
+			self.assertEqual(
+				filterResults["out"].getValue().value,
+				IECore.PathMatcher( [
+					p for p in GafferScene.SceneAlgo.matchingPaths( pathFilter, group["out"] ).paths()
+					if ( p + "/" ).startswith( root.rstrip( "/" ) + "/" )
+				] )
+			)
+
 	@unittest.skipIf( GafferTest.inCI(), "Performance not relevant on CI platform" )
 	@GafferTest.TestRunner.PerformanceTestMethod()
 	def testHashPerformance( self ):
@@ -301,5 +385,42 @@ class FilterResultsTest( GafferSceneTest.SceneTestCase ) :
 		with GafferTest.TestRunner.PerformanceScope():
 			filterResults["out"].getValue()
 
+	@unittest.skipIf( GafferTest.inCI(), "Performance not relevant on CI platform" )
+	@GafferTest.TestRunner.PerformanceTestMethod()
+	def testIncrementalComputePerformance( self ):
+
+		script = Gaffer.ScriptNode()
+		script["sphere"] = GafferScene.Sphere()
+		script["outerGroup"] = GafferScene.Group()
+
+		for i in range( 0, 100 ) :
+
+			script["duplicate%d" % i] = GafferScene.Duplicate()
+			script["duplicate%d" % i]["in"].setInput( script["sphere"]["out"] )
+			script["duplicate%d" % i]["target"].setValue( "/sphere" )
+			script["duplicate%d" % i]["copies"].setValue( 999 )
+
+			script["group%d" % i] = GafferScene.Group()
+			script["group%d" % i]["name"].setValue( "group%d" % i )
+			script["group%d" % i]["in"][0].setInput( script["duplicate%d" % i]["out"] )
+
+			script["outerGroup"]["in"][i].setInput( script["group%d" % i]["out"] )
+
+		script["pathFilter"] = GafferScene.PathFilter()
+		script["pathFilter"]["paths"].setValue( IECore.StringVectorData( [ '...' ] ) )
+
+		script["filterResults"] = GafferScene.FilterResults()
+		script["filterResults"]["scene"].setInput( script["outerGroup"]["out"] )
+		script["filterResults"]["filter"].setInput( script["pathFilter"]["out"] )
+
+		script["filterResults"]["out"].getValue()
+
+		# Edit a single branch, so that only that branch needs filtering again.
+		script["duplicate0"]["copies"].setValue( 998 )
+		script["outerGroup"]["out"].childNames( "/group/group0" )
+
+		with GafferTest.TestRunner.PerformanceScope():
+			script["filterResults"]["out"].getValue()
+
 if __name__ == "__main__":
 	unittest.main()
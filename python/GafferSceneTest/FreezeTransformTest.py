@@ -38,8 +38,10 @@ import unittest
 import imath
 
 import IECore
+import IECoreScene
 
 import Gaffer
+import GafferTest
 import GafferScene
 import GafferSceneTest
 
@@ -123,5 +125,65 @@ class FreezeTransformTest( GafferSceneTest.SceneTestCase ) :
 		self.assertSceneValid( freezeTransform["out"] )
 		self.assertEqual( freezeTransform["out"].transform( "/plane" ), imath.M44f() )
 
+	def testPrimitiveVariableTransformation( self ) :
+
+		numPoints = 50000
+		p = IECore.V3fVectorData( [ imath.V3f( i, i * 0.5, -i ) for i in range( numPoints ) ], IECore.GeometricData.Interpretation.Point )
+		n = IECore.V3fVectorData( [ imath.V3f( 0, 1, i ) for i in range( numPoints ) ], IECore.GeometricData.Interpretation.Normal )
+		v = IECore.V3fVectorData( [ imath.V3f( 1, i, 0 ) for i in range( numPoints ) ], IECore.GeometricData.Interpretation.Vector )
+		c = IECore.V3fVectorData( [ imath.V3f( i ) for i in range( numPoints ) ] )
+
+		points = IECoreScene.PointsPrimitive( p )
+		points["N"] = IECoreScene.PrimitiveVariable( IECoreScene.PrimitiveVariable.Interpolation.Vertex, n )
+		points["v"] = IECoreScene.PrimitiveVariable( IECoreScene.PrimitiveVariable.Interpolation.Vertex, v )
+		points["c"] = IECoreScene.PrimitiveVariable( IECoreScene.PrimitiveVariable.Interpolation.Vertex, c )
+		points["Pref"] = IECoreScene.PrimitiveVariable( IECoreScene.PrimitiveVariable.Interpolation.Vertex, p )
+
+		objectToScene = GafferScene.ObjectToScene()
+		objectToScene["object"].setValue( points )
+		objectToScene["transform"]["translate"].setValue( imath.V3f( 1, 2, 3 ) )
+		objectToScene["transform"]["rotate"].setValue( imath.V3f( 10, 20, 30 ) )
+		objectToScene["transform"]["scale"].setValue( imath.V3f( 1, 2, 3 ) )
+
+		freezeTransform = GafferScene.FreezeTransform()
+		freezeTransform["in"].setInput( objectToScene["out"] )
+
+		m = objectToScene["out"].fullTransform( "/object" )
+		normalMatrix = m.inverse().transposed()
+
+		frozen = freezeTransform["out"].object( "/object" )
+		self.assertEqual( frozen["P"].data, IECore.V3fVectorData( [ m.multVecMatrix( x ) for x in p ], IECore.GeometricData.Interpretation.Point ) )
+		self.assertEqual( frozen["Pref"].data, frozen["P"].data )
+		self.assertEqual( frozen["N"].data, IECore.V3fVectorData( [ normalMatrix.multDirMatrix( x ) for x in n ], IECore.GeometricData.Interpretation.Normal ) )
+		self.assertEqual( frozen["v"].data, IECore.V3fVectorData( [ m.multDirMatrix( x ) for x in v ], IECore.GeometricData.Interpretation.Vector ) )
+		self.assertEqual( frozen["c"].data, c )
+
+		# Check against the TransformOp that was previously used
+		# for all primitive variables.
+
+		expected = IECoreScene.TransformOp()(
+			input = points,
+			matrix = IECore.M44fData( m ),
+			primVarNames = IECore.StringVectorData( [ "P", "N", "v", "Pref" ] )
+		)
+		for name in [ "P", "N", "v", "Pref" ] :
+			self.assertEqual( frozen[name], expected[name] )
+
+	@GafferTest.TestRunner.PerformanceTestMethod()
+	def testPerformance( self ) :
+
+		plane = GafferScene.Plane()
+		plane["divisions"].setValue( imath.V2i( 2000 ) )
+		plane["transform"]["translate"].setValue( imath.V3f( 1, 2, 3 ) )
+		plane["transform"]["rotate"].setValue( imath.V3f( 10, 20, 30 ) )
+
+		freezeTransform = GafferScene.FreezeTransform()
+		freezeTransform["in"].setInput( plane["out"] )
+
+		freezeTransform["in"]["object"].getValue()
+
+		with GafferTest.TestRunner.PerformanceScope() :
+			freezeTransform["out"]["object"].getValue()
+
 if __name__ == "__main__":
 	unittest.main()
@@ -2307,6 +2307,260 @@ class InstancerTest( GafferSceneTest.SceneTestCase ) :
 
 		self.assertEqual( instancer["variations"].getValue(), IECore.CompoundData( { "" : IECore.IntData( 0 ) } ) )
 
+	def testCompactInstanceGroups( self ) :
+
+		points = IECoreScene.PointsPrimitive( IECore.V3fVectorData( [ imath.V3f( x, 0, 0 ) for x in range( 0, 4 ) ] ) )
+		points["index"] = IECoreScene.PrimitiveVariable( IECoreScene.PrimitiveVariable.Interpolation.Vertex, IECore.IntVectorData( [ 0, 1, 0, 1 ] ) )
+		points["testFloat"] = IECoreScene.PrimitiveVariable( IECoreScene.PrimitiveVariable.Interpolation.Vertex, IECore.FloatVectorData( [ 0, 1, 2, 3 ] ) )
+
+		objectToScene = GafferScene.ObjectToScene()
+		objectToScene["object"].setValue( points )
+
+		sphere = GafferScene.Sphere()
+		cube = GafferScene.Cube()
+		cube["transform"]["translate"].setValue( imath.V3f( 0, 1, 0 ) )
+
+		prototypes = GafferScene.Group()
+		prototypes["in"][0].setInput( sphere["out"] )
+		prototypes["in"][1].setInput( cube["out"] )
+
+		filter = GafferScene.PathFilter()
+		filter["paths"].setValue( IECore.StringVectorData( [ "/object" ] ) )
+
+		instancer = GafferScene.Instancer()
+		instancer["in"].setInput( objectToScene["out"] )
+		instancer["prototypes"].setInput( prototypes["out"] )
+		instancer["filter"].setInput( filter["out"] )
+		instancer["prototypeIndex"].setValue( "index" )
+		instancer["prototypeRootsList"].setValue( IECore.StringVectorData( [ "/group/sphere", "/group/cube" ] ) )
+		instancer["attributes"].setValue( "testFloat" )
+		instancer["encapsulateInstanceGroups"].setValue( True )
+
+		capsules = {}
+		for prototype in [ "sphere", "cube" ] :
+			capsules[prototype] = instancer["out"].object( "/object/instances/" + prototype )
+			self.assertIsInstance( capsules[prototype], GafferScene.Capsule )
+			self.assertNotIsInstance( capsules[prototype], GafferScene.InstanceArray )
+
+		capsuleHash = instancer["out"].objectHash( "/object/instances/sphere" )
+		instancer["compactInstanceGroups"].setValue( True )
+		self.assertNotEqual( instancer["out"].objectHash( "/object/instances/sphere" ), capsuleHash )
+
+		for prototype, ids in [ ( "sphere", [ 0, 2 ] ), ( "cube", [ 1, 3 ] ) ] :
+
+			path = "/object/instances/" + prototype
+			instanceArray = instancer["out"].object( path )
+			self.assertIsInstance( instanceArray, GafferScene.InstanceArray )
+			self.assertEqual( instancer["out"].childNames( path ), IECore.InternedStringVectorData() )
+
+			self.assertEqual( instanceArray.numInstances(), 2 )
+			self.assertEqual( instanceArray.prototypeRoot(), "/group/" + prototype )
+			self.assertTrue( instanceArray.prototypes().isSame( instancer["prototypes"] ) )
+			self.assertEqual( instanceArray.names(), IECore.InternedStringVectorData( [ str( i ) for i in ids ] ) )
+			self.assertEqual(
+				instanceArray.transforms(),
+				IECore.M44fVectorData( [ imath.M44f().translate( imath.V3f( i, 0, 0 ) ) for i in ids ] )
+			)
+			self.assertEqual( instanceArray.attributeIndices(), IECore.UInt64VectorData( ids ) )
+			self.assertEqual( instanceArray.attributes().keys(), [ "testFloat" ] )
+
+			# Rendering the array should be equivalent to rendering the
+			# per-location capsule.
+
+			capsuleRenderer = GafferScene.Private.IECoreScenePreview.CapturingRenderer(
+				GafferScene.Private.IECoreScenePreview.Renderer.RenderType.Batch
+			)
+			capsules[prototype].render( capsuleRenderer )
+
+			arrayRenderer = GafferScene.Private.IECoreScenePreview.CapturingRenderer(
+				GafferScene.Private.IECoreScenePreview.Renderer.RenderType.Batch
+			)
+			instanceArray.render( arrayRenderer )
+
+			for i in ids :
+				capsuleObject = capsuleRenderer.capturedObject( "/{}".format( i ) )
+				arrayObject = arrayRenderer.capturedObject( "/{}".format( i ) )
+				self.assertIsNotNone( arrayObject )
+				self.assertEqual( arrayObject.capturedSamples(), capsuleObject.capturedSamples() )
+				self.assertEqual( arrayObject.capturedTransforms(), capsuleObject.capturedTransforms() )
+				self.assertEqual( arrayObject.capturedAttributes().attributes(), capsuleObject.capturedAttributes().attributes() )
+
+		# The arrays should still be expandable by Unencapsulate.
+
+		unencapsulateFilter = GafferScene.PathFilter()
+		unencapsulateFilter["paths"].setValue( IECore.StringVectorData( [ "/..." ] ) )
+
+		unencapsulate = GafferScene.Unencapsulate()
+		unencapsulate["in"].setInput( instancer["out"] )
+		unencapsulate["filter"].setInput( unencapsulateFilter["out"] )
+
+		perLocationInstancer = GafferScene.Instancer()
+		perLocationInstancer["in"].setInput( objectToScene["out"] )
+		perLocationInstancer["prototypes"].setInput( prototypes["out"] )
+		perLocationInstancer["filter"].setInput( filter["out"] )
+		perLocationInstancer["prototypeIndex"].setValue( "index" )
+		perLocationInstancer["prototypeRootsList"].setValue( IECore.StringVectorData( [ "/group/sphere", "/group/cube" ] ) )
+		perLocationInstancer["attributes"].setValue( "testFloat" )
+
+		self.assertScenesEqual( unencapsulate["out"], perLocationInstancer["out"] )
+
+	def testCompactInstanceGroupsWithContextVariations( self ) :
+
+		plane = GafferScene.Plane()
+
+		filter = GafferScene.PathFilter()
+		filter["paths"].setValue( IECore.StringVectorData( [ "/plane" ] ) )
+
+		sphere = GafferScene.Sphere()
+
+		instancer = GafferScene.Instancer()
+		instancer["in"].setInput( plane["out"] )
+		instancer["prototypes"].setInput( sphere["out"] )
+		instancer["filter"].setInput( filter["out"] )
+		instancer["encapsulateInstanceGroups"].setValue( True )
+		instancer["compactInstanceGroups"].setValue( True )
+
+		self.assertIsInstance( instancer["out"].object( "/plane/instances/sphere" ), GafferScene.InstanceArray )
+
+		# Instances may differ from each other, so we can't share a single
+		# prototype evaluation and must fall back to a regular capsule.
+		instancer["seedEnabled"].setValue( True )
+		capsule = instancer["out"].object( "/plane/instances/sphere" )
+		self.assertIsInstance( capsule, GafferScene.Capsule )
+		self.assertNotIsInstance( capsule, GafferScene.InstanceArray )
+
+	def testTopologyReusedWhenPositionsChange( self ) :
+
+		points = IECoreScene.PointsPrimitive( IECore.V3fVectorData( [ imath.V3f( x, 0, 0 ) for x in range( 0, 4 ) ] ) )
+		points["instanceId"] = IECoreScene.PrimitiveVariable( IECoreScene.PrimitiveVariable.Interpolation.Vertex, IECore.IntVectorData( [ 10, 11, 12, 13 ] ) )
+
+		objectToScene = GafferScene.ObjectToScene()
+		objectToScene["object"].setValue( points )
+
+		sphere = GafferScene.Sphere()
+		sphere["sets"].setValue( "A" )
+
+		filter = GafferScene.PathFilter()
+		filter["paths"].setValue( IECore.StringVectorData( [ "/object" ] ) )
+
+		instancer = GafferScene.Instancer()
+		instancer["in"].setInput( objectToScene["out"] )
+		instancer["prototypes"].setInput( sphere["out"] )
+		instancer["filter"].setInput( filter["out"] )
+
+		def hashes() :
+			return (
+				instancer["out"].childNamesHash( "/object/instances" ),
+				instancer["out"].childNamesHash( "/object/instances/sphere" ),
+				instancer["out"].setHash( "A" ),
+			)
+
+		topologyHashes = hashes()
+		transformHash = instancer["out"].transformHash( "/object/instances/sphere/10" )
+
+		# Changing positions should change the transforms but nothing that
+		# depends only on the topology.
+
+		points["P"] = IECoreScene.PrimitiveVariable( IECoreScene.PrimitiveVariable.Interpolation.Vertex, IECore.V3fVectorData( [ imath.V3f( x, 1, 0 ) for x in range( 0, 4 ) ] ) )
+		objectToScene["object"].setValue( points )
+
+		self.assertEqual( hashes(), topologyHashes )
+		self.assertNotEqual( instancer["out"].transformHash( "/object/instances/sphere/10" ), transformHash )
+		self.assertEqual( instancer["out"].transform( "/object/instances/sphere/10" ), imath.M44f().translate( imath.V3f( 0, 1, 0 ) ) )
+
+		# Changing ids must update everything.
+
+		points["instanceId"] = IECoreScene.PrimitiveVariable( IECoreScene.PrimitiveVariable.Interpolation.Vertex, IECore.IntVectorData( [ 20, 21, 22, 23 ] ) )
+		objectToScene["object"].setValue( points )
+
+		self.assertNotEqual( hashes()[1], topologyHashes[1] )
+		self.assertEqual(
+			instancer["out"].childNames( "/object/instances/sphere" ),
+			IECore.InternedStringVectorData( [ "20", "21", "22", "23" ] )
+		)
+		self.assertEqual( instancer["out"].set( "A" ).value.paths(), [ "/object/instances/sphere/{}".format( i ) for i in range( 20, 24 ) ] )
+
+	@unittest.skipIf( GafferTest.inCI(), "Performance not relevant on CI platform" )
+	@GafferTest.TestRunner.PerformanceTestMethod()
+	def testPlaybackPerf( self ) :
+
+		# A million points, with positions animated over time and
+		# a static topology.
+
+		plane = GafferScene.Plane()
+		plane["divisions"].setValue( imath.V2i( 999 ) )
+
+		filter = GafferScene.PathFilter()
+		filter["paths"].setValue( IECore.StringVectorData( [ "/plane" ] ) )
+
+		transform = GafferScene.Transform()
+		transform["in"].setInput( plane["out"] )
+		transform["filter"].setInput( filter["out"] )
+		transform["expression"] = Gaffer.Expression()
+		transform["expression"].setExpression( 'parent["transform"]["translate"]["y"] = context.getFrame()' )
+
+		freezeTransform = GafferScene.FreezeTransform()
+		freezeTransform["in"].setInput( transform["out"] )
+		freezeTransform["filter"].setInput( filter["out"] )
+
+		sphere = GafferScene.Sphere()
+
+		instancer = GafferScene.Instancer()
+		instancer["in"].setInput( freezeTransform["out"] )
+		instancer["prototypes"].setInput( sphere["out"] )
+		instancer["filter"].setInput( filter["out"] )
+
+		frames = range( 1, 11 )
+
+		# Prime the input points for each frame, so we measure just the
+		# work done by the Instancer.
+		context = Gaffer.Context()
+		for frame in frames :
+			context.setFrame( frame )
+			with context :
+				freezeTransform["out"].object( "/plane" )
+
+		with GafferTest.TestRunner.PerformanceScope() :
+			for frame in frames :
+				context.setFrame( frame )
+				with context :
+					instancer["out"].childNames( "/plane/instances/sphere" )
+					instancer["out"].bound( "/plane/instances" )
+
+	def runTestInstanceGroupsPerf( self, compact ) :
+
+		plane = GafferScene.Plane()
+		plane["divisions"].setValue( imath.V2i( 1000 ) )
+
+		filter = GafferScene.PathFilter()
+		filter["paths"].setValue( IECore.StringVectorData( [ "/plane" ] ) )
+
+		sphere = GafferScene.Sphere()
+
+		instancer = GafferScene.Instancer()
+		instancer["in"].setInput( plane["out"] )
+		instancer["prototypes"].setInput( sphere["out"] )
+		instancer["filter"].setInput( filter["out"] )
+		instancer["encapsulateInstanceGroups"].setValue( compact )
+		instancer["compactInstanceGroups"].setValue( compact )
+
+		# Compute the engine outside the timed block, so we measure only
+		# the generation of the instances themselves.
+		instancer["out"].childNames( "/plane/instances" )
+
+		with GafferTest.TestRunner.PerformanceScope() :
+			GafferSceneTest.traverseScene( instancer["out"] )
+
+	@unittest.skipIf( GafferTest.inCI(), "Performance not relevant on CI platform" )
+	@GafferTest.TestRunner.PerformanceTestMethod()
+	def testPerLocationInstanceGroupsPerf( self ) :
+		self.runTestInstanceGroupsPerf( compact = False )
+
+	@unittest.skipIf( GafferTest.inCI(), "Performance not relevant on CI platform" )
+	@GafferTest.TestRunner.PerformanceTestMethod()
+	def testCompactInstanceGroupsPerf( self ) :
+		self.runTestInstanceGroupsPerf( compact = True )
+
 	@unittest.skipIf( GafferTest.inCI(), "Performance not relevant on CI platform" )
 	@GafferTest.TestRunner.PerformanceTestMethod()
 	def testContextSetPerfNoVariationsSingleEvaluate( self ):
@@ -41,6 +41,7 @@ import imath
 import IECore
 
 import Gaffer
+import GafferTest
 import GafferScene
 import GafferSceneTest
 
@@ -453,13 +454,14 @@ class MergeScenesTest( GafferSceneTest.SceneTestCase ) :
 		self.assertScenesEqual( sphere["out"], merge["out"] )
 		self.assertSceneHashesEqual( sphere["out"], merge["out"] )
 
-	def testMaxInputs( self ) :
+	def testManyInputs( self ) :
 
 		merge = GafferScene.MergeScenes()
 		spheres = []
 		groups = []
 
-		for i in range( 0, merge["in"].maxSize() ) :
+		numInputs = 100
+		for i in range( 0, numInputs ) :
 			sphere = GafferScene.Sphere()
 			sphere["name"].setValue( "sphere{}".format( i ) )
 			sphere["sets"].setValue( "set{}".format( i ) )
@@ -472,12 +474,72 @@ class MergeScenesTest( GafferSceneTest.SceneTestCase ) :
 		self.assertSceneValid( merge["out"] )
 		self.assertEqual(
 			list( merge["out"].childNames( "/group" ) ),
-			[ "sphere{}".format( i ) for i in range( 0, merge["in"].maxSize() ) ]
+			[ "sphere{}".format( i ) for i in range( 0, numInputs ) ]
 		)
 		self.assertEqual(
 			list( merge["out"].setNames() ),
-			[ "set{}".format( i ) for i in range( 0, merge["in"].maxSize() ) ]
+			[ "set{}".format( i ) for i in range( 0, numInputs ) ]
 		)
 
+		# Inputs beyond the first 32 must be tracked correctly
+		# when some inputs drop out partway down the hierarchy.
+
+		spheres[50]["sets"].setValue( "set0" )
+		groups[40]["name"].setValue( "otherGroup" )
+		self.assertSceneValid( merge["out"] )
+		self.assertEqual( merge["out"].childNames( "/" ), IECore.InternedStringVectorData( [ "group", "otherGroup" ] ) )
+		self.assertEqual( merge["out"].childNames( "/otherGroup" ), IECore.InternedStringVectorData( [ "sphere40" ] ) )
+		self.assertNotIn( "sphere40", merge["out"].childNames( "/group" ) )
+		self.assertEqual(
+			merge["out"].set( "set0" ).value,
+			IECore.PathMatcher( [ "/group/sphere0", "/group/sphere50" ] )
+		)
+
+	def __layeredMerge( self, numInputs ) :
+
+		# Simulates a typical layered asset, where each input
+		# contributes a few locations to a shared hierarchy.
+
+		merge = GafferScene.MergeScenes()
+		merge["attributesMode"].setValue( merge.Mode.Merge )
+
+		nodes = []
+		for i in range( 0, numInputs ) :
+			sphere = GafferScene.Sphere()
+			sphere["name"].setValue( "sphere{}".format( i ) )
+			sphere["sets"].setValue( "spheres layer{}".format( i ) )
+			group = GafferScene.Group()
+			group["in"][0].setInput( sphere["out"] )
+			group["name"].setValue( "asset" )
+			merge["in"][i].setInput( group["out"] )
+			nodes.extend( [ sphere, group ] )
+
+		return merge, nodes
+
+	def __testMergePerformance( self, numInputs ) :
+
+		merge, nodes = self.__layeredMerge( numInputs )
+
+		with GafferTest.TestRunner.PerformanceScope() :
+			GafferSceneTest.traverseScene( merge["out"] )
+			merge["out"].set( "spheres" )
+
+		self.assertEqual( len( merge["out"].childNames( "/asset" ) ), numInputs )
+
+	@GafferTest.TestRunner.PerformanceTestMethod()
+	def testMergePerformance10Inputs( self ) :
+
+		self.__testMergePerformance( 10 )
+
+	@GafferTest.TestRunner.PerformanceTestMethod()
+	def testMergePerformance100Inputs( self ) :
+
+		self.__testMergePerformance( 100 )
+
+	@GafferTest.TestRunner.PerformanceTestMethod()
+	def testMergePerformance1000Inputs( self ) :
+
+		self.__testMergePerformance( 1000 )
+
 if __name__ == "__main__":
 	unittest.main()
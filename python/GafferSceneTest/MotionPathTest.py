@@ -40,6 +40,7 @@ import IECore
 import IECoreScene
 
 import Gaffer
+import GafferTest
 import GafferScene
 
 import GafferSceneTest
@@ -517,3 +518,102 @@ class MotionPathTest( GafferSceneTest.SceneTestCase ) :
 		self.assertEqual( curve.verticesPerCurve(), IECore.IntVectorData( [ 6 ] ) )
 		for i in range( 0, len(curve["frame"].data) ) :
 			self.assertAlmostEqual( curve["frame"].data[i], onFrameSamples[i] + 0.25, 5 )
+
+	def testAbsoluteRangeReusedAcrossFrames( self ) :
+
+		script, expectedP = self.makeScene()
+		script["motion"]["start"]["mode"].setValue( GafferScene.MotionPath.FrameMode.Absolute )
+		script["motion"]["end"]["mode"].setValue( GafferScene.MotionPath.FrameMode.Absolute )
+
+		hashes = set()
+		for f in range( -5, 5 ) :
+			script.context().setFrame( f )
+			with script.context() :
+				hashes.add( script["motion"]["out"].objectHash( "/group/cube" ) )
+
+		self.assertEqual( len( hashes ), 1 )
+
+		script["motion"]["start"]["mode"].setValue( GafferScene.MotionPath.FrameMode.Relative )
+		script["motion"]["end"]["mode"].setValue( GafferScene.MotionPath.FrameMode.Relative )
+
+		hashes = set()
+		for f in range( -5, 5 ) :
+			script.context().setFrame( f )
+			with script.context() :
+				hashes.add( script["motion"]["out"].objectHash( "/group/cube" ) )
+
+		self.assertEqual( len( hashes ), 10 )
+
+	def testPartiallyStaticLocation( self ) :
+
+		script, expectedP = self.makeScene()
+		script["motion"]["start"]["mode"].setValue( GafferScene.MotionPath.FrameMode.Absolute )
+		script["motion"]["end"]["mode"].setValue( GafferScene.MotionPath.FrameMode.Absolute )
+		script["motion"]["start"]["frame"].setValue( -10 )
+		script["motion"]["end"]["frame"].setValue( 100 )
+		script["motionFilter"]["paths"].setValue( IECore.StringVectorData( [ "/group/cube", "/group/light" ] ) )
+
+		# The cube is static before frame 0 and after frame 4, and
+		# the light is static throughout. The samples at those frames
+		# share transforms, but must still be output individually.
+
+		with script.context() :
+			cubeCurve = script["motion"]["out"].object( "/group/cube" )
+			lightCurve = script["motion"]["out"].object( "/group/light" )
+
+		for curve in ( cubeCurve, lightCurve ) :
+			self.assertTrue( curve.arePrimitiveVariablesValid() )
+			self.assertEqual( curve.verticesPerCurve(), IECore.IntVectorData( [ 111 ] ) )
+			self.assertEqual( curve["frame"].data, IECore.FloatVectorData( [ float( f ) for f in range( -10, 101 ) ] ) )
+
+		self.assertEqual(
+			cubeCurve["P"].data,
+			IECore.V3fVectorData(
+				[ expectedP[0] ] * 10 + list( expectedP ) + [ expectedP[-1] ] * 96,
+				IECore.GeometricData.Interpretation.Point
+			)
+		)
+
+		self.assertEqual(
+			lightCurve["P"].data,
+			IECore.V3fVectorData( [ imath.V3f( 0 ) ] * 111, IECore.GeometricData.Interpretation.Point )
+		)
+		self.assertEqual( lightCurve["scale"].data, IECore.V3fVectorData( [ imath.V3f( 1 ) ] * 111 ) )
+
+	@GafferTest.TestRunner.PerformanceTestMethod()
+	def testCrowdPerformance( self ) :
+
+		script = Gaffer.ScriptNode()
+
+		script["sphere"] = GafferScene.Sphere()
+
+		script["plane"] = GafferScene.Plane()
+		script["plane"]["divisions"].setValue( imath.V2i( 31 ) )
+
+		script["instancer"] = GafferScene.Instancer()
+		script["instancer"]["in"].setInput( script["plane"]["out"] )
+		script["instancer"]["prototypes"].setInput( script["sphere"]["out"] )
+		script["instancer"]["parent"].setValue( "/plane" )
+
+		script["group"] = GafferScene.Group()
+		script["group"]["in"][0].setInput( script["instancer"]["out"] )
+
+		animation = Gaffer.Animation.acquire( script["group"]["transform"]["translate"]["x"] )
+		animation.addKey( Gaffer.Animation.Key( 0, 0, Gaffer.Animation.Interpolation.Linear ) )
+		animation.addKey( Gaffer.Animation.Key( 10, 10, Gaffer.Animation.Interpolation.Linear ) )
+
+		script["filter"] = GafferScene.PathFilter()
+		script["filter"]["paths"].setValue( IECore.StringVectorData( [ "/group/plane/instances/sphere/*" ] ) )
+
+		script["motion"] = GafferScene.MotionPath()
+		script["motion"]["in"].setInput( script["group"]["out"] )
+		script["motion"]["filter"].setInput( script["filter"]["out"] )
+		script["motion"]["start"]["mode"].setValue( GafferScene.MotionPath.FrameMode.Absolute )
+		script["motion"]["end"]["mode"].setValue( GafferScene.MotionPath.FrameMode.Absolute )
+		script["motion"]["start"]["frame"].setValue( 1 )
+		script["motion"]["end"]["frame"].setValue( 240 )
+
+		with script.context() :
+			GafferSceneTest.traverseScene( script["motion"]["in"] )
+			with GafferTest.TestRunner.PerformanceScope() :
+				GafferSceneTest.traverseScene( script["motion"]["out"] )
@@ -44,6 +44,7 @@ import IECore
 import IECoreScene
 
 import Gaffer
+import GafferTest
 import GafferScene
 import GafferSceneTest
 
@@ -219,6 +220,147 @@ class OrientationTest( GafferSceneTest.SceneTestCase ) :
 			str( cm.exception )
 		)
 
+	def __randomQuaternionPoints( self, numPoints ) :
+
+		random.seed( 0 )
+		quaternions = IECore.QuatfVectorData()
+		for i in range( 0, numPoints ) :
+			quaternions.append(
+				imath.Eulerf(
+					random.uniform( -math.pi, math.pi ),
+					random.uniform( -math.pi, math.pi ),
+					random.uniform( -math.pi, math.pi )
+				).toQuat()
+			)
+
+		points = IECoreScene.PointsPrimitive( IECore.V3fVectorData( [ imath.V3f( 0 ) ] * numPoints ) )
+		points["quaternion"] = IECoreScene.PrimitiveVariable( IECoreScene.PrimitiveVariable.Interpolation.Vertex, quaternions )
+
+		pointsNode = GafferScene.ObjectToScene()
+		pointsNode["object"].setValue( points )
+
+		pointsFilter = GafferScene.PathFilter()
+		pointsFilter["paths"].setValue( IECore.StringVectorData( [ "/object" ] ) )
+
+		orientation = GafferScene.Orientation()
+		orientation["in"].setInput( pointsNode["out"] )
+		orientation["filter"].setInput( pointsFilter["out"] )
+		orientation["inMode"].setValue( orientation.Mode.Quaternion )
+		orientation["inQuaternion"].setValue( "quaternion" )
+
+		return orientation, quaternions, [ pointsNode, pointsFilter ]
+
+	def testConversionsMatchPerPointConversion( self ) :
+
+		# Enough points to be split across multiple threads,
+		# each of which should match a scalar Imath conversion
+		# exactly.
+
+		orientation, quaternions, nodes = self.__randomQuaternionPoints( 20000 )
+		orientation["deleteInputs"].setValue( True )
+
+		orientation["outMode"].setValue( orientation.Mode.Matrix )
+		orientation["outMatrix"].setValue( "matrix" )
+		self.assertEqual(
+			orientation["out"].object( "/object" )["matrix"].data,
+			IECore.M33fVectorData( [ q.toMatrix33() for q in quaternions ] )
+		)
+
+		orientation["outMode"].setValue( orientation.Mode.AxisAngle )
+		orientation["outAxis"].setValue( "axis" )
+		orientation["outAngle"].setValue( "angle" )
+		result = orientation["out"].object( "/object" )
+		self.assertEqual( result["axis"].data, IECore.V3fVectorData( [ q.axis() for q in quaternions ] ) )
+		self.assertEqual( result["angle"].data, IECore.FloatVectorData( [ q.angle() for q in quaternions ] ) )
+
+		orientation["outMode"].setValue( orientation.Mode.Aim )
+		orientation["outXAxis"].setValue( "xAxis" )
+		orientation["outYAxis"].setValue( "yAxis" )
+		orientation["outZAxis"].setValue( "zAxis" )
+		result = orientation["out"].object( "/object" )
+		for i, name in enumerate( [ "xAxis", "yAxis", "zAxis" ] ) :
+			self.assertEqual(
+				result[name].data,
+				IECore.V3fVectorData( [ imath.V3f( *[ q.toMatrix44()[i][j] for j in range( 3 ) ] ) for q in quaternions ] )
+			)
+
+		# Round trip through axis/angle, comparing against the
+		# equivalent Imath conversion.
+
+		axisAngle = GafferScene.Orientation()
+		axisAngle["in"].setInput( orientation["out"] )
+		axisAngle["filter"].setInput( orientation["filter"].getInput() )
+		axisAngle["inMode"].setValue( axisAngle.Mode.AxisAngle )
+		axisAngle["inAxis"].setValue( "axis" )
+		axisAngle["inAngle"].setValue( "angle" )
+		axisAngle["outMode"].setValue( axisAngle.Mode.Quaternion )
+		axisAngle["outQuaternion"].setValue( "quaternion" )
+
+		orientation["outMode"].setValue( orientation.Mode.AxisAngle )
+		result = orientation["out"].object( "/object" )
+
+		expected = IECore.QuatfVectorData()
+		for axis, angle in zip( result["axis"].data, result["angle"].data ) :
+			q = imath.Quatf()
+			q.setAxisAngle( axis, angle )
+			expected.append( q )
+
+		self.assertEqual( axisAngle["out"].object( "/object" )["quaternion"].data, expected )
+
+		# Euler output, and round trip back through Euler input.
+
+		orientation["outMode"].setValue( orientation.Mode.Euler )
+		orientation["outEuler"].setValue( "euler" )
+
+		for order in [ imath.Eulerf.XYZ, imath.Eulerf.ZXY ] :
+			orientation["outOrder"].setValue( order )
+			self.assertEqual(
+				orientation["out"].object( "/object" )["euler"].data,
+				IECore.V3fVectorData( [ IECore.radiansToDegrees( imath.Eulerf( q.toMatrix33(), order ).toXYZVector() ) for q in quaternions ] )
+			)
+
+		orientation["outOrder"].setValue( imath.Eulerf.XYZ )
+
+		euler = GafferScene.Orientation()
+		euler["in"].setInput( orientation["out"] )
+		euler["filter"].setInput( orientation["filter"].getInput() )
+		euler["inMode"].setValue( euler.Mode.Euler )
+		euler["inEuler"].setValue( "euler" )
+		euler["inOrder"].setValue( imath.Eulerf.XYZ )
+		euler["outMode"].setValue( euler.Mode.Quaternion )
+		euler["outQuaternion"].setValue( "quaternion" )
+
+		self.assertEqual(
+			euler["out"].object( "/object" )["quaternion"].data,
+			IECore.QuatfVectorData( [
+				imath.Eulerf( IECore.degreesToRadians( e ), imath.Eulerf.XYZ ).toQuat()
+				for e in orientation["out"].object( "/object" )["euler"].data
+			] )
+		)
+
+	@GafferTest.TestRunner.PerformanceTestMethod()
+	def testConversionPerformance( self ) :
+
+		orientation, quaternions, nodes = self.__randomQuaternionPoints( 1000000 )
+		orientation["inMode"].setValue( orientation.Mode.Quaternion )
+		orientation["outMode"].setValue( orientation.Mode.Euler )
+		orientation["outEuler"].setValue( "euler" )
+
+		euler = GafferScene.Orientation()
+		euler["in"].setInput( orientation["out"] )
+		euler["filter"].setInput( orientation["filter"].getInput() )
+		euler["inMode"].setValue( euler.Mode.Euler )
+		euler["inEuler"].setValue( "euler" )
+		euler["outMode"].setValue( euler.Mode.Aim )
+		euler["outXAxis"].setValue( "xAxis" )
+		euler["outYAxis"].setValue( "yAxis" )
+		euler["outZAxis"].setValue( "zAxis" )
+
+		orientation["in"]["object"].getValue()
+
+		with GafferTest.TestRunner.PerformanceScope() :
+			euler["out"]["object"].getValue()
+
 	def __assertVectorDataAlmostEqual( self, a, b, delta = 0.00001 ) :
 
 		if isinstance( a, IECore.QuatfVectorData ) :
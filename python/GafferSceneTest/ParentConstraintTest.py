@@ -2075,5 +2075,86 @@ class ParentConstraintTest( GafferSceneTest.SceneTestCase ) :
 		constraint[ "targetUV" ].setValue( imath.V2f( 0.5, 0.5 ) )
 		self.assertEqual( constraint[ "out" ].fullTransform( "/" + cube[ "name" ].getValue() ), imath.M44f() )
 
+	def __crowdScene( self, numAgents ) :
+
+		plane = GafferScene.Plane()
+		plane["name"].setValue( "target" )
+		plane["divisions"].setValue( imath.V2i( 100 ) )
+
+		cube = GafferScene.Cube()
+
+		duplicate = GafferScene.Duplicate()
+		duplicate["in"].setInput( cube["out"] )
+		duplicate["target"].setValue( "/cube" )
+		duplicate["copies"].setValue( numAgents - 1 )
+
+		group = GafferScene.Group()
+		group["in"][0].setInput( plane["out"] )
+		group["in"][1].setInput( duplicate["out"] )
+
+		agentsFilter = GafferScene.PathFilter()
+		agentsFilter["paths"].setValue( IECore.StringVectorData( [ "/group/cube*" ] ) )
+
+		constraint = GafferScene.ParentConstraint()
+		constraint["in"].setInput( group["out"] )
+		constraint["filter"].setInput( agentsFilter["out"] )
+		constraint["target"].setValue( "/group/target" )
+		constraint["targetMode"].setValue( GafferScene.Constraint.TargetMode.UV )
+		constraint["targetUV"].setValue( imath.V2f( 0.25, 0.75 ) )
+
+		return constraint, [ plane, cube, duplicate, group, agentsFilter ]
+
+	def testTargetTransformSharedBetweenLocations( self ) :
+
+		constraint, nodes = self.__crowdScene( 100 )
+
+		agents = constraint["out"].childNames( "/group" )[1:]
+		self.assertEqual( len( agents ), 100 )
+
+		with Gaffer.PerformanceMonitor() as monitor :
+			transforms = [ constraint["out"].fullTransform( "/group/" + str( a ) ) for a in agents ]
+
+		self.assertEqual( monitor.plugStatistics( constraint["__targetTransform"] ).computeCount, 1 )
+		for t in transforms :
+			self.assertEqual( t, transforms[0] )
+			self.assertAlmostEqual( t.translation().x, -0.25, places = 5 )
+			self.assertAlmostEqual( t.translation().y, 0.25, places = 5 )
+
+		# Changing a setting which doesn't affect the target
+		# shouldn't require the target to be recomputed.
+
+		constraint["targetOffset"]["z"].setValue( 1 )
+		with Gaffer.PerformanceMonitor() as monitor :
+			transforms = [ constraint["out"].fullTransform( "/group/" + str( a ) ) for a in agents ]
+
+		self.assertEqual( monitor.plugStatistics( constraint["__targetTransform"] ).computeCount, 0 )
+		for t in transforms :
+			self.assertAlmostEqual( t.translation().z, 1, places = 5 )
+
+	def testPerLocationTargetSettings( self ) :
+
+		constraint, nodes = self.__crowdScene( 2 )
+		self.assertEqual( constraint["out"].childNames( "/group" ), IECore.InternedStringVectorData( [ "target", "cube", "cube1" ] ) )
+
+		constraint["expression"] = Gaffer.Expression()
+		constraint["expression"].setExpression(
+			'parent["targetUV"]["x"] = 0.25 if str( context["scene:path"][-1] ) == "cube" else 0.75'
+		)
+
+		with Gaffer.PerformanceMonitor() as monitor :
+			self.assertAlmostEqual( constraint["out"].fullTransform( "/group/cube" ).translation().x, -0.25, places = 5 )
+			self.assertAlmostEqual( constraint["out"].fullTransform( "/group/cube1" ).translation().x, 0.25, places = 5 )
+
+		self.assertEqual( monitor.plugStatistics( constraint["__targetTransform"] ).computeCount, 2 )
+
+	@GafferTest.TestRunner.PerformanceTestMethod()
+	def testSharedTargetPerformance( self ) :
+
+		constraint, nodes = self.__crowdScene( 50000 )
+		GafferSceneTest.traverseScene( constraint["in"] )
+
+		with GafferTest.TestRunner.PerformanceScope() :
+			GafferSceneTest.traverseScene( constraint["out"] )
+
 if __name__ == "__main__":
 	unittest.main()
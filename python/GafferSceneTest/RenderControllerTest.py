@@ -271,6 +271,57 @@ class RenderControllerTest( GafferSceneTest.SceneTestCase ) :
 
 		del capturedSphere, capturedLightA, capturedLightB
 
+	def testLightLinksUnaffectedByUnrelatedSetEdits( self ) :
+
+		sphere = GafferScene.Sphere()
+
+		attributes = GafferScene.StandardAttributes()
+		attributes["in"].setInput( sphere["out"] )
+		attributes["attributes"]["linkedLights"]["enabled"].setValue( True )
+		attributes["attributes"]["linkedLights"]["value"].setValue( "A" )
+
+		lightA = GafferSceneTest.TestLight()
+		lightA["name"].setValue( "lightA" )
+		lightA["sets"].setValue( "A" )
+
+		lightB = GafferSceneTest.TestLight()
+		lightB["name"].setValue( "lightB" )
+		lightB["sets"].setValue( "B" )
+
+		group = GafferScene.Group()
+		group["in"][0].setInput( attributes["out"] )
+		group["in"][1].setInput( lightA["out"] )
+		group["in"][2].setInput( lightB["out"] )
+
+		renderer = GafferScene.Private.IECoreScenePreview.CapturingRenderer()
+		controller = GafferScene.RenderController( group["out"], Gaffer.Context(), renderer )
+		controller.setMinimumExpansionDepth( 10 )
+		controller.update()
+
+		capturedSphere = renderer.capturedObject( "/group/sphere" )
+		capturedLightA = renderer.capturedObject( "/group/lightA" )
+		capturedLightB = renderer.capturedObject( "/group/lightB" )
+
+		self.assertEqual( capturedSphere.capturedLinks( "lights" ), { capturedLightA } )
+		self.assertEqual( capturedSphere.numLinkEdits( "lights" ), 1 )
+
+		# Editing a set which isn't used by the linking expression
+		# shouldn't cause the links to be emitted again.
+
+		lightB["sets"].setValue( "C" )
+		controller.update()
+		self.assertEqual( capturedSphere.capturedLinks( "lights" ), { capturedLightA } )
+		self.assertEqual( capturedSphere.numLinkEdits( "lights" ), 1 )
+
+		# But editing the set that is used should.
+
+		lightB["sets"].setValue( "A" )
+		controller.update()
+		self.assertEqual( capturedSphere.capturedLinks( "lights" ), { capturedLightA, capturedLightB } )
+		self.assertEqual( capturedSphere.numLinkEdits( "lights" ), 2 )
+
+		del capturedSphere, capturedLightA, capturedLightB
+
 	@GafferTest.TestRunner.PerformanceTestMethod()
 	def testLightLinkPerformance( self ) :
 
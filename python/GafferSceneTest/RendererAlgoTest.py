@@ -147,5 +147,34 @@ class RendererAlgoTest( GafferSceneTest.SceneTestCase ) :
 			self.assertEqual( len( samples ), 1 )
 			self.assertEqual( samples[0], coordinateSystem["out"].object( "/coordinateSystem" ) )
 
+	def testCollapsedMotionSamples( self ) :
+
+		frame = GafferTest.FrameNode()
+
+		staticSphere = GafferScene.Sphere()
+		staticSphere["type"].setValue( staticSphere.Type.Primitive )
+
+		movingSphere = GafferScene.Sphere()
+		movingSphere["type"].setValue( movingSphere.Type.Primitive )
+		movingSphere["radius"].setInput( frame["output"] )
+
+		GafferScene.Private.RendererAlgo.resetCollapsedMotionSamples()
+
+		with Gaffer.Context() as c :
+
+			c["scene:path"] = IECore.InternedStringVectorData( [ "sphere" ] )
+
+			samples = GafferScene.Private.RendererAlgo.objectSamples( movingSphere["out"]["object"], [ 0.75, 1.0, 1.25 ] )
+			self.assertEqual( [ s.radius() for s in samples ], [ 0.75, 1.0, 1.25 ] )
+			self.assertEqual( GafferScene.Private.RendererAlgo.collapsedMotionSamples(), 0 )
+
+			samples = GafferScene.Private.RendererAlgo.objectSamples( staticSphere["out"]["object"], [ 0.75, 1.0, 1.25 ] )
+			self.assertEqual( len( samples ), 1 )
+			self.assertEqual( samples[0], staticSphere["out"].object( "/sphere" ) )
+			self.assertEqual( GafferScene.Private.RendererAlgo.collapsedMotionSamples(), 2 )
+
+		GafferScene.Private.RendererAlgo.resetCollapsedMotionSamples()
+		self.assertEqual( GafferScene.Private.RendererAlgo.collapsedMotionSamples(), 0 )
+
 if __name__ == "__main__":
 	unittest.main()
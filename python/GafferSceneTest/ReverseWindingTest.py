@@ -36,9 +36,12 @@
 
 import unittest
 
+import imath
+
 import IECore
 import IECoreScene
 
+import GafferTest
 import GafferScene
 import GafferSceneTest
 
@@ -68,5 +71,71 @@ class ReverseWindingTest( GafferSceneTest.SceneTestCase ) :
 		m1 = reverseWinding["out"].object( "/plane" )
 		self.assertEqual( m0, m1 )
 
+	def testMixedFaceSizes( self ) :
+
+		mesh = IECoreScene.MeshPrimitive(
+			IECore.IntVectorData( [ 3, 4, 5 ] ),
+			IECore.IntVectorData( [ 0, 1, 2, 1, 3, 4, 2, 2, 4, 5, 6, 7 ] ),
+			"linear",
+			IECore.V3fVectorData( [ imath.V3f( i ) for i in range( 0, 8 ) ], IECore.GeometricData.Interpretation.Point )
+		)
+		mesh["faceVarying"] = IECoreScene.PrimitiveVariable(
+			IECoreScene.PrimitiveVariable.Interpolation.FaceVarying,
+			IECore.IntVectorData( range( 0, 12 ) )
+		)
+		mesh["indexedFaceVarying"] = IECoreScene.PrimitiveVariable(
+			IECoreScene.PrimitiveVariable.Interpolation.FaceVarying,
+			IECore.StringVectorData( [ "a", "b", "c" ] ),
+			IECore.IntVectorData( [ i % 3 for i in range( 0, 12 ) ] )
+		)
+		mesh["boolFaceVarying"] = IECoreScene.PrimitiveVariable(
+			IECoreScene.PrimitiveVariable.Interpolation.FaceVarying,
+			IECore.BoolVectorData( [ i % 2 == 0 for i in range( 0, 12 ) ] )
+		)
+		mesh["uniform"] = IECoreScene.PrimitiveVariable(
+			IECoreScene.PrimitiveVariable.Interpolation.Uniform,
+			IECore.IntVectorData( [ 0, 1, 2 ] )
+		)
+		self.assertTrue( mesh.arePrimitiveVariablesValid() )
+
+		objectToScene = GafferScene.ObjectToScene()
+		objectToScene["object"].setValue( mesh )
+
+		f = GafferScene.PathFilter()
+		f["paths"].setValue( IECore.StringVectorData( [ "/object" ] ) )
+
+		reverseWinding = GafferScene.ReverseWinding()
+		reverseWinding["in"].setInput( objectToScene["out"] )
+		reverseWinding["filter"].setInput( f["out"] )
+
+		expected = mesh.copy()
+		IECoreScene.MeshAlgo.reverseWinding( expected )
+		self.assertEqual( reverseWinding["out"].object( "/object" ), expected )
+
+		# Reversing twice should get us back to where we started.
+
+		reverseWinding2 = GafferScene.ReverseWinding()
+		reverseWinding2["in"].setInput( reverseWinding["out"] )
+		reverseWinding2["filter"].setInput( f["out"] )
+		self.assertEqual( reverseWinding2["out"].object( "/object" ), mesh )
+
+	@GafferTest.TestRunner.PerformanceTestMethod()
+	def testPerformance( self ) :
+
+		plane = GafferScene.Plane()
+		plane["divisions"].setValue( imath.V2i( 1000 ) )
+
+		f = GafferScene.PathFilter()
+		f["paths"].setValue( IECore.StringVectorData( [ "/plane" ] ) )
+
+		reverseWinding = GafferScene.ReverseWinding()
+		reverseWinding["in"].setInput( plane["out"] )
+		reverseWinding["filter"].setInput( f["out"] )
+
+		reverseWinding["in"].object( "/plane" )
+
+		with GafferTest.TestRunner.PerformanceScope() :
+			reverseWinding["out"].object( "/plane" )
+
 if __name__ == "__main__":
 	unittest.main()
@@ -1511,6 +1511,88 @@ class SceneAlgoTest( GafferSceneTest.SceneTestCase ) :
 
 		assertNoCanceller( history )
 
+	def __mergeScenesDiamonds( self, depth ) :
+
+		# Each MergeScenes node takes both its inputs from the node
+		# above, so the number of distinct paths through the graph
+		# doubles with each level.
+
+		plane = GafferScene.Plane()
+
+		planeFilter = GafferScene.PathFilter()
+		planeFilter["paths"].setValue( IECore.StringVectorData( [ "/plane" ] ) )
+
+		attributes = GafferScene.CustomAttributes()
+		attributes["in"].setInput( plane["out"] )
+		attributes["filter"].setInput( planeFilter["out"] )
+		attributes["attributes"].addChild( Gaffer.NameValuePlug( "test", 10 ) )
+
+		nodes = [ plane, planeFilter, attributes ]
+		for i in range( 0, depth ) :
+			mergeScenes = GafferScene.MergeScenes()
+			mergeScenes["in"][0].setInput( nodes[-1]["out"] )
+			mergeScenes["in"][1].setInput( nodes[-1]["out"] )
+			nodes.append( mergeScenes )
+
+		return nodes
+
+	def testHistoryWithSharedUpstreamNodes( self ) :
+
+		depth = 20
+		nodes = self.__mergeScenesDiamonds( depth )
+		plane, attributes, merge = nodes[0], nodes[2], nodes[-1]
+
+		with Gaffer.PerformanceMonitor() as monitor :
+			history = GafferScene.SceneAlgo.history( merge["out"]["attributes"], "/plane" )
+
+		# Shared upstream computations are only captured once, rather than
+		# once per path through the graph.
+		self.assertLessEqual( monitor.plugStatistics( plane["out"]["attributes"] ).hashCount, 2 )
+
+		h = history
+		for i in range( 0, depth ) :
+			self.assertEqual( h.scene, nodes[-1-i]["out"] )
+			self.assertEqual( len( h.predecessors ), 2 )
+			self.assertEqual( h.predecessors[0].scene, nodes[-1-i]["in"][0] )
+			self.assertEqual( h.predecessors[1].scene, nodes[-1-i]["in"][1] )
+			self.assertEqual( h.predecessors[0].predecessors[0].scene, nodes[-2-i]["out"] )
+			self.assertEqual( h.predecessors[1].predecessors[0].scene, nodes[-2-i]["out"] )
+			h = h.predecessors[1].predecessors[0]
+
+		self.assertEqual( h.scene, attributes["out"] )
+
+		attributeHistory = GafferScene.SceneAlgo.attributeHistory( history, "test" )
+		for i in range( 0, depth ) :
+			self.assertEqual( attributeHistory.scene, nodes[-1-i]["out"] )
+			self.assertEqual( attributeHistory.attributeValue, IECore.IntData( 10 ) )
+			self.assertEqual( len( attributeHistory.predecessors ), 1 )
+			self.assertEqual( attributeHistory.predecessors[0].scene, nodes[-1-i]["in"][1] )
+			attributeHistory = attributeHistory.predecessors[0].predecessors[0]
+
+		self.assertEqual( attributeHistory.scene, attributes["out"] )
+
+	def testAttributeHistoryCancellation( self ) :
+
+		plane = GafferScene.Plane()
+		history = GafferScene.SceneAlgo.history( plane["out"]["attributes"], "/plane" )
+
+		canceller = IECore.Canceller()
+		canceller.cancel()
+
+		with Gaffer.Context( Gaffer.Context(), canceller ) :
+			with self.assertRaises( IECore.Cancelled ) :
+				GafferScene.SceneAlgo.attributeHistory( history, "test" )
+
+	@GafferTest.TestRunner.PerformanceTestMethod()
+	def testHistoryWithSharedUpstreamNodesPerformance( self ) :
+
+		nodes = self.__mergeScenesDiamonds( 200 )
+		nodes[-1]["out"].attributesHash( "/plane" )
+
+		with GafferTest.TestRunner.PerformanceScope() :
+			history = GafferScene.SceneAlgo.history( nodes[-1]["out"]["attributes"], "/plane" )
+			GafferScene.SceneAlgo.attributeHistory( history, "test" )
+
 	def testLinkingQueries( self ) :
 
 		# Everything linked to `defaultLights` via the default value for the attribute.
@@ -1647,6 +1729,96 @@ class SceneAlgoTest( GafferSceneTest.SceneTestCase ) :
 			IECore.PathMatcher( [  "/group/defaultLight", "/group/nonDefaultLight" ] )
 		)
 
+	def testLinkingQueriesFollowEdits( self ) :
+
+		# Queries are answered using an index which is reused
+		# between queries, so we must check that it is kept up
+		# to date.
+
+		light = GafferSceneTest.TestLight()
+		light["sets"].setValue( "A" )
+
+		sphere = GafferScene.Sphere()
+
+		group = GafferScene.Group()
+		group["in"][0].setInput( sphere["out"] )
+		group["in"][1].setInput( light["out"] )
+
+		sphereFilter = GafferScene.PathFilter()
+		sphereFilter["paths"].setValue( IECore.StringVectorData( [ "/group/sphere" ] ) )
+
+		standardAttributes = GafferScene.StandardAttributes()
+		standardAttributes["in"].setInput( group["out"] )
+		standardAttributes["filter"].setInput( sphereFilter["out"] )
+		standardAttributes["attributes"]["linkedLights"]["enabled"].setValue( True )
+		standardAttributes["attributes"]["linkedLights"]["value"].setValue( "A" )
+
+		scene = standardAttributes["out"]
+
+		self.assertEqual( GafferScene.SceneAlgo.linkedObjects( scene, "/group/light" ), IECore.PathMatcher( [ "/group", "/group/sphere" ] ) )
+		self.assertEqual( GafferScene.SceneAlgo.linkedLights( scene, IECore.PathMatcher( [ "/group/sphere" ] ) ), IECore.PathMatcher( [ "/group/light" ] ) )
+
+		# Edit sets
+
+		light["sets"].setValue( "B" )
+		self.assertEqual( GafferScene.SceneAlgo.linkedObjects( scene, "/group/light" ), IECore.PathMatcher( [ "/group" ] ) )
+		self.assertEqual( GafferScene.SceneAlgo.linkedLights( scene, IECore.PathMatcher( [ "/group/sphere" ] ) ), IECore.PathMatcher() )
+
+		# Edit attributes
+
+		standardAttributes["attributes"]["linkedLights"]["value"].setValue( "B" )
+		self.assertEqual( GafferScene.SceneAlgo.linkedObjects( scene, "/group/light" ), IECore.PathMatcher( [ "/group", "/group/sphere" ] ) )
+		self.assertEqual( GafferScene.SceneAlgo.linkedLights( scene, IECore.PathMatcher( [ "/group/sphere" ] ) ), IECore.PathMatcher( [ "/group/light" ] ) )
+
+		# Edit hierarchy
+
+		cube = GafferScene.Cube()
+		group["in"][2].setInput( cube["out"] )
+		self.assertEqual( GafferScene.SceneAlgo.linkedObjects( scene, "/group/light" ), IECore.PathMatcher( [ "/group", "/group/sphere", "/group/cube" ] ) )
+		self.assertEqual( GafferScene.SceneAlgo.linkedLights( scene, IECore.PathMatcher( [ "/group/cube" ] ) ), IECore.PathMatcher( [ "/group/light" ] ) )
+
+	@GafferTest.TestRunner.PerformanceTestMethod()
+	def testLinkingQueryPerformance( self ) :
+
+		numSpheres = 100000
+		numLights = 1000
+
+		sphere = GafferScene.Sphere()
+
+		spherePlane = GafferScene.Plane()
+		spherePlane["name"].setValue( "spheres" )
+		spherePlane["divisions"].setValue( imath.V2i( 1, numSpheres // 2 - 1 ) )
+
+		sphereInstancer = GafferScene.Instancer()
+		sphereInstancer["in"].setInput( spherePlane["out"] )
+		sphereInstancer["prototypes"].setInput( sphere["out"] )
+		sphereInstancer["parent"].setValue( "/spheres" )
+
+		light = GafferSceneTest.TestLight()
+
+		lightPlane = GafferScene.Plane()
+		lightPlane["name"].setValue( "lights" )
+		lightPlane["divisions"].setValue( imath.V2i( 1, numLights // 2 - 1 ) )
+
+		lightInstancer = GafferScene.Instancer()
+		lightInstancer["in"].setInput( lightPlane["out"] )
+		lightInstancer["prototypes"].setInput( light["out"] )
+		lightInstancer["parent"].setValue( "/lights" )
+
+		group = GafferScene.Group()
+		group["in"][0].setInput( sphereInstancer["out"] )
+		group["in"][1].setInput( lightInstancer["out"] )
+
+		GafferSceneTest.traverseScene( group["out"] )
+
+		# Query each light in turn, as the Light Linking editor might
+		# when the selection changes.
+		with GafferTest.TestRunner.PerformanceScope() :
+			for i in range( 0, 10 ) :
+				objects = GafferScene.SceneAlgo.linkedObjects( group["out"], "/group/lights/instances/light/{}".format( i ) )
+
+		self.assertTrue( objects.match( "/group/spheres/instances/sphere/0" ) & IECore.PathMatcher.Result.ExactMatch )
+
 	def testMatchingPathsHash( self ) :
 
 		# /group
@@ -1722,6 +1894,134 @@ class SceneAlgoTest( GafferSceneTest.SceneTestCase ) :
 			result = IECore.PathMatcher()
 			GafferScene.SceneAlgo.matchingPaths( pathMatcher, scene, result )
 
+	def __boundsQueryScene( self, divisions ) :
+
+		sphere = GafferScene.Sphere()
+		sphere["radius"].setValue( 0.01 )
+
+		plane = GafferScene.Plane()
+		plane["divisions"].setValue( imath.V2i( divisions ) )
+
+		instancer = GafferScene.Instancer()
+		instancer["in"].setInput( plane["out"] )
+		instancer["prototypes"].setInput( sphere["out"] )
+		instancer["parent"].setValue( "/plane" )
+
+		group = GafferScene.Group()
+		group["in"][0].setInput( instancer["out"] )
+		group["transform"]["translate"].setValue( imath.V3f( 1, 2, 0 ) )
+		group["transform"]["rotate"].setValue( imath.V3f( 0, 0, 30 ) )
+
+		return sphere, group
+
+	def __bruteForceBoundsQuery( self, scene, predicate ) :
+
+		result = IECore.PathMatcher()
+
+		def walk( path, parentTransform ) :
+
+			fullTransform = scene.transform( path ) * parentTransform
+			bound = scene.bound( path )
+			if bound.isEmpty() or not predicate( bound * fullTransform ) :
+				return
+
+			result.addPath( path )
+			for childName in scene.childNames( path ) :
+				walk( path.rstrip( "/" ) + "/" + str( childName ), fullTransform )
+
+		walk( "/", imath.M44f() )
+		return result
+
+	def testBoundsQueries( self ) :
+
+		sphere, group = self.__boundsQueryScene( 15 )
+		sphereInstancesPath = "/group/plane/instances/sphere"
+		self.assertGreater( len( group["out"].childNames( sphereInstancesPath ) ), 64 )
+
+		# Orthographic frustums and axis-aligned rays allow us to write
+		# exact brute force tests in terms of boxes.
+
+		cameraTransform = imath.M44f().translate( imath.V3f( 1.2, 2.1, 10 ) )
+		frustum = imath.Frustumf( 1, 20, -0.2, 0.3, 0.25, -0.15, True )
+		frustumBox = imath.Box3f( imath.V3f( -0.2, -0.15, -20 ), imath.V3f( 0.3, 0.25, -1 ) ) * cameraTransform
+
+		ray = imath.Line3f( imath.V3f( 1.1, 2.05, 10 ), imath.V3f( 1.1, 2.05, 9 ) )
+		rayBox = imath.Box3f( imath.V3f( 1.1, 2.05, -1e10 ), imath.V3f( 1.1, 2.05, 10 ) )
+
+		def assertQueriesCorrect() :
+
+			inFrustum = GafferScene.SceneAlgo.findInFrustum( group["out"], frustum, cameraTransform )
+			self.assertEqual( inFrustum, self.__bruteForceBoundsQuery( group["out"], frustumBox.intersects ) )
+			self.assertGreater( inFrustum.size(), 4 )
+			self.assertLess( inFrustum.size(), len( group["out"].childNames( sphereInstancesPath ) ) )
+
+			intersecting = GafferScene.SceneAlgo.findIntersecting( group["out"], ray )
+			self.assertEqual( intersecting, self.__bruteForceBoundsQuery( group["out"], rayBox.intersects ) )
+			self.assertTrue( intersecting.match( sphereInstancesPath ) & IECore.PathMatcher.Result.DescendantMatch )
+
+			self.assertEqual(
+				GafferScene.SceneAlgo.findInFrustum( group["out"], frustum, cameraTransform, root = sphereInstancesPath ),
+				IECore.PathMatcher( [
+					p for p in inFrustum.paths()
+					if p == sphereInstancesPath or p.startswith( sphereInstancesPath + "/" )
+				] )
+			)
+
+		assertQueriesCorrect()
+
+		# Results must reflect edits to the scene, even though the
+		# acceleration structures are cached.
+
+		sphere["radius"].setValue( 0.03 )
+		assertQueriesCorrect()
+
+		group["transform"]["translate"]["x"].setValue( 1.1 )
+		assertQueriesCorrect()
+
+	def testBoundsQueriesWithEmptyScene( self ) :
+
+		group = GafferScene.Group()
+		self.assertEqual(
+			GafferScene.SceneAlgo.findIntersecting( group["out"], imath.Line3f( imath.V3f( 0 ), imath.V3f( 0, 0, -1 ) ) ),
+			IECore.PathMatcher()
+		)
+
+	def testBoundsQueryCacheMemoryLimit( self ) :
+
+		originalLimit = GafferScene.SceneAlgo.getBoundsQueryCacheMemoryLimit()
+		self.addCleanup( GafferScene.SceneAlgo.setBoundsQueryCacheMemoryLimit, originalLimit )
+
+		GafferScene.SceneAlgo.setBoundsQueryCacheMemoryLimit( 1024 * 1024 )
+		self.assertEqual( GafferScene.SceneAlgo.getBoundsQueryCacheMemoryLimit(), 1024 * 1024 )
+
+		# Results must still be correct when nothing can be cached.
+
+		GafferScene.SceneAlgo.setBoundsQueryCacheMemoryLimit( 0 )
+		self.assertEqual( GafferScene.SceneAlgo.getBoundsQueryCacheMemoryLimit(), 0 )
+
+		sphere, group = self.__boundsQueryScene( 15 )
+		ray = imath.Line3f( imath.V3f( 1.1, 2.05, 10 ), imath.V3f( 1.1, 2.05, 9 ) )
+		rayBox = imath.Box3f( imath.V3f( 1.1, 2.05, -1e10 ), imath.V3f( 1.1, 2.05, 10 ) )
+
+		intersecting = GafferScene.SceneAlgo.findIntersecting( group["out"], ray )
+		self.assertEqual( intersecting, self.__bruteForceBoundsQuery( group["out"], rayBox.intersects ) )
+		self.assertTrue( intersecting.match( "/group/plane/instances/sphere" ) & IECore.PathMatcher.Result.DescendantMatch )
+
+	@GafferTest.TestRunner.PerformanceTestMethod()
+	def testBoundsQueryPerformance( self ) :
+
+		sphere, group = self.__boundsQueryScene( 499 )
+
+		# Warm the caches, including the BVH, so we measure only
+		# the cost of repeated queries, as made by a viewer when picking.
+		ray = imath.Line3f( imath.V3f( 1, 2, 10 ), imath.V3f( 1, 2, 9 ) )
+		self.assertFalse( GafferScene.SceneAlgo.findIntersecting( group["out"], ray ).isEmpty() )
+
+		with GafferTest.TestRunner.PerformanceScope() :
+			for i in range( 0, 100 ) :
+				ray = imath.Line3f( imath.V3f( 1 + i * 0.001, 2, 10 ), imath.V3f( 1 + i * 0.001, 2, 9 ) )
+				GafferScene.SceneAlgo.findIntersecting( group["out"], ray )
+
 	def testRenderAdaptors( self ) :
 
 		sphere = GafferScene.Sphere()
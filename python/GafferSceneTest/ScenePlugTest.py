@@ -41,6 +41,7 @@ import imath
 import IECore
 
 import Gaffer
+import GafferTest
 import GafferScene
 import GafferSceneTest
 
@@ -141,6 +142,109 @@ class ScenePlugTest( GafferSceneTest.SceneTestCase ) :
 			} )
 		)
 
+	def testFullAttributesFollowEdits( self ) :
+
+		sphere = GafferScene.Sphere()
+
+		group = GafferScene.Group()
+		group["in"][0].setInput( sphere["out"] )
+
+		groupFilter = GafferScene.PathFilter()
+		groupFilter["paths"].setValue( IECore.StringVectorData( [ "/group" ] ) )
+
+		attributes = GafferScene.CustomAttributes()
+		attributes["in"].setInput( group["out"] )
+		attributes["filter"].setInput( groupFilter["out"] )
+		attributes["attributes"].addChild( Gaffer.NameValuePlug( "a", "groupValue" ) )
+
+		self.assertEqual( attributes["out"].fullAttributes( "/group/sphere" ), IECore.CompoundObject( { "a" : IECore.StringData( "groupValue" ) } ) )
+		h = attributes["out"].fullAttributesHash( "/group/sphere" )
+
+		# Edit inherited value
+
+		attributes["attributes"][0]["value"].setValue( "newGroupValue" )
+		self.assertNotEqual( attributes["out"].fullAttributesHash( "/group/sphere" ), h )
+		self.assertEqual( attributes["out"].fullAttributes( "/group/sphere" ), IECore.CompoundObject( { "a" : IECore.StringData( "newGroupValue" ) } ) )
+
+		# Move attribute to child
+
+		groupFilter["paths"].setValue( IECore.StringVectorData( [ "/group/sphere" ] ) )
+		self.assertEqual( attributes["out"].fullAttributes( "/group" ), IECore.CompoundObject() )
+		self.assertEqual( attributes["out"].fullAttributes( "/group/sphere" ), IECore.CompoundObject( { "a" : IECore.StringData( "newGroupValue" ) } ) )
+
+		# Results must be copies, since they are mutable.
+
+		a = attributes["out"].fullAttributes( "/group/sphere" )
+		a["b"] = IECore.IntData( 10 )
+		self.assertEqual( attributes["out"].fullAttributes( "/group/sphere" ), IECore.CompoundObject( { "a" : IECore.StringData( "newGroupValue" ) } ) )
+
+		# Context dependence
+
+		expression = Gaffer.Expression()
+		attributes.addChild( expression )
+		expression.setExpression( 'parent["attributes"]["attributes"]["NameValuePlug"]["value"] = str( context.getFrame() )'.replace( "NameValuePlug", attributes["attributes"][0].getName() ) )
+
+		for frame in range( 1, 4 ) :
+			with Gaffer.Context() as c :
+				c.setFrame( frame )
+				self.assertEqual( attributes["out"].fullAttributes( "/group/sphere" ), IECore.CompoundObject( { "a" : IECore.StringData( str( float( frame ) ) ) } ) )
+
+	def testFullAttributesCacheMemoryLimit( self ) :
+
+		originalLimit = GafferScene.ScenePlug.getFullAttributesCacheMemoryLimit()
+		self.addCleanup( GafferScene.ScenePlug.setFullAttributesCacheMemoryLimit, originalLimit )
+
+		GafferScene.ScenePlug.setFullAttributesCacheMemoryLimit( 1024 * 1024 )
+		self.assertEqual( GafferScene.ScenePlug.getFullAttributesCacheMemoryLimit(), 1024 * 1024 )
+
+		# Results must still be correct when nothing can be cached.
+
+		GafferScene.ScenePlug.setFullAttributesCacheMemoryLimit( 0 )
+		self.assertEqual( GafferScene.ScenePlug.getFullAttributesCacheMemoryLimit(), 0 )
+
+		sphere = GafferScene.Sphere()
+
+		group = GafferScene.Group()
+		group["in"][0].setInput( sphere["out"] )
+
+		groupFilter = GafferScene.PathFilter()
+		groupFilter["paths"].setValue( IECore.StringVectorData( [ "/group" ] ) )
+
+		attributes = GafferScene.CustomAttributes()
+		attributes["in"].setInput( group["out"] )
+		attributes["filter"].setInput( groupFilter["out"] )
+		attributes["attributes"].addChild( Gaffer.NameValuePlug( "a", "groupValue" ) )
+
+		self.assertEqual( attributes["out"].fullAttributes( "/group/sphere" ), IECore.CompoundObject( { "a" : IECore.StringData( "groupValue" ) } ) )
+		attributes["attributes"][0]["value"].setValue( "newGroupValue" )
+		self.assertEqual( attributes["out"].fullAttributes( "/group/sphere" ), IECore.CompoundObject( { "a" : IECore.StringData( "newGroupValue" ) } ) )
+
+	@GafferTest.TestRunner.PerformanceTestMethod()
+	def testDeepFullAttributesPerformance( self ) :
+
+		# A single deep branch, with attributes at every level.
+
+		depth = 1000
+		root = IECore.CompoundObject()
+		location = root
+		for i in range( 0, depth ) :
+			child = IECore.CompoundObject( {
+				"attributes" : IECore.CompoundObject( { "level{}".format( i % 20 ) : IECore.IntData( i ) } ),
+			} )
+			location["children"] = IECore.CompoundObject( { "c" : child } )
+			location = child
+
+		source = GafferSceneTest.CompoundObjectSource()
+		source["in"].setValue( root )
+
+		paths = [ "/c" * i for i in range( 1, depth + 1 ) ]
+		for path in paths :
+			source["out"].attributes( path )
+
+		with GafferTest.TestRunner.PerformanceScope() :
+			for path in paths :
+				source["out"].fullAttributes( path )
+
 	def testCreateCounterpart( self ) :
 
 		s1 = GafferScene.ScenePlug( "a", Gaffer.Plug.Direction.Out )
@@ -35,6 +35,7 @@
 ##########################################################################
 
 import os
+import time
 import unittest
 import inspect
 import imath
@@ -43,6 +44,7 @@ import IECore
 import IECoreScene
 
 import Gaffer
+import GafferTest
 import GafferScene
 import GafferSceneTest
 
@@ -596,5 +598,266 @@ class SceneReaderTest( GafferSceneTest.SceneTestCase ) :
 		self.assertEqual( mh.messages[0].level, IECore.Msg.Level.Warning )
 		self.assertEqual( mh.messages[0].message, 'Failed to load attribute "test:double4" at location "/sphere"' )
 
+	def __writeTaggedHierarchy( self, fileName, depth, branching ) :
+
+		scc = IECoreScene.SceneCache( fileName, IECore.IndexedIO.OpenMode.Write )
+
+		def walk( location, path, depth ) :
+
+			if depth == 0 :
+				return
+
+			for i in range( 0, branching ) :
+				child = location.createChild( "c{}".format( i ) )
+				childPath = path + [ "c{}".format( i ) ]
+				tags = [ "tag{}".format( len( childPath ) ), "branch{}".format( i ) ]
+				if sum( len( n ) for n in childPath ) % 3 == 0 :
+					tags.append( "sparse" )
+				child.writeTags( tags )
+				walk( child, childPath, depth - 1 )
+
+		walk( scc, [], depth )
+
+	def testSetsMatchTags( self ) :
+
+		fileName = self.temporaryDirectory() + "/tagged.scc"
+		self.__writeTaggedHierarchy( fileName, depth = 4, branching = 3 )
+
+		reader = GafferScene.SceneReader()
+		reader["fileName"].setValue( fileName )
+
+		# Compare against sets built by querying tags location by location.
+
+		scc = IECoreScene.SceneCache( fileName, IECore.IndexedIO.OpenMode.Read )
+		setNames = scc.readTags( IECoreScene.SceneInterface.TagFilter.EveryTag )
+
+		expectedSets = { str( n ) : IECore.PathMatcher() for n in setNames }
+		def walk( location ) :
+			for tag in location.readTags( IECoreScene.SceneInterface.TagFilter.LocalTag ) :
+				expectedSets[str( tag )].addPath( location.path() )
+			for childName in location.childNames() :
+				walk( location.child( childName ) )
+
+		walk( scc )
+
+		self.assertEqual( set( reader["out"]["setNames"].getValue() ), set( setNames ) )
+		self.assertEqual( set( expectedSets.keys() ), { "tag1", "tag2", "tag3", "tag4", "branch0", "branch1", "branch2", "sparse" } )
+		for setName, expectedSet in expectedSets.items() :
+			self.assertEqual( reader["out"].set( setName ).value, expectedSet )
+
+		self.assertEqual( reader["out"].set( "notATag" ).value, IECore.PathMatcher() )
+
+	def testSetsShareSingleWalk( self ) :
+
+		fileName = self.temporaryDirectory() + "/tagged.scc"
+		self.__writeTaggedHierarchy( fileName, depth = 3, branching = 3 )
+
+		reader = GafferScene.SceneReader()
+		reader["fileName"].setValue( fileName )
+
+		with Gaffer.PerformanceMonitor() as monitor :
+			for frame in range( 1, 4 ) :
+				with Gaffer.Context() as context :
+					context.setFrame( frame )
+					for setName in reader["out"]["setNames"].getValue() :
+						reader["out"].set( setName )
+
+		self.assertEqual( monitor.plugStatistics( reader["__sets"] ).computeCount, 1 )
+
+	@GafferTest.TestRunner.PerformanceTestMethod()
+	def testSetLoadingPerformance( self ) :
+
+		fileName = self.temporaryDirectory() + "/tagged.scc"
+		self.__writeTaggedHierarchy( fileName, depth = 6, branching = 6 )
+
+		reader = GafferScene.SceneReader()
+		reader["fileName"].setValue( fileName )
+
+		with GafferTest.TestRunner.PerformanceScope() :
+			for setName in reader["out"]["setNames"].getValue() :
+				reader["out"].set( setName )
+
+	def __writeLatencyTestFile( self, numChildren ) :
+
+		fileName = os.path.join( self.temporaryDirectory(), "latency.scc" )
+
+		scc = IECoreScene.SceneCache( fileName, IECore.IndexedIO.OpenMode.Write )
+		for i in range( 0, numChildren ) :
+			child = scc.createChild( "child{}".format( i ) )
+			child.writeTransform( IECore.M44dData( imath.M44d().translate( imath.V3d( i, 0, 0 ) ) ), 0 )
+			child.writeObject( IECoreScene.MeshPrimitive.createPlane( imath.Box2f( imath.V2f( -1 ), imath.V2f( 1 ) ), imath.V2i( i + 1 ) ), 0 )
+
+		del scc, child
+
+		# Reading via the ".latency" extension adds a delay to
+		# every read, simulating slow network storage.
+		return fileName + ".latency"
+
+	def __readChildrenSerially( self, scene ) :
+
+		for childName in scene.childNames( "/" ) :
+			path = "/" + str( childName )
+			scene.bound( path )
+			scene.transform( path )
+			scene.object( path )
+
+	def testPrefetch( self ) :
+
+		fileName = self.__writeLatencyTestFile( 20 )
+
+		reader = GafferScene.SceneReader()
+		reader["fileName"].setValue( fileName )
+		reader["refreshCount"].setValue( self.uniqueInt( fileName ) )
+
+		prefetchReader = GafferScene.SceneReader()
+		prefetchReader["fileName"].setValue( fileName )
+		prefetchReader["refreshCount"].setValue( self.uniqueInt( fileName ) )
+		prefetchReader["prefetch"].setValue( True )
+
+		self.assertScenesEqual( prefetchReader["out"], reader["out"] )
+
+	def testPrefetchMatchesRegularRead( self ) :
+
+		fileName = os.path.join( self.temporaryDirectory(), "prefetch.scc" )
+
+		def writeFile( offset ) :
+
+			scc = IECoreScene.SceneCache( fileName, IECore.IndexedIO.OpenMode.Write )
+			for i in range( 0, 10 ) :
+				child = scc.createChild( "child{}".format( i ) )
+				for t in ( 0, 1 ) :
+					child.writeTransform( IECore.M44dData( imath.M44d().translate( imath.V3d( i + offset, t, 0 ) ) ), t )
+					child.writeObject( IECoreScene.SpherePrimitive( i + t + 1 ), t )
+				for j in range( 0, 5 ) :
+					grandChild = child.createChild( "grandChild{}".format( j ) )
+					grandChild.writeTransform( IECore.M44dData( imath.M44d().translate( imath.V3d( 0, j, offset ) ) ), 0 )
+					grandChild.writeObject( IECoreScene.MeshPrimitive.createPlane( imath.Box2f( imath.V2f( -1 ), imath.V2f( 1 ) ), imath.V2i( j + 1 ) ), 0 )
+					del grandChild
+				del child
+			del scc
+
+		def scheduleFetches( path ) :
+
+			for childName in prefetchReader["out"].childNames( path ) :
+				scheduleFetches( path.rstrip( "/" ) + "/" + str( childName ) )
+
+		def assertReadersEqual( frame ) :
+
+			with Gaffer.Context() as c :
+				c.setFrame( frame )
+				# Computing only the child names schedules the prefetches.
+				# Give them a chance to complete, so that the comparison
+				# uses the prefetched values.
+				scheduleFetches( "/" )
+				time.sleep( 0.1 )
+				self.assertScenesEqual( prefetchReader["out"], reader["out"], checks = { "bound", "transform", "object", "childNames" } )
+
+		writeFile( offset = 0 )
+
+		# The readers have different refresh counts so that they don't
+		# share entries in the compute cache.
+
+		reader = GafferScene.SceneReader()
+		reader["fileName"].setValue( fileName )
+		reader["refreshCount"].setValue( self.uniqueInt( fileName ) )
+
+		prefetchReader = GafferScene.SceneReader()
+		prefetchReader["fileName"].setValue( fileName )
+		prefetchReader["refreshCount"].setValue( self.uniqueInt( fileName ) )
+		prefetchReader["prefetch"].setValue( True )
+
+		for frame in ( 0, 12, 24 ) :
+			assertReadersEqual( frame )
+
+		# Values prefetched before a refresh must not be used after it.
+
+		writeFile( offset = 100 )
+		reader["refreshCount"].setValue( self.uniqueInt( fileName ) )
+		prefetchReader["refreshCount"].setValue( self.uniqueInt( fileName ) )
+
+		scheduleFetches( "/" )
+		time.sleep( 0.1 )
+		self.assertEqual(
+			prefetchReader["out"].transform( "/child1" ),
+			imath.M44f().translate( imath.V3f( 101, 0, 0 ) )
+		)
+		for frame in ( 0, 12, 24 ) :
+			assertReadersEqual( frame )
+
+	def testPrefetchCacheMemoryLimit( self ) :
+
+		originalLimit = GafferScene.SceneReader.getPrefetchCacheMemoryLimit()
+		self.addCleanup( GafferScene.SceneReader.setPrefetchCacheMemoryLimit, originalLimit )
+
+		GafferScene.SceneReader.setPrefetchCacheMemoryLimit( 1024 * 1024 )
+		self.assertEqual( GafferScene.SceneReader.getPrefetchCacheMemoryLimit(), 1024 * 1024 )
+
+		# Results must still be correct when nothing can be prefetched.
+
+		GafferScene.SceneReader.setPrefetchCacheMemoryLimit( 0 )
+		self.assertEqual( GafferScene.SceneReader.getPrefetchCacheMemoryLimit(), 0 )
+
+		fileName = self.__writeLatencyTestFile( 20 )
+
+		reader = GafferScene.SceneReader()
+		reader["fileName"].setValue( fileName )
+		reader["refreshCount"].setValue( self.uniqueInt( fileName ) )
+
+		prefetchReader = GafferScene.SceneReader()
+		prefetchReader["fileName"].setValue( fileName )
+		prefetchReader["refreshCount"].setValue( self.uniqueInt( fileName ) )
+		prefetchReader["prefetch"].setValue( True )
+
+		self.assertScenesEqual( prefetchReader["out"], reader["out"] )
+
+	@unittest.skipIf( GafferTest.inCI(), "Performance not relevant on CI platform" )
+	@GafferTest.TestRunner.PerformanceTestMethod( repeat = 1 )
+	def testPrefetchHidesLatency( self ) :
+
+		fileName = self.__writeLatencyTestFile( 40 )
+
+		def readTime( prefetch ) :
+
+			Gaffer.ValuePlug.clearCache()
+
+			reader = GafferScene.SceneReader()
+			reader["fileName"].setValue( fileName )
+			reader["refreshCount"].setValue( self.uniqueInt( fileName ) )
+			reader["prefetch"].setValue( prefetch )
+
+			t = time.perf_counter()
+			self.__readChildrenSerially( reader["out"] )
+			return time.perf_counter() - t
+
+		GafferSceneTest.LatencySceneInterface.setLatency( 0.01 )
+		try :
+			regularTime = readTime( prefetch = False )
+			with GafferTest.TestRunner.PerformanceScope() :
+				prefetchTime = readTime( prefetch = True )
+		finally :
+			GafferSceneTest.LatencySceneInterface.setLatency( 0 )
+
+		# Without prefetching, every bound, transform and object is a
+		# separate blocking read, so we expect at least 40 * 3 * 0.01s.
+		self.assertGreater( regularTime, 1.0 )
+		self.assertLess( prefetchTime, regularTime * 0.5 )
+
+	@GafferTest.TestRunner.PerformanceTestMethod()
+	def testPrefetchPerformance( self ) :
+
+		fileName = self.__writeLatencyTestFile( 200 )
+
+		reader = GafferScene.SceneReader()
+		reader["fileName"].setValue( fileName )
+		reader["refreshCount"].setValue( self.uniqueInt( fileName ) )
+		reader["prefetch"].setValue( True )
+
+		GafferSceneTest.LatencySceneInterface.setLatency( 0.005 )
+		try :
+			with GafferTest.TestRunner.PerformanceScope() :
+				self.__readChildrenSerially( reader["out"] )
+		finally :
+			GafferSceneTest.LatencySceneInterface.setLatency( 0 )
+
 if __name__ == "__main__":
 	unittest.main()
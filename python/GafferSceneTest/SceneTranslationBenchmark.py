@@ -0,0 +1,274 @@
+##########################################################################
+#
+#  Copyright (c) 2022, Cinesite VFX Ltd. All rights reserved.
+#
+#  Redistribution and use in source and binary forms, with or without
+#  modification, are permitted provided that the following conditions are
+#  met:
+#
+#      * Redistributions of source code must retain the above
+#        copyright notice, this list of conditions and the following
+#        disclaimer.
+#
+#      * Redistributions in binary form must reproduce the above
+#        copyright notice, this list of conditions and the following
+#        disclaimer in the documentation and/or other materials provided with
+#        the distribution.
+#
+#      * Neither the name of John Haddon nor the names of
+#        any other contributors to this software may be used to endorse or
+#        promote products derived from this software without specific prior
+#        written permission.
+#
+#  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+#  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+#  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+#  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+#  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+#  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+#  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+#  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+#  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+#  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+#  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+##########################################################################
+
+import collections
+import resource
+import sys
+import time
+
+import imath
+
+import IECore
+
+import Gaffer
+import GafferScene
+
+from ._GafferSceneTest import countLocations, outputScene, traverseScene, TestLight
+
+## Builds synthetic scenes of configurable shape and size, and measures
+# the throughput of translating them to a renderer via RendererAlgo and
+# RenderController. This allows the performance of scene translation to
+# be tracked without needing a production renderer. It is used by
+# SceneTranslationBenchmarkTest, and may also be run from the command
+# line via `contrib/scripts/sceneTranslationBenchmark.py`.
+class SceneTranslationBenchmark( object ) :
+
+	Shapes = ( "wide", "deep", "instanced", "compact", "sets", "attributes" )
+
+	Results = collections.namedtuple( "Results", [ "locations", "timings", "peakMemory" ] )
+
+	## `size` is the approximate number of leaf locations to generate.
+	# `renderer` is the name of a registered `IECoreScenePreview.Renderer`
+	# type. The default captures the scene in memory.
+	def __init__( self, shape = "wide", size = 10000, renderer = "Capturing", numSets = 50, numAttributes = 50, depth = 4 ) :
+
+		if shape not in self.Shapes :
+			raise ValueError( "Unknown shape \"{}\"".format( shape ) )
+
+		self.__renderer = renderer
+		self.__nodes = Gaffer.Node()
+
+		if shape == "deep" :
+			content = self.__deep( size, depth )
+		else :
+			content = self.__instances(
+				size,
+				encapsulate = shape in ( "instanced", "compact" ),
+				compact = shape == "compact"
+			)
+			if shape == "sets" :
+				content = self.__addSets( content, numSets )
+			elif shape == "attributes" :
+				content = self.__addAttributes( content, numAttributes )
+
+		self.__nodes["camera"] = GafferScene.Camera()
+		self.__nodes["light"] = TestLight()
+
+		self.__nodes["group"] = GafferScene.Group()
+		self.__nodes["group"]["in"][0].setInput( content )
+		self.__nodes["group"]["in"][1].setInput( self.__nodes["camera"]["out"] )
+		self.__nodes["group"]["in"][2].setInput( self.__nodes["light"]["out"] )
+
+		self.__nodes["options"] = GafferScene.StandardOptions()
+		self.__nodes["options"]["in"].setInput( self.__nodes["group"]["out"] )
+		self.__nodes["options"]["options"]["renderCamera"]["enabled"].setValue( True )
+		self.__nodes["options"]["options"]["renderCamera"]["value"].setValue( "/group/camera" )
+
+	def scene( self ) :
+
+		return self.__nodes["options"]["out"]
+
+	## Runs the benchmark, returning `Results` containing the number of
+	# locations in the scene, an ordered dictionary mapping from phase name
+	# to wall clock duration in seconds, and the peak resident memory in bytes.
+	# Peak memory is the maximum for the lifetime of the process, so it is
+	# reported as a single total rather than per phase, and includes anything
+	# run before the benchmark.
+	# Caches are cleared before each phase, so that phases don't benefit from
+	# computations made by previous phases.
+	def run( self ) :
+
+		scene = self.scene()
+		timings = collections.OrderedDict()
+
+		self.__clearCaches()
+		with _Timer( timings, "Scene generation" ) :
+			traverseScene( scene )
+
+		locations = countLocations( scene )
+
+		self.__clearCaches()
+		renderer = GafferScene.Private.IECoreScenePreview.Renderer.create(
+			self.__renderer,
+			GafferScene.Private.IECoreScenePreview.Renderer.RenderType.Batch
+		)
+		for phase, duration in outputScene( scene, renderer ) :
+			timings["RendererAlgo : " + phase] = duration
+		del renderer
+
+		self.__clearCaches()
+		renderer = GafferScene.Private.IECoreScenePreview.Renderer.create(
+			self.__renderer,
+			GafferScene.Private.IECoreScenePreview.Renderer.RenderType.Interactive
+		)
+		controller = GafferScene.RenderController( scene, Gaffer.Context(), renderer )
+		controller.setMinimumExpansionDepth( sys.maxsize )
+		with _Timer( timings, "RenderController : Initial update" ) :
+			controller.update()
+		with _Timer( timings, "RenderController : Null update" ) :
+			controller.update()
+		del controller, renderer
+
+		return self.Results( locations, timings, self.__maxRSS() )
+
+	@staticmethod
+	def format( results ) :
+
+		items = [ ( "Locations", results.locations ) ]
+		items.extend( ( k, "%.3fs" % v ) for k, v in results.timings.items() )
+
+		objectsTime = results.timings.get( "RendererAlgo : Objects" )
+		if objectsTime :
+			items.append( ( "RendererAlgo : Locations per second", "%.0f" % ( results.locations / objectsTime ) ) )
+		updateTime = results.timings.get( "RenderController : Initial update" )
+		if updateTime :
+			items.append( ( "RenderController : Locations per second", "%.0f" % ( results.locations / updateTime ) ) )
+
+		items.append( ( "Peak memory (process total)", "%.3fM" % ( results.peakMemory / ( 1024 * 1024. ) ) ) )
+
+		width = max( len( x[0] ) for x in items ) + 4
+		return "\n".join( "{name:<{width}}{value}".format( name = n, width = width, value = v ) for n, v in items )
+
+	# Scene building
+	# ==============
+
+	def __instances( self, size, encapsulate, compact = False ) :
+
+		self.__nodes["sphere"] = GafferScene.Sphere()
+
+		self.__nodes["plane"] = GafferScene.Plane()
+		self.__nodes["plane"]["divisions"].setValue( imath.V2i( 1, max( 1, size // 2 - 1 ) ) )
+
+		self.__nodes["instancer"] = GafferScene.Instancer()
+		self.__nodes["instancer"]["in"].setInput( self.__nodes["plane"]["out"] )
+		self.__nodes["instancer"]["prototypes"].setInput( self.__nodes["sphere"]["out"] )
+		self.__nodes["instancer"]["parent"].setValue( "/plane" )
+		self.__nodes["instancer"]["encapsulateInstanceGroups"].setValue( encapsulate )
+		self.__nodes["instancer"]["compactInstanceGroups"].setValue( compact )
+
+		return self.__nodes["instancer"]["out"]
+
+	def __deep( self, size, depth ) :
+
+		# Nested instancers, each instancing the previous level onto the
+		# points of a plane, giving `branching ** depth` leaf locations.
+		branching = max( 2, int( round( size ** ( 1.0 / depth ) ) ) )
+
+		self.__nodes["sphere"] = GafferScene.Sphere()
+		prototypes = self.__nodes["sphere"]["out"]
+
+		for level in range( 0, depth ) :
+
+			plane = GafferScene.Plane( "plane{}".format( level ) )
+			plane["divisions"].setValue( imath.V2i( 1, max( 1, branching // 2 - 1 ) ) )
+			self.__nodes.addChild( plane )
+
+			instancer = GafferScene.Instancer( "instancer{}".format( level ) )
+			instancer["in"].setInput( plane["out"] )
+			instancer["prototypes"].setInput( prototypes )
+			instancer["parent"].setValue( "/plane" )
+			self.__nodes.addChild( instancer )
+
+			prototypes = instancer["out"]
+
+		return prototypes
+
+	def __addSets( self, content, numSets ) :
+
+		for i in range( 0, numSets ) :
+
+			pathFilter = GafferScene.PathFilter( "setFilter{}".format( i ) )
+			pathFilter["paths"].setValue( IECore.StringVectorData( [ "/plane/instances/sphere/*{}".format( i % 10 ) ] ) )
+			self.__nodes.addChild( pathFilter )
+
+			setNode = GafferScene.Set( "set{}".format( i ) )
+			setNode["in"].setInput( content )
+			setNode["name"].setValue( "render:set{}".format( i ) )
+			setNode["filter"].setInput( pathFilter["out"] )
+			self.__nodes.addChild( setNode )
+
+			content = setNode["out"]
+
+		return content
+
+	def __addAttributes( self, content, numAttributes ) :
+
+		self.__nodes["attributesFilter"] = GafferScene.PathFilter()
+		self.__nodes["attributesFilter"]["paths"].setValue( IECore.StringVectorData( [ "/plane/instances/sphere/*" ] ) )
+
+		self.__nodes["attributes"] = GafferScene.CustomAttributes()
+		self.__nodes["attributes"]["in"].setInput( content )
+		self.__nodes["attributes"]["filter"].setInput( self.__nodes["attributesFilter"]["out"] )
+
+		values = [ IECore.IntData( 1 ), IECore.FloatData( 1.0 ), IECore.StringData( "value" ), IECore.Color3fData( imath.Color3f( 1 ) ) ]
+		for i in range( 0, numAttributes ) :
+			self.__nodes["attributes"]["attributes"].addChild(
+				Gaffer.NameValuePlug( "user:attribute{}".format( i ), values[i % len( values )], flags = Gaffer.Plug.Flags.Default | Gaffer.Plug.Flags.Dynamic )
+			)
+
+		return self.__nodes["attributes"]["out"]
+
+	# Measurement
+	# ===========
+
+	@staticmethod
+	def __clearCaches() :
+
+		Gaffer.ValuePlug.clearCache()
+		Gaffer.ValuePlug.clearHashCache()
+
+	@staticmethod
+	def __maxRSS() :
+
+		if sys.platform == "darwin" :
+			return resource.getrusage( resource.RUSAGE_SELF ).ru_maxrss
+		else :
+			return resource.getrusage( resource.RUSAGE_SELF ).ru_maxrss * 1024
+
+class _Timer( object ) :
+
+	def __init__( self, timings, name ) :
+
+		self.__timings = timings
+		self.__name = name
+
+	def __enter__( self ) :
+
+		self.__startTime = time.time()
+
+	def __exit__( self, type, value, traceBack ) :
+
+		self.__timings[self.__name] = time.time() - self.__startTime
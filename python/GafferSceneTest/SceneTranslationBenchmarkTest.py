@@ -0,0 +1,142 @@
+##########################################################################
+#
+#  Copyright (c) 2022, Cinesite VFX Ltd. All rights reserved.
+#
+#  Redistribution and use in source and binary forms, with or without
+#  modification, are permitted provided that the following conditions are
+#  met:
+#
+#      * Redistributions of source code must retain the above
+#        copyright notice, this list of conditions and the following
+#        disclaimer.
+#
+#      * Redistributions in binary form must reproduce the above
+#        copyright notice, this list of conditions and the following
+#        disclaimer in the documentation and/or other materials provided with
+#        the distribution.
+#
+#      * Neither the name of John Haddon nor the names of
+#        any other contributors to this software may be used to endorse or
+#        promote products derived from this software without specific prior
+#        written permission.
+#
+#  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+#  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+#  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+#  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+#  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+#  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+#  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+#  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+#  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+#  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+#  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+##########################################################################
+
+import sys
+import unittest
+
+import IECore
+
+import Gaffer
+import GafferTest
+import GafferScene
+import GafferSceneTest
+
+class SceneTranslationBenchmarkTest( GafferSceneTest.SceneTestCase ) :
+
+	def testShapes( self ) :
+
+		for shape in GafferSceneTest.SceneTranslationBenchmark.Shapes :
+
+			with self.subTest( shape = shape ) :
+
+				benchmark = GafferSceneTest.SceneTranslationBenchmark( shape, size = 100, numSets = 5, numAttributes = 5, depth = 2 )
+				self.assertSceneValid( benchmark.scene() )
+
+				results = benchmark.run()
+				if shape not in ( "instanced", "compact" ) :
+					# Encapsulated instances aren't visible to traversals.
+					self.assertGreaterEqual( results.locations, 100 )
+				self.assertGreater( results.peakMemory, 0 )
+				self.assertEqual(
+					list( results.timings.keys() ),
+					[
+						"Scene generation",
+						"RendererAlgo : Globals",
+						"RendererAlgo : Sets",
+						"RendererAlgo : Cameras",
+						"RendererAlgo : Lights",
+						"RendererAlgo : Light filters",
+						"RendererAlgo : Objects",
+						"RenderController : Initial update",
+						"RenderController : Null update",
+					]
+				)
+
+				self.assertIn( "Locations per second", GafferSceneTest.SceneTranslationBenchmark.format( results ) )
+
+	def testOutputScene( self ) :
+
+		benchmark = GafferSceneTest.SceneTranslationBenchmark( "sets", size = 20, numSets = 2 )
+
+		renderer = GafferScene.Private.IECoreScenePreview.CapturingRenderer(
+			GafferScene.Private.IECoreScenePreview.Renderer.RenderType.Batch
+		)
+		GafferSceneTest.outputScene( benchmark.scene(), renderer )
+
+		self.assertIsNotNone( renderer.capturedObject( "/group/camera" ) )
+		self.assertIsNotNone( renderer.capturedObject( "/group/light" ) )
+
+		sphere = renderer.capturedObject( "/group/plane/instances/sphere/1" )
+		self.assertIsNotNone( sphere )
+		self.assertEqual( sphere.capturedAttributes().attributes()["sets"], IECore.InternedStringVectorData( [ "set1" ] ) )
+
+	def testInvalidShape( self ) :
+
+		with self.assertRaisesRegex( ValueError, "Unknown shape" ) :
+			GafferSceneTest.SceneTranslationBenchmark( "notAShape" )
+
+	def __testRenderControllerPerformance( self, shape, size ) :
+
+		benchmark = GafferSceneTest.SceneTranslationBenchmark( shape, size )
+		renderer = GafferScene.Private.IECoreScenePreview.CapturingRenderer()
+		controller = GafferScene.RenderController( benchmark.scene(), Gaffer.Context(), renderer )
+		controller.setMinimumExpansionDepth( sys.maxsize )
+
+		with GafferTest.TestRunner.PerformanceScope() :
+			controller.update()
+
+	@GafferTest.TestRunner.PerformanceTestMethod()
+	def testWidePerformance( self ) :
+
+		self.__testRenderControllerPerformance( "wide", 100000 )
+
+	@GafferTest.TestRunner.PerformanceTestMethod()
+	def testDeepPerformance( self ) :
+
+		self.__testRenderControllerPerformance( "deep", 100000 )
+
+	@GafferTest.TestRunner.PerformanceTestMethod()
+	def testInstancedPerformance( self ) :
+
+		self.__testRenderControllerPerformance( "instanced", 100000 )
+
+	@GafferTest.TestRunner.PerformanceTestMethod()
+	def testCompactPerformance( self ) :
+
+		self.__testRenderControllerPerformance( "compact", 100000 )
+
+	@GafferTest.TestRunner.PerformanceTestMethod()
+	def testSetsPerformance( self ) :
+
+		self.__testRenderControllerPerformance( "sets", 100000 )
+
+	@GafferTest.TestRunner.PerformanceTestMethod()
+	def testAttributesPerformance( self ) :
+
+		self.__testRenderControllerPerformance( "attributes", 100000 )
+
+if __name__ == "__main__":
+	unittest.main()
@@ -413,5 +413,134 @@ class SceneWriterTest( GafferSceneTest.SceneTestCase ) :
 		reader["fileName"].setInput( writer["fileName"] )
 		self.assertScenesEqual( reader["out"], writer["in"] )
 
+	def __animatedScene( self, copies = 20 ) :
+
+		script = Gaffer.ScriptNode()
+
+		script["sphere"] = GafferScene.Sphere()
+		script["sphere"]["sets"].setValue( "spheres" )
+
+		script["sphereFilter"] = GafferScene.PathFilter()
+		script["sphereFilter"]["paths"].setValue( IECore.StringVectorData( [ "/sphere" ] ) )
+
+		script["duplicate"] = GafferScene.Duplicate()
+		script["duplicate"]["in"].setInput( script["sphere"]["out"] )
+		script["duplicate"]["filter"].setInput( script["sphereFilter"]["out"] )
+		script["duplicate"]["copies"].setValue( copies )
+
+		script["group"] = GafferScene.Group()
+		script["group"]["in"][0].setInput( script["duplicate"]["out"] )
+
+		script["expression"] = Gaffer.Expression()
+		script["expression"].setExpression( inspect.cleandoc(
+			"""
+			parent["duplicate"]["transform"]["translate"]["x"] = context.getFrame()
+			parent["group"]["transform"]["rotate"]["y"] = context.getFrame() * 10
+			parent["sphere"]["radius"] = 1 + context.getFrame() * 0.1
+			"""
+		) )
+
+		script["writer"] = GafferScene.SceneWriter()
+		script["writer"]["in"].setInput( script["group"]["out"] )
+
+		return script
+
+	def testConcurrentFramesMatchesSerial( self ) :
+
+		script = self.__animatedScene()
+		frames = [ 1, 1.5, 2, 3, 4, 5, 6, 7, 8, 9, 10 ]
+
+		serialFileName = os.path.join( self.temporaryDirectory(), "serial.scc" )
+		script["writer"]["fileName"].setValue( serialFileName )
+		with Gaffer.Context() :
+			script["writer"]["task"].executeSequence( frames )
+
+		concurrentFileName = os.path.join( self.temporaryDirectory(), "concurrent.scc" )
+		script["writer"]["fileName"].setValue( concurrentFileName )
+		script["writer"]["concurrentFrames"].setValue( 4 )
+		with Gaffer.Context() :
+			script["writer"]["task"].executeSequence( frames )
+
+		serialReader = GafferScene.SceneReader()
+		serialReader["fileName"].setValue( serialFileName )
+
+		concurrentReader = GafferScene.SceneReader()
+		concurrentReader["fileName"].setValue( concurrentFileName )
+
+		with Gaffer.Context() as context :
+			for frame in frames :
+				context.setFrame( frame )
+				self.assertScenesEqual( concurrentReader["out"], serialReader["out"] )
+
+		serialScene = IECoreScene.SceneCache( serialFileName, IECore.IndexedIO.OpenMode.Read )
+		concurrentScene = IECoreScene.SceneCache( concurrentFileName, IECore.IndexedIO.OpenMode.Read )
+		self.assertEqual( concurrentScene.child( "group" ).childNames(), serialScene.child( "group" ).childNames() )
+		for name in serialScene.child( "group" ).childNames() :
+			serialChild = serialScene.child( "group" ).child( name )
+			concurrentChild = concurrentScene.child( "group" ).child( name )
+			self.assertEqual( concurrentChild.numTransformSamples(), len( frames ) )
+			self.assertEqual(
+				[ concurrentChild.transformSampleTime( i ) for i in range( 0, len( frames ) ) ],
+				[ serialChild.transformSampleTime( i ) for i in range( 0, len( frames ) ) ],
+			)
+
+	def testConcurrentFramesWithFrameDependentFileName( self ) :
+
+		script = self.__animatedScene( copies = 2 )
+		script["writer"]["fileName"].setValue( os.path.join( self.temporaryDirectory(), "test.####.scc" ) )
+		script["writer"]["concurrentFrames"].setValue( 4 )
+
+		with Gaffer.Context() as context :
+			script["writer"]["task"].executeSequence( [ 1, 2, 3, 4, 5 ] )
+			for frame in range( 1, 6 ) :
+				context.setFrame( frame )
+				scene = IECoreScene.SceneInterface.create(
+					context.substitute( script["writer"]["fileName"].getValue() ),
+					IECore.IndexedIO.OpenMode.Read
+				)
+				sphere = scene.scene( [ "group", "sphere1" ] )
+				self.assertEqual( sphere.numObjectSamples(), 1 )
+				self.assertEqual( sphere.objectSampleTime( 0 ), context.getTime() )
+
+	def testConcurrentFramesComputeError( self ) :
+
+		script = self.__animatedScene( copies = 2 )
+		script["writer"]["fileName"].setValue( os.path.join( self.temporaryDirectory(), "test.scc" ) )
+		script["writer"]["concurrentFrames"].setValue( 4 )
+
+		script["errorExpression"] = Gaffer.Expression()
+		script["errorExpression"].setExpression( inspect.cleandoc(
+			"""
+			if context.getFrame() == 5 :
+				raise Exception( "Frame 5 is broken" )
+			parent["sphere"]["name"] = "sphere"
+			"""
+		) )
+
+		with Gaffer.Context() :
+			with self.assertRaisesRegex( Exception, "Frame 5 is broken" ) :
+				script["writer"]["task"].executeSequence( list( range( 1, 10 ) ) )
+
+	def __writeSequencePerformance( self, concurrentFrames ) :
+
+		script = self.__animatedScene( copies = 200 )
+		script["sphere"]["divisions"].setValue( imath.V2i( 200, 400 ) )
+		script["writer"]["fileName"].setValue( os.path.join( self.temporaryDirectory(), "test.scc" ) )
+		script["writer"]["concurrentFrames"].setValue( concurrentFrames )
+
+		with Gaffer.Context() :
+			with GafferTest.TestRunner.PerformanceScope() :
+				script["writer"]["task"].executeSequence( list( range( 1, 25 ) ) )
+
+	@GafferTest.TestRunner.PerformanceTestMethod()
+	def testSequenceWritePerformance( self ) :
+
+		self.__writeSequencePerformance( concurrentFrames = 1 )
+
+	@GafferTest.TestRunner.PerformanceTestMethod()
+	def testConcurrentSequenceWritePerformance( self ) :
+
+		self.__writeSequencePerformance( concurrentFrames = 8 )
+
 if __name__ == "__main__":
 	unittest.main()
@@ -36,11 +36,13 @@
 
 import re
 import functools
+import unittest
 import six
 
 import IECore
 
 import Gaffer
+import GafferTest
 import GafferScene
 import GafferSceneTest
 
@@ -312,6 +314,107 @@ class SetAlgoTest( GafferSceneTest.SceneTestCase ) :
 
 		self.assertFalse( GafferScene.SetAlgo.affectsSetExpression( Gaffer.IntPlug() ) )
 
+	def __largeSetsScene( self, numSets, numTopLevelLocations, numPathsPerLocation ) :
+
+		# Sets are spread over many top-level locations, so that
+		# operations are parallelised over those branches. Each
+		# set contains every `i`th path, so the sets overlap.
+
+		script = Gaffer.ScriptNode()
+		script["sphere"] = GafferScene.Sphere()
+		upstream = script["sphere"]["out"]
+		for i in range( 1, numSets + 1 ) :
+			paths = [
+				"/group{0}/child{1}".format( t, p )
+				for t in range( 0, numTopLevelLocations )
+				for p in range( 0, numPathsPerLocation, i )
+			]
+			setNode = GafferScene.Set( "Set{}".format( i ) )
+			setNode["name"].setValue( "set{}".format( i ) )
+			setNode["paths"].setValue( IECore.StringVectorData( paths ) )
+			setNode["in"].setInput( upstream )
+			script.addChild( setNode )
+			upstream = setNode["out"]
+
+		return script, upstream
+
+	def testManyTopLevelLocations( self ) :
+
+		script, scene = self.__largeSetsScene( numSets = 3, numTopLevelLocations = 20, numPathsPerLocation = 12 )
+
+		set1 = scene.set( "set1" ).value
+		set2 = scene.set( "set2" ).value
+		set3 = scene.set( "set3" ).value
+
+		union = IECore.PathMatcher( set2 )
+		union.addPaths( set3 )
+		self.assertEqual( GafferScene.SetAlgo.evaluateSetExpression( "set2 | set3", scene ), union )
+		self.assertEqual( GafferScene.SetAlgo.evaluateSetExpression( "set2 & set3", scene ), set2.intersection( set3 ) )
+
+		difference = IECore.PathMatcher( set1 )
+		difference.removePaths( set2 )
+		self.assertEqual( GafferScene.SetAlgo.evaluateSetExpression( "set1 - set2", scene ), difference )
+
+		# Shared subexpressions.
+		difference.removePaths( union )
+		self.assertEqual( GafferScene.SetAlgo.evaluateSetExpression( "set1 - set2 - (set2 | set3)", scene ), difference )
+
+		# Mixing object names from a single branch with sets from many.
+		self.assertEqual(
+			set( GafferScene.SetAlgo.evaluateSetExpression( "set1 & /group3/child1", scene ).paths() ),
+			{ "/group3/child1" }
+		)
+		self.assertEqual(
+			GafferScene.SetAlgo.evaluateSetExpression( "set3 in /group3", scene ),
+			set3.intersection( IECore.PathMatcher( [ "/group3/child{}".format( p ) for p in range( 0, 12 ) ] ) )
+		)
+		self.assertEqual(
+			set( GafferScene.SetAlgo.evaluateSetExpression( "(/group1 /group2 /group3) containing set3", scene ).paths() ),
+			{ "/group1", "/group2", "/group3" }
+		)
+		self.assertEqual( GafferScene.SetAlgo.evaluateSetExpression( "/ containing set3", scene ), IECore.PathMatcher( [ "/" ] ) )
+		self.assertEqual( GafferScene.SetAlgo.evaluateSetExpression( "set1 in /", scene ), set1 )
+		self.assertEqual( set( GafferScene.SetAlgo.evaluateSetExpression( "/ | set1", scene ).paths() ), set( [ "/" ] + set1.paths() ) )
+
+	def testCachedResultsUpdate( self ) :
+
+		script, scene = self.__largeSetsScene( numSets = 2, numTopLevelLocations = 4, numPathsPerLocation = 4 )
+
+		expectedPaths = [ "/group{}/child0".format( t ) for t in range( 0, 4 ) ]
+		self.assertCorrectEvaluation( scene, "set1 & ( set2 - /group0/child2 )", [ "/group{}/child{}".format( t, p ) for t in range( 0, 4 ) for p in ( 0, 2 ) if ( t, p ) != ( 0, 2 ) ] )
+		h = GafferScene.SetAlgo.setExpressionHash( "set1 & ( set2 - /group0/child2 )", scene )
+
+		script["Set2"]["paths"].setValue( IECore.StringVectorData( expectedPaths ) )
+		self.assertNotEqual( GafferScene.SetAlgo.setExpressionHash( "set1 & ( set2 - /group0/child2 )", scene ), h )
+		self.assertCorrectEvaluation( scene, "set1 & ( set2 - /group0/child2 )", expectedPaths )
+
+	def testCacheMemoryLimit( self ) :
+
+		originalLimit = GafferScene.SetAlgo.getCacheMemoryLimit()
+		self.addCleanup( GafferScene.SetAlgo.setCacheMemoryLimit, originalLimit )
+
+		GafferScene.SetAlgo.setCacheMemoryLimit( 1024 * 1024 )
+		self.assertEqual( GafferScene.SetAlgo.getCacheMemoryLimit(), 1024 * 1024 )
+
+		# Results must still be correct when nothing can be cached.
+
+		GafferScene.SetAlgo.setCacheMemoryLimit( 0 )
+		self.assertEqual( GafferScene.SetAlgo.getCacheMemoryLimit(), 0 )
+
+		script, scene = self.__largeSetsScene( numSets = 2, numTopLevelLocations = 4, numPathsPerLocation = 4 )
+		self.assertCorrectEvaluation( scene, "set1 & ( set2 - /group0/child2 )", [ "/group{}/child{}".format( t, p ) for t in range( 0, 4 ) for p in ( 0, 2 ) if ( t, p ) != ( 0, 2 ) ] )
+
+	@GafferTest.TestRunner.PerformanceTestMethod()
+	def testEvaluationPerformance( self ) :
+
+		script, scene = self.__largeSetsScene( numSets = 10, numTopLevelLocations = 100, numPathsPerLocation = 10000 )
+		for i in range( 1, 11 ) :
+			scene.set( "set{}".format( i ) )
+
+		expression = "( set1 - set2 ) | ( set3 & ( set4 | set5 ) ) | ( set6 - ( set7 set8 ) ) | ( ( set4 | set5 ) - set9 ) | ( set10 in /group0 )"
+		with GafferTest.TestRunner.PerformanceScope() :
+			GafferScene.SetAlgo.evaluateSetExpression( expression, scene )
+
 	def assertCorrectEvaluation( self, scenePlug, expression, expectedContents ) :
 
 		result = set( GafferScene.SetAlgo.evaluateSetExpression( expression, scenePlug ).paths() )
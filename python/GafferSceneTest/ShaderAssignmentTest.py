@@ -657,5 +657,108 @@ class ShaderAssignmentTest( GafferSceneTest.SceneTestCase ) :
 		self.assertEqual( output.name, "shader1" )
 		self.assertEqual( output.blindData()["label"], IECore.StringData( "glass" ) )
 
+	def testIdenticalAttributesAreShared( self ) :
+
+		shader = GafferSceneTest.TestShader()
+		shader["type"].setValue( "test:surface" )
+
+		plane = GafferScene.Plane()
+		sphere = GafferScene.Sphere()
+
+		group = GafferScene.Group()
+		group["in"][0].setInput( plane["out"] )
+		group["in"][1].setInput( sphere["out"] )
+
+		groupFilter = GafferScene.PathFilter()
+		groupFilter["paths"].setValue( IECore.StringVectorData( [ "/group/plane", "/group/sphere" ] ) )
+
+		assignment = GafferScene.ShaderAssignment()
+		assignment["in"].setInput( group["out"] )
+		assignment["filter"].setInput( groupFilter["out"] )
+		assignment["shader"].setInput( shader["out"] )
+		# Label overrides require the shader to be copied per location.
+		assignment["label"].setValue( "glass" )
+
+		planeAttributes = assignment["out"].attributes( "/group/plane", _copy = False )
+		sphereAttributes = assignment["out"].attributes( "/group/sphere", _copy = False )
+		self.assertEqual( planeAttributes, sphereAttributes )
+		self.assertTrue( planeAttributes.isSame( sphereAttributes ) )
+		self.assertTrue( planeAttributes["test:surface"].isSame( sphereAttributes["test:surface"] ) )
+
+		# Identical attributes reached through differing upstream hashes
+		# should also be shared.
+
+		planeFilter = GafferScene.PathFilter()
+		planeFilter["paths"].setValue( IECore.StringVectorData( [ "/group/plane" ] ) )
+
+		planeCustomAttributes = GafferScene.CustomAttributes()
+		planeCustomAttributes["in"].setInput( group["out"] )
+		planeCustomAttributes["filter"].setInput( planeFilter["out"] )
+		planeCustomAttributes["attributes"].addChild( Gaffer.NameValuePlug( "user:a", 2 ) )
+
+		allAttributes = GafferScene.CustomAttributes()
+		allAttributes["in"].setInput( planeCustomAttributes["out"] )
+		allAttributes["filter"].setInput( groupFilter["out"] )
+		allAttributes["attributes"].addChild( Gaffer.NameValuePlug( "user:a", 1 ) )
+
+		assignment["in"].setInput( allAttributes["out"] )
+
+		self.assertNotEqual(
+			assignment["out"].attributesHash( "/group/plane" ),
+			assignment["out"].attributesHash( "/group/sphere" )
+		)
+
+		planeAttributes = assignment["out"].attributes( "/group/plane", _copy = False )
+		sphereAttributes = assignment["out"].attributes( "/group/sphere", _copy = False )
+		self.assertEqual( planeAttributes["user:a"], IECore.IntData( 1 ) )
+		self.assertEqual( planeAttributes, sphereAttributes )
+		self.assertTrue( planeAttributes.isSame( sphereAttributes ) )
+
+		# Differing attributes must not be shared, but the shader network
+		# they have in common still can be.
+
+		customAttributes = GafferScene.CustomAttributes()
+		customAttributes["in"].setInput( group["out"] )
+		customAttributes["filter"].setInput( groupFilter["out"] )
+		customAttributes["attributes"].addChild( Gaffer.NameValuePlug( "user:name", "${scene:path}" ) )
+
+		assignment["in"].setInput( customAttributes["out"] )
+
+		GafferScene.Private.AttributeInterning.resetStatistics()
+
+		planeAttributes = assignment["out"].attributes( "/group/plane", _copy = False )
+		sphereAttributes = assignment["out"].attributes( "/group/sphere", _copy = False )
+		self.assertEqual( planeAttributes["user:name"], IECore.StringData( "/group/plane" ) )
+		self.assertEqual( sphereAttributes["user:name"], IECore.StringData( "/group/sphere" ) )
+		self.assertFalse( planeAttributes.isSame( sphereAttributes ) )
+		self.assertTrue( planeAttributes["test:surface"].isSame( sphereAttributes["test:surface"] ) )
+
+		statistics = GafferScene.Private.AttributeInterning.statistics()
+		self.assertGreaterEqual( statistics.sharedObjects, 1 )
+		self.assertGreater( statistics.memorySaved, 0 )
+
+		# Clearing the compute cache should release the shared instances.
+
+		Gaffer.ValuePlug.clearCache()
+		GafferScene.Private.AttributeInterning.resetStatistics()
+		assignment["out"].attributes( "/group/plane" )
+		self.assertEqual( GafferScene.Private.AttributeInterning.statistics().sharedObjects, 0 )
+
+		# Nothing is shared when the memory limit is zero.
+
+		originalLimit = GafferScene.Private.AttributeInterning.getMemoryLimit()
+		self.addCleanup( GafferScene.Private.AttributeInterning.setMemoryLimit, originalLimit )
+		GafferScene.Private.AttributeInterning.setMemoryLimit( 0 )
+		self.assertEqual( GafferScene.Private.AttributeInterning.getMemoryLimit(), 0 )
+
+		Gaffer.ValuePlug.clearCache()
+		GafferScene.Private.AttributeInterning.resetStatistics()
+		assignment["in"].setInput( allAttributes["out"] )
+		planeAttributes = assignment["out"].attributes( "/group/plane", _copy = False )
+		sphereAttributes = assignment["out"].attributes( "/group/sphere", _copy = False )
+		self.assertEqual( planeAttributes, sphereAttributes )
+		self.assertFalse( planeAttributes.isSame( sphereAttributes ) )
+		self.assertEqual( GafferScene.Private.AttributeInterning.statistics().sharedObjects, 0 )
+
 if __name__ == "__main__":
 	unittest.main()
@@ -475,6 +475,62 @@ class ShaderQueryTest( GafferSceneTest.SceneTestCase ):
 		self.assertIsNone( scriptNode["target"]["parameters"]["b1"].getInput() )
 		self.assertEqual( str( scriptNode["target"]["parameters"]["b2"].getInput() ), str( q["out"][1]["exists"] ) )
 
+	def testLocations( self ) :
+
+		sphere = GafferScene.Sphere()
+
+		group = GafferScene.Group()
+		group["in"][0].setInput( sphere["out"] )
+		group["in"][1].setInput( sphere["out"] )
+
+		pathFilter = GafferScene.PathFilter()
+		pathFilter["paths"].setValue( IECore.StringVectorData( [ "/group", "/group/sphere1" ] ) )
+
+		shader = GafferSceneTest.TestShader( "surface" )
+		shader["type"].setValue( "test:surface" )
+		shader["parameters"]["i"].setValue( 10 )
+
+		assignment = GafferScene.ShaderAssignment()
+		assignment["in"].setInput( group["out"] )
+		assignment["filter"].setInput( pathFilter["out"] )
+		assignment["shader"].setInput( shader["out"] )
+
+		locations = [ "/group/sphere", "/group/sphere1", "", "/iDontExist", "/", "/group" ]
+
+		query = GafferScene.ShaderQuery()
+		query["scene"].setInput( assignment["out"] )
+		query["shader"].setValue( "test:surface" )
+		query["locations"].setValue( IECore.StringVectorData( locations ) )
+		query.addQuery( Gaffer.IntPlug( defaultValue = 1 ), "i" )
+		query.addQuery( Gaffer.IntPlug( defaultValue = 1 ), "missing" )
+
+		self.assertEqual( query.existsVectorPlugFromQuery( query["queries"][0] ), query["out"][0]["existsVector"] )
+		self.assertEqual( query.valueVectorPlugFromQuery( query["queries"][0] ), query["out"][0]["valueVector"] )
+
+		for inherit in ( False, True ) :
+			query["inherit"].setValue( inherit )
+
+			for out in query["out"].children() :
+				expectedExists = IECore.BoolVectorData()
+				expectedValue = IECore.ObjectVector()
+				for location in locations :
+					query["location"].setValue( location )
+					expectedExists.append( out["exists"].getValue() )
+					expectedValue.append( IECore.IntData( out["value"].getValue() ) if out["exists"].getValue() else IECore.NullObject() )
+
+				self.assertEqual( out["existsVector"].getValue(), expectedExists )
+				self.assertEqual( out["valueVector"].getValue(), expectedValue )
+
+			self.assertEqual(
+				query["out"][0]["existsVector"].getValue(),
+				IECore.BoolVectorData( [ inherit, True, False, False, False, True ] )
+			)
+			self.assertEqual( query["out"][1]["existsVector"].getValue(), IECore.BoolVectorData( [ False ] * len( locations ) ) )
+
+		# Changing the parameter name must update the vector outputs.
+
+		query["queries"][1]["name"].setValue( "i" )
+		self.assertEqual( query["out"][1]["existsVector"].getValue(), query["out"][0]["existsVector"].getValue() )
 
 if __name__ == "__main__":
 	unittest.main()
@@ -40,6 +40,7 @@ import imath
 import IECore
 
 import Gaffer
+import GafferTest
 import GafferScene
 import GafferSceneTest
 
@@ -650,5 +651,62 @@ class TransformQueryTest( GafferSceneTest.SceneTestCase ):
 		imath.M44f.extractScaling( m, s )
 		self.assertTrue( tq["scale"].getValue().equalWithAbsError( s, 0.000001 ) )
 
+	def testLocations( self ):
+
+		sphere = GafferScene.Sphere()
+		sphere["transform"]["translate"].setValue( imath.V3f( 1, 2, 3 ) )
+		sphere["transform"]["scale"].setValue( imath.V3f( 2, 2, 2 ) )
+
+		group = GafferScene.Group()
+		group["in"][0].setInput( sphere["out"] )
+		group["transform"]["rotate"].setValue( imath.V3f( 0, 90, 0 ) )
+
+		locations = [ "/group/sphere", "/group", "", "/iDontExist", "/", "/group/sphere" ]
+
+		query = GafferScene.TransformQuery()
+		query["scene"].setInput( group["out"] )
+		query["locations"].setValue( IECore.StringVectorData( locations ) )
+		query["relativeLocation"].setValue( "/group" )
+
+		for space in GafferScene.TransformQuery.Space.values.values() :
+			query["space"].setValue( space )
+			for invert in ( False, True ) :
+				query["invert"].setValue( invert )
+
+				expected = IECore.M44fVectorData()
+				for location in locations :
+					query["location"].setValue( location )
+					expected.append( query["matrix"].getValue() )
+
+				self.assertEqual( query["matrixVector"].getValue(), expected )
+
+	@GafferTest.TestRunner.PerformanceTestMethod()
+	def testLocationsPerformance( self ):
+
+		sphere = GafferScene.Sphere()
+
+		duplicate = GafferScene.Duplicate()
+		duplicate["in"].setInput( sphere["out"] )
+		duplicate["target"].setValue( "/sphere" )
+		duplicate["copies"].setValue( 100000 )
+		duplicate["transform"]["translate"].setValue( imath.V3f( 1, 0, 0 ) )
+
+		pathFilter = GafferScene.PathFilter()
+		pathFilter["paths"].setValue( IECore.StringVectorData( [ "/*" ] ) )
+
+		filterResults = GafferScene.FilterResults()
+		filterResults["scene"].setInput( duplicate["out"] )
+		filterResults["filter"].setInput( pathFilter["out"] )
+
+		query = GafferScene.TransformQuery()
+		query["scene"].setInput( duplicate["out"] )
+		query["locations"].setInput( filterResults["outStrings"] )
+		query["space"].setValue( GafferScene.TransformQuery.Space.World )
+
+		filterResults["outStrings"].getValue()
+
+		with GafferTest.TestRunner.PerformanceScope() :
+			query["matrixVector"].getValue()
+
 if __name__ == "__main__":
 	unittest.main()
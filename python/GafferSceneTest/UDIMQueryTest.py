@@ -174,6 +174,71 @@ class UDIMQueryTest( GafferSceneTest.SceneTestCase ) :
 		self.assertNotEqual( initialHash, udimQuery["out"].hash() )
 		self.assertEqual( dictResult(), {'1001': {'/test': {}}} )
 
+	def testOnlyChangedLocationsRescanned( self ) :
+
+		planes = []
+		group = GafferScene.Group()
+		for i in range( 0, 3 ) :
+			plane = GafferScene.Plane()
+			plane["divisions"].setValue( imath.V2i( 10 + i ) )
+			plane["transform"]["translate"]["x"].setValue( i )
+			group["in"][i].setInput( plane["out"] )
+			planes.append( plane )
+
+		allFilter = GafferScene.PathFilter()
+		allFilter["paths"].setValue( IECore.StringVectorData( [ '/...' ] ) )
+
+		udimQuery = GafferScene.UDIMQuery()
+		udimQuery["in"].setInput( group["out"] )
+		udimQuery["filter"].setInput( allFilter["out"] )
+
+		with Gaffer.PerformanceMonitor() as monitor :
+			udimQuery["out"].getValue()
+
+		# One scan per location, including the group and the root,
+		# which don't have meshes.
+		self.assertEqual( monitor.plugStatistics( udimQuery["__udims"] ).computeCount, 5 )
+
+		# Moving a plane doesn't change its object, so nothing
+		# needs rescanning.
+
+		planes[0]["transform"]["translate"]["y"].setValue( 1 )
+		with Gaffer.PerformanceMonitor() as monitor :
+			result = udimQuery["out"].getValue()
+
+		self.assertEqual( monitor.plugStatistics( udimQuery["__udims"] ).computeCount, 0 )
+		self.assertEqual( set( result["1001"].keys() ), { "/group/plane", "/group/plane1", "/group/plane2" } )
+
+		# Changing a single object should only rescan that object.
+
+		planes[1]["divisions"].setValue( imath.V2i( 20 ) )
+		with Gaffer.PerformanceMonitor() as monitor :
+			result = udimQuery["out"].getValue()
+
+		self.assertEqual( monitor.plugStatistics( udimQuery["__udims"] ).computeCount, 1 )
+		self.assertEqual( set( result.keys() ), { "1001" } )
+		self.assertEqual( set( result["1001"].keys() ), { "/group/plane", "/group/plane1", "/group/plane2" } )
+
+	@GafferTest.TestRunner.PerformanceTestMethod( repeat = 1 )
+	def testDenseMeshPerformance( self ) :
+
+		plane = GafferScene.Plane()
+		plane["divisions"].setValue( imath.V2i( 2000 ) )
+
+		allFilter = GafferScene.PathFilter()
+		allFilter["paths"].setValue( IECore.StringVectorData( [ '/...' ] ) )
+
+		udimQuery = GafferScene.UDIMQuery()
+		udimQuery["in"].setInput( plane["out"] )
+		udimQuery["filter"].setInput( allFilter["out"] )
+
+		udimQuery["in"]["object"].getValue()
+
+		with GafferTest.TestRunner.PerformanceScope() :
+			result = udimQuery["out"].getValue()
+
+		self.assertEqual( set( result.keys() ), { "1001" } )
+
 	@GafferTest.TestRunner.PerformanceTestMethod( repeat = 1)
 	def testCollaboratePerf( self ) :
 
@@ -43,6 +43,7 @@ import IECore
 import IECoreScene
 
 import Gaffer
+import GafferTest
 import GafferScene
 import GafferSceneTest
 
@@ -172,5 +173,59 @@ class WireframeTest( GafferSceneTest.SceneTestCase ) :
 		self.assertScenesEqual( wireframe["in"], wireframe["out"], checks = { "bound" } )
 		self.assertSceneHashesEqual( wireframe["in"], wireframe["out"], checks = { "bound" } )
 
+	def testMatchesSerialImplementation( self ) :
+
+		sphere = GafferScene.Sphere()
+		sphere["divisions"].setValue( imath.V2i( 37, 61 ) )
+
+		filter = GafferScene.PathFilter()
+		filter["paths"].setValue( IECore.StringVectorData( [ "/sphere" ] ) )
+
+		wireframe = GafferScene.Wireframe()
+		wireframe["in"].setInput( sphere["out"] )
+		wireframe["filter"].setInput( filter["out"] )
+
+		# Edges should be output once each, in the order in which
+		# they are first visited.
+
+		mesh = sphere["out"].object( "/sphere" )
+		vertexIds = mesh.vertexIds
+		p = mesh["P"].data
+
+		expectedP = []
+		visited = set()
+		offset = 0
+		for numVertices in mesh.verticesPerFace :
+			for i in range( 0, numVertices ) :
+				index0 = vertexIds[offset + i]
+				index1 = vertexIds[offset + ( i + 1 ) % numVertices]
+				edge = ( min( index0, index1 ), max( index0, index1 ) )
+				if edge not in visited :
+					visited.add( edge )
+					expectedP.extend( [ p[index0], p[index1] ] )
+			offset += numVertices
+
+		curves = wireframe["out"].object( "/sphere" )
+		self.assertEqual( list( curves["P"].data ), expectedP )
+		self.assertEqual( curves.verticesPerCurve(), IECore.IntVectorData( [ 2 ] * len( visited ) ) )
+
+	@GafferTest.TestRunner.PerformanceTestMethod()
+	def testPerformance( self ) :
+
+		plane = GafferScene.Plane()
+		plane["divisions"].setValue( imath.V2i( 1000 ) )
+
+		filter = GafferScene.PathFilter()
+		filter["paths"].setValue( IECore.StringVectorData( [ "/plane" ] ) )
+
+		wireframe = GafferScene.Wireframe()
+		wireframe["in"].setInput( plane["out"] )
+		wireframe["filter"].setInput( filter["out"] )
+
+		wireframe["in"].object( "/plane" )
+
+		with GafferTest.TestRunner.PerformanceScope() :
+			wireframe["out"].object( "/plane" )
+
 if __name__ == "__main__":
 	unittest.main()
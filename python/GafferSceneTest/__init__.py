@@ -40,6 +40,7 @@ import GafferScene
 from ._GafferSceneTest import *
 
 from .SceneTestCase import SceneTestCase
+from .SceneTranslationBenchmark import SceneTranslationBenchmark
 from .ScenePlugTest import ScenePlugTest
 from .GroupTest import GroupTest
 from .SceneTimeWarpTest import SceneTimeWarpTest
@@ -160,6 +161,8 @@ from .NameSwitchTest import NameSwitchTest
 from .CryptomatteTest import CryptomatteTest
 from .ShaderQueryTest import ShaderQueryTest
 from .AttributeTweaksTest import AttributeTweaksTest
+from .SceneTranslationBenchmarkTest import SceneTranslationBenchmarkTest
+from .ChildNamesMapTest import ChildNamesMapTest
 
 from .IECoreScenePreviewTest import *
 from .IECoreGLPreviewTest import *
@@ -148,6 +148,19 @@ Gaffer.Metadata.registerNode(
 
 		],
 
+		"locations" : [
+
+			"description",
+			"""
+			A list of locations to query the attribute for in a single batch,
+			outputting the results to the "Vector" outputs. This is much
+			more efficient than using a separate query per location, and
+			can be connected to `FilterResults.outStrings` to query all
+			the locations matched by a filter.
+			"""
+
+		],
+
 		"exists" : [
 
 			"description",
@@ -170,5 +183,30 @@ Gaffer.Metadata.registerNode(
 
 		],
 
+		"existsVector" : [
+
+			"description",
+			"""
+			Outputs true for each of the locations where the attribute exists,
+			otherwise false.
+			""",
+
+			"layout:section", "Settings.Outputs"
+
+		],
+
+		"valueVector" : [
+
+			"description",
+			"""
+			Outputs the value of the attribute for each of the locations, or
+			a NullObject where it does not exist. The default value is not used.
+			""",
+
+			"layout:section", "Settings.Outputs",
+			"plugValueWidget:type", ""
+
+		],
+
 	}
 )
@@ -105,6 +105,19 @@ Gaffer.Metadata.registerNode(
 
 		],
 
+		"locations" : [
+
+			"description",
+			"""
+			A list of locations to query the bound for in a single batch,
+			outputting the results to the "Vector" outputs. This is much
+			more efficient than using a separate query per location, and
+			can be connected to `FilterResults.outStrings` to query all
+			the locations matched by a filter.
+			"""
+
+		],
+
 		"bound" : [
 
 			"description",
@@ -137,5 +150,27 @@ Gaffer.Metadata.registerNode(
 			"layout:section", "Settings.Outputs"
 
 		],
+
+		"centerVector" : [
+
+			"description",
+			"""
+			Center point of the requested bound for each of the locations.
+			""",
+
+			"layout:section", "Settings.Outputs"
+
+		],
+
+		"sizeVector" : [
+
+			"description",
+			"""
+			Size of the requested bound for each of the locations.
+			""",
+
+			"layout:section", "Settings.Outputs"
+
+		],
 	}
 )
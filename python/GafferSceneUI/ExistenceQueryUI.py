@@ -70,6 +70,19 @@ Gaffer.Metadata.registerNode(
 
 		],
 
+		"locations" : [
+
+			"description",
+			"""
+			A list of locations to query existence for in a single batch,
+			outputting the results to the "Vector" outputs. This is much
+			more efficient than using a separate query per location, and
+			can be connected to `FilterResults.outStrings` to query all
+			the locations matched by a filter.
+			"""
+
+		],
+
 		"exists" : [
 
 			"description",
@@ -81,6 +94,17 @@ Gaffer.Metadata.registerNode(
 
 		],
 
+		"existsVector" : [
+
+			"description",
+			"""
+			Outputs true for each of the locations that exists, otherwise false.
+			""",
+
+			"layout:section", "Settings.Outputs"
+
+		],
+
 		"closestAncestor" : [
 
 			"description",
@@ -352,6 +352,7 @@ Gaffer.Metadata.registerNode(
 	"layout:activator:modeIsNotIndexedRootsList", lambda node : node["prototypeMode"].getValue() != GafferScene.Instancer.PrototypeMode.IndexedRootsList,
 	"layout:activator:modeIsNotRootPerVertex", lambda node : node["prototypeMode"].getValue() != GafferScene.Instancer.PrototypeMode.RootPerVertex,
 	"layout:activator:seedEnabled", lambda node : node["seedEnabled"].getValue(),
+	"layout:activator:encapsulateInstanceGroups", lambda node : node["encapsulateInstanceGroups"].getValue(),
 	"layout:activator:seedParameters", lambda node : not node["rawSeed"].getValue(),
 
 	"layout:customWidget:seedColumnHeadings:widgetType", "GafferSceneUI.InstancerUI._SeedColumnHeadings",
@@ -644,6 +645,30 @@ Gaffer.Metadata.registerNode(
 
 		],
 
+		"compactInstanceGroups" : [
+
+			"description",
+			"""
+			Represents each encapsulated group of instances as a compact
+			instance array, rather than as a capsule containing a location
+			per instance. The array stores just the packed transforms and
+			attributes for the instances, and the prototype is evaluated only
+			once at render time, with the renderer instancing the resulting
+			objects natively. This can substantially reduce scene generation
+			time and memory usage for large numbers of instances.
+
+			> Note : Instancers using context variations always fall back to
+			> regular capsules. Instance transforms are not motion blurred,
+			> and per-instance attributes take precedence over any attributes
+			> authored inside the prototypes.
+			""",
+			"label", "Compact",
+
+			"layout:section", "Settings.Encapsulation",
+			"layout:activator", "encapsulateInstanceGroups",
+
+		],
+
 		"seedEnabled" : [
 			"description",
 			"""
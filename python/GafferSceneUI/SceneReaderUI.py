@@ -114,6 +114,19 @@ Gaffer.Metadata.registerNode(
 
 		],
 
+		"prefetch" : [
+
+			"description",
+			"""
+			Reads the bounds, transforms and objects of child
+			locations in the background, as soon as the names of
+			the children are known. This hides the latency of
+			each individual read, and can greatly improve
+			performance when loading files from network storage.
+			""",
+
+		],
+
 	}
 
 )
@@ -92,6 +92,21 @@ Gaffer.Metadata.registerNode(
 
 		],
 
+		"concurrentFrames" : [
+
+			"description",
+			"""
+			The number of frames to compute concurrently when writing
+			a sequence. With a value greater than one, several frames
+			are computed in parallel while already computed locations
+			are written to the file, so that computation and file
+			writing overlap. This can greatly reduce the time taken
+			to write long sequences, at the expense of additional
+			memory usage.
+			""",
+
+		],
+
 	}
 
 )
@@ -231,6 +231,21 @@ Gaffer.Metadata.registerNode(
 
 		],
 
+		"locations" : [
+
+			"description",
+			"""
+			A list of locations to query the shader for in a single batch,
+			outputting the results to the "Vector" children of each output.
+			This is much more efficient than using a separate query per
+			location, and can be connected to `FilterResults.outStrings` to
+			query all the locations matched by a filter.
+			""",
+
+			"nodule:type", "",
+
+		],
+
 		"queries" : [
 
 			"description",
@@ -348,6 +363,33 @@ Gaffer.Metadata.registerNode(
 
 		],
 
+		"out.*.existsVector" : [
+
+			"description",
+			"""
+			Outputs true for each of the `locations` where the shader and
+			parameter exist, otherwise false.
+			""",
+
+			"plugValueWidget:type", "",
+			"nodule:type", "",
+
+		],
+
+		"out.*.valueVector" : [
+
+			"description",
+			"""
+			Outputs the value of the specified parameter for each of the
+			`locations`, or a NullObject where it does not exist. The default
+			value is not used.
+			""",
+
+			"plugValueWidget:type", "",
+			"nodule:type", "",
+
+		],
+
 		"out.*.value..." : [
 
 			"noduleLayout:label", functools.partial( __getLabel, parentPlug = "values" ),
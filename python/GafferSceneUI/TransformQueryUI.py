@@ -117,6 +117,19 @@ Gaffer.Metadata.registerNode(
 
 		],
 
+		"locations" : [
+
+			"description",
+			"""
+			A list of locations to query the transform for in a single batch,
+			outputting the results to the "Vector" outputs. This is much
+			more efficient than using a separate query per location, and
+			can be connected to `FilterResults.outStrings` to query all
+			the locations matched by a filter.
+			"""
+
+		],
+
 		"matrix" : [
 
 			"description",
@@ -154,5 +167,17 @@ Gaffer.Metadata.registerNode(
 
 			"layout:section", "Settings.Outputs"
 		],
+
+		"matrixVector" : [
+
+			"description",
+			"""
+			The requested transform for each of the locations, with an
+			identity matrix for any that do not exist.
+			""",
+
+			"layout:section", "Settings.Outputs"
+
+		],
 	}
 )
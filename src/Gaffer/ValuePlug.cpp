@@ -1228,6 +1228,13 @@ size_t ValuePlug::cacheMemoryUsage()
 void ValuePlug::clearCache()
 {
 	ComputeProcess::clearCache();
+	cacheClearedSignal()();
+}
+
+ValuePlug::CacheClearedSignal &ValuePlug::cacheClearedSignal()
+{
+	static CacheClearedSignal g_signal;
+	return g_signal;
 }
 
 size_t ValuePlug::getHashCacheSizeLimit()
@@ -0,0 +1,181 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2022, Cinesite VFX Ltd. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#include "GafferScene/Private/AttributeInterning.h"
+
+#include "Gaffer/Private/IECorePreview/LRUCache.h"
+#include "Gaffer/ValuePlug.h"
+
+#include "IECoreScene/ShaderNetwork.h"
+
+#include <atomic>
+
+using namespace IECore;
+using namespace IECoreScene;
+using namespace GafferScene::Private;
+
+namespace
+{
+
+// The members of CompoundObjects are typically shared with the upstream
+// attributes, so when an instance is replaced by an interned one, the
+// memory saved is only that of the map itself.
+size_t memorySavedBySharing( const Object *object )
+{
+	if( auto compoundObject = runTimeCast<const CompoundObject>( object ) )
+	{
+		return sizeof( CompoundObject ) + compoundObject->members().size() * ( sizeof( CompoundObject::ObjectMap::value_type ) + 4 * sizeof( void * ) );
+	}
+	return object->memoryUsage();
+}
+
+struct PoolGetterKey
+{
+
+	PoolGetterKey( const Object *object, const IECore::MurmurHash &hash )
+		:	object( object ), hash( hash )
+	{
+	}
+
+	operator const IECore::MurmurHash & () const
+	{
+		return hash;
+	}
+
+	const Object *object;
+	IECore::MurmurHash hash;
+
+};
+
+std::atomic<uint64_t> g_internedObjects( 0 );
+std::atomic<uint64_t> g_sharedObjects( 0 );
+std::atomic<uint64_t> g_memorySaved( 0 );
+
+ConstObjectPtr poolGetter( const PoolGetterKey &key, size_t &cost, const IECore::Canceller *canceller )
+{
+	// The pool keeps the whole object alive, including any members that
+	// have since been evicted from the compute cache, so we must charge
+	// for all of it.
+	cost = key.object->memoryUsage();
+	g_internedObjects++;
+	return key.object;
+}
+
+using Pool = IECorePreview::LRUCache<IECore::MurmurHash, ConstObjectPtr, IECorePreview::LRUCachePolicy::Parallel, PoolGetterKey>;
+// Cost is in bytes.
+Pool g_pool( poolGetter, 1024 * 1024 * 100 );
+const bool g_poolClearConnected = ( Gaffer::ValuePlug::cacheClearedSignal().connect( [] { g_pool.clear(); } ), true );
+
+template<typename T>
+typename T::ConstPtr internObject( const T *object, const IECore::MurmurHash &hash )
+{
+	ConstObjectPtr result = g_pool.get( PoolGetterKey( object, hash ) );
+	if( result.get() != object )
+	{
+		g_sharedObjects++;
+		g_memorySaved += memorySavedBySharing( object );
+	}
+	return static_cast<const T *>( result.get() );
+}
+
+} // namespace
+
+IECore::ConstCompoundObjectPtr AttributeInterning::intern( const IECore::ConstCompoundObjectPtr &attributes )
+{
+	// Intern ShaderNetworks first, since they are typically the largest
+	// members, and may be shared between locations whose other attributes
+	// differ.
+
+	CompoundObjectPtr updatedAttributes;
+	for( const auto &member : attributes->members() )
+	{
+		auto network = runTimeCast<const ShaderNetwork>( member.second.get() );
+		if( !network )
+		{
+			continue;
+		}
+
+		// ShaderNetworks cache their own hash, so this is cheap.
+		ConstShaderNetworkPtr internedNetwork = internObject( network, network->Object::hash() );
+		if( internedNetwork != network )
+		{
+			if( !updatedAttributes )
+			{
+				updatedAttributes = new CompoundObject;
+				updatedAttributes->members() = attributes->members();
+			}
+			updatedAttributes->members()[member.first] = boost::const_pointer_cast<ShaderNetwork>( internedNetwork );
+		}
+	}
+
+	// We key on the contents rather than the hash of the plug the attributes
+	// were computed for, because identical attributes are commonly reached
+	// through differing upstream hashes, and the compute cache already shares
+	// results with identical plug hashes. Interning doesn't change the
+	// contents, so the hash of the original is still valid.
+	return internObject( updatedAttributes ? updatedAttributes.get() : attributes.get(), attributes->Object::hash() );
+}
+
+AttributeInterning::Statistics AttributeInterning::statistics()
+{
+	Statistics result;
+	result.internedObjects = g_internedObjects;
+	result.sharedObjects = g_sharedObjects;
+	result.memorySaved = g_memorySaved;
+	return result;
+}
+
+void AttributeInterning::resetStatistics()
+{
+	g_internedObjects = 0;
+	g_sharedObjects = 0;
+	g_memorySaved = 0;
+}
+
+void AttributeInterning::clear()
+{
+	g_pool.clear();
+}
+
+size_t AttributeInterning::getMemoryLimit()
+{
+	return g_pool.getMaxCost();
+}
+
+void AttributeInterning::setMemoryLimit( size_t bytes )
+{
+	g_pool.setMaxCost( bytes );
+}
@@ -36,6 +36,8 @@
 
 #include "GafferScene/AttributeProcessor.h"
 
+#include "GafferScene/Private/AttributeInterning.h"
+
 using namespace IECore;
 using namespace Gaffer;
 using namespace GafferScene;
@@ -114,7 +116,15 @@ IECore::ConstCompoundObjectPtr AttributeProcessor::computeAttributes( const Scen
 	if( filterValue( context ) & IECore::PathMatcher::ExactMatch )
 	{
 		ConstCompoundObjectPtr inputAttributes = inPlug()->attributesPlug()->getValue();
-		return computeProcessedAttributes( path, context, inputAttributes.get() );
+		ConstCompoundObjectPtr result = computeProcessedAttributes( path, context, inputAttributes.get() );
+		if( result != inputAttributes )
+		{
+			// It is common for many locations to receive identical attributes,
+			// in which case we share a single instance between them all rather
+			// than storing a copy per location in the compute cache.
+			result = Private::AttributeInterning::intern( result );
+		}
+		return result;
 	}
 	else
 	{
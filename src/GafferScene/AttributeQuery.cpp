@@ -36,6 +36,8 @@
 
 #include "GafferScene/AttributeQuery.h"
 
+#include "GafferScene/Private/QueryAlgo.h"
+
 #include "Gaffer/PlugAlgo.h"
 
 #include "Gaffer/MetadataAlgo.h"
@@ -44,6 +46,7 @@
 #include "IECore/NullObject.h"
 #include "IECore/CompoundObject.h"
 #include "IECore/Exception.h"
+#include "IECore/ObjectVector.h"
 
 #include "boost/container/small_vector.hpp"
 
@@ -97,6 +100,40 @@ void addChildPlugsToAffectedOutputs( const Gaffer::Plug* const plug, Gaffer::Dep
 	}
 }
 
+void attributeHash( const GafferScene::ScenePlug* const scene, const GafferScene::ScenePlug::ScenePath& path, const bool inherit, IECore::MurmurHash& h )
+{
+	if( scene->exists( path ) )
+	{
+		h.append( ( inherit )
+			? scene->fullAttributesHash( path )
+			: scene->attributesHash( path ) );
+	}
+}
+
+// Returns NullObject if the location or attribute doesn't exist.
+IECore::ConstObjectPtr attribute( const GafferScene::ScenePlug* const scene, const GafferScene::ScenePlug::ScenePath& path, const std::string& name, const bool inherit )
+{
+	if( name.empty() || ! scene->exists( path ) )
+	{
+		return IECore::NullObject::defaultNullObject();
+	}
+
+	const IECore::ConstCompoundObjectPtr cobj = ( inherit )
+		? boost::static_pointer_cast< const IECore::CompoundObject >( scene->fullAttributes( path ) )
+		: ( scene->attributes( path ) );
+	assert( cobj );
+
+	const IECore::CompoundObject::ObjectMap& objmap = cobj->members();
+	const IECore::CompoundObject::ObjectMap::const_iterator it = objmap.find( name );
+
+	if( it != objmap.end() )
+	{
+		return ( *it ).second;
+	}
+
+	return IECore::NullObject::defaultNullObject();
+}
+
 } // namespace
 
 namespace GafferScene
@@ -116,6 +153,9 @@ AttributeQuery::AttributeQuery( const std::string& name )
 	addChild( new Gaffer::BoolPlug( "inherit", Gaffer::Plug::In, false ) );
 	addChild( new Gaffer::BoolPlug( "exists", Gaffer::Plug::Out, false ) );
 	addChild( new Gaffer::ObjectPlug( "__internalObject", Gaffer::Plug::Out, IECore::NullObject::defaultNullObject() ) );
+	addChild( new Gaffer::StringVectorDataPlug( "locations", Gaffer::Plug::In, new IECore::StringVectorData() ) );
+	addChild( new Gaffer::BoolVectorDataPlug( "existsVector", Gaffer::Plug::Out, new IECore::BoolVectorData() ) );
+	addChild( new Gaffer::ObjectVectorPlug( "valueVector", Gaffer::Plug::Out, new IECore::ObjectVector() ) );
 }
 
 AttributeQuery::~AttributeQuery()
@@ -187,6 +227,39 @@ const Gaffer::ObjectPlug* AttributeQuery::internalObjectPlug() const
 	return getChild< Gaffer::ObjectPlug >( g_firstPlugIndex + 5 );
 }
 
+Gaffer::StringVectorDataPlug* AttributeQuery::locationsPlug()
+{
+	return const_cast< Gaffer::StringVectorDataPlug* >(
+		static_cast< const AttributeQuery* >( this )->locationsPlug() );
+}
+
+const Gaffer::StringVectorDataPlug* AttributeQuery::locationsPlug() const
+{
+	return getChild< Gaffer::StringVectorDataPlug >( g_firstPlugIndex + 6 );
+}
+
+Gaffer::BoolVectorDataPlug* AttributeQuery::existsVectorPlug()
+{
+	return const_cast< Gaffer::BoolVectorDataPlug* >(
+		static_cast< const AttributeQuery* >( this )->existsVectorPlug() );
+}
+
+const Gaffer::BoolVectorDataPlug* AttributeQuery::existsVectorPlug() const
+{
+	return getChild< Gaffer::BoolVectorDataPlug >( g_firstPlugIndex + 7 );
+}
+
+Gaffer::ObjectVectorPlug* AttributeQuery::valueVectorPlug()
+{
+	return const_cast< Gaffer::ObjectVectorPlug* >(
+		static_cast< const AttributeQuery* >( this )->valueVectorPlug() );
+}
+
+const Gaffer::ObjectVectorPlug* AttributeQuery::valueVectorPlug() const
+{
+	return getChild< Gaffer::ObjectVectorPlug >( g_firstPlugIndex + 8 );
+}
+
 bool AttributeQuery::isSetup() const
 {
 	return ( defaultPlug() != nullptr ) && ( valuePlug() != nullptr );
@@ -254,15 +327,27 @@ void AttributeQuery::affects( const Gaffer::Plug* const input, AffectedPlugsCont
 
 		outputs.push_back( existsPlug() );
 	}
+	else if( input == valueVectorPlug() )
+	{
+		outputs.push_back( existsVectorPlug() );
+	}
 	else if(
 		( input == inheritPlug() ) ||
-		( input == locationPlug() ) ||
 		( input == attributePlug() ) ||
 		( input == scenePlug()->existsPlug() ) ||
 		( input == scenePlug()->attributesPlug() ) )
+	{
+		outputs.push_back( internalObjectPlug() );
+		outputs.push_back( valueVectorPlug() );
+	}
+	else if( input == locationPlug() )
 	{
 		outputs.push_back( internalObjectPlug() );
 	}
+	else if( input == locationsPlug() )
+	{
+		outputs.push_back( valueVectorPlug() );
+	}
 	else
 	{
 		assert( input != 0 );
@@ -299,9 +384,7 @@ void AttributeQuery::hash( const Gaffer::ValuePlug* const output, const Gaffer::
 
 			if( splug->exists( path ) )
 			{
-				h.append( ( inheritPlug()->getValue() )
-					? splug->fullAttributesHash( path )
-					: splug->attributesHash( path ) );
+				attributeHash( splug, path, inheritPlug()->getValue(), h );
 				attributePlug()->hash( h );
 			}
 		}
@@ -310,6 +393,24 @@ void AttributeQuery::hash( const Gaffer::ValuePlug* const output, const Gaffer::
 	{
 		internalObjectPlug()->hash( h );
 	}
+	else if( output == valueVectorPlug() )
+	{
+		const IECore::ConstStringVectorDataPtr locations = locationsPlug()->getValue();
+		const bool inherit = inheritPlug()->getValue();
+
+		h.append( Private::QueryAlgo::parallelLocationsHash(
+			locations->readable(),
+			[&] ( const ScenePlug::ScenePath& path, IECore::MurmurHash& locationHash ) {
+				attributeHash( scenePlug(), path, inherit, locationHash );
+			}
+		) );
+		h.append( inherit );
+		attributePlug()->hash( h );
+	}
+	else if( output == existsVectorPlug() )
+	{
+		valueVectorPlug()->hash( h );
+	}
 	else
 	{
 		assert( output != 0 );
@@ -330,36 +431,13 @@ void AttributeQuery::compute( Gaffer::ValuePlug* const output, const Gaffer::Con
 {
 	if( output == internalObjectPlug() )
 	{
-		IECore::ObjectPtr obj( IECore::NullObject::defaultNullObject() );
+		IECore::ConstObjectPtr obj( IECore::NullObject::defaultNullObject() );
 
 		const std::string loc = locationPlug()->getValue();
 
 		if( ! loc.empty() )
 		{
-			const ScenePlug* const splug = scenePlug();
-
-			const ScenePlug::ScenePath path = ScenePlug::stringToPath( loc );
-
-			if( splug->exists( path ) )
-			{
-				const std::string name = attributePlug()->getValue();
-
-				if( ! name.empty() )
-				{
-					const IECore::ConstCompoundObjectPtr cobj = ( inheritPlug()->getValue() )
-						? boost::static_pointer_cast< const IECore::CompoundObject >( splug->fullAttributes( path ) )
-						: ( splug->attributes( path ) );
-					assert( cobj );
-
-					const IECore::CompoundObject::ObjectMap& objmap = cobj->members();
-					const IECore::CompoundObject::ObjectMap::const_iterator it = objmap.find( name );
-
-					if( it != objmap.end() )
-					{
-						obj = ( *it ).second;
-					}
-				}
-			}
+			obj = attribute( scenePlug(), ScenePlug::stringToPath( loc ), attributePlug()->getValue(), inheritPlug()->getValue() );
 		}
 
 		IECore::assertedStaticCast< Gaffer::ObjectPlug >( output )->setValue( obj );
@@ -371,6 +449,42 @@ void AttributeQuery::compute( Gaffer::ValuePlug* const output, const Gaffer::Con
 
 		IECore::assertedStaticCast< Gaffer::BoolPlug >( output )->setValue( object->isNotEqualTo( IECore::NullObject::defaultNullObject() ) );
 	}
+	else if( output == valueVectorPlug() )
+	{
+		const IECore::ConstStringVectorDataPtr locations = locationsPlug()->getValue();
+		const std::string name = attributePlug()->getValue();
+		const bool inherit = inheritPlug()->getValue();
+
+		IECore::ObjectVectorPtr const values = new IECore::ObjectVector();
+		values->members().resize( locations->readable().size(), IECore::NullObject::defaultNullObject() );
+
+		Private::QueryAlgo::parallelForLocations(
+			locations->readable(),
+			[&] ( const ScenePlug::ScenePath& path, size_t i ) {
+				// NOTE : The const_pointer_cast is OK because the result is
+				// stored on a plug, which will only provide const access to it.
+				values->members()[ i ] = boost::const_pointer_cast< IECore::Object >(
+					attribute( scenePlug(), path, name, inherit )
+				);
+			}
+		);
+
+		IECore::assertedStaticCast< Gaffer::ObjectVectorPlug >( output )->setValue( values );
+	}
+	else if( output == existsVectorPlug() )
+	{
+		const IECore::ConstObjectVectorPtr values = valueVectorPlug()->getValue();
+
+		IECore::BoolVectorDataPtr const exists = new IECore::BoolVectorData();
+		exists->writable().reserve( values->members().size() );
+
+		for( const IECore::ObjectPtr& value : values->members() )
+		{
+			exists->writable().push_back( value->isNotEqualTo( IECore::NullObject::defaultNullObject() ) );
+		}
+
+		IECore::assertedStaticCast< Gaffer::BoolVectorDataPlug >( output )->setValue( exists );
+	}
 	else
 	{
 		assert( output != 0 );
@@ -412,4 +526,24 @@ void AttributeQuery::compute( Gaffer::ValuePlug* const output, const Gaffer::Con
 	}
 }
 
+Gaffer::ValuePlug::CachePolicy AttributeQuery::hashCachePolicy( const Gaffer::ValuePlug* const output ) const
+{
+	if( output == valueVectorPlug() )
+	{
+		return Gaffer::ValuePlug::CachePolicy::TaskCollaboration;
+	}
+
+	return ComputeNode::hashCachePolicy( output );
+}
+
+Gaffer::ValuePlug::CachePolicy AttributeQuery::computeCachePolicy( const Gaffer::ValuePlug* const output ) const
+{
+	if( output == valueVectorPlug() )
+	{
+		return Gaffer::ValuePlug::CachePolicy::TaskCollaboration;
+	}
+
+	return ComputeNode::computeCachePolicy( output );
+}
+
 } // GafferScene
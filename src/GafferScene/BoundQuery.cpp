@@ -36,6 +36,10 @@
 
 #include "GafferScene/BoundQuery.h"
 
+#include "GafferScene/Private/QueryAlgo.h"
+
+#include "IECore/VectorTypedData.h"
+
 #include "OpenEXR/ImathBoxAlgo.h"
 
 #include <cassert>
@@ -75,8 +79,93 @@ setV3fPlugComponentValue( Gaffer::V3fPlug const& parent, Gaffer::NumericPlug< fl
 	child.setValue( ensurePositiveZero( cv ) );
 }
 
+Imath::V3f ensurePositiveZero( Imath::V3f const& value )
+{
+	return Imath::V3f( ensurePositiveZero( value.x ), ensurePositiveZero( value.y ), ensurePositiveZero( value.z ) );
+}
+
 Imath::Box3f const g_singularBox( Imath::V3f( 0.f, 0.f, 0.f ), Imath::V3f( 0.f, 0.f, 0.f ) );
 
+using Space = GafferScene::BoundQuery::Space;
+
+void boundHash( GafferScene::ScenePlug const* const scene, GafferScene::ScenePlug::ScenePath const& path, Space const space, GafferScene::ScenePlug::ScenePath const* const relativePath, IECore::MurmurHash& h )
+{
+	if( ! scene->exists( path ) )
+	{
+		return;
+	}
+
+	switch( space )
+	{
+		case Space::Local:
+			h = scene->boundHash( path );
+			break;
+		case Space::World:
+			h.append( scene->fullTransformHash( path ) );
+			h.append( scene->boundHash( path ) );
+			break;
+		case Space::Relative:
+		{
+			if( relativePath != nullptr )
+			{
+				if( *relativePath == path )
+				{
+					h = scene->boundHash( path );
+				}
+				else if( scene->exists( *relativePath ) )
+				{
+					h.append( scene->fullTransformHash( path ) );
+					h.append( scene->fullTransformHash( *relativePath ) );
+					h.append( scene->boundHash( path ) );
+				}
+			}
+			break;
+		}
+		default:
+			break;
+	}
+}
+
+Imath::Box3f bound( GafferScene::ScenePlug const* const scene, GafferScene::ScenePlug::ScenePath const& path, Space const space, GafferScene::ScenePlug::ScenePath const* const relativePath )
+{
+	Imath::Box3f b;
+
+	if( ! scene->exists( path ) )
+	{
+		return g_singularBox;
+	}
+
+	switch( space )
+	{
+		case Space::Local:
+			b = scene->bound( path );
+			break;
+		case Space::World:
+			b = Imath::transform( scene->bound( path ), scene->fullTransform( path ) );
+			break;
+		case Space::Relative:
+		{
+			if( relativePath != nullptr )
+			{
+				if( *relativePath == path )
+				{
+					b = scene->bound( path );
+				}
+				else if( scene->exists( *relativePath ) )
+				{
+					b = Imath::transform( scene->bound( path ),
+						scene->fullTransform( path ) * scene->fullTransform( *relativePath ).inverse() );
+				}
+			}
+			break;
+		}
+		default:
+			break;
+	}
+
+	return b.isEmpty() ? g_singularBox : b;
+}
+
 } // namespace
 
 namespace GafferScene
@@ -100,6 +189,10 @@ BoundQuery::BoundQuery( std::string const& name )
 	addChild( new Gaffer::AtomicBox3fPlug( "__internalBound", Gaffer::Plug::Out ) );
 	addChild( new Gaffer::V3fPlug( "center", Gaffer::Plug::Out ) );
 	addChild( new Gaffer::V3fPlug( "size", Gaffer::Plug::Out ) );
+	addChild( new Gaffer::StringVectorDataPlug( "locations", Gaffer::Plug::In, new IECore::StringVectorData() ) );
+	addChild( new Gaffer::ObjectPlug( "__internalBoundVector", Gaffer::Plug::Out, new IECore::Box3fVectorData() ) );
+	addChild( new Gaffer::V3fVectorDataPlug( "centerVector", Gaffer::Plug::Out, new IECore::V3fVectorData() ) );
+	addChild( new Gaffer::V3fVectorDataPlug( "sizeVector", Gaffer::Plug::Out, new IECore::V3fVectorData() ) );
 }
 
 BoundQuery::~BoundQuery()
@@ -193,6 +286,50 @@ Gaffer::V3fPlug const* BoundQuery::sizePlug() const
 	return getChild< Gaffer::V3fPlug >( g_firstPlugIndex + 7 );
 }
 
+Gaffer::StringVectorDataPlug* BoundQuery::locationsPlug()
+{
+	return const_cast< Gaffer::StringVectorDataPlug* >(
+		static_cast< BoundQuery const* >( this )->locationsPlug() );
+}
+
+Gaffer::StringVectorDataPlug const* BoundQuery::locationsPlug() const
+{
+	return getChild< Gaffer::StringVectorDataPlug >( g_firstPlugIndex + 8 );
+}
+
+Gaffer::ObjectPlug* BoundQuery::internalBoundVectorPlug()
+{
+	return const_cast< Gaffer::ObjectPlug* >(
+		static_cast< BoundQuery const* >( this )->internalBoundVectorPlug() );
+}
+
+Gaffer::ObjectPlug const* BoundQuery::internalBoundVectorPlug() const
+{
+	return getChild< Gaffer::ObjectPlug >( g_firstPlugIndex + 9 );
+}
+
+Gaffer::V3fVectorDataPlug* BoundQuery::centerVectorPlug()
+{
+	return const_cast< Gaffer::V3fVectorDataPlug* >(
+		static_cast< BoundQuery const* >( this )->centerVectorPlug() );
+}
+
+Gaffer::V3fVectorDataPlug const* BoundQuery::centerVectorPlug() const
+{
+	return getChild< Gaffer::V3fVectorDataPlug >( g_firstPlugIndex + 10 );
+}
+
+Gaffer::V3fVectorDataPlug* BoundQuery::sizeVectorPlug()
+{
+	return const_cast< Gaffer::V3fVectorDataPlug* >(
+		static_cast< BoundQuery const* >( this )->sizeVectorPlug() );
+}
+
+Gaffer::V3fVectorDataPlug const* BoundQuery::sizeVectorPlug() const
+{
+	return getChild< Gaffer::V3fVectorDataPlug >( g_firstPlugIndex + 11 );
+}
+
 void BoundQuery::affects( Gaffer::Plug const* const input, AffectedPlugsContainer& outputs ) const
 {
 	ComputeNode::affects( input, outputs );
@@ -212,15 +349,28 @@ void BoundQuery::affects( Gaffer::Plug const* const input, AffectedPlugsContaine
 		outputs.push_back( sizePlug()->getChild( 1 ) );
 		outputs.push_back( sizePlug()->getChild( 2 ) );
 	}
+	else if( input == internalBoundVectorPlug() )
+	{
+		outputs.push_back( centerVectorPlug() );
+		outputs.push_back( sizeVectorPlug() );
+	}
 	else if(
 		( input == spacePlug() ) ||
-		( input == locationPlug() ) ||
 		( input == relativeLocationPlug() ) ||
 		( input == scenePlug()->boundPlug() ) ||
 		( input == scenePlug()->existsPlug() ) ||
 		( input == scenePlug()->transformPlug() ) )
 	{
 		outputs.push_back( internalBoundPlug() );
+		outputs.push_back( internalBoundVectorPlug() );
+	}
+	else if( input == locationPlug() )
+	{
+		outputs.push_back( internalBoundPlug() );
+	}
+	else if( input == locationsPlug() )
+	{
+		outputs.push_back( internalBoundVectorPlug() );
 	}
 }
 
@@ -233,52 +383,35 @@ void BoundQuery::hash( Gaffer::ValuePlug const* const output, Gaffer::Context co
 		std::string const loc = locationPlug()->getValue();
 		if( ! loc.empty() )
 		{
-			ScenePlug const* const splug = scenePlug();
-			assert( splug != 0 );
-
-			ScenePlug::ScenePath const path = ScenePlug::stringToPath( loc );
+			std::string const rloc = relativeLocationPlug()->getValue();
+			ScenePlug::ScenePath const rpath = ScenePlug::stringToPath( rloc );
 
-			if( splug->exists( path ) )
-			{
-				switch( static_cast< Space >( spacePlug()->getValue() ) )
-				{
-					case Space::Local:
-						h = splug->boundHash( path );
-						break;
-					case Space::World:
-						h.append( splug->fullTransformHash( path ) );
-						h.append( splug->boundHash( path ) );
-						break;
-					case Space::Relative:
-					{
-						std::string const rloc = relativeLocationPlug()->getValue();
-
-						if( ! rloc.empty() )
-						{
-							if( loc == rloc )
-							{
-								h = splug->boundHash( path );
-							}
-							else
-							{
-								ScenePlug::ScenePath const rpath = ScenePlug::stringToPath( rloc );
-
-								if( splug->exists( rpath ) )
-								{
-									h.append( splug->fullTransformHash( path ) );
-									h.append( splug->fullTransformHash( rpath ) );
-									h.append( splug->boundHash( path ) );
-								}
-							}
-						}
-						break;
-					}
-					default:
-						break;
-				}
-			}
+			boundHash(
+				scenePlug(), ScenePlug::stringToPath( loc ), static_cast< Space >( spacePlug()->getValue() ),
+				rloc.empty() ? nullptr : & rpath, h
+			);
 		}
 	}
+	else if( output == internalBoundVectorPlug() )
+	{
+		IECore::ConstStringVectorDataPtr const locations = locationsPlug()->getValue();
+		Space const space = static_cast< Space >( spacePlug()->getValue() );
+		std::string const rloc = relativeLocationPlug()->getValue();
+		ScenePlug::ScenePath const rpath = ScenePlug::stringToPath( rloc );
+
+		h.append( Private::QueryAlgo::parallelLocationsHash(
+			locations->readable(),
+			[&] ( ScenePlug::ScenePath const& path, IECore::MurmurHash& locationHash ) {
+				boundHash( scenePlug(), path, space, rloc.empty() ? nullptr : & rpath, locationHash );
+			}
+		) );
+	}
+	else if(
+		( output == centerVectorPlug() ) ||
+		( output == sizeVectorPlug() ) )
+	{
+		internalBoundVectorPlug()->hash( h );
+	}
 	else
 	{
 		Gaffer::GraphComponent const* const parent = output->parent();
@@ -298,56 +431,59 @@ void BoundQuery::compute( Gaffer::ValuePlug* const output, Gaffer::Context const
 {
 	if( output == internalBoundPlug() )
 	{
-		Imath::Box3f b;
+		Imath::Box3f b = g_singularBox;
 
 		std::string const loc = locationPlug()->getValue();
 		if( ! loc.empty() )
 		{
-			ScenePlug const* const splug = scenePlug();
-			assert( splug != 0 );
+			std::string const rloc = relativeLocationPlug()->getValue();
+			ScenePlug::ScenePath const rpath = ScenePlug::stringToPath( rloc );
 
-			ScenePlug::ScenePath const path = ScenePlug::stringToPath( loc );
+			b = bound(
+				scenePlug(), ScenePlug::stringToPath( loc ), static_cast< Space >( spacePlug()->getValue() ),
+				rloc.empty() ? nullptr : & rpath
+			);
+		}
 
-			if( splug->exists( path ) )
-			{
-				switch( static_cast< Space >( spacePlug()->getValue() ) )
-				{
-					case Space::Local:
-						b = splug->bound( path );
-						break;
-					case Space::World:
-						b = Imath::transform( splug->bound( path ), splug->fullTransform( path ) );
-						break;
-					case Space::Relative:
-					{
-						std::string const rloc = relativeLocationPlug()->getValue();
-
-						if( ! rloc.empty() )
-						{
-							if( loc == rloc )
-							{
-								b = splug->bound( path );
-							}
-							else
-							{
-								ScenePlug::ScenePath const rpath = ScenePlug::stringToPath( rloc );
-
-								if( splug->exists( rpath ) )
-								{
-									b = Imath::transform( splug->bound( path ),
-										splug->fullTransform( path ) * splug->fullTransform( rpath ).inverse() );
-								}
-							}
-						}
-						break;
-					}
-					default:
-						break;
-				}
+		IECore::assertedStaticCast< Gaffer::AtomicBox3fPlug >( output )->setValue( b );
+	}
+	else if( output == internalBoundVectorPlug() )
+	{
+		IECore::ConstStringVectorDataPtr const locations = locationsPlug()->getValue();
+		Space const space = static_cast< Space >( spacePlug()->getValue() );
+		std::string const rloc = relativeLocationPlug()->getValue();
+		ScenePlug::ScenePath const rpath = ScenePlug::stringToPath( rloc );
+
+		IECore::Box3fVectorDataPtr const bounds = new IECore::Box3fVectorData();
+		std::vector< Imath::Box3f >& b = bounds->writable();
+		b.resize( locations->readable().size(), g_singularBox );
+
+		Private::QueryAlgo::parallelForLocations(
+			locations->readable(),
+			[&] ( ScenePlug::ScenePath const& path, size_t i ) {
+				b[ i ] = bound( scenePlug(), path, space, rloc.empty() ? nullptr : & rpath );
 			}
+		);
+
+		IECore::assertedStaticCast< Gaffer::ObjectPlug >( output )->setValue( bounds );
+	}
+	else if(
+		( output == centerVectorPlug() ) ||
+		( output == sizeVectorPlug() ) )
+	{
+		IECore::ConstBox3fVectorDataPtr const bounds = IECore::runTimeCast< const IECore::Box3fVectorData >( internalBoundVectorPlug()->getValue() );
+		assert( bounds );
+
+		IECore::V3fVectorDataPtr const resultData = new IECore::V3fVectorData();
+		std::vector< Imath::V3f >& result = resultData->writable();
+		result.reserve( bounds->readable().size() );
+
+		for( Imath::Box3f const& b : bounds->readable() )
+		{
+			result.push_back( ensurePositiveZero( ( output == centerVectorPlug() ) ? b.center() : b.size() ) );
 		}
 
-		IECore::assertedStaticCast< Gaffer::AtomicBox3fPlug >( output )->setValue( b.isEmpty() ? g_singularBox : b );
+		IECore::assertedStaticCast< Gaffer::V3fVectorDataPlug >( output )->setValue( resultData );
 	}
 	else
 	{
@@ -386,4 +522,24 @@ void BoundQuery::compute( Gaffer::ValuePlug* const output, Gaffer::Context const
 	ComputeNode::compute( output, context );
 }
 
+Gaffer::ValuePlug::CachePolicy BoundQuery::hashCachePolicy( Gaffer::ValuePlug const* const output ) const
+{
+	if( output == internalBoundVectorPlug() )
+	{
+		return Gaffer::ValuePlug::CachePolicy::TaskCollaboration;
+	}
+
+	return ComputeNode::hashCachePolicy( output );
+}
+
+Gaffer::ValuePlug::CachePolicy BoundQuery::computeCachePolicy( Gaffer::ValuePlug const* const output ) const
+{
+	if( output == internalBoundVectorPlug() )
+	{
+		return Gaffer::ValuePlug::CachePolicy::TaskCollaboration;
+	}
+
+	return ComputeNode::computeCachePolicy( output );
+}
+
 } // GafferScene
@@ -264,6 +264,18 @@ class BranchCreator::BranchesData : public IECore::Data
 			return *location->sourcePaths;
 		}
 
+		// Returns the source paths for `destination` if it has no
+		// nested destinations below it, and null otherwise.
+		const Location::SourcePaths *leafSourcePaths( const ScenePlug::ScenePath &destination ) const
+		{
+			const Location *location = locationOrAncestor( destination );
+			if( location->depth != destination.size() || !location->children.empty() )
+			{
+				return nullptr;
+			}
+			return location->sourcePaths.get();
+		}
+
 		template<typename F>
 		void visitDestinations( F &&f ) const
 		{
@@ -453,7 +465,8 @@ void BranchCreator::affects( const Plug *input, AffectedPlugsContainer &outputs
 		input == mappingPlug() ||
 		input == inPlug()->boundPlug() ||
 		input == outPlug()->childBoundsPlug() ||
-		affectsBranchBound( input )
+		affectsBranchBound( input ) ||
+		( providesBranchesBound() && ( input == inPlug()->transformPlug() || affectsBranchesBound( input ) ) )
 	)
 	{
 		outputs.push_back( outPlug()->boundPlug() );
@@ -572,6 +585,31 @@ void BranchCreator::hashBound( const ScenePath &path, const Gaffer::Context *con
 	ScenePath sourcePath, branchPath;
 	const LocationType locationType = sourceAndBranchPaths( path, sourcePath, branchPath );
 
+	if( ( locationType == Destination || locationType == NewDestination ) && providesBranchesBound() )
+	{
+		ConstBranchesDataPtr branchesData = branches( context );
+		if( const BranchesData::Location::SourcePaths *sourcePaths = branchesData->leafSourcePaths( path ) )
+		{
+			FilteredSceneProcessor::hashBound( path, context, parent, h );
+			if( locationType == Destination )
+			{
+				inPlug()->boundPlug()->hash( h );
+			}
+			for( const auto &source : *sourcePaths )
+			{
+				h.append( source.data(), source.size() );
+				h.append( (uint64_t)source.size() );
+				hashBranchesBound( source, context, h );
+				if( source != path )
+				{
+					h.append( inPlug()->fullTransformHash( source ) );
+					h.append( outPlug()->fullTransformHash( path ) );
+				}
+			}
+			return;
+		}
+	}
+
 	switch( locationType )
 	{
 		case Branch :
@@ -599,6 +637,29 @@ Imath::Box3f BranchCreator::computeBound( const ScenePath &path, const Gaffer::C
 	ScenePath sourcePath, branchPath;
 	const LocationType locationType = sourceAndBranchPaths( path, sourcePath, branchPath );
 
+	if( ( locationType == Destination || locationType == NewDestination ) && providesBranchesBound() )
+	{
+		ConstBranchesDataPtr branchesData = branches( context );
+		if( const BranchesData::Location::SourcePaths *sourcePaths = branchesData->leafSourcePaths( path ) )
+		{
+			// Children from the input are passed through unchanged, so are
+			// already accounted for by the input bound. We only need to add
+			// the branches, using the same relative transform as
+			// `computeTransform()` applies to their children.
+			Box3f result = locationType == Destination ? inPlug()->boundPlug()->getValue() : Box3f();
+			for( const auto &source : *sourcePaths )
+			{
+				M44f relativeTransform;
+				if( source != path )
+				{
+					relativeTransform = inPlug()->fullTransform( source ) * outPlug()->fullTransform( path ).inverse();
+				}
+				result.extendBy( computeBranchesBound( source, relativeTransform, context ) );
+			}
+			return result;
+		}
+	}
+
 	switch( locationType )
 	{
 		case Branch :
@@ -1048,6 +1109,25 @@ bool BranchCreator::affectsBranchBound( const Gaffer::Plug *input ) const
 	return false;
 }
 
+bool BranchCreator::providesBranchesBound() const
+{
+	return false;
+}
+
+bool BranchCreator::affectsBranchesBound( const Gaffer::Plug *input ) const
+{
+	return false;
+}
+
+void BranchCreator::hashBranchesBound( const ScenePath &sourcePath, const Gaffer::Context *context, IECore::MurmurHash &h ) const
+{
+}
+
+Imath::Box3f BranchCreator::computeBranchesBound( const ScenePath &sourcePath, const Imath::M44f &transform, const Gaffer::Context *context ) const
+{
+	throw IECore::NotImplementedException( string( typeName() ) + "::computeBranchesBound" );
+}
+
 bool BranchCreator::affectsBranchTransform( const Gaffer::Plug *input ) const
 {
 	return false;
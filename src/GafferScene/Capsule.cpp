@@ -40,9 +40,12 @@
 #include "GafferScene/ScenePlug.h"
 
 #include "Gaffer/Node.h"
+#include "Gaffer/Private/IECorePreview/LRUCache.h"
+#include "Gaffer/ValuePlug.h"
 
 #include "IECore/MessageHandler.h"
 
+#include "boost/algorithm/string/predicate.hpp"
 #include "boost/bind/bind.hpp"
 
 using namespace boost::placeholders;
@@ -62,6 +65,97 @@ namespace
 		result->remove( ScenePlug::scenePathContextName );
 		return result;
 	}
+
+	const InternedString g_camerasSetName( "__cameras" );
+	const InternedString g_lightsSetName( "__lights" );
+	const InternedString g_lightFiltersSetName( "__lightFilters" );
+	const std::string g_renderSetsPrefix( "render:" );
+
+	// Hashes everything that `RendererAlgo::RenderSets` and the globals
+	// depend on, without computing the sets themselves.
+	IECore::MurmurHash renderDataHash( const ScenePlug *scene, const IECore::MurmurHash &globalsHash )
+	{
+		IECore::MurmurHash h = globalsHash;
+
+		ConstInternedStringVectorDataPtr setNamesData = scene->setNamesPlug()->getValue();
+		for( const auto &setName : setNamesData->readable() )
+		{
+			if( boost::starts_with( setName.string(), g_renderSetsPrefix ) )
+			{
+				h.append( setName );
+				h.append( scene->setHash( setName ) );
+			}
+		}
+
+		for( const auto &setName : { g_camerasSetName, g_lightsSetName, g_lightFiltersSetName } )
+		{
+			h.append( scene->setHash( setName ) );
+		}
+
+		return h;
+	}
+
+	struct RenderData
+	{
+		ConstCompoundObjectPtr globals;
+		std::shared_ptr<const GafferScene::Private::RendererAlgo::RenderSets> renderSets;
+	};
+
+	struct RenderDataCacheGetterKey
+	{
+
+		RenderDataCacheGetterKey( const ScenePlug *scene, const IECore::MurmurHash &globalsHash )
+			:	scene( scene ), globalsHash( globalsHash ), hash( renderDataHash( scene, globalsHash ) )
+		{
+		}
+
+		operator const IECore::MurmurHash & () const
+		{
+			return hash;
+		}
+
+		const ScenePlug *scene;
+		const IECore::MurmurHash globalsHash;
+		const IECore::MurmurHash hash;
+
+	};
+
+	using RenderDataCache = IECorePreview::LRUCache<IECore::MurmurHash, RenderData, IECorePreview::LRUCachePolicy::TaskParallel, RenderDataCacheGetterKey>;
+
+	RenderDataCache &renderDataCache()
+	{
+		static RenderDataCache g_cache(
+			[] ( const RenderDataCacheGetterKey &key, size_t &cost, const IECore::Canceller *canceller ) {
+				RenderData result;
+				result.globals = key.scene->globalsPlug()->getValue( &key.globalsHash );
+				result.renderSets = std::make_shared<GafferScene::Private::RendererAlgo::RenderSets>( key.scene );
+				cost = 1;
+				return result;
+			},
+			// Cost is measured in entries, because RenderSets doesn't
+			// provide a measure of its memory usage. We only need enough
+			// to cover the distinct source scenes expanded in a single
+			// render.
+			100
+		);
+		return g_cache;
+	}
+
+	// Globals and render sets are only useful while capsules are being
+	// expanded, so we release them along with the compute cache rather
+	// than keeping them alive indefinitely after a render.
+	const bool g_renderDataCacheClearConnected = (
+		ValuePlug::cacheClearedSignal().connect( [] { renderDataCache().clear(); } ),
+		true
+	);
+
+	// Returns the globals and render sets for `scene` in the current context.
+	// These are cached by hash and shared between all capsules, so that
+	// expanding many capsules concurrently computes them only once.
+	RenderData renderData( const ScenePlug *scene )
+	{
+		return renderDataCache().get( RenderDataCacheGetterKey( scene, scene->globalsPlug()->hash() ) );
+	}
 }
 
 IE_CORE_DEFINEOBJECTTYPEDESCRIPTION( Capsule );
@@ -195,9 +289,8 @@ void Capsule::render( IECoreScenePreview::Renderer *renderer ) const
 {
 	throwIfNoScene();
 	ScenePlug::GlobalScope scope( m_context.get() );
-	IECore::ConstCompoundObjectPtr globals = m_scene->globalsPlug()->getValue();
-	GafferScene::Private::RendererAlgo::RenderSets renderSets( m_scene );
-	GafferScene::Private::RendererAlgo::outputObjects( m_scene, globals.get(), renderSets, /* lightLinks = */ nullptr, renderer, m_root );
+	const RenderData data = renderData( m_scene );
+	GafferScene::Private::RendererAlgo::outputObjects( m_scene, data.globals.get(), *data.renderSets, /* lightLinks = */ nullptr, renderer, m_root );
 }
 
 const ScenePlug *Capsule::scene() const
@@ -39,79 +39,426 @@
 #include "IECore/StringAlgo.h"
 
 #include "boost/format.hpp"
-#include "boost/lexical_cast.hpp"
-#include "boost/regex.hpp"
 
-#include <unordered_set>
+#include "tbb/blocked_range.h"
+#include "tbb/parallel_for.h"
+
+#include <algorithm>
+#include <limits>
+#include <queue>
+#include <unordered_map>
 
 using namespace std;
 using namespace IECore;
+using namespace GafferScene::Private;
 
-namespace IECore
+//////////////////////////////////////////////////////////////////////////
+// Internal utilities
+//////////////////////////////////////////////////////////////////////////
+
+namespace
 {
 
-/// \todo Move to Cortex. This `hash_value()` implementation differs from the existing
-/// `std::hash` implementation that Cortex has in that it hashes the pointer and not
-/// the string contents. I don't see any reason not to make `std::hash` use the faster
-/// option as well.
-/// Override `boost::hash_value()` to allow InternedString to be used
-/// with `hashed_index`.
-size_t hash_value( const IECore::InternedString &v )
+// Below this number of children, it's quicker to build
+// the map serially than to spawn tasks to do it.
+const size_t g_parallelThreshold = 10000;
+
+template<typename RangeFunctor>
+void forEachRange( size_t size, RangeFunctor &&f )
 {
-	return boost::hash<const char *>()( v.c_str() );
+	using Range = tbb::blocked_range<size_t>;
+	if( size < g_parallelThreshold )
+	{
+		f( Range( 0, size ) );
+		return;
+	}
+
+	tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+	tbb::parallel_for( Range( 0, size ), f, taskGroupContext );
 }
 
-} // namespace IECore
+// Finalisation step from MurmurHash3. InternedStrings are
+// unique pointers, so we only need to scramble the bits of
+// the pointer to get a good distribution in the table.
+size_t mix( uint64_t h )
+{
+	h ^= h >> 33;
+	h *= 0xff51afd7ed558ccdULL;
+	h ^= h >> 33;
+	h *= 0xc4ceb9fe1a85ec53ULL;
+	h ^= h >> 33;
+	return h;
+}
+
+size_t nameHash( const InternedString &name )
+{
+	return mix( reinterpret_cast<uintptr_t>( name.c_str() ) );
+}
+
+size_t inputHash( const ChildNamesMap::Input &input )
+{
+	return mix( reinterpret_cast<uintptr_t>( input.name.c_str() ) ^ ( input.index * 0x9e3779b97f4a7c15ULL ) );
+}
+
+// Functions for manipulating the open-addressed tables stored by
+// ChildNamesMap. Each slot holds a position plus one, with zero
+// denoting an empty slot. Keys are not stored, so callers provide an
+// `equal( position )` predicate to test the key for a position.
+
+using IndexTable = vector<std::atomic<uint32_t>>;
+
+const uint32_t g_emptySlot = 0;
 
-namespace GafferScene
+size_t tableSize( size_t numEntries )
 {
+	// Power of two, with a load factor no greater than two thirds.
+	size_t result = 8;
+	while( result < numEntries + numEntries / 2 + 1 )
+	{
+		result *= 2;
+	}
+	return result;
+}
 
-namespace Private
+// Returns the position for the key matched by `equal`, or -1.
+template<typename Equal>
+int64_t find( const IndexTable &table, size_t hash, Equal &&equal )
 {
+	if( table.empty() )
+	{
+		return -1;
+	}
 
-// Override `boost::hash_value()` to allow Input to be used
-/// with `hashed_index`.
-size_t hash_value( const ChildNamesMap::Input &v )
+	const size_t mask = table.size() - 1;
+	for( size_t i = hash & mask; ; i = ( i + 1 ) & mask )
+	{
+		const uint32_t slot = table[i].load( std::memory_order_relaxed );
+		if( slot == g_emptySlot )
+		{
+			return -1;
+		}
+		else if( equal( slot - 1 ) )
+		{
+			return slot - 1;
+		}
+	}
+}
+
+// Inserts `position` into the first empty slot, without
+// checking for an existing entry with the same key.
+void insert( IndexTable &table, size_t hash, uint32_t position )
 {
-	size_t s = 0;
-	boost::hash_combine( s, v.name );
-	boost::hash_combine( s, v.index );
-	return s;
+	const size_t mask = table.size() - 1;
+	for( size_t i = hash & mask; ; i = ( i + 1 ) & mask )
+	{
+		if( table[i].load( std::memory_order_relaxed ) == g_emptySlot )
+		{
+			table[i].store( position + 1, std::memory_order_relaxed );
+			return;
+		}
+	}
 }
 
+// Inserts `position`, unless an entry with the same key and a lower
+// position already exists. May be called concurrently, in which case
+// the lowest position for each key wins, regardless of the order in
+// which the calls are made.
+template<typename Equal>
+void insertLowest( IndexTable &table, size_t hash, uint32_t position, Equal &&equal )
+{
+	const size_t mask = table.size() - 1;
+	const uint32_t value = position + 1;
+
+	size_t i = hash & mask;
+	uint32_t slot = table[i].load();
+	while( true )
+	{
+		if( slot == g_emptySlot )
+		{
+			if( table[i].compare_exchange_weak( slot, value ) )
+			{
+				return;
+			}
+			// Lost a race for the slot. `slot` now holds the
+			// current value, so loop round to examine it.
+			continue;
+		}
+
+		if( equal( slot - 1 ) )
+		{
+			while( value < slot )
+			{
+				if( table[i].compare_exchange_weak( slot, value ) )
+				{
+					break;
+				}
+			}
+			return;
+		}
+
+		i = ( i + 1 ) & mask;
+		slot = table[i].load();
+	}
+}
+
+// Half-open range of numeric suffixes known to be in
+// use for a particular prefix.
+struct SuffixRange
+{
+	int begin = 0;
+	int end = 0;
+};
+
+} // namespace
+
+//////////////////////////////////////////////////////////////////////////
+// ChildNamesMap
+//////////////////////////////////////////////////////////////////////////
+
 ChildNamesMap::ChildNamesMap( const std::vector<IECore::ConstInternedStringVectorDataPtr> &inputChildNames )
 	:	m_childNames( new InternedStringVectorData() )
 {
-	vector<InternedString> &outputChildNames = m_childNames->writable();
-	boost::format namePrefixSuffixFormatter( "%s%d" );
+	// Concatenate the input names, and record the input each came from.
 
-	unordered_set<InternedString> allNames;
-	size_t index = 0;
+	vector<size_t> offsets; offsets.reserve( inputChildNames.size() );
+	size_t size = 0;
 	for( const auto &childNamesData : inputChildNames )
 	{
-		for( const auto &inputChildName : childNamesData->readable() )
+		offsets.push_back( size );
+		size += childNamesData->readable().size();
+	}
+
+	if( size >= numeric_limits<uint32_t>::max() )
+	{
+		throw IECore::Exception( boost::str( boost::format( "Too many children (%1%)" ) % size ) );
+	}
+
+	vector<InternedString> &outputChildNames = m_childNames->writable();
+	outputChildNames.resize( size );
+	m_inputs.resize( size );
+
+	forEachRange(
+		size,
+		[&] ( const tbb::blocked_range<size_t> &range ) {
+			size_t inputIndex = std::upper_bound( offsets.begin(), offsets.end(), range.begin() ) - offsets.begin() - 1;
+			for( size_t i = range.begin(); i != range.end(); ++i )
+			{
+				while( i >= offsets[inputIndex] + inputChildNames[inputIndex]->readable().size() )
+				{
+					// Skip to next non-empty input.
+					++inputIndex;
+				}
+				const InternedString &name = inputChildNames[inputIndex]->readable()[i - offsets[inputIndex]];
+				outputChildNames[i] = name;
+				m_inputs[i] = { name, inputIndex };
+			}
+		}
+	);
+
+	// Build the output table, recording the first occurrence of
+	// each name.
+
+	m_outputTable = IndexTable( tableSize( size ) );
+	forEachRange(
+		size,
+		[&] ( const tbb::blocked_range<size_t> &range ) {
+			for( size_t i = range.begin(); i != range.end(); ++i )
+			{
+				const InternedString &name = outputChildNames[i];
+				insertLowest(
+					m_outputTable, nameHash( name ), i,
+					[&] ( uint32_t position ) { return outputChildNames[position] == name; }
+				);
+			}
+		}
+	);
+
+	// Any child which isn't the first occurrence of its name
+	// clashes with an earlier child, and must be renamed.
+
+	vector<char> clashing( size, false );
+	forEachRange(
+		size,
+		[&] ( const tbb::blocked_range<size_t> &range ) {
+			for( size_t i = range.begin(); i != range.end(); ++i )
+			{
+				const InternedString &name = outputChildNames[i];
+				clashing[i] = find(
+					m_outputTable, nameHash( name ),
+					[&] ( uint32_t position ) { return outputChildNames[position] == name; }
+				) != (int64_t)i;
+			}
+		}
+	);
+
+	vector<uint32_t> clashes;
+	for( size_t i = 0; i < size; ++i )
+	{
+		if( clashing[i] )
 		{
-			InternedString outputChildName = inputChildName;
-			if( allNames.find( inputChildName ) != allNames.end() )
+			clashes.push_back( i );
+		}
+	}
+
+	if( clashes.size() )
+	{
+		renameClashes( clashes );
+	}
+}
+
+void ChildNamesMap::renameClashes( const std::vector<uint32_t> &clashes )
+{
+	vector<InternedString> &outputChildNames = m_childNames->writable();
+
+	// We must generate exactly the names that a naive serial implementation
+	// would, renaming each child in turn if its name is taken by an earlier
+	// child. `m_outputTable` tells us the first position for each of the
+	// original names, so a name is taken at `position` if it either occurs
+	// earlier in the original names, or has already been generated for an
+	// earlier child. Generating a name can take it from a later child that
+	// was otherwise unique, so we must then rename that child as well, in
+	// its proper turn.
+
+	unordered_map<InternedString, uint32_t> generated;
+	vector<pair<uint32_t, uint32_t>> displaced; // ( displaced position, generated position )
+	priority_queue<uint32_t, vector<uint32_t>, greater<uint32_t>> displacedQueue;
+
+	auto originalPosition = [&] ( const InternedString &name ) {
+		return find(
+			m_outputTable, nameHash( name ),
+			[&] ( uint32_t position ) { return outputChildNames[position] == name; }
+		);
+	};
+
+	// Numeric suffixes are tested in increasing order until a free name is
+	// found. Because names are never freed, we can remember the range of
+	// suffixes found to be in use for each prefix, and skip straight past
+	// them when the next child with the same prefix is renamed. This avoids
+	// quadratic behaviour when many children share the same name.
+	unordered_map<string, SuffixRange> usedSuffixes;
+
+	string prefix;
+	string candidate;
+	auto clashIt = clashes.begin();
+	while( clashIt != clashes.end() || !displacedQueue.empty() )
+	{
+		uint32_t position;
+		if( !displacedQueue.empty() && ( clashIt == clashes.end() || displacedQueue.top() < *clashIt ) )
+		{
+			position = displacedQueue.top();
+			displacedQueue.pop();
+		}
+		else
+		{
+			position = *clashIt++;
+		}
+
+		const int firstSuffix = IECore::StringAlgo::numericSuffix( outputChildNames[position].string(), 1, &prefix );
+		SuffixRange &used = usedSuffixes[prefix];
+
+		int suffix = firstSuffix;
+		InternedString newName;
+		while( true )
+		{
+			if( suffix >= used.begin && suffix < used.end )
 			{
-				// uniqueify the name
-				string prefix;
-				int suffix = IECore::StringAlgo::numericSuffix( inputChildName.string(), 1, &prefix );
+				suffix = used.end;
+			}
 
-				do
+			candidate = prefix;
+			candidate += std::to_string( suffix );
+			newName = candidate;
+
+			const int64_t p = originalPosition( newName );
+			if( ( p == -1 || p > position ) && !generated.count( newName ) )
+			{
+				if( p != -1 )
 				{
-					outputChildName = boost::str( namePrefixSuffixFormatter % prefix % suffix );
-					suffix++;
-				} while( allNames.find( outputChildName ) != allNames.end() );
+					displaced.push_back( { p, position } );
+					displacedQueue.push( p );
+				}
+				break;
 			}
+			suffix++;
+		}
 
-			allNames.insert( outputChildName );
-			outputChildNames.push_back( outputChildName );
+		generated[newName] = position;
 
-			m_map.insert( { { inputChildName, index }, outputChildName } );
+		// All suffixes from `firstSuffix` to `suffix` are now in use.
+		if( firstSuffix <= used.end && suffix + 1 >= used.begin )
+		{
+			used = { std::min( used.begin, firstSuffix ), std::max( used.end, suffix + 1 ) };
+		}
+		else
+		{
+			used = { firstSuffix, suffix + 1 };
 		}
-		index++;
 	}
+
+	// Now we know all the new names, we can update the output table.
+	// First we point the slots for any displaced children at the
+	// children that took their names. This must be done before we
+	// apply the renames, because we need the original names to find
+	// the slots.
+
+	const size_t mask = m_outputTable.size() - 1;
+	for( const auto &d : displaced )
+	{
+		const uint32_t displacedSlot = d.first + 1;
+		for( size_t i = nameHash( outputChildNames[d.first] ) & mask; ; i = ( i + 1 ) & mask )
+		{
+			if( m_outputTable[i].load( std::memory_order_relaxed ) == displacedSlot )
+			{
+				m_outputTable[i].store( d.second + 1, std::memory_order_relaxed );
+				break;
+			}
+		}
+	}
+
+	for( const auto &g : generated )
+	{
+		outputChildNames[g.second] = g.first;
+	}
+
+	// Then we add entries for all generated names that
+	// didn't displace anything.
+
+	for( const auto &g : generated )
+	{
+		if( originalPosition( g.first ) == -1 )
+		{
+			insert( m_outputTable, nameHash( g.first ), g.second );
+		}
+	}
+
+	// And finally we record the renamed children, so we can find
+	// them from their inputs.
+
+	m_renamedTable = IndexTable( tableSize( generated.size() ) );
+	for( const auto &g : generated )
+	{
+		insert( m_renamedTable, inputHash( m_inputs[g.second] ), g.second );
+	}
+}
+
+int64_t ChildNamesMap::outputPosition( const Input &input ) const
+{
+	const vector<InternedString> &outputChildNames = m_childNames->readable();
+	const int64_t position = find(
+		m_outputTable, nameHash( input.name ),
+		[&] ( uint32_t p ) { return outputChildNames[p] == input.name; }
+	);
+
+	if( position != -1 && m_inputs[position] == input )
+	{
+		// Child wasn't renamed.
+		return position;
+	}
+
+	return find(
+		m_renamedTable, inputHash( input ),
+		[&] ( uint32_t p ) { return m_inputs[p] == input; }
+	);
 }
 
 const IECore::InternedStringVectorData *ChildNamesMap::outputChildNames() const
@@ -121,19 +468,26 @@ const IECore::InternedStringVectorData *ChildNamesMap::outputChildNames() const
 
 const ChildNamesMap::Input &ChildNamesMap::input( IECore::InternedString outputName ) const
 {
-	auto it = m_map.find( outputName );
-	if( it == m_map.end() )
+	const vector<InternedString> &outputChildNames = m_childNames->readable();
+	const int64_t position = find(
+		m_outputTable, nameHash( outputName ),
+		[&] ( uint32_t p ) { return outputChildNames[p] == outputName; }
+	);
+
+	if( position == -1 )
 	{
 		throw IECore::Exception(
 			boost::str( boost::format( "Invalid child name \"%1%\"" ) % outputName )
 		);
 	}
 
-	return it->input;
+	return m_inputs[position];
 }
 
 IECore::PathMatcher ChildNamesMap::set( const std::vector<IECore::ConstPathMatcherDataPtr> &inputSets ) const
 {
+	const vector<InternedString> &outputChildNames = m_childNames->readable();
+
 	IECore::PathMatcher result;
 	size_t inputIndex = 0;
 	for( const auto &inputSetData : inputSets )
@@ -143,8 +497,8 @@ IECore::PathMatcher ChildNamesMap::set( const std::vector<IECore::ConstPathMatch
 			const PathMatcher &inputSet = inputSetData->readable();
 			// We want our outputSet to reference the data within inputSet rather
 			// than do an expensive copy. But we may need to rename the children of
-			// the root location according to m_map. Here we do that by taking subtrees
-			// of the input and adding them to our output under a renamed prefix.
+			// the root location according to our mapping. Here we do that by taking
+			// subtrees of the input and adding them to our output under a renamed prefix.
 			for( PathMatcher::RawIterator pIt = inputSet.begin(), peIt = inputSet.end(); pIt != peIt; ++pIt )
 			{
 				const vector<InternedString> &inputPath = *pIt;
@@ -155,11 +509,10 @@ IECore::PathMatcher ChildNamesMap::set( const std::vector<IECore::ConstPathMatch
 				}
 				assert( inputPath.size() == 1 );
 
-				const auto &inputMap = m_map.get<1>();
-				auto it = inputMap.find( Input{ inputPath[0], inputIndex } );
-				if( it != inputMap.end() )
+				const int64_t position = outputPosition( Input{ inputPath[0], inputIndex } );
+				if( position != -1 )
 				{
-					result.addPaths( inputSet.subTree( inputPath ), { it->output } );
+					result.addPaths( inputSet.subTree( inputPath ), { outputChildNames[position] } );
 				}
 				else
 				{
@@ -179,7 +532,3 @@ IECore::PathMatcher ChildNamesMap::set( const std::vector<IECore::ConstPathMatch
 
 	return result;
 }
-
-} // namespace Private
-
-} // namespace GafferScene
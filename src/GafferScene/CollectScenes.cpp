@@ -36,6 +36,7 @@
 
 #include "GafferScene/CollectScenes.h"
 
+#include "GafferScene/Private/MergeAlgo.h"
 #include "GafferScene/SceneAlgo.h"
 
 #include "Gaffer/Context.h"
@@ -421,6 +422,33 @@ void CollectScenes::compute( Gaffer::ValuePlug *output, const Gaffer::Context *c
 	SceneProcessor::compute( output, context );
 }
 
+Gaffer::ValuePlug::CachePolicy CollectScenes::hashCachePolicy( const Gaffer::ValuePlug *output ) const
+{
+	if(
+		output == outPlug()->globalsPlug() ||
+		output == outPlug()->setNamesPlug() ||
+		output == outPlug()->setPlug()
+	)
+	{
+		// These are computed in parallel for many root names.
+		return ValuePlug::CachePolicy::TaskCollaboration;
+	}
+	return SceneProcessor::hashCachePolicy( output );
+}
+
+Gaffer::ValuePlug::CachePolicy CollectScenes::computeCachePolicy( const Gaffer::ValuePlug *output ) const
+{
+	if(
+		output == outPlug()->globalsPlug() ||
+		output == outPlug()->setNamesPlug() ||
+		output == outPlug()->setPlug()
+	)
+	{
+		return ValuePlug::CachePolicy::TaskCollaboration;
+	}
+	return SceneProcessor::computeCachePolicy( output );
+}
+
 void CollectScenes::hashBound( const ScenePath &path, const Gaffer::Context *context, const ScenePlug *parent, IECore::MurmurHash &h ) const
 {
 	SourcePathScope sourcePathScope( context, this, path );
@@ -575,19 +603,29 @@ void CollectScenes::hashGlobals( const Gaffer::Context *context, const ScenePlug
 		return;
 	}
 
-	SourceScope sourceScope( context, rootNameVariablePlug()->getValue() );
+	const InternedString rootVariable = rootNameVariablePlug()->getValue();
 
 	if( mergeGlobalsPlug()->getValue() )
 	{
 		SceneProcessor::hashGlobals( context, parent, h );
-		for( const auto &root : rootTree->roots() )
+		const vector<string> &roots = rootTree->roots();
+		vector<MurmurHash> rootHashes( roots.size() );
+		Private::MergeAlgo::parallelFor(
+			roots.size(),
+			[&] ( size_t i ) {
+				SourceScope sourceScope( context, rootVariable );
+				sourceScope.setRoot( &roots[i] );
+				rootHashes[i] = inPlug()->globalsPlug()->hash();
+			}
+		);
+		for( const auto &rootHash : rootHashes )
 		{
-			sourceScope.setRoot( &root );
-			inPlug()->globalsPlug()->hash( h );
+			h.append( rootHash );
 		}
 	}
 	else
 	{
+		SourceScope sourceScope( context, rootVariable );
 		sourceScope.setRoot( &rootTree->roots()[0] );
 		h = inPlug()->globalsPlug()->hash();
 	}
@@ -601,15 +639,24 @@ IECore::ConstCompoundObjectPtr CollectScenes::computeGlobals( const Gaffer::Cont
 		return inPlug()->globalsPlug()->defaultValue();
 	}
 
-	SourceScope sourceScope( context, rootNameVariablePlug()->getValue() );
+	const InternedString rootVariable = rootNameVariablePlug()->getValue();
 
 	if( mergeGlobalsPlug()->getValue() )
 	{
+		const vector<string> &roots = rootTree->roots();
+		vector<ConstCompoundObjectPtr> rootGlobals( roots.size() );
+		Private::MergeAlgo::parallelFor(
+			roots.size(),
+			[&] ( size_t i ) {
+				SourceScope sourceScope( context, rootVariable );
+				sourceScope.setRoot( &roots[i] );
+				rootGlobals[i] = inPlug()->globalsPlug()->getValue();
+			}
+		);
+
 		CompoundObjectPtr result = new CompoundObject;
-		for( const auto &root : rootTree->roots() )
+		for( const auto &globals : rootGlobals )
 		{
-			sourceScope.setRoot( &root );
-			ConstCompoundObjectPtr globals = inPlug()->globalsPlug()->getValue();
 			for( const auto &m : globals->members() )
 			{
 				result->members()[m.first] = m.second;
@@ -619,6 +666,7 @@ IECore::ConstCompoundObjectPtr CollectScenes::computeGlobals( const Gaffer::Cont
 	}
 	else
 	{
+		SourceScope sourceScope( context, rootVariable );
 		sourceScope.setRoot( &rootTree->roots()[0] );
 		return inPlug()->globalsPlug()->getValue();
 	}
@@ -629,40 +677,44 @@ void CollectScenes::hashSetNames( const Gaffer::Context *context, const ScenePlu
 	SceneProcessor::hashSetNames( context, parent, h );
 
 	ConstRootTreePtr rootTree = boost::static_pointer_cast<const RootTree>( rootTreePlug()->getValue() );
+	const vector<string> &roots = rootTree->roots();
 	const ValuePlug *inSetNamesPlug = inPlug()->setNamesPlug();
+	const InternedString rootVariable = rootNameVariablePlug()->getValue();
+
+	vector<MurmurHash> rootHashes( roots.size() );
+	Private::MergeAlgo::parallelFor(
+		roots.size(),
+		[&] ( size_t i ) {
+			SourceScope sourceScope( context, rootVariable );
+			sourceScope.setRoot( &roots[i] );
+			rootHashes[i] = inSetNamesPlug->hash();
+		}
+	);
 
-	SourceScope sourceScope( context, rootNameVariablePlug()->getValue() );
-	for( const auto &root : rootTree->roots() )
+	for( const auto &rootHash : rootHashes )
 	{
-		sourceScope.setRoot( &root );
-		inSetNamesPlug->hash( h );
+		h.append( rootHash );
 	}
 }
 
 IECore::ConstInternedStringVectorDataPtr CollectScenes::computeSetNames( const Gaffer::Context *context, const ScenePlug *parent ) const
 {
 	ConstRootTreePtr rootTree = boost::static_pointer_cast<const RootTree>( rootTreePlug()->getValue() );
-
-	InternedStringVectorDataPtr setNamesData = new InternedStringVectorData;
-	vector<InternedString> &setNames = setNamesData->writable();
-
+	const vector<string> &roots = rootTree->roots();
 	const InternedStringVectorDataPlug *inSetNamesPlug = inPlug()->setNamesPlug();
-
-	SourceScope sourceScope( context, rootNameVariablePlug()->getValue() );
-	for( const auto &root : rootTree->roots() )
-	{
-		sourceScope.setRoot( &root );
-		ConstInternedStringVectorDataPtr inSetNamesData = inSetNamesPlug->getValue();
-		for( const auto &setName : inSetNamesData->readable() )
-		{
-			if( find( setNames.begin(), setNames.end(), setName ) == setNames.end() )
-			{
-				setNames.push_back( setName );
-			}
+	const InternedString rootVariable = rootNameVariablePlug()->getValue();
+
+	vector<ConstInternedStringVectorDataPtr> rootSetNames( roots.size() );
+	Private::MergeAlgo::parallelFor(
+		roots.size(),
+		[&] ( size_t i ) {
+			SourceScope sourceScope( context, rootVariable );
+			sourceScope.setRoot( &roots[i] );
+			rootSetNames[i] = inSetNamesPlug->getValue();
 		}
-	}
+	);
 
-	return setNamesData;
+	return Private::MergeAlgo::mergeNames( rootSetNames );
 }
 
 void CollectScenes::hashSet( const IECore::InternedString &setName, const Gaffer::Context *context, const ScenePlug *parent, IECore::MurmurHash &h ) const
@@ -675,16 +727,26 @@ void CollectScenes::hashSet( const IECore::InternedString &setName, const Gaffer
 		rootTree = boost::static_pointer_cast<const RootTree>( rootTreePlug()->getValue() );
 	}
 
+	const vector<string> &roots = rootTree->roots();
 	const PathMatcherDataPlug *inSetPlug = inPlug()->setPlug();
 	const StringPlug *sourceRootPlug = this->sourceRootPlug();
+	const InternedString rootVariable = rootNameVariablePlug()->getValue();
+
+	vector<MurmurHash> rootHashes( roots.size() );
+	Private::MergeAlgo::parallelFor(
+		roots.size(),
+		[&] ( size_t i ) {
+			SourceScope sourceScope( context, rootVariable );
+			sourceScope.setRoot( &roots[i] );
+			inSetPlug->hash( rootHashes[i] );
+			sourceRootPlug->hash( rootHashes[i] );
+			rootHashes[i].append( roots[i] );
+		}
+	);
 
-	SourceScope sourceScope( context, rootNameVariablePlug()->getValue() );
-	for( const auto &root : rootTree->roots() )
+	for( const auto &rootHash : rootHashes )
 	{
-		sourceScope.setRoot( &root );
-		inSetPlug->hash( h );
-		sourceRootPlug->hash( h );
-		h.append( root );
+		h.append( rootHash );
 	}
 }
 
@@ -696,33 +758,45 @@ IECore::ConstPathMatcherDataPtr CollectScenes::computeSet( const IECore::Interne
 		rootTree = boost::static_pointer_cast<const RootTree>( rootTreePlug()->getValue() );
 	}
 
-	PathMatcherDataPtr setData = new PathMatcherData;
-	PathMatcher &set = setData->writable();
-
+	const vector<string> &roots = rootTree->roots();
 	const PathMatcherDataPlug *inSetPlug = inPlug()->setPlug();
 	const StringPlug *sourceRootPlug = this->sourceRootPlug();
+	const InternedString rootVariable = rootNameVariablePlug()->getValue();
+
+	// Fetch the set for each root concurrently, relocating it
+	// under the root as we go. Relocation shares the input's
+	// PathMatcher nodes, so is cheap.
+
+	vector<ConstPathMatcherDataPtr> rootSets( roots.size() );
+	Private::MergeAlgo::parallelFor(
+		roots.size(),
+		[&] ( size_t i ) {
+			SourceScope sourceScope( context, rootVariable );
+			sourceScope.setRoot( &roots[i] );
+			ConstPathMatcherDataPtr inSetData = inSetPlug->getValue();
+			const PathMatcher &inSet = inSetData->readable();
+			if( inSet.isEmpty() )
+			{
+				return;
+			}
 
-	SourceScope sourceScope( context, rootNameVariablePlug()->getValue() );
-	ScenePlug::ScenePath prefix;
-	for( const auto &root : rootTree->roots() )
-	{
-		sourceScope.setRoot( &root );
-		ConstPathMatcherDataPtr inSetData = inSetPlug->getValue();
-		const PathMatcher &inSet = inSetData->readable();
-		if( !inSet.isEmpty() )
-		{
-			ScenePlug::stringToPath( root, prefix );
-			const string root = sourceRootPlug->getValue();
-			if( !root.empty() )
+			ScenePlug::ScenePath prefix;
+			ScenePlug::stringToPath( roots[i], prefix );
+			PathMatcherDataPtr rootSet = new PathMatcherData;
+			const string sourceRoot = sourceRootPlug->getValue();
+			if( !sourceRoot.empty() )
 			{
-				set.addPaths( inSet.subTree( root ), prefix );
+				rootSet->writable().addPaths( inSet.subTree( sourceRoot ), prefix );
 			}
 			else
 			{
-				set.addPaths( inSet, prefix );
+				rootSet->writable().addPaths( inSet, prefix );
 			}
+			rootSets[i] = rootSet;
 		}
-	}
+	);
 
-	return setData;
+	// Roots can't be nested, so the relocated sets are disjoint
+	// and the union is just a matter of grafting them together.
+	return Private::MergeAlgo::unionSets( rootSets );
 }
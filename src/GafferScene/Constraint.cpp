@@ -799,6 +799,64 @@ void computeUVLocalFrame( const IECore::Object& object, Imath::M44f& m, const Im
 	}
 }
 
+// Context variables used to pass the per-location target settings
+// through to `__targetTransform`. These are removed again before
+// evaluating the target scene.
+const InternedString g_targetModeContextName( "scene:constraint:targetMode" );
+const InternedString g_targetUVContextName( "scene:constraint:targetUV" );
+const InternedString g_targetVertexContextName( "scene:constraint:targetVertex" );
+const InternedString g_ignoreMissingTargetContextName( "scene:constraint:ignoreMissingTarget" );
+
+// Scope for evaluating `__targetTransform`. Only the settings relevant
+// to the target mode are transferred to the context, so that locations
+// sharing a target also share a single cached target transform.
+class TargetScope : public Context::EditableScope
+{
+
+	public :
+
+		TargetScope( const Context *context, const Constraint *constraint, const ScenePlug::ScenePath &targetPath )
+			:	EditableScope( context ), m_uv( 0 ), m_vertex( 0 ), m_ignoreMissingTarget( false )
+		{
+			m_targetMode = constraint->targetModePlug()->getValue();
+			if( m_targetMode == Constraint::UV )
+			{
+				m_uv = constraint->targetUVPlug()->getValue();
+				set( g_targetUVContextName, &m_uv );
+			}
+			else if( m_targetMode == Constraint::Vertex )
+			{
+				m_vertex = constraint->targetVertexPlug()->getValue();
+				set( g_targetVertexContextName, &m_vertex );
+			}
+
+			if( m_targetMode == Constraint::UV || m_targetMode == Constraint::Vertex )
+			{
+				m_ignoreMissingTarget = constraint->ignoreMissingTargetPlug()->getValue();
+				set( g_ignoreMissingTargetContextName, &m_ignoreMissingTarget );
+			}
+
+			set( g_targetModeContextName, &m_targetMode );
+			set( ScenePlug::scenePathContextName, &targetPath );
+		}
+
+	private :
+
+		int m_targetMode;
+		V2f m_uv;
+		int m_vertex;
+		bool m_ignoreMissingTarget;
+
+};
+
+void removeTargetVariables( Context::EditableScope &scope )
+{
+	scope.remove( g_targetModeContextName );
+	scope.remove( g_targetUVContextName );
+	scope.remove( g_targetVertexContextName );
+	scope.remove( g_ignoreMissingTargetContextName );
+}
+
 } // namespace
 
 GAFFER_NODE_DEFINE_TYPE( Constraint );
@@ -816,6 +874,7 @@ Constraint::Constraint( const std::string &name )
 	addChild( new V2fPlug( "targetUV" ) );
 	addChild( new IntPlug( "targetVertex", Plug::In, 0, 0 ) );
 	addChild( new V3fPlug( "targetOffset" ) );
+	addChild( new M44fPlug( "__targetTransform", Plug::Out ) );
 
 	// Pass through things we don't want to modify
 	outPlug()->attributesPlug()->setInput( inPlug()->attributesPlug() );
@@ -896,10 +955,36 @@ const Gaffer::V3fPlug *Constraint::targetOffsetPlug() const
 	return getChild<Gaffer::V3fPlug>( g_firstPlugIndex + 6 );
 }
 
+Gaffer::M44fPlug *Constraint::targetTransformPlug()
+{
+	return getChild<Gaffer::M44fPlug>( g_firstPlugIndex + 7 );
+}
+
+const Gaffer::M44fPlug *Constraint::targetTransformPlug() const
+{
+	return getChild<Gaffer::M44fPlug>( g_firstPlugIndex + 7 );
+}
+
 void Constraint::affects( const Gaffer::Plug *input, AffectedPlugsContainer &outputs ) const
 {
 	SceneElementProcessor::affects( input, outputs );
 
+	if(
+		input == inPlug()->transformPlug() ||
+		input == inPlug()->boundPlug() ||
+		input == inPlug()->objectPlug() ||
+		input == targetScenePlug()->transformPlug() ||
+		input == targetScenePlug()->boundPlug() ||
+		input == targetScenePlug()->objectPlug() ||
+		input == targetModePlug() ||
+		input->parent<Plug>() == targetUVPlug() ||
+		input == targetVertexPlug() ||
+		input == ignoreMissingTargetPlug()
+	)
+	{
+		outputs.push_back( targetTransformPlug() );
+	}
+
 	if(
 		input == targetPlug() ||
 		input == ignoreMissingTargetPlug() ||
@@ -914,6 +999,7 @@ void Constraint::affects( const Gaffer::Plug *input, AffectedPlugsContainer &out
 		input->parent<Plug>() == targetOffsetPlug() ||
 		input->parent<Plug>() == targetUVPlug() ||
 		input == targetVertexPlug() ||
+		input == targetTransformPlug() ||
 		// TypeId comparison is necessary to avoid calling pure virtual
 		// if we're called before being fully constructed.
 		( typeId() != staticTypeId() && affectsConstraint( input ) )
@@ -924,78 +1010,78 @@ void Constraint::affects( const Gaffer::Plug *input, AffectedPlugsContainer &out
 	}
 }
 
-bool Constraint::processesTransform() const
+void Constraint::hash( const Gaffer::ValuePlug *output, const Gaffer::Context *context, IECore::MurmurHash &h ) const
 {
-	return true;
-}
+	SceneElementProcessor::hash( output, context, h );
 
-void Constraint::hashProcessedTransform( const ScenePath &path, const Gaffer::Context *context, IECore::MurmurHash &h ) const
-{
-	auto targetOpt = target();
-	if( !targetOpt )
+	if( output != targetTransformPlug() )
 	{
-		// Pass through input unchanged
-		h = inPlug()->transformPlug()->hash();
 		return;
 	}
 
-	ScenePath parentPath = path;
-	parentPath.pop_back();
-	h.append( inPlug()->fullTransformHash( parentPath ) );
-
-	h.append( targetOpt->scene->fullTransformHash( targetOpt->path ) );
-
-	const TargetMode targetMode = (TargetMode)targetModePlug()->getValue();
+	const ScenePath &targetPath = context->get<ScenePath>( ScenePlug::scenePathContextName );
+	const int targetMode = context->get<int>( g_targetModeContextName );
 	h.append( targetMode );
 	switch( targetMode )
 	{
-		case Constraint::BoundMin:
-		case Constraint::BoundMax:
-		case Constraint::BoundCenter:
-			h.append( targetOpt->scene->boundHash( targetOpt->path ) );
+		case Constraint::UV :
+			h.append( context->get<V2f>( g_targetUVContextName ) );
+			h.append( context->get<bool>( g_ignoreMissingTargetContextName ) );
 			break;
-		case Constraint::UV:
-			h.append( targetOpt->scene->objectHash( targetOpt->path ) );
-			ignoreMissingTargetPlug()->hash( h );
-			targetUVPlug()->hash( h );
+		case Constraint::Vertex :
+			h.append( context->get<int>( g_targetVertexContextName ) );
+			h.append( context->get<bool>( g_ignoreMissingTargetContextName ) );
 			break;
-		case Constraint::Vertex:
-			h.append( targetOpt->scene->objectHash( targetOpt->path ) );
-			ignoreMissingTargetPlug()->hash( h );
-			targetVertexPlug()->hash( h );
-			break;
-		default:
+		default :
 			break;
 	}
 
-	targetOffsetPlug()->hash( h );
+	Context::EditableScope scope( context );
+	removeTargetVariables( scope );
 
-	hashConstraint( context, h );
+	const ScenePlug *scene = targetScene();
+	h.append( scene->fullTransformHash( targetPath ) );
+	switch( targetMode )
+	{
+		case Constraint::BoundMin :
+		case Constraint::BoundMax :
+		case Constraint::BoundCenter :
+			h.append( scene->boundHash( targetPath ) );
+			break;
+		case Constraint::UV :
+		case Constraint::Vertex :
+			h.append( scene->objectHash( targetPath ) );
+			break;
+		default :
+			break;
+	}
 }
 
-Imath::M44f Constraint::computeProcessedTransform( const ScenePath &path, const Gaffer::Context *context, const Imath::M44f &inputTransform ) const
+void Constraint::compute( Gaffer::ValuePlug *output, const Gaffer::Context *context ) const
 {
-	auto targetOpt = target();
-	if( !targetOpt )
+	if( output != targetTransformPlug() )
 	{
-		return inputTransform;
+		SceneElementProcessor::compute( output, context );
+		return;
 	}
 
-	ScenePath parentPath = path;
-	parentPath.pop_back();
+	const ScenePath &targetPath = context->get<ScenePath>( ScenePlug::scenePathContextName );
+	const TargetMode targetMode = (TargetMode)context->get<int>( g_targetModeContextName );
+	const bool throwOnError = !context->get<bool>( g_ignoreMissingTargetContextName, false );
+	const V2f uv = context->get<V2f>( g_targetUVContextName, V2f( 0 ) );
+	const int vertexId = context->get<int>( g_targetVertexContextName, 0 );
 
-	const M44f parentTransform = inPlug()->fullTransform( parentPath );
-	const M44f fullInputTransform = inputTransform * parentTransform;
+	Context::EditableScope scope( context );
+	removeTargetVariables( scope );
 
-	M44f fullTargetTransform = targetOpt->scene->fullTransform( targetOpt->path );
-
-	const TargetMode targetMode = (TargetMode)targetModePlug()->getValue();
+	const ScenePlug *scene = targetScene();
+	M44f fullTargetTransform = scene->fullTransform( targetPath );
 
 	switch( targetMode )
 	{
 		case Constraint::BoundMin:
 		{
-			const Box3f targetBound = targetOpt->scene->bound( targetOpt->path );
+			const Box3f targetBound = scene->bound( targetPath );
 			if( ! targetBound.isEmpty() )
 			{
 				fullTargetTransform.translate( targetBound.min );
@@ -1004,7 +1090,7 @@ Imath::M44f Constraint::computeProcessedTransform( const ScenePath &path, const
 		}
 		case Constraint::BoundMax:
 		{
-			const Box3f targetBound = targetOpt->scene->bound( targetOpt->path );
+			const Box3f targetBound = scene->bound( targetPath );
 			if( ! targetBound.isEmpty() )
 			{
 				fullTargetTransform.translate( targetBound.max );
@@ -1013,7 +1099,7 @@ Imath::M44f Constraint::computeProcessedTransform( const ScenePath &path, const
 		}
 		case Constraint::BoundCenter:
 		{
-			const Box3f targetBound = targetOpt->scene->bound( targetOpt->path );
+			const Box3f targetBound = scene->bound( targetPath );
 			if( ! targetBound.isEmpty() )
 			{
 				fullTargetTransform.translate( targetBound.center() );
@@ -1022,20 +1108,16 @@ Imath::M44f Constraint::computeProcessedTransform( const ScenePath &path, const
 		}
 		case Constraint::UV:
 		{
-			const IECore::ConstObjectPtr object = targetOpt->scene->object( targetOpt->path );
+			const IECore::ConstObjectPtr object = scene->object( targetPath );
 			Imath::M44f surfaceTransform;
-			const Imath::V2f uv = targetUVPlug()->getValue();
-			const bool throwOnError = !( ignoreMissingTargetPlug()->getValue() );
 			computeUVLocalFrame( *object, surfaceTransform, uv, "uv", throwOnError, context->canceller() );
 			fullTargetTransform = surfaceTransform * fullTargetTransform;
 			break;
 		}
 		case Constraint::Vertex:
 		{
-			const IECore::ConstObjectPtr object = targetOpt->scene->object( targetOpt->path );
+			const IECore::ConstObjectPtr object = scene->object( targetPath );
 			Imath::M44f surfaceTransform;
-			const int vertexId = targetVertexPlug()->getValue();
-			const bool throwOnError = !( ignoreMissingTargetPlug()->getValue() );
 			computeVertexLocalFrame( *object, surfaceTransform, vertexId, "uv", throwOnError, context->canceller() );
 			fullTargetTransform = surfaceTransform * fullTargetTransform;
 			break;
@@ -1044,6 +1126,69 @@ Imath::M44f Constraint::computeProcessedTransform( const ScenePath &path, const
 			break;
 	}
 
+	static_cast<M44fPlug *>( output )->setValue( fullTargetTransform );
+}
+
+Gaffer::ValuePlug::CachePolicy Constraint::computeCachePolicy( const Gaffer::ValuePlug *output ) const
+{
+	if( output == targetTransformPlug() )
+	{
+		// Many locations will typically request the same target
+		// concurrently, so we want only one of them to compute it.
+		return ValuePlug::CachePolicy::Standard;
+	}
+	return SceneElementProcessor::computeCachePolicy( output );
+}
+
+bool Constraint::processesTransform() const
+{
+	return true;
+}
+
+void Constraint::hashProcessedTransform( const ScenePath &path, const Gaffer::Context *context, IECore::MurmurHash &h ) const
+{
+	auto targetOpt = target();
+	if( !targetOpt )
+	{
+		// Pass through input unchanged
+		h = inPlug()->transformPlug()->hash();
+		return;
+	}
+
+	ScenePath parentPath = path;
+	parentPath.pop_back();
+	h.append( inPlug()->fullTransformHash( parentPath ) );
+
+	{
+		TargetScope targetScope( context, this, targetOpt->path );
+		h.append( targetTransformPlug()->hash() );
+	}
+
+	targetOffsetPlug()->hash( h );
+
+	hashConstraint( context, h );
+}
+
+Imath::M44f Constraint::computeProcessedTransform( const ScenePath &path, const Gaffer::Context *context, const Imath::M44f &inputTransform ) const
+{
+	auto targetOpt = target();
+	if( !targetOpt )
+	{
+		return inputTransform;
+	}
+
+	ScenePath parentPath = path;
+	parentPath.pop_back();
+
+	const M44f parentTransform = inPlug()->fullTransform( parentPath );
+	const M44f fullInputTransform = inputTransform * parentTransform;
+
+	M44f fullTargetTransform;
+	{
+		TargetScope targetScope( context, this, targetOpt->path );
+		fullTargetTransform = targetTransformPlug()->getValue();
+	}
+
 	fullTargetTransform.translate( targetOffsetPlug()->getValue() );
 
 	const M44f fullConstrainedTransform = computeConstraint( fullTargetTransform, fullInputTransform, inputTransform );
@@ -1061,14 +1206,7 @@ std::optional<Constraint::Target> Constraint::target() const
 	ScenePath targetPath;
 	ScenePlug::stringToPath( targetPathAsString, targetPath );
 
-	const ScenePlug *targetScene = targetScenePlug();
-	if( !targetScene->getInput() )
-	{
-		// Backwards compatibility for time when there was
-		// no `targetScene` plug.
-		targetScene = inPlug();
-	}
-
+	const ScenePlug *targetScene = this->targetScene();
 	if( !targetScene->exists( targetPath ) )
 	{
 		if( ignoreMissingTargetPlug()->getValue() )
@@ -1084,3 +1222,14 @@ std::optional<Constraint::Target> Constraint::target() const
 
 	return Target( { targetPath, targetScene } );
 }
+
+const ScenePlug *Constraint::targetScene() const
+{
+	if( !targetScenePlug()->getInput() )
+	{
+		// Backwards compatibility for time when there was
+		// no `targetScene` plug.
+		return inPlug();
+	}
+	return targetScenePlug();
+}
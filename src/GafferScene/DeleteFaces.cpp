@@ -38,17 +38,386 @@
 
 #include "Gaffer/StringPlug.h"
 
-#include "IECoreScene/MeshAlgo.h"
 #include "IECoreScene/MeshPrimitive.h"
 
+#include "IECore/DataAlgo.h"
+#include "IECore/TypeTraits.h"
+
 #include "boost/algorithm/string.hpp"
 #include "boost/format.hpp"
 
+#include "tbb/parallel_for.h"
+#include "tbb/parallel_scan.h"
+
+#include <atomic>
+
+using namespace std;
 using namespace IECore;
 using namespace IECoreScene;
 using namespace Gaffer;
 using namespace GafferScene;
 
+//////////////////////////////////////////////////////////////////////////
+// Face deletion
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+using Range = tbb::blocked_range<size_t>;
+
+// Uses a parallel prefix sum to compute the index of each kept element
+// in the compacted output. Elements which are not kept are given an index
+// of -1. Returns the number of kept elements.
+template<typename KeepFunctor>
+size_t compactIndices( size_t size, KeepFunctor &&keep, vector<int> &indices, const Canceller *canceller )
+{
+	indices.resize( size );
+	return tbb::parallel_scan(
+		Range( 0, size ),
+		size_t( 0 ),
+		[&] ( const Range &range, size_t sum, bool isFinalScan ) {
+			Canceller::check( canceller );
+			for( size_t i = range.begin(); i != range.end(); ++i )
+			{
+				const bool k = keep( i );
+				if( isFinalScan )
+				{
+					indices[i] = k ? sum : -1;
+				}
+				sum += k;
+			}
+			return sum;
+		},
+		std::plus<size_t>()
+	);
+}
+
+template<typename T>
+size_t compactFaceIndices( const TypedData<vector<T>> *deleteData, const IntVectorData *deleteIndices, bool invert, vector<int> &indices, const Canceller *canceller )
+{
+	const vector<T> &flags = deleteData->readable();
+	const vector<int> *flagIndices = deleteIndices ? &deleteIndices->readable() : nullptr;
+	return compactIndices(
+		flagIndices ? flagIndices->size() : flags.size(),
+		[&] ( size_t i ) {
+			return bool( flags[flagIndices ? (*flagIndices)[i] : i] ) == invert;
+		},
+		indices, canceller
+	);
+}
+
+// Copies the elements which have an index in the compacted output,
+// processing ranges of elements in parallel.
+struct Compact
+{
+
+	Compact( const vector<int> &indices, size_t size, const Canceller *canceller )
+		:	m_indices( indices ), m_size( size ), m_canceller( canceller )
+	{
+	}
+
+	template<typename T>
+	DataPtr operator()( const T *data, typename std::enable_if<TypeTraits::IsVectorTypedData<T>::value>::type *enabler = nullptr ) const
+	{
+		const auto &in = data->readable();
+
+		typename T::Ptr result = new T;
+		auto &out = result->writable();
+		out.resize( m_size );
+
+		tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+		tbb::parallel_for(
+			Range( 0, in.size() ),
+			[&] ( const Range &range ) {
+				Canceller::check( m_canceller );
+				for( size_t i = range.begin(); i != range.end(); ++i )
+				{
+					if( m_indices[i] >= 0 )
+					{
+						out[m_indices[i]] = in[i];
+					}
+				}
+			},
+			taskGroupContext
+		);
+
+		const GeometricData::Interpretation interpretation = getGeometricInterpretation( data );
+		if( interpretation != GeometricData::None )
+		{
+			setGeometricInterpretation( result.get(), interpretation );
+		}
+
+		return result;
+	}
+
+	// Elements of `std::vector<bool>` can't be written concurrently.
+	DataPtr operator()( const BoolVectorData *data ) const
+	{
+		const vector<bool> &in = data->readable();
+
+		BoolVectorDataPtr result = new BoolVectorData;
+		vector<bool> &out = result->writable();
+		out.reserve( m_size );
+
+		for( size_t i = 0; i < in.size(); ++i )
+		{
+			if( m_indices[i] >= 0 )
+			{
+				out.push_back( in[i] );
+			}
+		}
+
+		return result;
+	}
+
+	DataPtr operator()( const Data *data ) const
+	{
+		return nullptr;
+	}
+
+	private :
+
+		const vector<int> &m_indices;
+		const size_t m_size;
+		const Canceller *m_canceller;
+
+};
+
+PrimitiveVariable compactPrimitiveVariable( const std::string &name, const PrimitiveVariable &primitiveVariable, const vector<int> &indices, size_t size, const Canceller *canceller )
+{
+	const Compact compact( indices, size, canceller );
+
+	// For indexed primitive variables we only need to compact the
+	// indices, and the data can be shared with the input.
+	const Data *data = primitiveVariable.indices ? primitiveVariable.indices.get() : primitiveVariable.data.get();
+	if( IECore::size( data ) != indices.size() )
+	{
+		throw InvalidArgumentException( boost::str( boost::format( "DeleteFaces : Primitive variable \"%s\" has the wrong size" ) % name ) );
+	}
+
+	DataPtr compacted = dispatch( data, compact );
+	if( !compacted )
+	{
+		throw InvalidArgumentException( boost::str( boost::format( "DeleteFaces : Primitive variable \"%s\" has unsupported type \"%s\"" ) % name % data->typeName() ) );
+	}
+
+	if( primitiveVariable.indices )
+	{
+		return PrimitiveVariable( primitiveVariable.interpolation, primitiveVariable.data, runTimeCast<IntVectorData>( compacted ) );
+	}
+	return PrimitiveVariable( primitiveVariable.interpolation, compacted );
+}
+
+MeshPrimitivePtr deleteFaces( const MeshPrimitive *mesh, const std::string &deleteName, const PrimitiveVariable &deleteVariable, bool invert, const Canceller *canceller )
+{
+	// Compute the output index for each face, face-vertex and vertex,
+	// using a parallel prefix sum over the elements we are keeping.
+
+	vector<int> faceIndices;
+	size_t numFaces = 0;
+	if( deleteVariable.interpolation == PrimitiveVariable::Uniform )
+	{
+		if( auto intData = runTimeCast<const IntVectorData>( deleteVariable.data.get() ) )
+		{
+			numFaces = compactFaceIndices( intData, deleteVariable.indices.get(), invert, faceIndices, canceller );
+		}
+		else if( auto boolData = runTimeCast<const BoolVectorData>( deleteVariable.data.get() ) )
+		{
+			numFaces = compactFaceIndices( boolData, deleteVariable.indices.get(), invert, faceIndices, canceller );
+		}
+		else if( auto floatData = runTimeCast<const FloatVectorData>( deleteVariable.data.get() ) )
+		{
+			numFaces = compactFaceIndices( floatData, deleteVariable.indices.get(), invert, faceIndices, canceller );
+		}
+		else
+		{
+			throw InvalidArgumentException( boost::str( boost::format( "DeleteFaces : Primitive variable \"%s\" must be IntVectorData, BoolVectorData or FloatVectorData" ) % deleteName ) );
+		}
+	}
+	else
+	{
+		throw InvalidArgumentException( boost::str( boost::format( "DeleteFaces : Primitive variable \"%s\" must have Uniform interpolation" ) % deleteName ) );
+	}
+
+	const vector<int> &verticesPerFace = mesh->verticesPerFace()->readable();
+	const vector<int> &vertexIds = mesh->vertexIds()->readable();
+	if( faceIndices.size() != verticesPerFace.size() )
+	{
+		throw InvalidArgumentException( boost::str( boost::format( "DeleteFaces : Primitive variable \"%s\" has the wrong size" ) % deleteName ) );
+	}
+
+	vector<size_t> faceOffsets;
+	faceOffsets.reserve( verticesPerFace.size() );
+	size_t faceOffset = 0;
+	for( int numVertices : verticesPerFace )
+	{
+		faceOffsets.push_back( faceOffset );
+		faceOffset += numVertices;
+	}
+
+	vector<char> faceVertexKept( vertexIds.size() );
+	vector<std::atomic<char>> vertexUsed( mesh->variableSize( PrimitiveVariable::Vertex ) );
+
+	tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+	tbb::parallel_for(
+		Range( 0, verticesPerFace.size() ),
+		[&] ( const Range &range ) {
+			Canceller::check( canceller );
+			for( size_t face = range.begin(); face != range.end(); ++face )
+			{
+				const bool kept = faceIndices[face] >= 0;
+				for( size_t i = faceOffsets[face], e = i + verticesPerFace[face]; i < e; ++i )
+				{
+					faceVertexKept[i] = kept;
+					if( kept )
+					{
+						vertexUsed[vertexIds[i]].store( 1, std::memory_order_relaxed );
+					}
+				}
+			}
+		},
+		taskGroupContext
+	);
+
+	vector<int> faceVertexIndices;
+	const size_t numFaceVertices = compactIndices(
+		faceVertexKept.size(), [&] ( size_t i ) { return faceVertexKept[i]; }, faceVertexIndices, canceller
+	);
+
+	vector<int> vertexIndices;
+	const size_t numVertices = compactIndices(
+		vertexUsed.size(), [&] ( size_t i ) { return vertexUsed[i].load( std::memory_order_relaxed ); }, vertexIndices, canceller
+	);
+
+	// Build the new topology.
+
+	IntVectorDataPtr newVerticesPerFaceData = runTimeCast<IntVectorData>( Compact( faceIndices, numFaces, canceller )( mesh->verticesPerFace() ) );
+
+	IntVectorDataPtr newVertexIdsData = new IntVectorData;
+	vector<int> &newVertexIds = newVertexIdsData->writable();
+	newVertexIds.resize( numFaceVertices );
+	tbb::parallel_for(
+		Range( 0, vertexIds.size() ),
+		[&] ( const Range &range ) {
+			Canceller::check( canceller );
+			for( size_t i = range.begin(); i != range.end(); ++i )
+			{
+				if( faceVertexIndices[i] >= 0 )
+				{
+					newVertexIds[faceVertexIndices[i]] = vertexIndices[vertexIds[i]];
+				}
+			}
+		},
+		taskGroupContext
+	);
+
+	MeshPrimitivePtr result = new MeshPrimitive( newVerticesPerFaceData, newVertexIdsData, mesh->interpolation() );
+
+	// Keep the corners and creases for the remaining vertices. Creases
+	// are chains of vertices, so are split wherever a vertex is removed.
+
+	const vector<int> &cornerIds = mesh->cornerIds()->readable();
+	if( cornerIds.size() )
+	{
+		const vector<float> &cornerSharpnesses = mesh->cornerSharpnesses()->readable();
+		IntVectorDataPtr newCornerIdsData = new IntVectorData;
+		FloatVectorDataPtr newCornerSharpnessesData = new FloatVectorData;
+		for( size_t i = 0; i < cornerIds.size(); ++i )
+		{
+			const int vertexIndex = vertexIndices[cornerIds[i]];
+			if( vertexIndex >= 0 )
+			{
+				newCornerIdsData->writable().push_back( vertexIndex );
+				newCornerSharpnessesData->writable().push_back( cornerSharpnesses[i] );
+			}
+		}
+		result->setCorners( newCornerIdsData.get(), newCornerSharpnessesData.get() );
+	}
+
+	const vector<int> &creaseLengths = mesh->creaseLengths()->readable();
+	if( creaseLengths.size() )
+	{
+		const vector<int> &creaseIds = mesh->creaseIds()->readable();
+		const vector<float> &creaseSharpnesses = mesh->creaseSharpnesses()->readable();
+		IntVectorDataPtr newCreaseLengthsData = new IntVectorData;
+		IntVectorDataPtr newCreaseIdsData = new IntVectorData;
+		FloatVectorDataPtr newCreaseSharpnessesData = new FloatVectorData;
+		vector<int> &newCreaseLengths = newCreaseLengthsData->writable();
+		vector<int> &newCreaseIds = newCreaseIdsData->writable();
+		vector<float> &newCreaseSharpnesses = newCreaseSharpnessesData->writable();
+
+		size_t creaseOffset = 0;
+		for( size_t crease = 0; crease < creaseLengths.size(); ++crease )
+		{
+			int runLength = 0;
+			auto endRun = [&] {
+				if( runLength >= 2 )
+				{
+					newCreaseLengths.push_back( runLength );
+					newCreaseSharpnesses.push_back( creaseSharpnesses[crease] );
+				}
+				else
+				{
+					newCreaseIds.resize( newCreaseIds.size() - runLength );
+				}
+				runLength = 0;
+			};
+
+			for( int i = 0; i < creaseLengths[crease]; ++i )
+			{
+				const int vertexIndex = vertexIndices[creaseIds[creaseOffset + i]];
+				if( vertexIndex >= 0 )
+				{
+					newCreaseIds.push_back( vertexIndex );
+					runLength++;
+				}
+				else
+				{
+					endRun();
+				}
+			}
+			endRun();
+			creaseOffset += creaseLengths[crease];
+		}
+
+		if( newCreaseLengths.size() )
+		{
+			result->setCreases( newCreaseLengthsData.get(), newCreaseIdsData.get(), newCreaseSharpnessesData.get() );
+		}
+	}
+
+	// Compact the primitive variables.
+
+	for( const auto &primitiveVariable : mesh->variables )
+	{
+		switch( primitiveVariable.second.interpolation )
+		{
+			case PrimitiveVariable::Uniform :
+				result->variables[primitiveVariable.first] = compactPrimitiveVariable( primitiveVariable.first, primitiveVariable.second, faceIndices, numFaces, canceller );
+				break;
+			case PrimitiveVariable::Vertex :
+			case PrimitiveVariable::Varying :
+				result->variables[primitiveVariable.first] = compactPrimitiveVariable( primitiveVariable.first, primitiveVariable.second, vertexIndices, numVertices, canceller );
+				break;
+			case PrimitiveVariable::FaceVarying :
+				result->variables[primitiveVariable.first] = compactPrimitiveVariable( primitiveVariable.first, primitiveVariable.second, faceVertexIndices, numFaceVertices, canceller );
+				break;
+			default :
+				result->variables[primitiveVariable.first] = primitiveVariable.second;
+				break;
+		}
+	}
+
+	return result;
+}
+
+} // namespace
+
+//////////////////////////////////////////////////////////////////////////
+// DeleteFaces
+//////////////////////////////////////////////////////////////////////////
+
 GAFFER_NODE_DEFINE_TYPE( DeleteFaces );
 
 size_t DeleteFaces::g_firstPlugIndex = 0;
@@ -141,5 +510,11 @@ IECore::ConstObjectPtr DeleteFaces::computeProcessedObject( const ScenePath &pat
 		throw InvalidArgumentException( boost::str( boost::format( "DeleteFaces : No primitive variable \"%s\" found" ) % deletePrimVarName ) );
 	}
 
-	return MeshAlgo::deleteFaces( mesh, it->second, invertPlug()->getValue(), context->canceller() );
+	return deleteFaces( mesh, deletePrimVarName, it->second, invertPlug()->getValue(), context->canceller() );
+}
+
+Gaffer::ValuePlug::CachePolicy DeleteFaces::processedObjectComputeCachePolicy() const
+{
+	// We spawn TBB tasks to compact the mesh in parallel.
+	return ValuePlug::CachePolicy::TaskCollaboration;
 }
@@ -43,13 +43,32 @@
 #include "IECore/NullObject.h"
 #include "IECore/StringAlgo.h"
 
-#include <unordered_map>
+#include "boost/format.hpp"
+
+#include "tbb/parallel_reduce.h"
 
 using namespace std;
 using namespace IECore;
 using namespace Gaffer;
 using namespace GafferScene;
 
+//////////////////////////////////////////////////////////////////////////
+// DuplicatesData
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+// The transform for copy `i` is the transform for copy `i - 1`, multiplied by
+// the `transform` plug matrix. Rather than store the transform for every copy,
+// we store one checkpoint every `g_checkpointInterval` copies, and generate the
+// rest on demand by continuing the chain of multiplications from the nearest
+// checkpoint. This gives results identical to storing every transform, for a
+// fraction of the memory.
+const int g_checkpointInterval = 64;
+
+} // namespace
+
 class Duplicate::DuplicatesData : public IECore::Data
 {
 
@@ -62,47 +81,47 @@ class Duplicate::DuplicatesData : public IECore::Data
 			// The names of the duplicates are composed of a stem and possibly a
 			// numeric suffix.
 
-			std::string stem;
-			int suffix;
-
 			const std::string name = node->namePlug()->getValue();
 			const int copies = node->copiesPlug()->getValue();
 
 			if( name.size() )
 			{
-				const int nameSuffix = StringAlgo::numericSuffix( name, &stem );
-				suffix = copies == 1 ? nameSuffix : max( nameSuffix, 1 );
+				const int nameSuffix = StringAlgo::numericSuffix( name, &m_stem );
+				m_firstSuffix = copies == 1 ? nameSuffix : max( nameSuffix, 1 );
 			}
 			else
 			{
 				// No explicit name provided. Derive stem and suffix from source.
-				suffix = StringAlgo::numericSuffix( source.back(), 0, &stem );
-				suffix++;
+				m_firstSuffix = StringAlgo::numericSuffix( source.back(), 0, &m_stem );
+				m_firstSuffix++;
 			}
 
-			// Generate names, and at the same time, the transforms associated with them.
+			// Generate names, and at the same time, the transform checkpoints.
 
 			m_names = new InternedStringVectorData;
 			std::vector<InternedString> &names = m_names->writable();
 			names.reserve( copies );
 
-			const Imath::M44f matrix = node->transformPlug()->matrix();
+			m_matrix = node->transformPlug()->matrix();
+			m_checkpoints.reserve( copies / g_checkpointInterval + 1 );
 
-			if( suffix == -1 )
+			if( m_firstSuffix == -1 )
 			{
 				assert( copies == 1 );
-				names.push_back( stem );
-				m_transforms[stem] = matrix;
+				names.push_back( m_stem );
+				m_checkpoints.push_back( m_matrix );
 			}
 			else
 			{
-				Imath::M44f m = matrix;
+				Imath::M44f m = m_matrix;
 				for( int i = 0; i < copies; ++i )
 				{
-					InternedString name = stem + std::to_string( suffix++ );
-					names.push_back( name );
-					m_transforms[name] = m;
-					m = m * matrix;
+					names.push_back( m_stem + std::to_string( m_firstSuffix + i ) );
+					if( i % g_checkpointInterval == 0 )
+					{
+						m_checkpoints.push_back( m );
+					}
+					m = m * m_matrix;
 				}
 			}
 		}
@@ -130,15 +149,87 @@ class Duplicate::DuplicatesData : public IECore::Data
 			return m_names;
 		}
 
-		const Imath::M44f &transform( const IECore::InternedString &name ) const
+		Imath::M44f transform( const IECore::InternedString &name ) const
+		{
+			const size_t index = copyIndex( name );
+			Imath::M44f result = m_checkpoints[index / g_checkpointInterval];
+			for( size_t i = index % g_checkpointInterval; i; --i )
+			{
+				result = result * m_matrix;
+			}
+			return result;
+		}
+
+		// Returns the union of `sourceBound` transformed by the transform of every
+		// copy, followed by `transform`. Each range of copies continues the
+		// chain of multiplications from its checkpoint, so the matrices are
+		// identical to those returned by `transform( name )`.
+		Imath::Box3f bound( const Imath::Box3f &sourceBound, const Imath::M44f &transform, const IECore::Canceller *canceller ) const
 		{
-			return m_transforms.at( name );
+			if( sourceBound.isEmpty() )
+			{
+				return Imath::Box3f();
+			}
+
+			const size_t numCopies = m_names->readable().size();
+			tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+			return tbb::parallel_reduce(
+				tbb::blocked_range<size_t>( 0, m_checkpoints.size() ),
+				Imath::Box3f(),
+				[&] ( const tbb::blocked_range<size_t> &range, const Imath::Box3f &init ) {
+					Imath::Box3f result = init;
+					for( size_t c = range.begin(); c != range.end(); ++c )
+					{
+						Canceller::check( canceller );
+						Imath::M44f m = m_checkpoints[c];
+						const size_t end = std::min( ( c + 1 ) * g_checkpointInterval, numCopies );
+						for( size_t i = c * g_checkpointInterval; i < end; ++i )
+						{
+							result.extendBy( Imath::transform( sourceBound, m * transform ) );
+							m = m * m_matrix;
+						}
+					}
+					return result;
+				},
+				[] ( const Imath::Box3f &x, const Imath::Box3f &y ) {
+					Imath::Box3f result = x;
+					result.extendBy( y );
+					return result;
+				},
+				tbb::auto_partitioner(),
+				taskGroupContext
+			);
 		}
 
 	private :
 
+		size_t copyIndex( const IECore::InternedString &name ) const
+		{
+			const std::vector<InternedString> &names = m_names->readable();
+			if( m_firstSuffix == -1 )
+			{
+				if( name == names[0] )
+				{
+					return 0;
+				}
+			}
+			else
+			{
+				const int index = StringAlgo::numericSuffix( name.string(), -1 ) - m_firstSuffix;
+				if( index >= 0 && index < (int)names.size() && names[index] == name )
+				{
+					return index;
+				}
+			}
+
+			throw IECore::Exception( boost::str( boost::format( "Duplicate \"%1%\" does not exist" ) % name.string() ) );
+		}
+
 		InternedStringVectorDataPtr m_names;
-		unordered_map<InternedString, Imath::M44f> m_transforms;
+		std::string m_stem;
+		int m_firstSuffix;
+		Imath::M44f m_matrix;
+		vector<Imath::M44f> m_checkpoints;
 
 };
 
@@ -274,6 +365,37 @@ Imath::Box3f Duplicate::computeBranchBound( const ScenePath &sourcePath, const S
 	return inPlug()->bound( source );
 }
 
+bool Duplicate::providesBranchesBound() const
+{
+	return true;
+}
+
+bool Duplicate::affectsBranchesBound( const Gaffer::Plug *input ) const
+{
+	return
+		input == inPlug()->boundPlug() ||
+		input == duplicatesPlug()
+	;
+}
+
+void Duplicate::hashBranchesBound( const ScenePath &sourcePath, const Gaffer::Context *context, IECore::MurmurHash &h ) const
+{
+	h.append( inPlug()->boundHash( sourcePath ) );
+	ScenePlug::PathScope s( context, &sourcePath );
+	duplicatesPlug()->hash( h );
+}
+
+Imath::Box3f Duplicate::computeBranchesBound( const ScenePath &sourcePath, const Imath::M44f &transform, const Gaffer::Context *context ) const
+{
+	// The copies are numerous, but all share the source bound, so
+	// we can compute their union directly from the copy transforms
+	// without computing the bound and transform of every copy.
+	const Imath::Box3f sourceBound = inPlug()->bound( sourcePath );
+	ScenePlug::PathScope s( context, &sourcePath );
+	ConstDuplicatesDataPtr duplicates = static_pointer_cast<const DuplicatesData>( duplicatesPlug()->getValue() );
+	return duplicates->bound( sourceBound, transform, context->canceller() );
+}
+
 bool Duplicate::affectsBranchTransform( const Gaffer::Plug *input ) const
 {
 	return
@@ -36,6 +36,8 @@
 
 #include "GafferScene/ExistenceQuery.h"
 
+#include "GafferScene/Private/QueryAlgo.h"
+
 #include <cassert>
 
 namespace GafferScene
@@ -53,6 +55,8 @@ ExistenceQuery::ExistenceQuery( const std::string& name )
 	addChild( new Gaffer::StringPlug( "location" ) );
 	addChild( new Gaffer::BoolPlug( "exists", Gaffer::Plug::Out, false ) );
 	addChild( new Gaffer::StringPlug( "closestAncestor", Gaffer::Plug::Out ) );
+	addChild( new Gaffer::StringVectorDataPlug( "locations", Gaffer::Plug::In, new IECore::StringVectorData() ) );
+	addChild( new Gaffer::BoolVectorDataPlug( "existsVector", Gaffer::Plug::Out, new IECore::BoolVectorData() ) );
 }
 
 ExistenceQuery::~ExistenceQuery()
@@ -102,6 +106,28 @@ const Gaffer::StringPlug* ExistenceQuery::closestAncestorPlug() const
 	return getChild< Gaffer::StringPlug >( g_firstPlugIndex + 3 );
 }
 
+Gaffer::StringVectorDataPlug* ExistenceQuery::locationsPlug()
+{
+	return const_cast< Gaffer::StringVectorDataPlug* >(
+		static_cast< const ExistenceQuery* >( this )->locationsPlug() );
+}
+
+const Gaffer::StringVectorDataPlug* ExistenceQuery::locationsPlug() const
+{
+	return getChild< Gaffer::StringVectorDataPlug >( g_firstPlugIndex + 4 );
+}
+
+Gaffer::BoolVectorDataPlug* ExistenceQuery::existsVectorPlug()
+{
+	return const_cast< Gaffer::BoolVectorDataPlug* >(
+		static_cast< const ExistenceQuery* >( this )->existsVectorPlug() );
+}
+
+const Gaffer::BoolVectorDataPlug* ExistenceQuery::existsVectorPlug() const
+{
+	return getChild< Gaffer::BoolVectorDataPlug >( g_firstPlugIndex + 5 );
+}
+
 void ExistenceQuery::affects( const Gaffer::Plug* const input, AffectedPlugsContainer& outputs ) const
 {
 	ComputeNode::affects( input, outputs );
@@ -113,6 +139,13 @@ void ExistenceQuery::affects( const Gaffer::Plug* const input, AffectedPlugsCont
 		outputs.push_back( existsPlug() );
 		outputs.push_back( closestAncestorPlug() );
 	}
+
+	if(
+		( input == locationsPlug() ) ||
+		( input == scenePlug()->existsPlug() ) )
+	{
+		outputs.push_back( existsVectorPlug() );
+	}
 }
 
 void ExistenceQuery::hash( const Gaffer::ValuePlug* const output, const Gaffer::Context* const context, IECore::MurmurHash& h ) const
@@ -175,6 +208,28 @@ void ExistenceQuery::hash( const Gaffer::ValuePlug* const output, const Gaffer::
 			}
 		}
 	}
+	else if( output == existsVectorPlug() )
+	{
+		const IECore::ConstStringVectorDataPtr locations = locationsPlug()->getValue();
+		const Gaffer::BoolPlug* const eplug = scenePlug()->existsPlug();
+
+		// NOTE : scene exists plug returns true by default when there is no input scene. See issue #4245
+
+		if( eplug->getInput() )
+		{
+			h.append( Private::QueryAlgo::parallelLocationsHash(
+				locations->readable(),
+				[&] ( const ScenePlug::ScenePath& path, IECore::MurmurHash& locationHash ) {
+					const ScenePlug::PathScope scope( Gaffer::Context::current(), & path );
+					locationHash = eplug->hash();
+				}
+			) );
+		}
+		else
+		{
+			h.append( (uint64_t)locations->readable().size() );
+		}
+	}
 }
 
 void ExistenceQuery::compute( Gaffer::ValuePlug* const output, const Gaffer::Context* const context ) const
@@ -238,8 +293,55 @@ void ExistenceQuery::compute( Gaffer::ValuePlug* const output, const Gaffer::Con
 
 		IECore::assertedStaticCast< Gaffer::StringPlug >( output )->setValue( loc );
 	}
+	else if( output == existsVectorPlug() )
+	{
+		const IECore::ConstStringVectorDataPtr locations = locationsPlug()->getValue();
+		const Gaffer::BoolPlug* const eplug = scenePlug()->existsPlug();
+
+		// NOTE : `std::vector<bool>` can't be written to concurrently, so we
+		// gather the results into bytes first.
+
+		std::vector< unsigned char > exists( locations->readable().size(), 0 );
+
+		// NOTE : scene exists plug returns true by default when there is no input scene. See issue #4245
+
+		if( eplug->getInput() )
+		{
+			Private::QueryAlgo::parallelForLocations(
+				locations->readable(),
+				[&] ( const ScenePlug::ScenePath& path, size_t i ) {
+					const ScenePlug::PathScope scope( Gaffer::Context::current(), & path );
+					exists[ i ] = eplug->getValue();
+				}
+			);
+		}
+
+		IECore::BoolVectorDataPtr const result = new IECore::BoolVectorData();
+		result->writable().assign( exists.begin(), exists.end() );
+		IECore::assertedStaticCast< Gaffer::BoolVectorDataPlug >( output )->setValue( result );
+	}
 
 	ComputeNode::compute( output, context );
 }
 
+Gaffer::ValuePlug::CachePolicy ExistenceQuery::hashCachePolicy( const Gaffer::ValuePlug* const output ) const
+{
+	if( output == existsVectorPlug() )
+	{
+		return Gaffer::ValuePlug::CachePolicy::TaskCollaboration;
+	}
+
+	return ComputeNode::hashCachePolicy( output );
+}
+
+Gaffer::ValuePlug::CachePolicy ExistenceQuery::computeCachePolicy( const Gaffer::ValuePlug* const output ) const
+{
+	if( output == existsVectorPlug() )
+	{
+		return Gaffer::ValuePlug::CachePolicy::TaskCollaboration;
+	}
+
+	return ComputeNode::computeCachePolicy( output );
+}
+
 } // GafferScene
@@ -40,10 +40,39 @@
 #include "GafferScene/SceneAlgo.h"
 #include "GafferScene/ScenePlug.h"
 
+#include "tbb/parallel_for.h"
+#include "tbb/parallel_reduce.h"
+
+using namespace std;
 using namespace IECore;
 using namespace Gaffer;
 using namespace GafferScene;
 
+//////////////////////////////////////////////////////////////////////////
+// Internal utilities
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+// Subtrees are cached individually down to this depth, provided
+// that their parent doesn't have too many children. Beyond that we
+// gather the results with a regular traversal, to avoid filling the
+// caches with many tiny entries.
+const size_t g_maxSubtreeDepth = 4;
+const size_t g_maxSubtreeChildren = 1000;
+
+bool cacheChildSubtrees( const ScenePlug::ScenePath &path, const vector<InternedString> &childNames )
+{
+	return path.size() < g_maxSubtreeDepth && childNames.size() <= g_maxSubtreeChildren;
+}
+
+} // namespace
+
+//////////////////////////////////////////////////////////////////////////
+// FilterResults
+//////////////////////////////////////////////////////////////////////////
+
 size_t FilterResults::g_firstPlugIndex = 0;
 
 GAFFER_NODE_DEFINE_TYPE( FilterResults )
@@ -58,6 +87,7 @@ FilterResults::FilterResults( const std::string &name )
 	addChild( new PathMatcherDataPlug( "__internalOut", Gaffer::Plug::Out, new PathMatcherData ) );
 	addChild( new PathMatcherDataPlug( "out", Gaffer::Plug::Out, new PathMatcherData ) );
 	addChild( new StringVectorDataPlug( "outStrings", Gaffer::Plug::Out, new StringVectorData ) );
+	addChild( new PathMatcherDataPlug( "__subtreeMatches", Gaffer::Plug::Out, new PathMatcherData ) );
 }
 
 FilterResults::~FilterResults()
@@ -124,6 +154,16 @@ const Gaffer::StringVectorDataPlug *FilterResults::outStringsPlug() const
 	return getChild<StringVectorDataPlug>( g_firstPlugIndex + 5 );
 }
 
+Gaffer::PathMatcherDataPlug *FilterResults::subtreeMatchesPlug()
+{
+	return getChild<PathMatcherDataPlug>( g_firstPlugIndex + 6 );
+}
+
+const Gaffer::PathMatcherDataPlug *FilterResults::subtreeMatchesPlug() const
+{
+	return getChild<PathMatcherDataPlug>( g_firstPlugIndex + 6 );
+}
+
 void FilterResults::affects( const Gaffer::Plug *input, AffectedPlugsContainer &outputs ) const
 {
 	ComputeNode::affects( input, outputs );
@@ -135,9 +175,16 @@ void FilterResults::affects( const Gaffer::Plug *input, AffectedPlugsContainer &
 
 	if(
 		input == filterPlug() ||
-		input == rootPlug() ||
 		input == scenePlug()->childNamesPlug()
 	)
+	{
+		outputs.push_back( subtreeMatchesPlug() );
+	}
+
+	if(
+		input == subtreeMatchesPlug() ||
+		input == rootPlug()
+	)
 	{
 		outputs.push_back( internalOutPlug() );
 	}
@@ -161,7 +208,64 @@ void FilterResults::hash( const Gaffer::ValuePlug *output, const Gaffer::Context
 	{
 		ScenePlug::ScenePath rootPath;
 		ScenePlug::stringToPath( rootPlug()->getValue(), rootPath );
-		h.append( SceneAlgo::matchingPathsHash( filterPlug(), scenePlug(), rootPath ) );
+		h.append( rootPath.data(), rootPath.size() );
+		ScenePlug::PathScope pathScope( context, &rootPath );
+		subtreeMatchesPlug()->hash( h );
+	}
+	else if( output == subtreeMatchesPlug() )
+	{
+		const unsigned match = filterPlug()->match( scenePlug() );
+		h.append( match );
+		if( !( match & PathMatcher::DescendantMatch ) )
+		{
+			return;
+		}
+
+		const ScenePlug::ScenePath &path = context->get<ScenePlug::ScenePath>( ScenePlug::scenePathContextName );
+		ConstInternedStringVectorDataPtr childNamesData = scenePlug()->childNamesPlug()->getValue();
+		const vector<InternedString> &childNames = childNamesData->readable();
+		if( !cacheChildSubtrees( path, childNames ) )
+		{
+			h.append( SceneAlgo::matchingPathsHash( filterPlug(), scenePlug(), path ) );
+			return;
+		}
+
+		h.append( childNames.data(), childNames.size() );
+
+		const ThreadState &threadState = ThreadState::current();
+		using Range = tbb::blocked_range<size_t>;
+		tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+
+		const IECore::MurmurHash reduction = tbb::parallel_deterministic_reduce(
+			Range( 0, childNames.size() ),
+			h,
+			[&] ( const Range &range, const MurmurHash &hash ) {
+
+				ScenePlug::PathScope pathScope( threadState );
+				ScenePlug::ScenePath childPath = path;
+				childPath.push_back( InternedString() ); // room for the child name
+
+				MurmurHash result = hash;
+				for( size_t i = range.begin(); i != range.end(); ++i )
+				{
+					childPath.back() = childNames[i];
+					pathScope.setPath( &childPath );
+					subtreeMatchesPlug()->hash( result );
+				}
+				return result;
+
+			},
+			[] ( const MurmurHash &x, const MurmurHash &y ) {
+
+				MurmurHash result = x;
+				result.append( y );
+				return result;
+			},
+			tbb::simple_partitioner(),
+			taskGroupContext
+		);
+
+		h.append( reduction );
 	}
 	else if( output == outPlug() )
 	{
@@ -180,8 +284,69 @@ void FilterResults::compute( Gaffer::ValuePlug *output, const Gaffer::Context *c
 	{
 		ScenePlug::ScenePath rootPath;
 		ScenePlug::stringToPath( rootPlug()->getValue(), rootPath );
+		ConstPathMatcherDataPtr subtreeMatches;
+		{
+			ScenePlug::PathScope pathScope( context, &rootPath );
+			subtreeMatches = subtreeMatchesPlug()->getValue();
+		}
 		PathMatcherDataPtr data = new PathMatcherData;
-		SceneAlgo::matchingPaths( filterPlug(), scenePlug(), rootPath, data->writable() );
+		data->writable().addPaths( subtreeMatches->readable(), rootPath );
+		static_cast<PathMatcherDataPlug *>( output )->setValue( data );
+		return;
+	}
+	else if( output == subtreeMatchesPlug() )
+	{
+		PathMatcherDataPtr data = new PathMatcherData;
+		PathMatcher &result = data->writable();
+
+		const unsigned match = filterPlug()->match( scenePlug() );
+		if( match & PathMatcher::ExactMatch )
+		{
+			result.addPath( ScenePlug::ScenePath() );
+		}
+
+		if( match & PathMatcher::DescendantMatch )
+		{
+			const ScenePlug::ScenePath &path = context->get<ScenePlug::ScenePath>( ScenePlug::scenePathContextName );
+			ConstInternedStringVectorDataPtr childNamesData = scenePlug()->childNamesPlug()->getValue();
+			const vector<InternedString> &childNames = childNamesData->readable();
+			if( cacheChildSubtrees( path, childNames ) )
+			{
+				// Gather the results for each child in parallel. Children
+				// whose subtrees are unchanged are retrieved from the cache.
+				vector<ConstPathMatcherDataPtr> childMatches( childNames.size() );
+
+				const ThreadState &threadState = ThreadState::current();
+				tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+				tbb::parallel_for(
+					tbb::blocked_range<size_t>( 0, childNames.size() ),
+					[&] ( const tbb::blocked_range<size_t> &range ) {
+						ScenePlug::PathScope pathScope( threadState );
+						ScenePlug::ScenePath childPath = path;
+						childPath.push_back( InternedString() ); // room for the child name
+						for( size_t i = range.begin(); i != range.end(); ++i )
+						{
+							childPath.back() = childNames[i];
+							pathScope.setPath( &childPath );
+							childMatches[i] = subtreeMatchesPlug()->getValue();
+						}
+					},
+					taskGroupContext
+				);
+
+				for( size_t i = 0; i < childNames.size(); ++i )
+				{
+					result.addPaths( childMatches[i]->readable(), { childNames[i] } );
+				}
+			}
+			else
+			{
+				PathMatcher matches;
+				SceneAlgo::matchingPaths( filterPlug(), scenePlug(), path, matches );
+				result = matches.subTree( path );
+			}
+		}
+
 		static_cast<PathMatcherDataPlug *>( output )->setValue( data );
 		return;
 	}
@@ -205,7 +370,7 @@ void FilterResults::compute( Gaffer::ValuePlug *output, const Gaffer::Context *c
 
 Gaffer::ValuePlug::CachePolicy FilterResults::computeCachePolicy( const Gaffer::ValuePlug *output ) const
 {
-	if( output == internalOutPlug() )
+	if( output == internalOutPlug() || output == subtreeMatchesPlug() )
 	{
 		return ValuePlug::CachePolicy::TaskCollaboration;
 	}
@@ -214,7 +379,7 @@ Gaffer::ValuePlug::CachePolicy FilterResults::computeCachePolicy( const Gaffer::
 
 Gaffer::ValuePlug::CachePolicy FilterResults::hashCachePolicy( const Gaffer::ValuePlug *output ) const
 {
-	if( output == internalOutPlug() )
+	if( output == internalOutPlug() || output == subtreeMatchesPlug() )
 	{
 		return ValuePlug::CachePolicy::TaskCollaboration;
 	}
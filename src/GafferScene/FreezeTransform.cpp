@@ -44,6 +44,10 @@
 #include "IECore/DataAlgo.h"
 #include "IECore/TypeTraits.h"
 
+#include "tbb/parallel_for.h"
+
+#include <unordered_map>
+
 using namespace std;
 using namespace Imath;
 using namespace IECore;
@@ -51,6 +55,76 @@ using namespace IECoreScene;
 using namespace Gaffer;
 using namespace GafferScene;
 
+//////////////////////////////////////////////////////////////////////////
+// Internal utilities
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+// Returns a copy of `data` transformed by `matrix` according to its
+// interpretation, or null if the interpretation is not one we handle.
+// The points are transformed in parallel, using the same Imath
+// operations as `IECoreScene::TransformOp`, so results are identical.
+V3fVectorDataPtr transformedData( const V3fVectorData *data, const M44f &matrix, const M44f &normalMatrix, const IECore::Canceller *canceller )
+{
+	const GeometricData::Interpretation interpretation = data->getInterpretation();
+	if(
+		interpretation != GeometricData::Point &&
+		interpretation != GeometricData::Vector &&
+		interpretation != GeometricData::Normal
+	)
+	{
+		return nullptr;
+	}
+
+	const std::vector<V3f> &in = data->readable();
+	V3fVectorDataPtr result = new V3fVectorData;
+	result->setInterpretation( interpretation );
+	std::vector<V3f> &out = result->writable();
+	out.resize( in.size() );
+
+	tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+	tbb::parallel_for(
+		tbb::blocked_range<size_t>( 0, in.size(), 10000 ),
+		[&]( const tbb::blocked_range<size_t> &range ) {
+			IECore::Canceller::check( canceller );
+			const V3f *source = in.data();
+			V3f *destination = out.data();
+			switch( interpretation )
+			{
+				case GeometricData::Point :
+					for( size_t i = range.begin(); i != range.end(); ++i )
+					{
+						matrix.multVecMatrix( source[i], destination[i] );
+					}
+					break;
+				case GeometricData::Vector :
+					for( size_t i = range.begin(); i != range.end(); ++i )
+					{
+						matrix.multDirMatrix( source[i], destination[i] );
+					}
+					break;
+				default :
+					for( size_t i = range.begin(); i != range.end(); ++i )
+					{
+						normalMatrix.multDirMatrix( source[i], destination[i] );
+					}
+					break;
+			}
+		},
+		taskGroupContext
+	);
+
+	return result;
+}
+
+} // namespace
+
+//////////////////////////////////////////////////////////////////////////
+// FreezeTransform
+//////////////////////////////////////////////////////////////////////////
+
 GAFFER_NODE_DEFINE_TYPE( FreezeTransform );
 
 size_t FreezeTransform::g_firstPlugIndex = 0;
@@ -154,6 +228,16 @@ void FreezeTransform::compute( Gaffer::ValuePlug *output, const Gaffer::Context
 	FilteredSceneProcessor::compute( output, context );
 }
 
+Gaffer::ValuePlug::CachePolicy FreezeTransform::computeCachePolicy( const Gaffer::ValuePlug *output ) const
+{
+	if( output == outPlug()->objectPlug() )
+	{
+		// Primitive variables are transformed with `tbb::parallel_for()`.
+		return ValuePlug::CachePolicy::TaskCollaboration;
+	}
+	return FilteredSceneProcessor::computeCachePolicy( output );
+}
+
 void FreezeTransform::hashBound( const ScenePath &path, const Gaffer::Context *context, const ScenePlug *parent, IECore::MurmurHash &h ) const
 {
 	const unsigned m = filterValue( context );
@@ -252,20 +336,46 @@ IECore::ConstObjectPtr FreezeTransform::computeObject( const ScenePath &path, co
 
 		PrimitivePtr outputPrimitive = inputPrimitive->copy();
 
-		/// \todo This is a pain - we need functionality in Cortex to just automatically apply
-		/// the transform to all appropriate primitive variables, without having to manually
-		/// list them. At the same time, we could add a PrimitiveAlgo.h file to Cortex, allowing
-		/// us to apply a transform without having to create an Op to do it.
+		const M44f transform = transformPlug()->getValue();
+		M44f normalTransform = transform.inverse();
+		normalTransform.transpose();
+
+		// We transform the common case of V3f points, vectors and normals
+		// ourselves, in parallel. Data shared between several primitive
+		// variables is only transformed once, and remains shared.
+		std::unordered_map<const Data *, DataPtr> transformed;
 		vector<string> primVarNames;
-		for( PrimitiveVariableMap::const_iterator it = inputPrimitive->variables.begin(), eIt = inputPrimitive->variables.end(); it != eIt; ++it )
+		for( auto &primVar : outputPrimitive->variables )
 		{
-			if( trait<TypeTraits::IsFloatVec3VectorTypedData>( it->second.data.get() ) )
+			if( auto data = runTimeCast<const V3fVectorData>( primVar.second.data.get() ) )
 			{
-				primVarNames.push_back( it->first );
+				auto it = transformed.find( data );
+				if( it == transformed.end() )
+				{
+					it = transformed.emplace( data, transformedData( data, transform, normalTransform, context->canceller() ) ).first;
+				}
+				if( it->second )
+				{
+					primVar.second.data = it->second;
+					continue;
+				}
+			}
+
+			if( trait<TypeTraits::IsFloatVec3VectorTypedData>( primVar.second.data.get() ) )
+			{
+				primVarNames.push_back( primVar.first );
 			}
 		}
 
-		const M44f transform = transformPlug()->getValue();
+		if( primVarNames.empty() )
+		{
+			return outputPrimitive;
+		}
+
+		/// \todo This is a pain - we need functionality in Cortex to just automatically apply
+		/// the transform to all appropriate primitive variables, without having to manually
+		/// list them. At the same time, we could add a PrimitiveAlgo.h file to Cortex, allowing
+		/// us to apply a transform without having to create an Op to do it.
 
 		TransformOpPtr transformOp = new TransformOp;
 		transformOp->inputParameter()->setValue( outputPrimitive );
@@ -0,0 +1,520 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2022, Cinesite VFX Ltd. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#include "GafferScene/InstanceArray.h"
+
+#include "GafferScene/Private/IECoreScenePreview/Renderer.h"
+#include "GafferScene/Private/RendererAlgo.h"
+#include "GafferScene/ScenePlug.h"
+
+#include "Gaffer/Context.h"
+
+#include "IECore/DataAlgo.h"
+#include "IECore/MessageHandler.h"
+
+#include "tbb/parallel_for.h"
+#include "tbb/spin_mutex.h"
+
+#include <algorithm>
+
+using namespace std;
+using namespace Imath;
+using namespace IECore;
+using namespace IECoreScene;
+using namespace Gaffer;
+using namespace GafferScene;
+
+//////////////////////////////////////////////////////////////////////////
+// Internal utilities
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+const InternedString g_setsAttributeName( "sets" );
+
+// Renderer which simply records the objects it is given, so that they
+// can be replayed once per instance into the real renderer.
+class PrototypeCapture : public IECoreScenePreview::Renderer
+{
+
+	public :
+
+		IE_CORE_DECLAREMEMBERPTR( PrototypeCapture )
+
+		class CapturedAttributes : public AttributesInterface
+		{
+
+			public :
+
+				CapturedAttributes( const CompoundObject *attributes )
+					:	attributes( attributes )
+				{
+				}
+
+				ConstCompoundObjectPtr attributes;
+
+		};
+
+		IE_CORE_DECLAREPTR( CapturedAttributes )
+
+		class CapturedObject : public ObjectInterface
+		{
+
+			public :
+
+				CapturedObject( const std::string &name, const std::vector<const Object *> &samples, const std::vector<float> &times, const CapturedAttributes *attributes )
+					:	name( name ), sampleTimes( times ), objectAttributes( attributes->attributes )
+				{
+					for( const auto &s : samples )
+					{
+						this->samples.push_back( s );
+					}
+				}
+
+				void transform( const M44f &transform ) override
+				{
+					transformSamples = { transform };
+					transformTimes.clear();
+				}
+
+				void transform( const std::vector<M44f> &samples, const std::vector<float> &times ) override
+				{
+					transformSamples = samples;
+					transformTimes = times;
+				}
+
+				bool attributes( const AttributesInterface *attributes ) override
+				{
+					return false;
+				}
+
+				void link( const IECore::InternedString &type, const ConstObjectSetPtr &objects ) override
+				{
+				}
+
+				void assignID( uint32_t id ) override
+				{
+				}
+
+				const std::string name;
+				std::vector<ConstObjectPtr> samples;
+				const std::vector<float> sampleTimes;
+				const ConstCompoundObjectPtr objectAttributes;
+				std::vector<M44f> transformSamples = { M44f() };
+				std::vector<float> transformTimes;
+
+		};
+
+		IE_CORE_DECLAREPTR( CapturedObject )
+
+		IECore::InternedString name() const override
+		{
+			return "PrototypeCapture";
+		}
+
+		void option( const IECore::InternedString &name, const IECore::Object *value ) override
+		{
+		}
+
+		void output( const IECore::InternedString &name, const IECoreScene::Output *output ) override
+		{
+		}
+
+		AttributesInterfacePtr attributes( const IECore::CompoundObject *attributes ) override
+		{
+			return new CapturedAttributes( attributes );
+		}
+
+		ObjectInterfacePtr camera( const std::string &name, const IECoreScene::Camera *camera, const AttributesInterface *attributes ) override
+		{
+			return nullptr;
+		}
+
+		ObjectInterfacePtr light( const std::string &name, const IECore::Object *object, const AttributesInterface *attributes ) override
+		{
+			return nullptr;
+		}
+
+		ObjectInterfacePtr lightFilter( const std::string &name, const IECore::Object *object, const AttributesInterface *attributes ) override
+		{
+			return nullptr;
+		}
+
+		ObjectInterfacePtr object( const std::string &name, const IECore::Object *object, const AttributesInterface *attributes ) override
+		{
+			return this->object( name, std::vector<const Object *>( { object } ), std::vector<float>(), attributes );
+		}
+
+		ObjectInterfacePtr object( const std::string &name, const std::vector<const IECore::Object *> &samples, const std::vector<float> &times, const AttributesInterface *attributes ) override
+		{
+			CapturedObjectPtr result = new CapturedObject( name, samples, times, static_cast<const CapturedAttributes *>( attributes ) );
+			tbb::spin_mutex::scoped_lock lock( m_mutex );
+			m_objects.push_back( result );
+			return result;
+		}
+
+		void render() override
+		{
+		}
+
+		void pause() override
+		{
+		}
+
+		// Returns the captured objects, sorted by name so that output
+		// is deterministic.
+		const std::vector<CapturedObjectPtr> &objects()
+		{
+			std::sort(
+				m_objects.begin(), m_objects.end(),
+				[] ( const CapturedObjectPtr &a, const CapturedObjectPtr &b ) { return a->name < b->name; }
+			);
+			return m_objects;
+		}
+
+	private :
+
+		tbb::spin_mutex m_mutex;
+		std::vector<CapturedObjectPtr> m_objects;
+
+};
+
+IE_CORE_DECLAREPTR( PrototypeCapture )
+
+struct ElementToData
+{
+
+	template<typename T>
+	DataPtr operator()( const TypedData<vector<T>> *data, size_t index )
+	{
+		return new TypedData<T>( data->readable()[index] );
+	}
+
+	template<typename T>
+	DataPtr operator()( const GeometricTypedData<vector<T>> *data, size_t index )
+	{
+		return new GeometricTypedData<T>( data->readable()[index], data->getInterpretation() );
+	}
+
+	DataPtr operator()( const Data *data, size_t index )
+	{
+		throw IECore::InvalidArgumentException( "Expected VectorTypedData" );
+	}
+
+};
+
+} // namespace
+
+//////////////////////////////////////////////////////////////////////////
+// InstanceArray
+//////////////////////////////////////////////////////////////////////////
+
+IE_CORE_DEFINEOBJECTTYPEDESCRIPTION( InstanceArray );
+
+InstanceArray::InstanceArray()
+	:	m_prototypes( nullptr )
+{
+}
+
+InstanceArray::InstanceArray(
+	const ScenePlug *scene,
+	const ScenePlug::ScenePath &root,
+	const Gaffer::Context &context,
+	const IECore::MurmurHash &hash,
+	const Imath::Box3f &bound,
+	const ScenePlug *prototypes,
+	const ScenePlug::ScenePath &prototypeRoot,
+	const IECore::InternedStringVectorData *names,
+	const IECore::M44fVectorData *transforms,
+	const IECore::UInt64VectorData *attributeIndices,
+	const IECore::CompoundData *attributes
+)
+	:	Capsule( scene, root, context, hash, bound ),
+		m_prototypes( prototypes ), m_prototypeRoot( prototypeRoot ),
+		m_names( names ), m_transforms( transforms ),
+		m_attributeIndices( attributeIndices ), m_attributes( attributes )
+{
+	if( m_names->readable().size() != m_transforms->readable().size() )
+	{
+		throw IECore::InvalidArgumentException( "InstanceArray : Number of names does not match number of transforms" );
+	}
+
+	if( m_attributes && !m_attributes->readable().empty() )
+	{
+		if( !m_attributeIndices || m_attributeIndices->readable().size() != m_names->readable().size() )
+		{
+			throw IECore::InvalidArgumentException( "InstanceArray : Number of attribute indices does not match number of names" );
+		}
+	}
+}
+
+InstanceArray::~InstanceArray()
+{
+}
+
+bool InstanceArray::isEqualTo( const IECore::Object *other ) const
+{
+	// The hash provided to the Capsule constructor is required to
+	// identify the entire subtree, so there is no need to compare
+	// the instance data itself.
+	return Capsule::isEqualTo( other );
+}
+
+void InstanceArray::hash( IECore::MurmurHash &h ) const
+{
+	Capsule::hash( h );
+}
+
+void InstanceArray::copyFrom( const IECore::Object *other, IECore::Object::CopyContext *context )
+{
+	Capsule::copyFrom( other, context );
+
+	const InstanceArray *instanceArray = static_cast<const InstanceArray *>( other );
+	m_prototypes = instanceArray->m_prototypes;
+	m_prototypeRoot = instanceArray->m_prototypeRoot;
+	m_names = instanceArray->m_names;
+	m_transforms = instanceArray->m_transforms;
+	m_attributeIndices = instanceArray->m_attributeIndices;
+	m_attributes = instanceArray->m_attributes;
+}
+
+void InstanceArray::save( IECore::Object::SaveContext *context ) const
+{
+	Capsule::save( context );
+}
+
+void InstanceArray::load( IECore::Object::LoadContextPtr context )
+{
+	Capsule::load( context );
+}
+
+void InstanceArray::memoryUsage( IECore::Object::MemoryAccumulator &accumulator ) const
+{
+	Capsule::memoryUsage( accumulator );
+	accumulator.accumulate( sizeof( InstanceArray ) - sizeof( Capsule ) );
+	accumulator.accumulate( m_names.get() );
+	accumulator.accumulate( m_transforms.get() );
+	if( m_attributeIndices )
+	{
+		accumulator.accumulate( m_attributeIndices.get() );
+	}
+	if( m_attributes )
+	{
+		accumulator.accumulate( m_attributes.get() );
+	}
+}
+
+void InstanceArray::render( IECoreScenePreview::Renderer *renderer ) const
+{
+	const ScenePlug *scene = this->scene();
+	ScenePlug::GlobalScope scope( context() );
+
+	// Capture the prototype subtree once. Attributes and transforms at
+	// the prototype root are not output by `outputObjects()`, so we
+	// inject the attributes via the globals and apply the transform
+	// ourselves.
+
+	GafferScene::Private::RendererAlgo::RenderSets renderSets( m_prototypes );
+
+	IECore::ConstCompoundObjectPtr globals = scene->globalsPlug()->getValue();
+	IECore::CompoundObjectPtr prototypeGlobals = new CompoundObject;
+	prototypeGlobals->members() = globals->members();
+
+	M44f prototypeTransform;
+	{
+		ScenePlug::PathScope pathScope( Context::current(), &m_prototypeRoot );
+		prototypeTransform = m_prototypes->transformPlug()->getValue();
+		IECore::ConstCompoundObjectPtr prototypeAttributes = m_prototypes->attributesPlug()->getValue();
+		for( const auto &a : prototypeAttributes->members() )
+		{
+			prototypeGlobals->members()["attribute:" + a.first.string()] = a.second;
+		}
+		if( IECore::ConstInternedStringVectorDataPtr sets = renderSets.setsAttribute( m_prototypeRoot ) )
+		{
+			prototypeGlobals->members()["attribute:" + g_setsAttributeName.string()] = boost::const_pointer_cast<InternedStringVectorData>( sets );
+		}
+	}
+
+	PrototypeCapturePtr capture = new PrototypeCapture;
+	GafferScene::Private::RendererAlgo::outputObjects( m_prototypes, prototypeGlobals.get(), renderSets, /* lightLinks = */ nullptr, capture.get(), m_prototypeRoot );
+
+	const std::vector<PrototypeCapture::CapturedObjectPtr> &prototypeObjects = capture->objects();
+	if( prototypeObjects.empty() )
+	{
+		return;
+	}
+
+	// Share attributes and objects between all instances where possible,
+	// so that the renderer can instance them natively.
+
+	const bool instanceAttributes = m_attributes && !m_attributes->readable().empty();
+
+	std::vector<IECoreScenePreview::Renderer::AttributesInterfacePtr> sharedAttributes;
+	if( !instanceAttributes )
+	{
+		for( const auto &o : prototypeObjects )
+		{
+			sharedAttributes.push_back( renderer->attributes( o->objectAttributes.get() ) );
+		}
+	}
+
+	std::vector<std::vector<const Object *>> prototypeSamples;
+	for( const auto &o : prototypeObjects )
+	{
+		prototypeSamples.emplace_back();
+		for( const auto &s : o->samples )
+		{
+			prototypeSamples.back().push_back( s.get() );
+		}
+	}
+
+	const std::vector<InternedString> &names = m_names->readable();
+	const std::vector<M44f> &transforms = m_transforms->readable();
+
+	tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+	tbb::parallel_for(
+		tbb::blocked_range<size_t>( 0, names.size() ),
+		[&]( const tbb::blocked_range<size_t> &r )
+		{
+			for( size_t i = r.begin(); i != r.end(); ++i )
+			{
+				const std::string instanceName = "/" + names[i].string();
+				const M44f instanceTransform = prototypeTransform * transforms[i];
+
+				CompoundObject::ObjectMap perInstanceAttributes;
+				if( instanceAttributes )
+				{
+					const size_t attributeIndex = m_attributeIndices->readable()[i];
+					for( const auto &a : m_attributes->readable() )
+					{
+						perInstanceAttributes[a.first] = dispatch( a.second.get(), ElementToData(), attributeIndex );
+					}
+				}
+
+				for( size_t j = 0; j < prototypeObjects.size(); ++j )
+				{
+					const PrototypeCapture::CapturedObject *prototypeObject = prototypeObjects[j].get();
+
+					IECoreScenePreview::Renderer::AttributesInterfacePtr attributes;
+					if( instanceAttributes )
+					{
+						CompoundObjectPtr a = new CompoundObject;
+						a->members() = prototypeObject->objectAttributes->members();
+						for( const auto &p : perInstanceAttributes )
+						{
+							a->members()[p.first] = p.second;
+						}
+						attributes = renderer->attributes( a.get() );
+					}
+					else
+					{
+						attributes = sharedAttributes[j];
+					}
+
+					const std::string name = prototypeObject->name == "/" ? instanceName : instanceName + prototypeObject->name;
+
+					IECoreScenePreview::Renderer::ObjectInterfacePtr objectInterface;
+					if( prototypeSamples[j].size() == 1 )
+					{
+						objectInterface = renderer->object( name, prototypeSamples[j][0], attributes.get() );
+					}
+					else
+					{
+						objectInterface = renderer->object( name, prototypeSamples[j], prototypeObject->sampleTimes, attributes.get() );
+					}
+
+					if( !objectInterface )
+					{
+						continue;
+					}
+
+					if( prototypeObject->transformTimes.empty() )
+					{
+						objectInterface->transform( prototypeObject->transformSamples[0] * instanceTransform );
+					}
+					else
+					{
+						std::vector<M44f> transformSamples;
+						transformSamples.reserve( prototypeObject->transformSamples.size() );
+						for( const auto &m : prototypeObject->transformSamples )
+						{
+							transformSamples.push_back( m * instanceTransform );
+						}
+						objectInterface->transform( transformSamples, prototypeObject->transformTimes );
+					}
+				}
+			}
+		},
+		taskGroupContext
+	);
+}
+
+size_t InstanceArray::numInstances() const
+{
+	return m_names ? m_names->readable().size() : 0;
+}
+
+const ScenePlug *InstanceArray::prototypes() const
+{
+	scene(); // Throws if the capsule has expired
+	return m_prototypes;
+}
+
+const ScenePlug::ScenePath &InstanceArray::prototypeRoot() const
+{
+	return m_prototypeRoot;
+}
+
+const IECore::InternedStringVectorData *InstanceArray::names() const
+{
+	return m_names.get();
+}
+
+const IECore::M44fVectorData *InstanceArray::transforms() const
+{
+	return m_transforms.get();
+}
+
+const IECore::UInt64VectorData *InstanceArray::attributeIndices() const
+{
+	return m_attributeIndices.get();
+}
+
+const IECore::CompoundData *InstanceArray::attributes() const
+{
+	return m_attributes.get();
+}
@@ -38,6 +38,7 @@
 #include "GafferScene/Instancer.h"
 
 #include "GafferScene/Capsule.h"
+#include "GafferScene/InstanceArray.h"
 #include "GafferScene/SceneAlgo.h"
 
 #include "GafferScene/Private/ChildNamesMap.h"
@@ -286,6 +287,314 @@ ConstInternedStringVectorDataPtr g_emptyNames = new InternedStringVectorData();
 
 }
 
+//////////////////////////////////////////////////////////////////////////
+// TopologyData
+//////////////////////////////////////////////////////////////////////////
+
+// The part of the engine which depends only on the point count, ids and
+// prototype indices. This is cached separately from EngineData, so that
+// it can be reused when only positions or other varying primitive
+// variables change, as is typical during playback. Like EngineData, we
+// omit a custom TypeId because this is a private class.
+class Instancer::TopologyData : public Data
+{
+
+	public :
+
+		TopologyData(
+			const Primitive *primitive,
+			PrototypeMode mode,
+			const std::string &index,
+			const std::string &rootsVariable,
+			const StringVectorData *rootsList,
+			const ScenePlug *prototypes,
+			const std::string &id
+		)
+			:	m_numPoints( 0 ),
+				m_numPrototypes( 0 ),
+				m_numValidPrototypes( 0 ),
+				m_indices( nullptr ),
+				m_ids( nullptr )
+		{
+			if( !primitive )
+			{
+				return;
+			}
+
+			m_numPoints = primitive->variableSize( PrimitiveVariable::Vertex );
+
+			initPrototypes( primitive, mode, index, rootsVariable, rootsList, prototypes );
+
+			if( const IntVectorData *ids = primitive->variableData<IntVectorData>( id ) )
+			{
+				m_idsData = ids;
+				m_ids = &ids->readable();
+				if( m_ids->size() != numPoints() )
+				{
+					throw IECore::Exception( boost::str( boost::format( "Id primitive variable \"%1%\" has incorrect size" ) % id ) );
+				}
+			}
+
+			if( m_ids )
+			{
+				for( size_t i = 0; i<numPoints(); ++i )
+				{
+					// Iterate in reverse order so that in case of duplicates, the first one will override
+					size_t reverseI = numPoints() - 1 - i;
+					m_idsToPointIndices[(*m_ids)[reverseI]] = reverseI;
+				}
+			}
+		}
+
+		// Appends a hash of everything that would be used in the
+		// construction of a TopologyData for `primitive`.
+		static void topologyHash( const Primitive *primitive, const std::string &index, const std::string &rootsVariable, const std::string &id, IECore::MurmurHash &h )
+		{
+			if( !primitive )
+			{
+				h.append( false );
+				return;
+			}
+
+			h.append( (uint64_t)primitive->variableSize( PrimitiveVariable::Vertex ) );
+			for( const auto &name : { index, rootsVariable, id } )
+			{
+				auto it = primitive->variables.find( name );
+				if( it == primitive->variables.end() )
+				{
+					h.append( false );
+					continue;
+				}
+				h.append( name );
+				h.append( it->second.interpolation );
+				it->second.data->hash( h );
+				if( it->second.indices )
+				{
+					it->second.indices->hash( h );
+				}
+			}
+		}
+
+		size_t numPoints() const
+		{
+			return m_numPoints;
+		}
+
+		size_t instanceId( size_t pointIndex ) const
+		{
+			return m_ids ? (*m_ids)[pointIndex] : pointIndex;
+		}
+
+		size_t pointIndex( const InternedString &name ) const
+		{
+			const size_t i = boost::lexical_cast<size_t>( name );
+			if( !m_ids )
+			{
+				if( i >= numPoints() )
+				{
+					throw IECore::Exception( boost::str( boost::format( "Instance id \"%1%\" is invalid, instancer produces only %2% children.  Topology may have changed during shutter." ) % name % numPoints() ) );
+				}
+				return i;
+			}
+
+			IdsToPointIndices::const_iterator it = m_idsToPointIndices.find( i );
+			if( it == m_idsToPointIndices.end() )
+			{
+				throw IECore::Exception( boost::str( boost::format( "Instance id \"%1%\" is invalid.  Topology may have changed during shutter." ) % name ) );
+			}
+
+			return it->second;
+		}
+
+		size_t numValidPrototypes() const
+		{
+			return m_numValidPrototypes;
+		}
+
+		int prototypeIndex( size_t pointIndex ) const
+		{
+			if( m_numPrototypes )
+			{
+				return m_prototypeIndexRemap[ ( m_indices ? (*m_indices)[pointIndex] : 0 ) % m_numPrototypes ];
+			}
+			else
+			{
+				return -1;
+			}
+		}
+
+		const InternedStringVectorData *prototypeRootData( int prototypeIndex ) const
+		{
+			return m_roots[prototypeIndex].get();
+		}
+
+		// Return a pointer since this is for internal use only, and it helps communicate that we
+		// are responsible for holding the storage for this scene path when it gets put in the context
+		const ScenePlug::ScenePath *prototypeRoot( const InternedString &name ) const
+		{
+			return &( m_roots[m_names->input( name ).index]->readable() );
+		}
+
+		const InternedStringVectorData *prototypeNames() const
+		{
+			return m_names ? m_names->outputChildNames() : g_emptyNames.get();
+		}
+
+	protected :
+
+		void copyFrom( const Object *other, CopyContext *context ) override
+		{
+			Data::copyFrom( other, context );
+			msg( Msg::Warning, "TopologyData::copyFrom", "Not implemented" );
+		}
+
+		void save( SaveContext *context ) const override
+		{
+			Data::save( context );
+			msg( Msg::Warning, "TopologyData::save", "Not implemented" );
+		}
+
+		void load( LoadContextPtr context ) override
+		{
+			Data::load( context );
+			msg( Msg::Warning, "TopologyData::load", "Not implemented" );
+		}
+
+	private :
+
+		void initPrototypes( const Primitive *primitive, PrototypeMode mode, const std::string &index, const std::string &rootsVariable, const StringVectorData *rootsList, const ScenePlug *prototypes )
+		{
+			const std::vector<std::string> *rootStrings = nullptr;
+
+			switch( mode )
+			{
+				case PrototypeMode::IndexedRootsList :
+				{
+					if( const auto *indices = primitive->variableData<IntVectorData>( index ) )
+					{
+						m_indicesData = indices;
+						m_indices = &indices->readable();
+						if( m_indices->size() != numPoints() )
+						{
+							throw IECore::Exception( boost::str( boost::format( "prototypeIndex primitive variable \"%1%\" has incorrect size" ) % index ) );
+						}
+					}
+
+					rootStrings = &rootsList->readable();
+
+					break;
+				}
+				case PrototypeMode::IndexedRootsVariable :
+				{
+					if( const auto *indices = primitive->variableData<IntVectorData>( index ) )
+					{
+						m_indicesData = indices;
+						m_indices = &indices->readable();
+						if( m_indices->size() != numPoints() )
+						{
+							throw IECore::Exception( boost::str( boost::format( "prototypeIndex primitive variable \"%1%\" has incorrect size" ) % index ) );
+						}
+					}
+
+					const auto *roots = primitive->variableData<StringVectorData>( rootsVariable, PrimitiveVariable::Constant );
+					if( !roots )
+					{
+						std::string message = boost::str( boost::format( "prototypeRoots primitive variable \"%1%\" must be Constant StringVectorData when using IndexedRootsVariable mode" ) % rootsVariable );
+						if( primitive->variables.find( rootsVariable ) == primitive->variables.end() )
+						{
+							message += ", but it does not exist";
+						}
+						throw IECore::Exception( message );
+					}
+
+					rootStrings = &roots->readable();
+					if( rootStrings->empty() )
+					{
+						throw IECore::Exception( boost::str( boost::format( "prototypeRoots primitive variable \"%1%\" must specify at least one root location" ) % rootsVariable ) );
+					}
+
+					break;
+				}
+				case PrototypeMode::RootPerVertex :
+				{
+					const auto view = primitive->variableIndexedView<StringVectorData>( rootsVariable, PrimitiveVariable::Vertex );
+					if( !view )
+					{
+						std::string message = boost::str( boost::format( "prototypeRoots primitive variable \"%1%\" must be Vertex StringVectorData when using RootPerVertex mode" ) % rootsVariable );
+						if( primitive->variables.find( rootsVariable ) == primitive->variables.end() )
+						{
+							message += ", but it does not exist";
+						}
+						throw IECore::Exception( message );
+					}
+
+					m_indicesData = primitive->variables.find( rootsVariable )->second.indices;
+					m_indices = view->indices();
+					rootStrings = &view->data();
+					break;
+				}
+			}
+
+			std::vector<ConstInternedStringVectorDataPtr> inputNames;
+			inputNames.reserve( rootStrings->size() );
+			m_roots.reserve( rootStrings->size() );
+			m_prototypeIndexRemap.reserve( rootStrings->size() );
+
+			size_t i = 0;
+			ScenePlug::ScenePath path;
+			for( const auto &root : *rootStrings )
+			{
+				ScenePlug::stringToPath( root, path );
+				if( !prototypes->exists( path ) )
+				{
+					throw IECore::Exception( boost::str( boost::format( "Prototype root \"%1%\" does not exist in the `prototypes` scene" ) % root ) );
+				}
+
+				if( path.empty() )
+				{
+					if( root == "/" )
+					{
+						inputNames.emplace_back( new InternedStringVectorData( { g_prototypeRootName } ) );
+						m_roots.emplace_back( new InternedStringVectorData( path ) );
+						m_prototypeIndexRemap.emplace_back( i++ );
+					}
+					else
+					{
+						m_prototypeIndexRemap.emplace_back( -1 );
+					}
+				}
+				else
+				{
+					inputNames.emplace_back( new InternedStringVectorData( { path.back() } ) );
+					m_roots.emplace_back( new InternedStringVectorData( path ) );
+					m_prototypeIndexRemap.emplace_back( i++ );
+				}
+			}
+
+			m_names = new Private::ChildNamesMap( inputNames );
+			m_numPrototypes = m_prototypeIndexRemap.size();
+			m_numValidPrototypes = m_names->outputChildNames()->readable().size();
+		}
+
+		size_t m_numPoints;
+		size_t m_numPrototypes;
+		size_t m_numValidPrototypes;
+		Private::ChildNamesMapPtr m_names;
+		std::vector<ConstInternedStringVectorDataPtr> m_roots;
+		std::vector<int> m_prototypeIndexRemap;
+		// We keep references to the data we point into, rather than
+		// to the whole primitive, so that we don't keep varying data
+		// such as positions alive for longer than necessary.
+		ConstIntVectorDataPtr m_indicesData;
+		const std::vector<int> *m_indices;
+		ConstIntVectorDataPtr m_idsData;
+		const std::vector<int> *m_ids;
+
+		using IdsToPointIndices = std::unordered_map <int, size_t>;
+		IdsToPointIndices m_idsToPointIndices;
+
+};
+
 //////////////////////////////////////////////////////////////////////////
 // EngineData
 //////////////////////////////////////////////////////////////////////////
@@ -300,12 +609,7 @@ class Instancer::EngineData : public Data
 
 		EngineData(
 			ConstPrimitivePtr primitive,
-			PrototypeMode mode,
-			const std::string &index,
-			const std::string &rootsVariable,
-			const StringVectorData *rootsList,
-			const ScenePlug *prototypes,
-			const std::string &id,
+			ConstTopologyDataPtr topology,
 			const std::string &position,
 			const std::string &orientation,
 			const std::string &scale,
@@ -314,14 +618,12 @@ class Instancer::EngineData : public Data
 			const std::vector< PrototypeContextVariable > &prototypeContextVariables
 		)
 			:	m_primitive( primitive ),
-				m_numPrototypes( 0 ),
-				m_numValidPrototypes( 0 ),
-				m_indices( nullptr ),
-				m_ids( nullptr ),
+				m_topology( topology ),
 				m_positions( nullptr ),
 				m_orientations( nullptr ),
 				m_scales( nullptr ),
 				m_uniformScales( nullptr ),
+				m_attributeArrays( new CompoundData ),
 				m_prototypeContextVariables( prototypeContextVariables )
 		{
 			if( !m_primitive )
@@ -329,17 +631,6 @@ class Instancer::EngineData : public Data
 				return;
 			}
 
-			initPrototypes( mode, index, rootsVariable, rootsList, prototypes );
-
-			if( const IntVectorData *ids = m_primitive->variableData<IntVectorData>( id ) )
-			{
-				m_ids = &ids->readable();
-				if( m_ids->size() != numPoints() )
-				{
-					throw IECore::Exception( boost::str( boost::format( "Id primitive variable \"%1%\" has incorrect size" ) % id ) );
-				}
-			}
-
 			if( const V3fVectorData *p = m_primitive->variableData<V3fVectorData>( position ) )
 			{
 				m_positions = &p->readable();
@@ -369,19 +660,9 @@ class Instancer::EngineData : public Data
 			else if( const FloatVectorData *s = m_primitive->variableData<FloatVectorData>( scale ) )
 			{
 				m_uniformScales = &s->readable();
-				if( m_uniformScales->size() != numPoints() )
-				{
-					throw IECore::Exception( boost::str( boost::format( "Uniform scale primitive variable \"%1%\" has incorrect size" ) % scale ) );
-				}
-			}
-
-			if( m_ids )
-			{
-				for( size_t i = 0; i<numPoints(); ++i )
-				{
-					// Iterate in reverse order so that in case of duplicates, the first one will override
-					size_t reverseI = numPoints() - 1 - i;
-					m_idsToPointIndices[(*m_ids)[reverseI]] = reverseI;
+				if( m_uniformScales->size() != numPoints() )
+				{
+					throw IECore::Exception( boost::str( boost::format( "Uniform scale primitive variable \"%1%\" has incorrect size" ) % scale ) );
 				}
 			}
 
@@ -410,57 +691,32 @@ class Instancer::EngineData : public Data
 
 		size_t instanceId( size_t pointIndex ) const
 		{
-			return m_ids ? (*m_ids)[pointIndex] : pointIndex;
+			return m_topology->instanceId( pointIndex );
 		}
 
 		size_t pointIndex( const InternedString &name ) const
 		{
-			const size_t i = boost::lexical_cast<size_t>( name );
-			if( !m_ids )
-			{
-				if( i >= numPoints() )
-				{
-					throw IECore::Exception( boost::str( boost::format( "Instance id \"%1%\" is invalid, instancer produces only %2% children.  Topology may have changed during shutter." ) % name % numPoints() ) );
-				}
-				return i;
-			}
-
-			IdsToPointIndices::const_iterator it = m_idsToPointIndices.find( i );
-			if( it == m_idsToPointIndices.end() )
-			{
-				throw IECore::Exception( boost::str( boost::format( "Instance id \"%1%\" is invalid.  Topology may have changed during shutter." ) % name ) );
-			}
-
-			return it->second;
+			return m_topology->pointIndex( name );
 		}
 
 		size_t numValidPrototypes() const
 		{
-			return m_numValidPrototypes;
+			return m_topology->numValidPrototypes();
 		}
 
 		int prototypeIndex( size_t pointIndex ) const
 		{
-			if( m_numPrototypes )
-			{
-				return m_prototypeIndexRemap[ ( m_indices ? (*m_indices)[pointIndex] : 0 ) % m_numPrototypes ];
-			}
-			else
-			{
-				return -1;
-			}
+			return m_topology->prototypeIndex( pointIndex );
 		}
 
-		// Return a pointer since this is for internal use only, and it helps communicate that we
-		// are responsible for holding the storage for this scene path when it gets put in the context
 		const ScenePlug::ScenePath *prototypeRoot( const InternedString &name ) const
 		{
-			return &( m_roots[m_names->input( name ).index]->readable() );
+			return m_topology->prototypeRoot( name );
 		}
 
 		const InternedStringVectorData *prototypeNames() const
 		{
-			return m_names ? m_names->outputChildNames() : g_emptyNames.get();
+			return m_topology->prototypeNames();
 		}
 
 		M44f instanceTransform( size_t pointIndex ) const
@@ -490,6 +746,13 @@ class Instancer::EngineData : public Data
 			return m_attributeCreators.size();
 		}
 
+		// The expanded primitive variables used to generate instance attributes,
+		// keyed by attribute name and indexed by point index.
+		const CompoundData *instanceAttributeArrays() const
+		{
+			return m_attributeArrays.get();
+		}
+
 		void instanceAttributesHash( size_t pointIndex, MurmurHash &h ) const
 		{
 			h.append( m_attributesHash );
@@ -527,7 +790,7 @@ class Instancer::EngineData : public Data
 				}
 
 				IECore::MurmurHash totalHash;
-				const InternedStringVectorData &rootPath = *m_roots[ protoIndex ];
+				const InternedStringVectorData &rootPath = *m_topology->prototypeRootData( protoIndex );
 
 				// Note that we are rehashing the root path for every point, even though they are heavily
 				// reused.  This seems suboptimal, but is simpler, and the more complex version doesn't
@@ -690,139 +953,21 @@ class Instancer::EngineData : public Data
 				DataPtr d = primVar.second.expandedData();
 				AttributeCreator attributeCreator = dispatch( d.get(), MakeAttributeCreator() );
 				m_attributeCreators[attributePrefix + primVar.first] = attributeCreator;
+				m_attributeArrays->writable()[attributePrefix + primVar.first] = d;
 				m_attributesHash.append( primVar.first );
 				d->hash( m_attributesHash );
 			}
 		}
 
-		void initPrototypes( PrototypeMode mode, const std::string &index, const std::string &rootsVariable, const StringVectorData *rootsList, const ScenePlug *prototypes )
-		{
-			const std::vector<std::string> *rootStrings = nullptr;
-
-			switch( mode )
-			{
-				case PrototypeMode::IndexedRootsList :
-				{
-					if( const auto *indices = m_primitive->variableData<IntVectorData>( index ) )
-					{
-						m_indices = &indices->readable();
-						if( m_indices->size() != numPoints() )
-						{
-							throw IECore::Exception( boost::str( boost::format( "prototypeIndex primitive variable \"%1%\" has incorrect size" ) % index ) );
-						}
-					}
-
-					rootStrings = &rootsList->readable();
-
-					break;
-				}
-				case PrototypeMode::IndexedRootsVariable :
-				{
-					if( const auto *indices = m_primitive->variableData<IntVectorData>( index ) )
-					{
-						m_indices = &indices->readable();
-						if( m_indices->size() != numPoints() )
-						{
-							throw IECore::Exception( boost::str( boost::format( "prototypeIndex primitive variable \"%1%\" has incorrect size" ) % index ) );
-						}
-					}
-
-					const auto *roots = m_primitive->variableData<StringVectorData>( rootsVariable, PrimitiveVariable::Constant );
-					if( !roots )
-					{
-						std::string message = boost::str( boost::format( "prototypeRoots primitive variable \"%1%\" must be Constant StringVectorData when using IndexedRootsVariable mode" ) % rootsVariable );
-						if( m_primitive->variables.find( rootsVariable ) == m_primitive->variables.end() )
-						{
-							message += ", but it does not exist";
-						}
-						throw IECore::Exception( message );
-					}
-
-					rootStrings = &roots->readable();
-					if( rootStrings->empty() )
-					{
-						throw IECore::Exception( boost::str( boost::format( "prototypeRoots primitive variable \"%1%\" must specify at least one root location" ) % rootsVariable ) );
-					}
-
-					break;
-				}
-				case PrototypeMode::RootPerVertex :
-				{
-					const auto view = m_primitive->variableIndexedView<StringVectorData>( rootsVariable, PrimitiveVariable::Vertex );
-					if( !view )
-					{
-						std::string message = boost::str( boost::format( "prototypeRoots primitive variable \"%1%\" must be Vertex StringVectorData when using RootPerVertex mode" ) % rootsVariable );
-						if( m_primitive->variables.find( rootsVariable ) == m_primitive->variables.end() )
-						{
-							message += ", but it does not exist";
-						}
-						throw IECore::Exception( message );
-					}
-
-					m_indices = view->indices();
-					rootStrings = &view->data();
-					break;
-				}
-			}
-
-			std::vector<ConstInternedStringVectorDataPtr> inputNames;
-			inputNames.reserve( rootStrings->size() );
-			m_roots.reserve( rootStrings->size() );
-			m_prototypeIndexRemap.reserve( rootStrings->size() );
-
-			size_t i = 0;
-			ScenePlug::ScenePath path;
-			for( const auto &root : *rootStrings )
-			{
-				ScenePlug::stringToPath( root, path );
-				if( !prototypes->exists( path ) )
-				{
-					throw IECore::Exception( boost::str( boost::format( "Prototype root \"%1%\" does not exist in the `prototypes` scene" ) % root ) );
-				}
-
-				if( path.empty() )
-				{
-					if( root == "/" )
-					{
-						inputNames.emplace_back( new InternedStringVectorData( { g_prototypeRootName } ) );
-						m_roots.emplace_back( new InternedStringVectorData( path ) );
-						m_prototypeIndexRemap.emplace_back( i++ );
-					}
-					else
-					{
-						m_prototypeIndexRemap.emplace_back( -1 );
-					}
-				}
-				else
-				{
-					inputNames.emplace_back( new InternedStringVectorData( { path.back() } ) );
-					m_roots.emplace_back( new InternedStringVectorData( path ) );
-					m_prototypeIndexRemap.emplace_back( i++ );
-				}
-			}
-
-			m_names = new Private::ChildNamesMap( inputNames );
-			m_numPrototypes = m_prototypeIndexRemap.size();
-			m_numValidPrototypes = m_names->outputChildNames()->readable().size();
-		}
-
 		IECoreScene::ConstPrimitivePtr m_primitive;
-		size_t m_numPrototypes;
-		size_t m_numValidPrototypes;
-		Private::ChildNamesMapPtr m_names;
-		std::vector<ConstInternedStringVectorDataPtr> m_roots;
-		std::vector<int> m_prototypeIndexRemap;
-		const std::vector<int> *m_indices;
-		const std::vector<int> *m_ids;
+		ConstTopologyDataPtr m_topology;
 		const std::vector<Imath::V3f> *m_positions;
 		const std::vector<Imath::Quatf> *m_orientations;
 		const std::vector<Imath::V3f> *m_scales;
 		const std::vector<float> *m_uniformScales;
 
-		using IdsToPointIndices = std::unordered_map <int, size_t>;
-		IdsToPointIndices m_idsToPointIndices;
-
 		boost::container::flat_map<InternedString, AttributeCreator> m_attributeCreators;
+		CompoundDataPtr m_attributeArrays;
 		MurmurHash m_attributesHash;
 
 		const std::vector< PrototypeContextVariable > m_prototypeContextVariables;
@@ -907,6 +1052,7 @@ Instancer::Instancer( const std::string &name )
 	addChild( new StringPlug( "attributes", Plug::In ) );
 	addChild( new StringPlug( "attributePrefix", Plug::In ) );
 	addChild( new BoolPlug( "encapsulateInstanceGroups", Plug::In ) );
+	addChild( new BoolPlug( "compactInstanceGroups", Plug::In ) );
 	addChild( new BoolPlug( "seedEnabled", Plug::In ) );
 	addChild( new StringPlug( "seedVariable", Plug::In, "seed" ) );
 	addChild( new IntPlug( "seeds", Plug::In, 10, 1 ) );
@@ -919,6 +1065,8 @@ Instancer::Instancer( const std::string &name )
 	addChild( new AtomicCompoundDataPlug( "__prototypeChildNames", Plug::Out, new CompoundData ) );
 	addChild( new ScenePlug( "__capsuleScene", Plug::Out ) );
 	addChild( new PathMatcherDataPlug( "__setCollaborate", Plug::Out, new IECore::PathMatcherData() ) );
+	addChild( new ObjectPlug( "__topology", Plug::Out, NullObject::defaultNullObject() ) );
+	addChild( new ObjectPlug( "__topologyHash", Plug::Out, NullObject::defaultNullObject() ) );
 
 	// Hide `destination` plug until we resolve issues surrounding `processesRootObject()`.
 	// See `BranchCreator::computeObject()`.
@@ -1065,124 +1213,154 @@ const Gaffer::BoolPlug *Instancer::encapsulateInstanceGroupsPlug() const
 	return getChild<BoolPlug>( g_firstPlugIndex + 12 );
 }
 
-Gaffer::BoolPlug *Instancer::seedEnabledPlug()
+Gaffer::BoolPlug *Instancer::compactInstanceGroupsPlug()
 {
 	return getChild<BoolPlug>( g_firstPlugIndex + 13 );
 }
 
-const Gaffer::BoolPlug *Instancer::seedEnabledPlug() const
+const Gaffer::BoolPlug *Instancer::compactInstanceGroupsPlug() const
 {
 	return getChild<BoolPlug>( g_firstPlugIndex + 13 );
 }
 
+Gaffer::BoolPlug *Instancer::seedEnabledPlug()
+{
+	return getChild<BoolPlug>( g_firstPlugIndex + 14 );
+}
+
+const Gaffer::BoolPlug *Instancer::seedEnabledPlug() const
+{
+	return getChild<BoolPlug>( g_firstPlugIndex + 14 );
+}
+
 Gaffer::StringPlug *Instancer::seedVariablePlug()
 {
-	return getChild<StringPlug>( g_firstPlugIndex + 14 );
+	return getChild<StringPlug>( g_firstPlugIndex + 15 );
 }
 
 const Gaffer::StringPlug *Instancer::seedVariablePlug() const
 {
-	return getChild<StringPlug>( g_firstPlugIndex + 14 );
+	return getChild<StringPlug>( g_firstPlugIndex + 15 );
 }
 
 Gaffer::IntPlug *Instancer::seedsPlug()
 {
-	return getChild<IntPlug>( g_firstPlugIndex + 15 );
+	return getChild<IntPlug>( g_firstPlugIndex + 16 );
 }
 
 const Gaffer::IntPlug *Instancer::seedsPlug() const
 {
-	return getChild<IntPlug>( g_firstPlugIndex + 15 );
+	return getChild<IntPlug>( g_firstPlugIndex + 16 );
 }
 
 Gaffer::IntPlug *Instancer::seedPermutationPlug()
 {
-	return getChild<IntPlug>( g_firstPlugIndex + 16 );
+	return getChild<IntPlug>( g_firstPlugIndex + 17 );
 }
 
 const Gaffer::IntPlug *Instancer::seedPermutationPlug() const
 {
-	return getChild<IntPlug>( g_firstPlugIndex + 16 );
+	return getChild<IntPlug>( g_firstPlugIndex + 17 );
 }
 
 Gaffer::BoolPlug *Instancer::rawSeedPlug()
 {
-	return getChild<BoolPlug>( g_firstPlugIndex + 17 );
+	return getChild<BoolPlug>( g_firstPlugIndex + 18 );
 }
 
 const Gaffer::BoolPlug *Instancer::rawSeedPlug() const
 {
-	return getChild<BoolPlug>( g_firstPlugIndex + 17 );
+	return getChild<BoolPlug>( g_firstPlugIndex + 18 );
 }
 
 Gaffer::ValuePlug *Instancer::contextVariablesPlug()
 {
-	return getChild<ValuePlug>( g_firstPlugIndex + 18 );
+	return getChild<ValuePlug>( g_firstPlugIndex + 19 );
 }
 
 const Gaffer::ValuePlug *Instancer::contextVariablesPlug() const
 {
-	return getChild<ValuePlug>( g_firstPlugIndex + 18 );
+	return getChild<ValuePlug>( g_firstPlugIndex + 19 );
 }
 
 GafferScene::Instancer::ContextVariablePlug *Instancer::timeOffsetPlug()
 {
-	return getChild<ContextVariablePlug>( g_firstPlugIndex + 19 );
+	return getChild<ContextVariablePlug>( g_firstPlugIndex + 20 );
 }
 
 const GafferScene::Instancer::ContextVariablePlug *Instancer::timeOffsetPlug() const
 {
-	return getChild<ContextVariablePlug>( g_firstPlugIndex + 19 );
+	return getChild<ContextVariablePlug>( g_firstPlugIndex + 20 );
 }
 
 Gaffer::AtomicCompoundDataPlug *Instancer::variationsPlug()
 {
-	return getChild<AtomicCompoundDataPlug>( g_firstPlugIndex + 20 );
+	return getChild<AtomicCompoundDataPlug>( g_firstPlugIndex + 21 );
 }
 
 const Gaffer::AtomicCompoundDataPlug *Instancer::variationsPlug() const
 {
-	return getChild<AtomicCompoundDataPlug>( g_firstPlugIndex + 20 );
+	return getChild<AtomicCompoundDataPlug>( g_firstPlugIndex + 21 );
 }
 
 Gaffer::ObjectPlug *Instancer::enginePlug()
 {
-	return getChild<ObjectPlug>( g_firstPlugIndex + 21 );
+	return getChild<ObjectPlug>( g_firstPlugIndex + 22 );
 }
 
 const Gaffer::ObjectPlug *Instancer::enginePlug() const
 {
-	return getChild<ObjectPlug>( g_firstPlugIndex + 21 );
+	return getChild<ObjectPlug>( g_firstPlugIndex + 22 );
 }
 
 Gaffer::AtomicCompoundDataPlug *Instancer::prototypeChildNamesPlug()
 {
-	return getChild<AtomicCompoundDataPlug>( g_firstPlugIndex + 22 );
+	return getChild<AtomicCompoundDataPlug>( g_firstPlugIndex + 23 );
 }
 
 const Gaffer::AtomicCompoundDataPlug *Instancer::prototypeChildNamesPlug() const
 {
-	return getChild<AtomicCompoundDataPlug>( g_firstPlugIndex + 22 );
+	return getChild<AtomicCompoundDataPlug>( g_firstPlugIndex + 23 );
 }
 
 GafferScene::ScenePlug *Instancer::capsuleScenePlug()
 {
-	return getChild<ScenePlug>( g_firstPlugIndex + 23 );
+	return getChild<ScenePlug>( g_firstPlugIndex + 24 );
 }
 
 const GafferScene::ScenePlug *Instancer::capsuleScenePlug() const
 {
-	return getChild<ScenePlug>( g_firstPlugIndex + 23 );
+	return getChild<ScenePlug>( g_firstPlugIndex + 24 );
 }
 
 Gaffer::PathMatcherDataPlug *Instancer::setCollaboratePlug()
 {
-	return getChild<PathMatcherDataPlug>( g_firstPlugIndex + 24 );
+	return getChild<PathMatcherDataPlug>( g_firstPlugIndex + 25 );
 }
 
 const Gaffer::PathMatcherDataPlug *Instancer::setCollaboratePlug() const
 {
-	return getChild<PathMatcherDataPlug>( g_firstPlugIndex + 24 );
+	return getChild<PathMatcherDataPlug>( g_firstPlugIndex + 25 );
+}
+
+Gaffer::ObjectPlug *Instancer::topologyPlug()
+{
+	return getChild<ObjectPlug>( g_firstPlugIndex + 26 );
+}
+
+const Gaffer::ObjectPlug *Instancer::topologyPlug() const
+{
+	return getChild<ObjectPlug>( g_firstPlugIndex + 26 );
+}
+
+Gaffer::ObjectPlug *Instancer::topologyHashPlug()
+{
+	return getChild<ObjectPlug>( g_firstPlugIndex + 27 );
+}
+
+const Gaffer::ObjectPlug *Instancer::topologyHashPlug() const
+{
+	return getChild<ObjectPlug>( g_firstPlugIndex + 27 );
 }
 
 void Instancer::affects( const Plug *input, AffectedPlugsContainer &outputs ) const
@@ -1191,12 +1369,31 @@ void Instancer::affects( const Plug *input, AffectedPlugsContainer &outputs ) co
 
 	if(
 		input == inPlug()->objectPlug() ||
+		input == prototypeIndexPlug() ||
+		input == prototypeRootsPlug() ||
+		input == idPlug()
+	)
+	{
+		outputs.push_back( topologyHashPlug() );
+	}
+
+	if(
+		input == topologyHashPlug() ||
 		input == prototypeModePlug() ||
 		input == prototypeIndexPlug() ||
 		input == prototypeRootsPlug() ||
 		input == prototypeRootsListPlug() ||
 		input == prototypesPlug()->childNamesPlug() ||
 		input == prototypesPlug()->existsPlug() ||
+		input == idPlug()
+	)
+	{
+		outputs.push_back( topologyPlug() );
+	}
+
+	if(
+		input == topologyPlug() ||
+		input == inPlug()->objectPlug() ||
 		input == idPlug() ||
 		input == positionPlug() ||
 		input == orientationPlug() ||
@@ -1215,7 +1412,7 @@ void Instancer::affects( const Plug *input, AffectedPlugsContainer &outputs ) co
 		outputs.push_back( enginePlug() );
 	}
 
-	if( input == enginePlug() )
+	if( input == topologyPlug() )
 	{
 		outputs.push_back( prototypeChildNamesPlug() );
 	}
@@ -1223,7 +1420,7 @@ void Instancer::affects( const Plug *input, AffectedPlugsContainer &outputs ) co
 	// For the affects of our output plug, we can mostly rely on BranchCreator's mechanism driven
 	// by affectsBranchObject etc., but for these 3 plugs, we have an overridden hash/compute
 	// which in addition to everything that BranchCreator handles, are also affected by
-	// encapsulateInstanceGroupsPlug()
+	// encapsulateInstanceGroupsPlug(). The object plug is also affected by compactInstanceGroupsPlug().
 	if( input == encapsulateInstanceGroupsPlug() )
 	{
 		outputs.push_back( outPlug()->objectPlug() );
@@ -1231,6 +1428,11 @@ void Instancer::affects( const Plug *input, AffectedPlugsContainer &outputs ) co
 		outputs.push_back( outPlug()->setPlug() );
 	}
 
+	if( input == compactInstanceGroupsPlug() )
+	{
+		outputs.push_back( outPlug()->objectPlug() );
+	}
+
 	// The capsule scene depends on all the same things as the regular output scene ( aside from not
 	// being affected by the encapsulate plug, which always must be true when it's evaluated anyway ),
 	// so we can leverage the logic in BranchCreator to drive it
@@ -1271,15 +1473,34 @@ void Instancer::hash( const Gaffer::ValuePlug *output, const Gaffer::Context *co
 {
 	BranchCreator::hash( output, context, h );
 
-	if( output == enginePlug() )
+	if( output == topologyHashPlug() )
 	{
 		inPlug()->objectPlug()->hash( h );
+		prototypeIndexPlug()->hash( h );
+		prototypeRootsPlug()->hash( h );
+		idPlug()->hash( h );
+	}
+	else if( output == topologyPlug() )
+	{
+		// We can't just hash the input object, because that changes whenever
+		// any primitive variable changes. Instead we use the hash of only the
+		// primitive variables that the topology depends on, so that the topology
+		// can be reused when positions change from frame to frame. That is
+		// computed on a separate plug, so it is cached, and the input object
+		// is only computed if the input object hash changes.
+		topologyHashPlug()->getValue()->hash( h );
 
 		prototypeModePlug()->hash( h );
 		prototypeIndexPlug()->hash( h );
 		prototypeRootsPlug()->hash( h );
 		prototypeRootsListPlug()->hash( h );
 		h.append( prototypesPlug()->childNamesHash( ScenePath() ) );
+		idPlug()->hash( h );
+	}
+	else if( output == enginePlug() )
+	{
+		inPlug()->objectPlug()->hash( h );
+		topologyPlug()->hash( h );
 
 		idPlug()->hash( h );
 		positionPlug()->hash( h );
@@ -1312,7 +1533,7 @@ void Instancer::hash( const Gaffer::ValuePlug *output, const Gaffer::Context *co
 	}
 	else if( output == prototypeChildNamesPlug() )
 	{
-		enginePlug()->hash( h );
+		topologyPlug()->hash( h );
 	}
 	else if( output == variationsPlug() )
 	{
@@ -1349,7 +1570,7 @@ void Instancer::hash( const Gaffer::ValuePlug *output, const Gaffer::Context *co
 			// We could always hash this stuff in hashBranchSet, but we would lose out a benefit of a more
 			// accurate hash when we do actually have context variables:  the slower hash won't change
 			// if point locations change, unlike the engineHash which includes all changes
-			engineHash( sourcePath, context, h );
+			topologyHash( sourcePath, context, h );
 			prototypeChildNamesHash( sourcePath, context, h );
 			prototypesPlug()->setPlug()->hash( h );
 			namePlug()->hash( h );
@@ -1396,10 +1617,18 @@ void Instancer::hash( const Gaffer::ValuePlug *output, const Gaffer::Context *co
 
 void Instancer::compute( Gaffer::ValuePlug *output, const Gaffer::Context *context ) const
 {
-	// Both the enginePlug and prototypeChildNamesPlug are evaluated
-	// in a context in which scene:path holds the parent path for a
-	// branch.
-	if( output == enginePlug() )
+	// The topologyHashPlug, topologyPlug, enginePlug and prototypeChildNamesPlug
+	// are evaluated in a context in which scene:path holds the parent path
+	// for a branch.
+	if( output == topologyHashPlug() )
+	{
+		ConstPrimitivePtr primitive = runTimeCast<const Primitive>( inPlug()->objectPlug()->getValue() );
+		IECore::MurmurHash h;
+		TopologyData::topologyHash( primitive.get(), prototypeIndexPlug()->getValue(), prototypeRootsPlug()->getValue(), idPlug()->getValue(), h );
+		static_cast<ObjectPlug *>( output )->setValue( new StringData( h.toString() ) );
+		return;
+	}
+	else if( output == topologyPlug() )
 	{
 		PrototypeMode mode = (PrototypeMode)prototypeModePlug()->getValue();
 		ConstStringVectorDataPtr prototypeRootsList = prototypeRootsListPlug()->getValue();
@@ -1416,6 +1645,24 @@ void Instancer::compute( Gaffer::ValuePlug *output, const Gaffer::Context *conte
 
 		ConstPrimitivePtr primitive = runTimeCast<const Primitive>( inPlug()->objectPlug()->getValue() );
 
+		static_cast<ObjectPlug *>( output )->setValue(
+			new TopologyData(
+				primitive.get(),
+				mode,
+				prototypeIndexPlug()->getValue(),
+				prototypeRootsPlug()->getValue(),
+				prototypeRootsList.get(),
+				prototypesPlug(),
+				idPlug()->getValue()
+			)
+		);
+		return;
+	}
+	else if( output == enginePlug() )
+	{
+		ConstPrimitivePtr primitive = runTimeCast<const Primitive>( inPlug()->objectPlug()->getValue() );
+		ConstTopologyDataPtr topology = boost::static_pointer_cast<const TopologyData>( topologyPlug()->getValue() );
+
 		// Prepare the list of all context variables that affect the prototype scope, in an internal
 		// struct that makes it easier to use them later
 		std::vector< PrototypeContextVariable > prototypeContextVariables;
@@ -1503,12 +1750,7 @@ void Instancer::compute( Gaffer::ValuePlug *output, const Gaffer::Context *conte
 		static_cast<ObjectPlug *>( output )->setValue(
 			new EngineData(
 				primitive,
-				mode,
-				prototypeIndexPlug()->getValue(),
-				prototypeRootsPlug()->getValue(),
-				prototypeRootsList.get(),
-				prototypesPlug(),
-				idPlug()->getValue(),
+				topology,
 				positionPlug()->getValue(),
 				orientationPlug()->getValue(),
 				scalePlug()->getValue(),
@@ -1527,21 +1769,21 @@ void Instancer::compute( Gaffer::ValuePlug *output, const Gaffer::Context *conte
 		// computeBranchChildNames() but that would require N
 		// passes over the input points, where N is the number
 		// of prototypes.
-		ConstEngineDataPtr engine = boost::static_pointer_cast<const EngineData>( enginePlug()->getValue() );
-		const auto &prototypeNames = engine->prototypeNames()->readable();
+		ConstTopologyDataPtr topology = boost::static_pointer_cast<const TopologyData>( topologyPlug()->getValue() );
+		const auto &prototypeNames = topology->prototypeNames()->readable();
 
 		vector<vector<size_t>> indexedPrototypeChildIds;
 
-		size_t numPrototypes = engine->numValidPrototypes();
+		size_t numPrototypes = topology->numValidPrototypes();
 		if( numPrototypes )
 		{
 			indexedPrototypeChildIds.resize( numPrototypes );
-			for( size_t i = 0, e = engine->numPoints(); i < e; ++i )
+			for( size_t i = 0, e = topology->numPoints(); i < e; ++i )
 			{
-				int prototypeIndex = engine->prototypeIndex( i );
+				int prototypeIndex = topology->prototypeIndex( i );
 				if( prototypeIndex != -1 )
 				{
-					indexedPrototypeChildIds[prototypeIndex].push_back( engine->instanceId( i ) );
+					indexedPrototypeChildIds[prototypeIndex].push_back( topology->instanceId( i ) );
 				}
 			}
 		}
@@ -2026,6 +2268,7 @@ void Instancer::hashObject( const ScenePath &path, const Gaffer::Context *contex
 			engineHash( sourcePath, context, h );
 			h.append( context->hash() );
 			outPlug()->boundPlug()->hash( h );
+			compactInstanceGroupsPlug()->hash( h );
 			return;
 		}
 	}
@@ -2041,6 +2284,17 @@ IECore::ConstObjectPtr Instancer::computeObject( const ScenePath &path, const Ga
 		parentAndBranchPaths( path, sourcePath, branchPath );
 		if( branchPath.size() == 2 )
 		{
+			if( compactInstanceGroupsPlug()->getValue() )
+			{
+				ConstEngineDataPtr engine = this->engine( sourcePath, context );
+				// Instances with context variations can't share a single evaluation of
+				// the prototype, so we fall back to a regular Capsule for those.
+				if( !engine->hasContextVariables() )
+				{
+					return compactInstanceGroup( engine.get(), sourcePath, branchPath, context );
+				}
+			}
+
 			return new Capsule(
 				capsuleScenePlug(),
 				context->get<ScenePlug::ScenePath>( ScenePlug::scenePathContextName ) ,
@@ -2055,12 +2309,68 @@ IECore::ConstObjectPtr Instancer::computeObject( const ScenePath &path, const Ga
 	return BranchCreator::computeObject( path, context, parent );
 }
 
+IECore::ConstObjectPtr Instancer::compactInstanceGroup( const EngineData *engine, const ScenePath &sourcePath, const ScenePath &branchPath, const Gaffer::Context *context ) const
+{
+	IECore::ConstCompoundDataPtr prototypeChildNames = this->prototypeChildNames( sourcePath, context );
+	ConstInternedStringVectorDataPtr names = prototypeChildNames->member<InternedStringVectorData>( branchPath[1] );
+	const vector<InternedString> &childNames = names->readable();
+
+	const CompoundData *attributeArrays = engine->instanceAttributeArrays();
+	const bool hasAttributes = !attributeArrays->readable().empty();
+
+	M44fVectorDataPtr transformsData = new M44fVectorData;
+	vector<M44f> &transforms = transformsData->writable();
+	transforms.resize( childNames.size() );
+
+	UInt64VectorDataPtr attributeIndicesData;
+	vector<uint64_t> *attributeIndices = nullptr;
+	if( hasAttributes )
+	{
+		attributeIndicesData = new UInt64VectorData;
+		attributeIndices = &attributeIndicesData->writable();
+		attributeIndices->resize( childNames.size() );
+	}
+
+	tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+	tbb::parallel_for(
+		tbb::blocked_range<size_t>( 0, childNames.size() ),
+		[&]( const tbb::blocked_range<size_t> &r )
+		{
+			for( size_t i = r.begin(); i != r.end(); ++i )
+			{
+				const size_t pointIndex = engine->pointIndex( childNames[i] );
+				transforms[i] = engine->instanceTransform( pointIndex );
+				if( attributeIndices )
+				{
+					(*attributeIndices)[i] = pointIndex;
+				}
+			}
+		},
+		taskGroupContext
+	);
+
+	return new InstanceArray(
+		capsuleScenePlug(),
+		context->get<ScenePlug::ScenePath>( ScenePlug::scenePathContextName ),
+		*context,
+		outPlug()->objectPlug()->hash(),
+		outPlug()->boundPlug()->getValue(),
+		prototypesPlug(),
+		*engine->prototypeRoot( branchPath[1] ),
+		names.get(),
+		transformsData.get(),
+		attributeIndicesData.get(),
+		hasAttributes ? attributeArrays : nullptr
+	);
+}
+
 
 bool Instancer::affectsBranchChildNames( const Gaffer::Plug *input ) const
 {
 	return
 		input == namePlug() ||
 		input == prototypeChildNamesPlug() ||
+		input == topologyPlug() ||
 		input == enginePlug()
 	;
 }
@@ -2077,7 +2387,7 @@ void Instancer::hashBranchChildNames( const ScenePath &sourcePath, const ScenePa
 	{
 		// "/instances"
 		BranchCreator::hashBranchChildNames( sourcePath, branchPath, context, h );
-		engineHash( sourcePath, context, h );
+		topologyHash( sourcePath, context, h );
 	}
 	else if( branchPath.size() == 2 )
 	{
@@ -2111,7 +2421,7 @@ IECore::ConstInternedStringVectorDataPtr Instancer::computeBranchChildNames( con
 	else if( branchPath.size() == 1 )
 	{
 		// "/instances"
-		return engine( sourcePath, context )->prototypeNames();
+		return topology( sourcePath, context )->prototypeNames();
 	}
 	else if( branchPath.size() == 2 )
 	{
@@ -2178,6 +2488,7 @@ IECore::ConstInternedStringVectorDataPtr Instancer::computeBranchSetNames( const
 bool Instancer::affectsBranchSet( const Gaffer::Plug *input ) const
 {
 	return
+		input == topologyPlug() ||
 		input == enginePlug() ||
 		input == prototypesPlug()->setPlug() ||
 		input == prototypeChildNamesPlug() ||
@@ -2216,7 +2527,9 @@ void Instancer::hashBranchSet( const ScenePath &sourcePath, const IECore::Intern
 	}
 	else
 	{
-		engineHash( sourcePath, context, h );
+		// Set membership depends only on the topology, so we don't need
+		// to rehash when point positions change.
+		topologyHash( sourcePath, context, h );
 		prototypeChildNamesHash( sourcePath, context, h );
 		prototypesPlug()->setPlug()->hash( h );
 		namePlug()->hash( h );
@@ -2299,6 +2612,18 @@ void Instancer::engineHash( const ScenePath &sourcePath, const Gaffer::Context *
 	enginePlug()->hash( h );
 }
 
+Instancer::ConstTopologyDataPtr Instancer::topology( const ScenePath &sourcePath, const Gaffer::Context *context ) const
+{
+	ScenePlug::PathScope scope( context, &sourcePath );
+	return boost::static_pointer_cast<const TopologyData>( topologyPlug()->getValue() );
+}
+
+void Instancer::topologyHash( const ScenePath &sourcePath, const Gaffer::Context *context, IECore::MurmurHash &h ) const
+{
+	ScenePlug::PathScope scope( context, &sourcePath );
+	topologyPlug()->hash( h );
+}
+
 IECore::ConstCompoundDataPtr Instancer::prototypeChildNames( const ScenePath &sourcePath, const Gaffer::Context *context ) const
 {
 	ScenePlug::PathScope scope( context, &sourcePath );
@@ -0,0 +1,149 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2022, Cinesite VFX Ltd. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#include "GafferScene/Private/MergeAlgo.h"
+
+#include "tbb/parallel_reduce.h"
+
+#include <unordered_set>
+
+using namespace std;
+using namespace IECore;
+using namespace GafferScene::Private;
+
+IECore::ConstInternedStringVectorDataPtr MergeAlgo::mergeNames( const std::vector<IECore::ConstInternedStringVectorDataPtr> &names )
+{
+	ConstInternedStringVectorDataPtr result;
+	InternedStringVectorDataPtr merged;
+	unordered_set<InternedString> visited;
+
+	for( const auto &n : names )
+	{
+		if( !n )
+		{
+			continue;
+		}
+
+		if( !result || result->readable().empty() )
+		{
+			result = n;
+			continue;
+		}
+
+		if( n->readable().empty() )
+		{
+			continue;
+		}
+
+		if( !merged )
+		{
+			size_t maxSize = 0;
+			for( const auto &m : names )
+			{
+				maxSize += m ? m->readable().size() : 0;
+			}
+
+			merged = new InternedStringVectorData;
+			merged->writable().reserve( maxSize );
+			merged->writable() = result->readable();
+			visited.reserve( maxSize );
+			visited.insert( merged->readable().begin(), merged->readable().end() );
+			result = merged;
+		}
+
+		for( const auto &name : n->readable() )
+		{
+			if( visited.insert( name ).second )
+			{
+				merged->writable().push_back( name );
+			}
+		}
+	}
+
+	return result ? result : new InternedStringVectorData;
+}
+
+IECore::ConstPathMatcherDataPtr MergeAlgo::unionSets( const std::vector<IECore::ConstPathMatcherDataPtr> &sets )
+{
+	ConstPathMatcherDataPtr first;
+	vector<const PathMatcher *> toMerge;
+	for( const auto &s : sets )
+	{
+		if( !s )
+		{
+			continue;
+		}
+		if( !first || first->readable().isEmpty() )
+		{
+			first = s;
+		}
+		if( !s->readable().isEmpty() )
+		{
+			toMerge.push_back( &s->readable() );
+		}
+	}
+
+	if( toMerge.size() < 2 )
+	{
+		return first ? first : new PathMatcherData;
+	}
+
+	using Range = tbb::blocked_range<size_t>;
+	tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+
+	PathMatcherDataPtr result = new PathMatcherData;
+	result->writable() = tbb::parallel_reduce(
+		Range( 0, toMerge.size() ),
+		PathMatcher(),
+		[&] ( const Range &range, const PathMatcher &paths ) {
+			PathMatcher result = paths;
+			for( size_t i = range.begin(); i != range.end(); ++i )
+			{
+				result.addPaths( *toMerge[i] );
+			}
+			return result;
+		},
+		[] ( const PathMatcher &x, const PathMatcher &y ) {
+			PathMatcher result = x;
+			result.addPaths( y );
+			return result;
+		},
+		tbb::auto_partitioner(),
+		taskGroupContext
+	);
+
+	return result;
+}
@@ -43,13 +43,15 @@
 
 #include "GafferScene/MergeScenes.h"
 
+#include "GafferScene/Private/MergeAlgo.h"
 #include "GafferScene/SceneAlgo.h"
 
 #include "Gaffer/ArrayPlug.h"
 
 #include "IECore/NullObject.h"
 
-#include "unordered_set"
+#include "tbb/blocked_range.h"
+#include "tbb/parallel_reduce.h"
 
 using namespace std;
 using namespace Imath;
@@ -67,20 +69,41 @@ GAFFER_NODE_DEFINE_TYPE( MergeScenes );
 namespace
 {
 
-size_t first( const std::bitset<32> &inputs )
+// Calls `getter( inputIndex, input )` for each of the specified inputs,
+// concurrently when there are enough of them to warrant it. Returns
+// the results in the same order as `inputIndices`.
+template<typename Getter>
+auto parallelGet( const ArrayPlug *inputs, const vector<int> &inputIndices, Getter &&getter ) -> vector<decltype( getter( 0, nullptr ) )>
 {
-	for( size_t i = 0; i < inputs.size(); ++i )
+	vector<decltype( getter( 0, nullptr ) )> result( inputIndices.size() );
+	Private::MergeAlgo::parallelFor(
+		inputIndices.size(),
+		[&] ( size_t i ) {
+			result[i] = getter( inputIndices[i], inputs->getChild<ScenePlug>( inputIndices[i] ) );
+		}
+	);
+	return result;
+}
+
+// Returns the subset of `candidates` in which `path` exists.
+vector<int> existingInputs( const ArrayPlug *inputs, const vector<int> &candidates, const ScenePlug::ScenePath &path )
+{
+	const vector<char> exists = parallelGet(
+		inputs, candidates,
+		[&path] ( int index, const ScenePlug *scene ) -> char {
+			return scene->exists( path );
+		}
+	);
+
+	vector<int> result;
+	for( size_t i = 0; i < candidates.size(); ++i )
 	{
-		if( inputs[i] )
+		if( exists[i] )
 		{
-			return i;
+			result.push_back( candidates[i] );
 		}
 	}
-
-	// We shouldn't get here, because all valid locations should
-	// have at least one active input.
-	assert( false );
-	return 0;
+	return result;
 }
 
 } // namespace
@@ -90,7 +113,7 @@ size_t first( const std::bitset<32> &inputs )
 //////////////////////////////////////////////////////////////////////////
 
 MergeScenes::MergeScenes( const std::string &name )
-	:	SceneProcessor( name, /* minInputs = */ 2, /* maxInputs = */ InputMask().size() )
+	:	SceneProcessor( name, /* minInputs = */ 2 )
 {
 	storeIndexOfNextChild( g_firstPlugIndex );
 
@@ -99,7 +122,7 @@ MergeScenes::MergeScenes( const std::string &name )
 	addChild( new IntPlug( "objectMode", Plug::In, (int)Mode::Keep, (int)Mode::Keep, (int)Mode::Replace ) );
 	addChild( new IntPlug( "globalsMode", Plug::In, (int)Mode::Keep, (int)Mode::Keep, (int)Mode::Merge ) );
 	addChild( new BoolPlug( "adjustBounds", Plug::In, true ) );
-	addChild( new IntPlug( "__activeInputs", Plug::Out, 0 ) );
+	addChild( new IntVectorDataPlug( "__activeInputs", Plug::Out, new IntVectorData ) );
 	addChild( new AtomicBox3fPlug( "__mergedDescendantsBound", Plug::Out ) );
 
 	outPlug()->childBoundsPlug()->setFlags( Plug::AcceptsDependencyCycles, true );
@@ -159,14 +182,14 @@ const Gaffer::BoolPlug *MergeScenes::adjustBoundsPlug() const
 	return getChild<BoolPlug>( g_firstPlugIndex + 4 );
 }
 
-Gaffer::IntPlug *MergeScenes::activeInputsPlug()
+Gaffer::IntVectorDataPlug *MergeScenes::activeInputsPlug()
 {
-	return getChild<IntPlug>( g_firstPlugIndex + 5 );
+	return getChild<IntVectorDataPlug>( g_firstPlugIndex + 5 );
 }
 
-const Gaffer::IntPlug *MergeScenes::activeInputsPlug() const
+const Gaffer::IntVectorDataPlug *MergeScenes::activeInputsPlug() const
 {
-	return getChild<IntPlug>( g_firstPlugIndex + 5 );
+	return getChild<IntVectorDataPlug>( g_firstPlugIndex + 5 );
 }
 
 Gaffer::AtomicBox3fPlug *MergeScenes::mergedDescendantsBoundPlug()
@@ -288,7 +311,7 @@ void MergeScenes::compute( Gaffer::ValuePlug *output, const Gaffer::Context *con
 {
 	if( output == activeInputsPlug() )
 	{
-		static_cast<IntPlug *>( output )->setValue( computeActiveInputs( context ) );
+		static_cast<IntVectorDataPlug *>( output )->setValue( computeActiveInputs( context ) );
 	}
 	else if( output == mergedDescendantsBoundPlug() )
 	{
@@ -300,205 +323,265 @@ void MergeScenes::compute( Gaffer::ValuePlug *output, const Gaffer::Context *con
 	}
 }
 
+Gaffer::ValuePlug::CachePolicy MergeScenes::hashCachePolicy( const Gaffer::ValuePlug *output ) const
+{
+	if(
+		output == activeInputsPlug() ||
+		output == mergedDescendantsBoundPlug() ||
+		output == outPlug()->attributesPlug() ||
+		output == outPlug()->childNamesPlug() ||
+		output == outPlug()->setNamesPlug() ||
+		output == outPlug()->setPlug()
+	)
+	{
+		// These are visited in parallel for many inputs.
+		return ValuePlug::CachePolicy::TaskCollaboration;
+	}
+	return SceneProcessor::hashCachePolicy( output );
+}
+
+Gaffer::ValuePlug::CachePolicy MergeScenes::computeCachePolicy( const Gaffer::ValuePlug *output ) const
+{
+	if(
+		output == activeInputsPlug() ||
+		output == mergedDescendantsBoundPlug() ||
+		output == outPlug()->attributesPlug() ||
+		output == outPlug()->childNamesPlug() ||
+		output == outPlug()->setNamesPlug() ||
+		output == outPlug()->setPlug()
+	)
+	{
+		return ValuePlug::CachePolicy::TaskCollaboration;
+	}
+	return SceneProcessor::computeCachePolicy( output );
+}
+
 void MergeScenes::hashActiveInputs( const Gaffer::Context *context, IECore::MurmurHash &h ) const
 {
 	const ScenePath &scenePath = context->get<ScenePath>( ScenePlug::scenePathContextName );
 
 	if( scenePath.empty() )
 	{
-		h.append( (uint64_t)connectedInputs().to_ulong() );
+		const InputIndices inputs = connectedInputs();
+		h.append( inputs.data(), inputs.size() );
 	}
 	else
 	{
-		InputMask parentActiveInputs;
+		ConstIntVectorDataPtr parentActiveInputsData;
 		{
 			ScenePath parentPath = scenePath; parentPath.pop_back();
 			ScenePlug::PathScope parentScope( context, &parentPath );
-			parentActiveInputs = activeInputsPlug()->getValue();
+			parentActiveInputsData = activeInputsPlug()->getValue();
 		}
 
-		if( parentActiveInputs.count() == 1 )
+		const InputIndices &parentActiveInputs = parentActiveInputsData->readable();
+		if( parentActiveInputs.size() == 1 )
 		{
-			h.append( (uint64_t)parentActiveInputs.to_ulong() );
+			h.append( parentActiveInputs.data(), parentActiveInputs.size() );
 		}
 		else
 		{
-			InputMask activeInputs;
-			visit(
-				parentActiveInputs,
-				[&scenePath, &activeInputs] ( InputType type, size_t index, const ScenePlug *scene ) {
-					if( scene->exists( scenePath ) )
-					{
-						activeInputs[index] = true;
-					}
-					return true;
-				}
-			);
-			h.append( (uint64_t)activeInputs.to_ulong() );
+			const InputIndices activeInputs = existingInputs( inPlugs(), parentActiveInputs, scenePath );
+			h.append( activeInputs.data(), activeInputs.size() );
 		}
 	}
 }
 
-int MergeScenes::computeActiveInputs( const Gaffer::Context *context ) const
+IECore::ConstIntVectorDataPtr MergeScenes::computeActiveInputs( const Gaffer::Context *context ) const
 {
 	const ScenePath &scenePath = context->get<ScenePath>( ScenePlug::scenePathContextName );
 
-	InputMask result;
 	if( scenePath.empty() )
 	{
 		// Root
-		result = connectedInputs();
+		return new IntVectorData( connectedInputs() );
 	}
-	else
+
+	// Get active inputs from the parent.
+	ConstIntVectorDataPtr parentActiveInputsData;
 	{
-		// Get active inputs from the parent.
-		InputMask parentActiveInputs;
-		{
-			ScenePath parentPath = scenePath; parentPath.pop_back();
-			ScenePlug::PathScope parentScope( context, &parentPath );
-			parentActiveInputs = activeInputsPlug()->getValue();
-		}
+		ScenePath parentPath = scenePath; parentPath.pop_back();
+		ScenePlug::PathScope parentScope( context, &parentPath );
+		parentActiveInputsData = activeInputsPlug()->getValue();
+	}
 
-		if( parentActiveInputs.count() == 1 )
-		{
-			// It is forbidden for anyone to evaluate us for a location
-			// that doesn't exist. Therefore, if our parent only has
-			// one active input, then that input must still be active for
-			// us.
-			result = parentActiveInputs;
-		}
-		else
-		{
-			// Figure out which of those parent inputs are
-			// still active. Using the parent active inputs as
-			// a mask reduces the number of existence queries
-			// we must make when merging many sparsely overlapping
-			// scenes.
-			visit(
-				parentActiveInputs,
-				[&result, &scenePath] ( InputType type, size_t index, const ScenePlug *scene ) {
-					if( scene->exists( scenePath ) )
-					{
-						result[index] = true;
-					}
-					return true;
-				}
-			);
-		}
+	if( parentActiveInputsData->readable().size() == 1 )
+	{
+		// It is forbidden for anyone to evaluate us for a location
+		// that doesn't exist. Therefore, if our parent only has
+		// one active input, then that input must still be active for
+		// us.
+		return parentActiveInputsData;
 	}
 
-	return result.to_ulong();
+	// Figure out which of those parent inputs are
+	// still active. Using the parent active inputs as
+	// a mask reduces the number of existence queries
+	// we must make when merging many sparsely overlapping
+	// scenes.
+	return new IntVectorData( existingInputs( inPlugs(), parentActiveInputsData->readable(), scenePath ) );
 }
 
 void MergeScenes::hashMergedDescendantsBound( const Gaffer::Context *context, IECore::MurmurHash &h ) const
 {
-	const InputMask activeInputs( activeInputsPlug()->getValue() );
-	if( activeInputs.count() == 1 )
+	ConstIntVectorDataPtr activeInputsData = activeInputsPlug()->getValue();
+	if( activeInputsData->readable().size() == 1 )
 	{
 		return;
 	}
 
 	ConstInternedStringVectorDataPtr childNamesData = outPlug()->childNamesPlug()->getValue();
-	if( childNamesData->readable().empty() )
+	const vector<InternedString> &childNames = childNamesData->readable();
+	if( childNames.empty() )
 	{
 		return;
 	}
 
-	const size_t firstActiveIndex = first( activeInputs );
+	const int firstActiveIndex = activeInputsData->readable().front();
 
-	ScenePath childPath = context->get<ScenePath>( ScenePlug::scenePathContextName );
-	childPath.push_back( InternedString() ); // Room for child name
-	ScenePlug::PathScope childScope( context );
+	const ThreadState &threadState = ThreadState::current();
+	using Range = tbb::blocked_range<size_t>;
+	tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
 
-	for( const auto &childName : childNamesData->readable() )
-	{
-		childPath.back() = childName;
-		childScope.setPath( &childPath );
-		const InputMask childActiveInputs( activeInputsPlug()->getValue() );
-		if( childActiveInputs.count() == 1 && childActiveInputs[firstActiveIndex] )
-		{
-			continue;
-		}
+	const IECore::MurmurHash reduction = tbb::parallel_deterministic_reduce(
+		Range( 0, childNames.size() ),
+		h,
+		[&] ( const Range &range, const MurmurHash &hash ) {
 
-		const ScenePlug *childScene = inPlugs()->getChild<ScenePlug>( first( childActiveInputs ) );
+			ScenePlug::PathScope childScope( threadState );
+			ScenePath childPath = context->get<ScenePath>( ScenePlug::scenePathContextName );
+			childPath.push_back( InternedString() ); // Room for child name
 
-		if( childActiveInputs.count() == 1 )
-		{
-			childScene->boundPlug()->hash( h );
-		}
-		else
-		{
-			mergedDescendantsBoundPlug()->hash( h );
-		}
+			MurmurHash result = hash;
+			for( size_t i = range.begin(); i != range.end(); ++i )
+			{
+				childPath.back() = childNames[i];
+				childScope.setPath( &childPath );
+				ConstIntVectorDataPtr childActiveInputsData = activeInputsPlug()->getValue();
+				const InputIndices &childActiveInputs = childActiveInputsData->readable();
+				if( childActiveInputs.size() == 1 && childActiveInputs.front() == firstActiveIndex )
+				{
+					continue;
+				}
+
+				const ScenePlug *childScene = inPlugs()->getChild<ScenePlug>( childActiveInputs.front() );
+
+				if( childActiveInputs.size() == 1 )
+				{
+					childScene->boundPlug()->hash( result );
+				}
+				else
+				{
+					mergedDescendantsBoundPlug()->hash( result );
+				}
+
+				childScene->transformPlug()->hash( result );
+			}
+			return result;
+
+		},
+		[] ( const MurmurHash &x, const MurmurHash &y ) {
+
+			MurmurHash result = x;
+			result.append( y );
+			return result;
+
+		},
+		tbb::simple_partitioner(),
+		taskGroupContext
+	);
 
-		childScene->transformPlug()->hash( h );
-	};
+	h.append( reduction );
 }
 
 const Imath::Box3f MergeScenes::computeMergedDescendantsBound( const Gaffer::Context *context ) const
 {
-	const InputMask activeInputs( activeInputsPlug()->getValue() );
-	if( activeInputs.count() == 1 )
+	ConstIntVectorDataPtr activeInputsData = activeInputsPlug()->getValue();
+	if( activeInputsData->readable().size() == 1 )
 	{
 		// All children coming from the first input. There can be no descendants to merge.
 		return Box3f();
 	}
 
 	ConstInternedStringVectorDataPtr childNamesData = outPlug()->childNamesPlug()->getValue();
-	if( childNamesData->readable().empty() )
+	const vector<InternedString> &childNames = childNamesData->readable();
+	if( childNames.empty() )
 	{
 		// No children. There can be no descendants to merge.
 		return Box3f();
 	}
 
-	const size_t firstActiveIndex = first( activeInputs );
+	const int firstActiveIndex = activeInputsData->readable().front();
 
-	ScenePath childPath = context->get<ScenePath>( ScenePlug::scenePathContextName );
-	childPath.push_back( InternedString() ); // Room for child name
-	ScenePlug::PathScope childScope( context );
+	const ThreadState &threadState = ThreadState::current();
+	using Range = tbb::blocked_range<size_t>;
+	tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
 
-	Box3f result;
-	for( const auto &childName : childNamesData->readable() )
-	{
-		childPath.back() = childName;
-		childScope.setPath( &childPath );
-		const InputMask childActiveInputs( activeInputsPlug()->getValue() );
-		if( childActiveInputs.count() == 1 && childActiveInputs[firstActiveIndex] )
-		{
-			// Child coming from first input only.
-			// There can be no descendants to merge.
-			continue;
-		}
+	return tbb::parallel_reduce(
+		Range( 0, childNames.size() ),
+		Box3f(),
+		[&] ( const Range &range, const Box3f &bound ) {
 
-		const ScenePlug *childScene = inPlugs()->getChild<ScenePlug>( first( childActiveInputs ) );
+			ScenePlug::PathScope childScope( threadState );
+			ScenePath childPath = context->get<ScenePath>( ScenePlug::scenePathContextName );
+			childPath.push_back( InternedString() ); // Room for child name
 
-		Box3f bound;
-		if( childActiveInputs.count() == 1 )
-		{
-			// Child being merged in from another input.
-			bound = childScene->boundPlug()->getValue();
-		}
-		else
-		{
-			// No child being merged in at this point, but
-			// there may still be a descendant merge lower
-			// in the hierarchy. Recurse.
-			bound = mergedDescendantsBoundPlug()->getValue();
-		}
+			Box3f result = bound;
+			for( size_t i = range.begin(); i != range.end(); ++i )
+			{
+				childPath.back() = childNames[i];
+				childScope.setPath( &childPath );
+				ConstIntVectorDataPtr childActiveInputsData = activeInputsPlug()->getValue();
+				const InputIndices &childActiveInputs = childActiveInputsData->readable();
+				if( childActiveInputs.size() == 1 && childActiveInputs.front() == firstActiveIndex )
+				{
+					// Child coming from first input only.
+					// There can be no descendants to merge.
+					continue;
+				}
 
-		result.extendBy( transform( bound, childScene->transformPlug()->getValue() ) );
-	};
-	return result;
+				const ScenePlug *childScene = inPlugs()->getChild<ScenePlug>( childActiveInputs.front() );
+
+				Box3f childBound;
+				if( childActiveInputs.size() == 1 )
+				{
+					// Child being merged in from another input.
+					childBound = childScene->boundPlug()->getValue();
+				}
+				else
+				{
+					// No child being merged in at this point, but
+					// there may still be a descendant merge lower
+					// in the hierarchy. Recurse.
+					childBound = mergedDescendantsBoundPlug()->getValue();
+				}
+
+				result.extendBy( transform( childBound, childScene->transformPlug()->getValue() ) );
+			}
+			return result;
+
+		},
+		[] ( const Box3f &x, const Box3f &y ) {
+
+			Box3f result = x;
+			result.extendBy( y );
+			return result;
+
+		},
+		tbb::auto_partitioner(),
+		taskGroupContext
+	);
 }
 
 void MergeScenes::hashBound( const ScenePath &path, const Gaffer::Context *context, const ScenePlug *parent, IECore::MurmurHash &h ) const
 {
 	// Pass through.
 
-	const InputMask activeInputs( activeInputsPlug()->getValue() );
-	if( activeInputs.count() == 1 || !adjustBoundsPlug()->getValue() )
+	ConstIntVectorDataPtr activeInputsData = activeInputsPlug()->getValue();
+	const InputIndices &activeInputs = activeInputsData->readable();
+	if( activeInputs.size() == 1 || !adjustBoundsPlug()->getValue() )
 	{
-		h = inPlugs()->getChild<ScenePlug>( first( activeInputs ) )->boundPlug()->hash();
+		h = inPlugs()->getChild<ScenePlug>( activeInputs.front() )->boundPlug()->hash();
 		return;
 	}
 
@@ -507,7 +590,7 @@ void MergeScenes::hashBound( const ScenePath &path, const Gaffer::Context *conte
 	if( objectModePlug()->getValue() == (int)Mode::Keep && transformModePlug()->getValue() == (int)Mode::Keep )
 	{
 		SceneProcessor::hashBound( path, context, parent, h );
-		inPlugs()->getChild<ScenePlug>( first( activeInputs ) )->boundPlug()->hash( h );
+		inPlugs()->getChild<ScenePlug>( activeInputs.front() )->boundPlug()->hash( h );
 		mergedDescendantsBoundPlug()->hash( h );
 		return;
 	}
@@ -523,10 +606,11 @@ Imath::Box3f MergeScenes::computeBound( const ScenePath &path, const Gaffer::Con
 {
 	// Pass through for simple cases.
 
-	const InputMask activeInputs( activeInputsPlug()->getValue() );
-	if( activeInputs.count() == 1 || !adjustBoundsPlug()->getValue() )
+	ConstIntVectorDataPtr activeInputsData = activeInputsPlug()->getValue();
+	const InputIndices &activeInputs = activeInputsData->readable();
+	if( activeInputs.size() == 1 || !adjustBoundsPlug()->getValue() )
 	{
-		return inPlugs()->getChild<ScenePlug>( first( activeInputs ) )->boundPlug()->getValue();
+		return inPlugs()->getChild<ScenePlug>( activeInputs.front() )->boundPlug()->getValue();
 	}
 
 	// If objects and transforms always come from the first active input,
@@ -536,7 +620,7 @@ Imath::Box3f MergeScenes::computeBound( const ScenePath &path, const Gaffer::Con
 
 	if( objectModePlug()->getValue() == (int)Mode::Keep && transformModePlug()->getValue() == (int)Mode::Keep )
 	{
-		Box3f result = inPlugs()->getChild<ScenePlug>( first( activeInputs ) )->boundPlug()->getValue();
+		Box3f result = inPlugs()->getChild<ScenePlug>( activeInputs.front() )->boundPlug()->getValue();
 		result.extendBy( mergedDescendantsBoundPlug()->getValue() );
 		return result;
 	}
@@ -553,7 +637,7 @@ Imath::Box3f MergeScenes::computeBound( const ScenePath &path, const Gaffer::Con
 void MergeScenes::hashTransform( const ScenePath &path, const Gaffer::Context *context, const ScenePlug *parent, IECore::MurmurHash &h ) const
 {
 	visit(
-		activeInputsPlug()->getValue(),
+		activeInputsPlug()->getValue()->readable(),
 		[&] ( InputType type, size_t index, const ScenePlug *scene ) {
 			h = scene->transformPlug()->hash();
 			return false;
@@ -566,7 +650,7 @@ Imath::M44f MergeScenes::computeTransform( const ScenePath &path, const Gaffer::
 {
 	M44f result;
 	visit(
-		activeInputsPlug()->getValue(),
+		activeInputsPlug()->getValue()->readable(),
 		[&result] ( InputType type, size_t index, const ScenePlug *scene ) {
 			result = scene->transformPlug()->getValue();
 			return false;
@@ -579,68 +663,85 @@ Imath::M44f MergeScenes::computeTransform( const ScenePath &path, const Gaffer::
 
 void MergeScenes::hashAttributes( const ScenePath &path, const Gaffer::Context *context, const ScenePlug *parent, IECore::MurmurHash &h ) const
 {
-	visit(
-		activeInputsPlug()->getValue(),
-		[&] ( InputType type, size_t index, const ScenePlug *scene ) {
-			switch( type )
-			{
-				case InputType::Sole :
-					// Pass hash through unchanged
-					h = scene->attributesPlug()->hash();
-					break;
-				case InputType::First :
-					// Initialise hash and fall through
-					SceneProcessor::hashAttributes( path, context, parent, h );
-					[[fallthrough]];
-				case InputType::Other :
-					// Merge input hash
-					scene->attributesPlug()->hash( h );
-			}
-			return true;
-		},
-		visitOrder( (Mode)attributesModePlug()->getValue() )
+	ConstIntVectorDataPtr activeInputsData = activeInputsPlug()->getValue();
+	const InputIndices &activeInputs = activeInputsData->readable();
+	const Mode mode = (Mode)attributesModePlug()->getValue();
+
+	if( mode != Mode::Merge || activeInputs.size() == 1 )
+	{
+		visit(
+			activeInputs,
+			[&h] ( InputType type, size_t index, const ScenePlug *scene ) {
+				// Pass hash through unchanged
+				h = scene->attributesPlug()->hash();
+				return false;
+			},
+			visitOrder( mode )
+		);
+		return;
+	}
+
+	SceneProcessor::hashAttributes( path, context, parent, h );
+	const vector<MurmurHash> inputHashes = parallelGet(
+		inPlugs(), activeInputs,
+		[] ( int index, const ScenePlug *scene ) {
+			return scene->attributesPlug()->hash();
+		}
 	);
+
+	for( const auto &inputHash : inputHashes )
+	{
+		h.append( inputHash );
+	}
 }
 
 IECore::ConstCompoundObjectPtr MergeScenes::computeAttributes( const ScenePath &path, const Gaffer::Context *context, const ScenePlug *parent ) const
 {
-	ConstCompoundObjectPtr result;
-	CompoundObjectPtr merged;
-	visit(
-		activeInputsPlug()->getValue(),
-		[&] ( InputType type, size_t index, const ScenePlug *scene ) {
-			switch( type )
-			{
-				case InputType::Sole :
-					// Pass input through unchanged.
-					result = scene->attributesPlug()->getValue();
-					break;
-				case InputType::First :
-					// Initialise merged result and
-					// fall through.
-					merged = new CompoundObject();
-					result = merged;
-					[[fallthrough]];
-				case InputType::Other :
-					// Merge input attributes into result.
-					ConstCompoundObjectPtr attributes = scene->attributesPlug()->getValue();
-					for( const auto &a : attributes->members() )
-					{
-						merged->members()[a.first] = a.second;
-					}
-			}
-			return true;
-		},
-		visitOrder( (Mode)attributesModePlug()->getValue() )
+	ConstIntVectorDataPtr activeInputsData = activeInputsPlug()->getValue();
+	const InputIndices &activeInputs = activeInputsData->readable();
+	const Mode mode = (Mode)attributesModePlug()->getValue();
+
+	if( mode != Mode::Merge || activeInputs.size() == 1 )
+	{
+		ConstCompoundObjectPtr result;
+		visit(
+			activeInputs,
+			[&result] ( InputType type, size_t index, const ScenePlug *scene ) {
+				// Pass input through unchanged.
+				result = scene->attributesPlug()->getValue();
+				return false;
+			},
+			visitOrder( mode )
+		);
+		return result;
+	}
+
+	// Fetch all inputs concurrently, and then merge
+	// them in order so that later inputs win.
+
+	const vector<ConstCompoundObjectPtr> inputAttributes = parallelGet(
+		inPlugs(), activeInputs,
+		[] ( int index, const ScenePlug *scene ) {
+			return scene->attributesPlug()->getValue();
+		}
 	);
 
+	CompoundObjectPtr result = new CompoundObject();
+	for( const auto &attributes : inputAttributes )
+	{
+		for( const auto &a : attributes->members() )
+		{
+			result->members()[a.first] = a.second;
+		}
+	}
+
 	return result;
 }
 
 void MergeScenes::hashObject( const ScenePath &path, const Gaffer::Context *context, const ScenePlug *parent, IECore::MurmurHash &h ) const
 {
 	visit(
-		activeInputsPlug()->getValue(),
+		activeInputsPlug()->getValue()->readable(),
 		[&] ( InputType type, size_t index, const ScenePlug *scene ) {
 			switch( type )
 			{
@@ -666,7 +767,7 @@ IECore::ConstObjectPtr MergeScenes::computeObject( const ScenePath &path, const
 {
 	ConstObjectPtr result = IECore::NullObject::defaultNullObject();
 	visit(
-		activeInputsPlug()->getValue(),
+		activeInputsPlug()->getValue()->readable(),
 		[&result] ( InputType type, size_t index, const ScenePlug *scene ) {
 			ConstObjectPtr o = scene->objectPlug()->getValue();
 			if( runTimeCast<const NullObject>( o.get() ) )
@@ -689,65 +790,39 @@ IECore::ConstObjectPtr MergeScenes::computeObject( const ScenePath &path, const
 
 void MergeScenes::hashChildNames( const ScenePath &path, const Gaffer::Context *context, const ScenePlug *parent, IECore::MurmurHash &h ) const
 {
-	visit(
-		activeInputsPlug()->getValue(),
-		[&] ( InputType type, size_t index, const ScenePlug *scene ) {
-			switch( type )
-			{
-				case InputType::Sole :
-					h = scene->childNamesPlug()->hash();
-					break;
-				case InputType::First :
-					SceneProcessor::hashChildNames( path, context, parent, h );
-					[[fallthrough]];
-				case InputType::Other :
-					scene->childNamesPlug()->hash( h );
-			}
-			return true;
+	ConstIntVectorDataPtr activeInputsData = activeInputsPlug()->getValue();
+	const InputIndices &activeInputs = activeInputsData->readable();
+	if( activeInputs.size() == 1 )
+	{
+		h = inPlugs()->getChild<ScenePlug>( activeInputs.front() )->childNamesPlug()->hash();
+		return;
+	}
+
+	SceneProcessor::hashChildNames( path, context, parent, h );
+	const vector<MurmurHash> inputHashes = parallelGet(
+		inPlugs(), activeInputs,
+		[] ( int index, const ScenePlug *scene ) {
+			return scene->childNamesPlug()->hash();
 		}
 	);
+
+	for( const auto &inputHash : inputHashes )
+	{
+		h.append( inputHash );
+	}
 }
 
 IECore::ConstInternedStringVectorDataPtr MergeScenes::computeChildNames( const ScenePath &path, const Gaffer::Context *context, const ScenePlug *parent ) const
 {
-	ConstInternedStringVectorDataPtr result;
-	InternedStringVectorDataPtr merged;
-	unordered_set<InternedString> visited;
-
-	visit(
-		activeInputsPlug()->getValue(),
-		[&] ( InputType type, size_t index, const ScenePlug *scene ) {
-			switch( type )
-			{
-				case InputType::Sole :
-				case InputType::First :
-					result = scene->childNamesPlug()->getValue();
-					break;
-				case InputType::Other :
-					ConstInternedStringVectorDataPtr toMerge = scene->childNamesPlug()->getValue();
-					if( toMerge->readable().size() )
-					{
-						if( !merged )
-						{
-							merged = result->copy();
-							result = merged;
-							visited.insert( merged->readable().begin(), merged->readable().end() );
-						}
-
-						for( const auto & n : toMerge->readable() )
-						{
-							if( visited.insert( n ).second )
-							{
-								merged->writable().push_back( n );
-							}
-						}
-					}
+	ConstIntVectorDataPtr activeInputsData = activeInputsPlug()->getValue();
+	return Private::MergeAlgo::mergeNames(
+		parallelGet(
+			inPlugs(), activeInputsData->readable(),
+			[] ( int index, const ScenePlug *scene ) {
+				return scene->childNamesPlug()->getValue();
 			}
-			return true;
-		}
+		)
 	);
-
-	return result;
 }
 
 void MergeScenes::hashGlobals( const Gaffer::Context *context, const ScenePlug *parent, IECore::MurmurHash &h ) const
@@ -812,119 +887,74 @@ IECore::ConstCompoundObjectPtr MergeScenes::computeGlobals( const Gaffer::Contex
 
 void MergeScenes::hashSetNames( const Gaffer::Context *context, const ScenePlug *parent, IECore::MurmurHash &h ) const
 {
-	visit(
-		connectedInputs(),
-		[&] ( InputType type, size_t index, const ScenePlug *scene ) {
-			switch( type )
-			{
-				case InputType::Sole :
-					// Pass hash through unchanged.
-					h = scene->setNamesPlug()->hash();
-					break;
-				case InputType::First :
-					// Initialise hash and fall through.
-					SceneProcessor::hashSetNames( context, parent, h );
-					[[fallthrough]];
-				case InputType::Other :
-					// Merge input hash.
-					scene->setNamesPlug()->hash( h );
-			}
-			return true;
+	const InputIndices inputs = connectedInputs();
+	if( inputs.size() == 1 )
+	{
+		// Pass hash through unchanged.
+		h = inPlugs()->getChild<ScenePlug>( inputs.front() )->setNamesPlug()->hash();
+		return;
+	}
+
+	SceneProcessor::hashSetNames( context, parent, h );
+	const vector<MurmurHash> inputHashes = parallelGet(
+		inPlugs(), inputs,
+		[] ( int index, const ScenePlug *scene ) {
+			return scene->setNamesPlug()->hash();
 		}
 	);
+
+	for( const auto &inputHash : inputHashes )
+	{
+		h.append( inputHash );
+	}
 }
 
 IECore::ConstInternedStringVectorDataPtr MergeScenes::computeSetNames( const Gaffer::Context *context, const ScenePlug *parent ) const
 {
-	ConstInternedStringVectorDataPtr result;
-	InternedStringVectorDataPtr merged;
-	visit(
-		connectedInputs(),
-		[&] ( InputType type, size_t index, const ScenePlug *scene ) {
-			switch( type )
-			{
-				case InputType::Sole :
-					// Pass input through unchanged.
-					result = scene->setNamesPlug()->getValue();
-					break;
-				case InputType::First :
-					// Initialise merged result and
-					// fall through.
-					merged = new InternedStringVectorData();
-					result = merged;
-					[[fallthrough]];
-				case InputType::Other :
-					// This naive approach to merging set names preserves the order of the incoming names,
-					// but at the expense of using linear search. We assume that the number of sets is small
-					// enough and the InternedString comparison fast enough that this is OK.
-					ConstInternedStringVectorDataPtr setNames = scene->setNamesPlug()->getValue();
-					for( const auto &setName : setNames->readable() )
-					{
-						if( std::find( merged->readable().begin(), merged->readable().end(), setName ) == merged->readable().end() )
-						{
-							merged->writable().push_back( setName );
-						}
-					}
+	return Private::MergeAlgo::mergeNames(
+		parallelGet(
+			inPlugs(), connectedInputs(),
+			[] ( int index, const ScenePlug *scene ) {
+				return scene->setNamesPlug()->getValue();
 			}
-			return true;
-		}
+		)
 	);
-
-	return result;
 }
 
 void MergeScenes::hashSet( const IECore::InternedString &setName, const Gaffer::Context *context, const ScenePlug *parent, IECore::MurmurHash &h ) const
 {
-	visit(
-		connectedInputs(),
-		[&] ( InputType type, size_t index, const ScenePlug *scene ) {
-			switch( type )
-			{
-				case InputType::Sole :
-					// Pass hash through unchanged.
-					h = scene->setPlug()->hash();
-					break;
-				case InputType::First :
-					// Initialise hash and fall through.
-					SceneProcessor::hashSet( setName, context, parent, h );
-					[[fallthrough]];
-				case InputType::Other :
-					// Merge input hash.
-					scene->setPlug()->hash( h );
-			}
-			return true;
+	const InputIndices inputs = connectedInputs();
+	if( inputs.size() == 1 )
+	{
+		// Pass hash through unchanged.
+		h = inPlugs()->getChild<ScenePlug>( inputs.front() )->setPlug()->hash();
+		return;
+	}
+
+	SceneProcessor::hashSet( setName, context, parent, h );
+	const vector<MurmurHash> inputHashes = parallelGet(
+		inPlugs(), inputs,
+		[] ( int index, const ScenePlug *scene ) {
+			return scene->setPlug()->hash();
 		}
 	);
+
+	for( const auto &inputHash : inputHashes )
+	{
+		h.append( inputHash );
+	}
 }
 
 IECore::ConstPathMatcherDataPtr MergeScenes::computeSet( const IECore::InternedString &setName, const Gaffer::Context *context, const ScenePlug *parent ) const
 {
-	ConstPathMatcherDataPtr result;
-	PathMatcherDataPtr merged;
-	visit(
-		connectedInputs(),
-		[&] ( InputType type, size_t index, const ScenePlug *scene ) {
-			switch( type )
-			{
-				case InputType::Sole :
-					// Pass input through unchanged.
-					result = scene->setPlug()->getValue();
-					break;
-				case InputType::First :
-					// Initialise merged result and
-					// fall through.
-					merged = new PathMatcherData();
-					result = merged;
-					[[fallthrough]];
-				case InputType::Other :
-					ConstPathMatcherDataPtr paths = scene->setPlug()->getValue();
-					merged->writable().addPaths( paths->readable() );
+	return Private::MergeAlgo::unionSets(
+		parallelGet(
+			inPlugs(), connectedInputs(),
+			[] ( int index, const ScenePlug *scene ) {
+				return scene->setPlug()->getValue();
 			}
-			return true;
-		}
+		)
 	);
-
-	return result;
 }
 
 MergeScenes::VisitOrder MergeScenes::visitOrder( Mode mode, VisitOrder replaceOrder ) const
@@ -940,34 +970,37 @@ MergeScenes::VisitOrder MergeScenes::visitOrder( Mode mode, VisitOrder replaceOr
 	}
 }
 
-MergeScenes::InputMask MergeScenes::connectedInputs() const
+MergeScenes::InputIndices MergeScenes::connectedInputs() const
 {
-	InputMask result;
-	for( size_t i = 0, e = inPlugs()->children().size(); i < e; ++i )
+	InputIndices result;
+	for( int i = 0, e = inPlugs()->children().size(); i < e; ++i )
 	{
-		result[i] = (bool)inPlugs()->getChild<ScenePlug>( i )->getInput();
+		if( inPlugs()->getChild<ScenePlug>( i )->getInput() )
+		{
+			result.push_back( i );
+		}
 	}
 
-	if( !result.count() )
+	if( result.empty() )
 	{
-		result[0] = true;
+		result.push_back( 0 );
 	}
 
 	return result;
 }
 
 template<typename Visitor>
-void MergeScenes::visit( InputMask inputMask, Visitor &&visitor, VisitOrder order ) const
+void MergeScenes::visit( const InputIndices &inputs, Visitor &&visitor, VisitOrder order ) const
 {
-	assert( inputMask.count() );
+	assert( inputs.size() );
 
 	const bool backwards = order == VisitOrder::Backwards || order == VisitOrder::LastOnly;
-	const int startIndex = backwards ? inPlugs()->children().size() - 1 : 0;
-	const int endIndex = backwards ? -1 : inPlugs()->children().size();
+	const int startIndex = backwards ? inputs.size() - 1 : 0;
+	const int endIndex = backwards ? -1 : inputs.size();
 	const int increment = backwards ? -1 : 1;
 
 	InputType type;
-	if( order == VisitOrder::FirstOnly || order == VisitOrder::LastOnly || inputMask.count() == 1 )
+	if( order == VisitOrder::FirstOnly || order == VisitOrder::LastOnly || inputs.size() == 1 )
 	{
 		type = InputType::Sole;
 	}
@@ -978,14 +1011,11 @@ void MergeScenes::visit( InputMask inputMask, Visitor &&visitor, VisitOrder orde
 
 	for( int i = startIndex; i != endIndex; i += increment )
 	{
-		if( inputMask[i] )
+		const bool c = visitor( type, inputs[i], inPlugs()->getChild<ScenePlug>( inputs[i] ) );
+		if( !c || order == VisitOrder::FirstOnly || order == VisitOrder::LastOnly )
 		{
-			const bool c = visitor( type, i, inPlugs()->getChild<ScenePlug>( i ) );
-			if( !c || order == VisitOrder::FirstOnly || order == VisitOrder::LastOnly )
-			{
-				break;
-			}
-			type = InputType::Other;
+			break;
 		}
+		type = InputType::Other;
 	}
 }
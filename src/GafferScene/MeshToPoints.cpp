@@ -118,3 +118,11 @@ IECore::ConstObjectPtr MeshToPoints::computeProcessedObject( const ScenePath &pa
 
 	return result;
 }
+
+Gaffer::ValuePlug::CachePolicy MeshToPoints::processedObjectComputeCachePolicy() const
+{
+	// We don't spawn any tasks, and we're cheap to compute because
+	// we reference the input data rather than copying it. But there's
+	// no need for concurrent callers to duplicate the work.
+	return ValuePlug::CachePolicy::Standard;
+}
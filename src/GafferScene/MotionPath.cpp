@@ -46,6 +46,11 @@
 
 #include "OpenEXR/ImathMatrixAlgo.h"
 
+#include "boost/unordered_map.hpp"
+
+#include "tbb/parallel_for.h"
+
+using namespace std;
 using namespace IECore;
 using namespace IECoreScene;
 using namespace Gaffer;
@@ -58,6 +63,28 @@ InternedString g_lightsSetName( "__lights" );
 InternedString g_defaultLightsSetName( "defaultLights" );
 InternedString g_camerasSetName( "__cameras" );
 
+vector<MurmurHash> fullTransformHashes( const ScenePlug *scene, const ScenePlug::ScenePath &path, const vector<float> &frames )
+{
+	vector<MurmurHash> result( frames.size() );
+
+	const ThreadState &threadState = ThreadState::current();
+	tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+	tbb::parallel_for(
+		tbb::blocked_range<size_t>( 0, frames.size() ),
+		[&] ( const tbb::blocked_range<size_t> &range ) {
+			Context::EditableScope scope( threadState );
+			for( size_t i = range.begin(); i != range.end(); ++i )
+			{
+				scope.setFrame( frames[i] );
+				result[i] = scene->fullTransformHash( path );
+			}
+		},
+		taskGroupContext
+	);
+
+	return result;
+}
+
 } // namespace
 
 GAFFER_NODE_DEFINE_TYPE( MotionPath );
@@ -307,17 +334,21 @@ void MotionPath::hashObject( const ScenePath &path, const Context *context, cons
 
 	FilteredSceneProcessor::hashObject( path, context, parent, h );
 
-	h.append( inPlug()->fullTransformHash( path ) );
-
-	h.append( context->getFrame() );
+	const vector<float> frames = sampleFrames( context );
+	if( frames.empty() )
+	{
+		h = inPlug()->objectPlug()->defaultHash();
+		return;
+	}
 
-	startModePlug()->hash( h );
-	startFramePlug()->hash( h );
-	endModePlug()->hash( h );
-	endFramePlug()->hash( h );
-	samplingModePlug()->hash( h );
-	stepPlug()->hash( h );
-	samplesPlug()->hash( h );
+	// We hash the transform at every sample frame, rather than the current
+	// frame. This means that paths using an absolute frame range are reused
+	// as the current frame changes.
+	h.append( frames.data(), frames.size() );
+	for( const auto &transformHash : fullTransformHashes( inPlug(), path, frames ) )
+	{
+		h.append( transformHash );
+	}
 }
 
 ConstObjectPtr MotionPath::computeObject( const ScenePath &path, const Context *context, const ScenePlug *parent ) const
@@ -327,74 +358,143 @@ ConstObjectPtr MotionPath::computeObject( const ScenePath &path, const Context *
 		return inPlug()->objectPlug()->defaultValue();
 	}
 
-	float start = ( (FrameMode)startModePlug()->getValue() == FrameMode::Absolute ) ? startFramePlug()->getValue() : context->getFrame() + startFramePlug()->getValue();
-	float end = ( (FrameMode)endModePlug()->getValue() == FrameMode::Absolute ) ? endFramePlug()->getValue() : context->getFrame() + endFramePlug()->getValue();
-	if( start >= end )
+	const vector<float> frames = sampleFrames( context );
+	if( frames.empty() )
 	{
 		return inPlug()->objectPlug()->defaultValue();
 	}
 
-	float step = 0;
-	int samples = 0;
-	if( (SamplingMode)samplingModePlug()->getValue() == SamplingMode::Variable )
+	// Locations which are static for all or part of the frame range have
+	// the same transform at many frames. We use the transform hashes to
+	// identify the distinct transforms, and compute and decompose each only
+	// once, in parallel.
+
+	const vector<MurmurHash> transformHashes = fullTransformHashes( inPlug(), path, frames );
+
+	vector<size_t> distinctSamples;
+	vector<size_t> sampleSources( frames.size() );
+	boost::unordered_map<MurmurHash, size_t> hashesToSamples;
+	for( size_t i = 0; i < frames.size(); ++i )
 	{
-		step = stepPlug()->getValue();
-		samples = ceil( ( end - start ) / step - 1e-6 ) + 1;
+		auto inserted = hashesToSamples.insert( { transformHashes[i], i } );
+		if( inserted.second )
+		{
+			distinctSamples.push_back( i );
+		}
+		sampleSources[i] = inserted.first->second;
 	}
-	else
+
+	struct Sample
 	{
-		samples = samplesPlug()->getValue();
-		step = ( end - start ) / ( samples - 1 );
-	}
+		Imath::V3f translate;
+		Imath::Quatf orientation;
+		Imath::V3f scale;
+	};
+
+	vector<Sample> samples( frames.size() );
+
+	const ThreadState &threadState = ThreadState::current();
+	tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+	tbb::parallel_for(
+		tbb::blocked_range<size_t>( 0, distinctSamples.size() ),
+		[&] ( const tbb::blocked_range<size_t> &range ) {
+			Context::EditableScope scope( threadState );
+			Imath::V3f s;
+			Imath::V3f h;
+			Imath::Eulerf r;
+			Imath::V3f t;
+			for( size_t i = range.begin(); i != range.end(); ++i )
+			{
+				const size_t sampleIndex = distinctSamples[i];
+				scope.setFrame( frames[sampleIndex] );
+				Imath::extractSHRT( inPlug()->fullTransform( path ), s, h, r, t );
+				samples[sampleIndex] = { t, r.toQuat(), s };
+			}
+		},
+		taskGroupContext
+	);
 
 	V3fVectorDataPtr points = new V3fVectorData;
 	points->setInterpretation( GeometricData::Point );
 	auto &p = points->writable();
-	p.reserve( samples );
+	p.reserve( frames.size() );
 
 	QuatfVectorDataPtr orientations = new QuatfVectorData;
 	auto &orients = orientations->writable();
-	orients.reserve( samples );
+	orients.reserve( frames.size() );
 
 	V3fVectorDataPtr scaleData = new V3fVectorData;
 	auto &scales = scaleData->writable();
-	scales.reserve( samples );
-
-	FloatVectorDataPtr sampleFrames = new FloatVectorData;
-	auto &frames = sampleFrames->writable();
-	frames.reserve( samples );
+	scales.reserve( frames.size() );
 
-	Imath::V3f s;
-	Imath::V3f h;
-	Imath::Eulerf r;
-	Imath::V3f t;
+	FloatVectorDataPtr framesData = new FloatVectorData( frames );
 
-	Context::EditableScope scope( context );
-	for( int i = 0; i < samples - 1; ++i )
+	for( size_t sampleSource : sampleSources )
 	{
-		float f = start + step * i;
-		scope.setFrame( f );
-		Imath::extractSHRT( inPlug()->fullTransform( path ), s, h, r, t );
-		p.emplace_back( t );
-		orients.emplace_back( r.toQuat() );
-		scales.emplace_back( s );
-		frames.emplace_back( f );
+		const Sample &sample = samples[sampleSource];
+		p.emplace_back( sample.translate );
+		orients.emplace_back( sample.orientation );
+		scales.emplace_back( sample.scale );
 	}
 
-	scope.setFrame( end );
-	Imath::extractSHRT( inPlug()->fullTransform( path ), s, h, r, t );
-	p.emplace_back( t );
-	orients.emplace_back( r.toQuat() );
-	scales.emplace_back( s );
-	frames.emplace_back( end );
-
 	CurvesPrimitivePtr motionPath = new CurvesPrimitive( new IntVectorData( { (int)p.size() } ), CubicBasisf::linear(), false, points );
 	motionPath->variables["orientation"] = PrimitiveVariable( PrimitiveVariable::Vertex, orientations );
 	motionPath->variables["scale"] = PrimitiveVariable( PrimitiveVariable::Vertex, scaleData );
-	motionPath->variables["frame"] = PrimitiveVariable( PrimitiveVariable::Vertex, sampleFrames );
+	motionPath->variables["frame"] = PrimitiveVariable( PrimitiveVariable::Vertex, framesData );
 	return motionPath;
 }
 
+Gaffer::ValuePlug::CachePolicy MotionPath::hashCachePolicy( const Gaffer::ValuePlug *output ) const
+{
+	if( output == outPlug()->objectPlug() )
+	{
+		return ValuePlug::CachePolicy::TaskCollaboration;
+	}
+	return FilteredSceneProcessor::hashCachePolicy( output );
+}
+
+Gaffer::ValuePlug::CachePolicy MotionPath::computeCachePolicy( const Gaffer::ValuePlug *output ) const
+{
+	if( output == outPlug()->objectPlug() )
+	{
+		return ValuePlug::CachePolicy::TaskCollaboration;
+	}
+	return FilteredSceneProcessor::computeCachePolicy( output );
+}
+
+std::vector<float> MotionPath::sampleFrames( const Gaffer::Context *context ) const
+{
+	const float start = ( (FrameMode)startModePlug()->getValue() == FrameMode::Absolute ) ? startFramePlug()->getValue() : context->getFrame() + startFramePlug()->getValue();
+	const float end = ( (FrameMode)endModePlug()->getValue() == FrameMode::Absolute ) ? endFramePlug()->getValue() : context->getFrame() + endFramePlug()->getValue();
+	if( start >= end )
+	{
+		return {};
+	}
+
+	float step = 0;
+	int samples = 0;
+	if( (SamplingMode)samplingModePlug()->getValue() == SamplingMode::Variable )
+	{
+		step = stepPlug()->getValue();
+		samples = ceil( ( end - start ) / step - 1e-6 ) + 1;
+	}
+	else
+	{
+		samples = samplesPlug()->getValue();
+		step = ( end - start ) / ( samples - 1 );
+	}
+
+	vector<float> result;
+	result.reserve( samples );
+	for( int i = 0; i < samples - 1; ++i )
+	{
+		result.push_back( start + step * i );
+	}
+	result.push_back( end );
+
+	return result;
+}
+
 void MotionPath::hashSetNames( const Context *context, const ScenePlug *parent, MurmurHash &h ) const
 {
 	FilteredSceneProcessor::hashSetNames( context, parent, h );
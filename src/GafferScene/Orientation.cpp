@@ -47,12 +47,15 @@
 #include "IECoreScene/Primitive.h"
 
 #include "IECore/AngleConversion.h"
+#include "IECore/Canceller.h"
 #include "IECore/MatrixAlgo.h"
 
 #include "OpenEXR/ImathEuler.h"
 #include "OpenEXR/ImathMatrixAlgo.h"
 #include "OpenEXR/ImathRandom.h"
 
+#include "tbb/parallel_for.h"
+
 #include <random>
 
 using namespace std;
@@ -76,6 +79,28 @@ using namespace GafferScene;
 namespace
 {
 
+// Calls `f( i )` for every index in `[0, size)`, in parallel. All the
+// conversions below are written as independent per-element operations
+// over contiguous storage, so that they give identical results to a
+// serial loop, and the compiler is free to vectorise the inner loops.
+// Cancellation is checked once per range.
+template<typename F>
+void parallelForEachIndex( size_t size, const IECore::Canceller *canceller, F &&f )
+{
+	tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+	tbb::parallel_for(
+		tbb::blocked_range<size_t>( 0, size, 1000 ),
+		[&f, canceller]( const tbb::blocked_range<size_t> &range ) {
+			IECore::Canceller::check( canceller );
+			for( size_t i = range.begin(); i != range.end(); ++i )
+			{
+				f( i );
+			}
+		},
+		taskGroupContext
+	);
+}
+
 struct ViewSpec
 {
 	std::string name;
@@ -143,7 +168,7 @@ PrimitiveVariable::IndexedView<T> indexedView( const Primitive *inputPrimitive,
 	return PrimitiveVariable::IndexedView<T>( it->second );
 }
 
-PrimitiveVariable inEuler( const Primitive *inputPrimitive, Primitive *outputPrimitive, const std::string &eulerName, const Imath::Eulerf::Order order, bool deleteInputs )
+PrimitiveVariable inEuler( const Primitive *inputPrimitive, Primitive *outputPrimitive, const std::string &eulerName, const Imath::Eulerf::Order order, bool deleteInputs, const IECore::Canceller *canceller )
 {
 	if( eulerName == "" )
 	{
@@ -155,18 +180,20 @@ PrimitiveVariable inEuler( const Primitive *inputPrimitive, Primitive *outputPri
 
 	QuatfVectorDataPtr quaternionData = new QuatfVectorData;
 	auto &quaternions = quaternionData->writable();
-	quaternions.reserve( view.size() );
+	quaternions.resize( view.size() );
 
-	for( auto &eulerVec : view )
-	{
-		const Eulerf euler( degreesToRadians( eulerVec ), order, Eulerf::XYZLayout );
-		quaternions.push_back( euler.toQuat() );
-	}
+	parallelForEachIndex(
+		view.size(), canceller,
+		[&]( size_t i ) {
+			const Eulerf euler( degreesToRadians( view[i] ), order, Eulerf::XYZLayout );
+			quaternions[i] = euler.toQuat();
+		}
+	);
 
 	return PrimitiveVariable( spec.interpolation, quaternionData );
 }
 
-PrimitiveVariable inQuaternion( const Primitive *inputPrimitive, Primitive *outputPrimitive, const std::string &quaternionName, bool deleteInputs, bool xyzw )
+PrimitiveVariable inQuaternion( const Primitive *inputPrimitive, Primitive *outputPrimitive, const std::string &quaternionName, bool deleteInputs, bool xyzw, const IECore::Canceller *canceller )
 {
 	if( quaternionName == "" )
 	{
@@ -178,24 +205,27 @@ PrimitiveVariable inQuaternion( const Primitive *inputPrimitive, Primitive *outp
 
 	QuatfVectorDataPtr quaternionData = new QuatfVectorData;
 	auto &quaternions = quaternionData->writable();
-	quaternions.reserve( view.size() );
-
-	for( auto &q : view )
-	{
-		if( xyzw )
-		{
-			quaternions.push_back( Quatf( q.v.z, V3f( q.r, q.v.x, q.v.y ) ) );
-		}
-		else
-		{
-			quaternions.push_back( q );
+	quaternions.resize( view.size() );
+
+	parallelForEachIndex(
+		view.size(), canceller,
+		[&]( size_t i ) {
+			const Quatf &q = view[i];
+			if( xyzw )
+			{
+				quaternions[i] = Quatf( q.v.z, V3f( q.r, q.v.x, q.v.y ) );
+			}
+			else
+			{
+				quaternions[i] = q;
+			}
 		}
-	}
+	);
 
 	return PrimitiveVariable( spec.interpolation, quaternionData );
 }
 
-PrimitiveVariable inAxisAngle( const Primitive *inputPrimitive, Primitive *outputPrimitive, const std::string &axisName, const std::string &angleName, bool deleteInputs )
+PrimitiveVariable inAxisAngle( const Primitive *inputPrimitive, Primitive *outputPrimitive, const std::string &axisName, const std::string &angleName, bool deleteInputs, const IECore::Canceller *canceller )
 {
 	if( axisName == "" || angleName == "" )
 	{
@@ -208,17 +238,19 @@ PrimitiveVariable inAxisAngle( const Primitive *inputPrimitive, Primitive *outpu
 
 	QuatfVectorDataPtr quaternionData = new QuatfVectorData;
 	auto &quaternions = quaternionData->writable();
-	quaternions.reserve( axisView.size() );
+	quaternions.resize( axisView.size() );
 
-	for( size_t i = 0, s = axisView.size(); i < s; ++i )
-	{
-		quaternions.push_back( Quatf().setAxisAngle( axisView[i], angleView[i] ) );
-	}
+	parallelForEachIndex(
+		axisView.size(), canceller,
+		[&]( size_t i ) {
+			quaternions[i] = Quatf().setAxisAngle( axisView[i], angleView[i] );
+		}
+	);
 
 	return PrimitiveVariable( spec.interpolation, quaternionData );
 }
 
-PrimitiveVariable inAim( const Primitive *inputPrimitive, Primitive *outputPrimitive, const std::string &xAxisName, const std::string &yAxisName, const std::string &zAxisName, bool deleteInputs )
+PrimitiveVariable inAim( const Primitive *inputPrimitive, Primitive *outputPrimitive, const std::string &xAxisName, const std::string &yAxisName, const std::string &zAxisName, bool deleteInputs, const IECore::Canceller *canceller )
 {
 	ViewSpec spec;
 
@@ -245,71 +277,75 @@ PrimitiveVariable inAim( const Primitive *inputPrimitive, Primitive *outputPrimi
 
 	QuatfVectorDataPtr quaternionData = new QuatfVectorData;
 	auto &quaternions = quaternionData->writable();
-	quaternions.reserve( spec.size );
-
-	for( size_t i = 0; i < spec.size; ++i )
-	{
-		M44f m;
-		if( xAxis && yAxis && zAxis )
-		{
-			m = matrixFromBasis( (*xAxis)[i], (*yAxis)[i], (*zAxis)[i], V3f( 0 ) );
-		}
-		else if( xAxis && yAxis )
-		{
-			const V3f &x = (*xAxis)[i];
-			const V3f &y = (*yAxis)[i];
-			m = matrixFromBasis( x, y, x.cross( y ), V3f( 0 ) );
-		}
-		else if( xAxis && zAxis )
-		{
-			const V3f &x = (*xAxis)[i];
-			const V3f &z = (*zAxis)[i];
-			m = matrixFromBasis( x, z.cross( x ), z, V3f( 0 ) );
-		}
-		else if( yAxis && zAxis )
-		{
-			const V3f &y = (*yAxis)[i];
-			const V3f &z = (*zAxis)[i];
-			m = matrixFromBasis( y.cross( z ), y, z, V3f( 0 ) );
-		}
-		else if( xAxis )
-		{
-			m = rotationMatrixWithUpDir( V3f( 1, 0, 0 ), (*xAxis)[i], V3f( 0, 1, 0 ) );
-		}
-		else if( yAxis )
-		{
-			m = rotationMatrixWithUpDir( V3f( 0, 1, 0 ), (*yAxis)[i], V3f( 0, 1, 0 ) );
-		}
-		else if( zAxis )
-		{
-			m = rotationMatrixWithUpDir( V3f( 0, 0, 1 ), (*zAxis)[i], V3f( 0, 1, 0 ) );
+	quaternions.resize( spec.size );
+
+	parallelForEachIndex(
+		spec.size, canceller,
+		[&]( size_t i ) {
+			M44f m;
+			if( xAxis && yAxis && zAxis )
+			{
+				m = matrixFromBasis( (*xAxis)[i], (*yAxis)[i], (*zAxis)[i], V3f( 0 ) );
+			}
+			else if( xAxis && yAxis )
+			{
+				const V3f &x = (*xAxis)[i];
+				const V3f &y = (*yAxis)[i];
+				m = matrixFromBasis( x, y, x.cross( y ), V3f( 0 ) );
+			}
+			else if( xAxis && zAxis )
+			{
+				const V3f &x = (*xAxis)[i];
+				const V3f &z = (*zAxis)[i];
+				m = matrixFromBasis( x, z.cross( x ), z, V3f( 0 ) );
+			}
+			else if( yAxis && zAxis )
+			{
+				const V3f &y = (*yAxis)[i];
+				const V3f &z = (*zAxis)[i];
+				m = matrixFromBasis( y.cross( z ), y, z, V3f( 0 ) );
+			}
+			else if( xAxis )
+			{
+				m = rotationMatrixWithUpDir( V3f( 1, 0, 0 ), (*xAxis)[i], V3f( 0, 1, 0 ) );
+			}
+			else if( yAxis )
+			{
+				m = rotationMatrixWithUpDir( V3f( 0, 1, 0 ), (*yAxis)[i], V3f( 0, 1, 0 ) );
+			}
+			else if( zAxis )
+			{
+				m = rotationMatrixWithUpDir( V3f( 0, 0, 1 ), (*zAxis)[i], V3f( 0, 1, 0 ) );
+			}
+
+			removeScalingAndShear( m );
+			quaternions[i] = extractQuat( m );
 		}
-
-		removeScalingAndShear( m );
-		quaternions.push_back( extractQuat( m ) );
-	}
+	);
 
 	return PrimitiveVariable( spec.interpolation, quaternionData );
 }
 
-PrimitiveVariable inMatrix( const Primitive *inputPrimitive, Primitive *outputPrimitive, const std::string &matrixName, bool deleteInputs )
+PrimitiveVariable inMatrix( const Primitive *inputPrimitive, Primitive *outputPrimitive, const std::string &matrixName, bool deleteInputs, const IECore::Canceller *canceller )
 {
 	ViewSpec spec;
 	auto matrixView = indexedView<M33f>( inputPrimitive, outputPrimitive, matrixName, deleteInputs, spec );
 
 	QuatfVectorDataPtr quaternionData = new QuatfVectorData;
 	auto &quaternions = quaternionData->writable();
-	quaternions.reserve( matrixView.size() );
+	quaternions.resize( matrixView.size() );
 
-	for( auto &m : matrixView )
-	{
-		quaternions.push_back( extractQuat( M44f( m, V3f( 0 ) ) ) );
-	}
+	parallelForEachIndex(
+		matrixView.size(), canceller,
+		[&]( size_t i ) {
+			quaternions[i] = extractQuat( M44f( matrixView[i], V3f( 0 ) ) );
+		}
+	);
 
 	return PrimitiveVariable( spec.interpolation, quaternionData );
 }
 
-void outEuler( const PrimitiveVariable &orientations, Primitive *outputPrimitive, const std::string &eulerName, Imath::Eulerf::Order order )
+void outEuler( const PrimitiveVariable &orientations, Primitive *outputPrimitive, const std::string &eulerName, Imath::Eulerf::Order order, const IECore::Canceller *canceller )
 {
 	if( eulerName == "" )
 	{
@@ -320,13 +356,15 @@ void outEuler( const PrimitiveVariable &orientations, Primitive *outputPrimitive
 
 	V3fVectorDataPtr eulerData = new V3fVectorData();
 	auto &euler = eulerData->writable();
-	euler.reserve( quaternions.size() );
+	euler.resize( quaternions.size() );
 
-	for( auto &q : quaternions )
-	{
-		Eulerf e( q.toMatrix33(), order );
-		euler.push_back( radiansToDegrees( e.toXYZVector() ) );
-	}
+	parallelForEachIndex(
+		quaternions.size(), canceller,
+		[&]( size_t i ) {
+			Eulerf e( quaternions[i].toMatrix33(), order );
+			euler[i] = radiansToDegrees( e.toXYZVector() );
+		}
+	);
 
 	outputPrimitive->variables[eulerName] = PrimitiveVariable( orientations.interpolation, eulerData );
 }
@@ -340,7 +378,7 @@ void outQuaternion( const PrimitiveVariable &orientations, Primitive *outputPrim
 	outputPrimitive->variables[quaternionName] = orientations;
 }
 
-void outAxisAngle( const PrimitiveVariable &orientations, Primitive *outputPrimitive, const std::string &axisName, const std::string &angleName )
+void outAxisAngle( const PrimitiveVariable &orientations, Primitive *outputPrimitive, const std::string &axisName, const std::string &angleName, const IECore::Canceller *canceller )
 {
 	const auto &quaternions = static_cast<const QuatfVectorData *>( orientations.data.get() )->readable();
 
@@ -350,7 +388,7 @@ void outAxisAngle( const PrimitiveVariable &orientations, Primitive *outputPrimi
 	{
 		axisData = new V3fVectorData();
 		axis = &axisData->writable();
-		axis->reserve( quaternions.size() );
+		axis->resize( quaternions.size() );
 		outputPrimitive->variables[axisName] = PrimitiveVariable( orientations.interpolation, axisData );
 	}
 
@@ -360,7 +398,7 @@ void outAxisAngle( const PrimitiveVariable &orientations, Primitive *outputPrimi
 	{
 		angleData = new FloatVectorData();
 		angle = &angleData->writable();
-		angle->reserve( quaternions.size() );
+		angle->resize( quaternions.size() );
 		outputPrimitive->variables[angleName] = PrimitiveVariable( orientations.interpolation, angleData );
 	}
 
@@ -369,20 +407,22 @@ void outAxisAngle( const PrimitiveVariable &orientations, Primitive *outputPrimi
 		return;
 	}
 
-	for( auto &q : quaternions )
-	{
-		if( axis )
-		{
-			axis->push_back( q.axis() );
-		}
-		if( angle )
-		{
-			angle->push_back( q.angle() );
+	parallelForEachIndex(
+		quaternions.size(), canceller,
+		[&]( size_t i ) {
+			if( axis )
+			{
+				(*axis)[i] = quaternions[i].axis();
+			}
+			if( angle )
+			{
+				(*angle)[i] = quaternions[i].angle();
+			}
 		}
-	}
+	);
 }
 
-void outAim( const PrimitiveVariable &orientations, Primitive *outputPrimitive, const std::string &xAxisName, const std::string &yAxisName, const std::string &zAxisName )
+void outAim( const PrimitiveVariable &orientations, Primitive *outputPrimitive, const std::string &xAxisName, const std::string &yAxisName, const std::string &zAxisName, const IECore::Canceller *canceller )
 {
 	const auto &quaternions = static_cast<const QuatfVectorData *>( orientations.data.get() )->readable();
 
@@ -392,7 +432,7 @@ void outAim( const PrimitiveVariable &orientations, Primitive *outputPrimitive,
 	{
 		xAxisData = new V3fVectorData;
 		xAxis = &xAxisData->writable();
-		xAxis->reserve( quaternions.size() );
+		xAxis->resize( quaternions.size() );
 		outputPrimitive->variables[xAxisName] = PrimitiveVariable( orientations.interpolation, xAxisData );
 	}
 
@@ -402,7 +442,7 @@ void outAim( const PrimitiveVariable &orientations, Primitive *outputPrimitive,
 	{
 		yAxisData = new V3fVectorData;
 		yAxis = &yAxisData->writable();
-		yAxis->reserve( quaternions.size() );
+		yAxis->resize( quaternions.size() );
 		outputPrimitive->variables[yAxisName] = PrimitiveVariable( orientations.interpolation, yAxisData );
 	}
 
@@ -412,7 +452,7 @@ void outAim( const PrimitiveVariable &orientations, Primitive *outputPrimitive,
 	{
 		zAxisData = new V3fVectorData;
 		zAxis = &zAxisData->writable();
-		zAxis->reserve( quaternions.size() );
+		zAxis->resize( quaternions.size() );
 		outputPrimitive->variables[zAxisName] = PrimitiveVariable( orientations.interpolation, zAxisData );
 	}
 
@@ -421,25 +461,27 @@ void outAim( const PrimitiveVariable &orientations, Primitive *outputPrimitive,
 		return;
 	}
 
-	for( auto &q : quaternions )
-	{
-		const M44f m = q.toMatrix44();
-		if( xAxis )
-		{
-			xAxis->push_back( V3f( m[0][0], m[0][1], m[0][2] ) );
+	parallelForEachIndex(
+		quaternions.size(), canceller,
+		[&]( size_t i ) {
+			const M44f m = quaternions[i].toMatrix44();
+			if( xAxis )
+			{
+				(*xAxis)[i] = V3f( m[0][0], m[0][1], m[0][2] );
+			}
+			if( yAxis )
+			{
+				(*yAxis)[i] = V3f( m[1][0], m[1][1], m[1][2] );
+			}
+			if( zAxis )
+			{
+				(*zAxis)[i] = V3f( m[2][0], m[2][1], m[2][2] );
+			}
 		}
-		if( yAxis )
-		{
-			yAxis->push_back( V3f( m[1][0], m[1][1], m[1][2] ) );
-		}
-		if( zAxis )
-		{
-			zAxis->push_back( V3f( m[2][0], m[2][1], m[2][2] ) );
-		}
-	}
+	);
 }
 
-void outMatrix( const PrimitiveVariable &orientations, Primitive *outputPrimitive, const std::string &matrixName )
+void outMatrix( const PrimitiveVariable &orientations, Primitive *outputPrimitive, const std::string &matrixName, const IECore::Canceller *canceller )
 {
 	if( matrixName == "" )
 	{
@@ -450,12 +492,14 @@ void outMatrix( const PrimitiveVariable &orientations, Primitive *outputPrimitiv
 
 	M33fVectorDataPtr matricesData = new M33fVectorData();
 	auto &matrices = matricesData->writable();
-	matrices.reserve( matrices.size() );
+	matrices.resize( quaternions.size() );
 
-	for( auto &q : quaternions )
-	{
-		matrices.push_back( q.toMatrix33() );
-	}
+	parallelForEachIndex(
+		quaternions.size(), canceller,
+		[&]( size_t i ) {
+			matrices[i] = quaternions[i].toMatrix33();
+		}
+	);
 
 	outputPrimitive->variables[matrixName] = PrimitiveVariable( orientations.interpolation, matricesData );
 }
@@ -949,7 +993,8 @@ IECore::ConstObjectPtr Orientation::computeProcessedObject( const ScenePath &pat
 				result.get(),
 				inEulerPlug()->getValue(),
 				(Imath::Eulerf::Order)inOrderPlug()->getValue(),
-				deleteInputs
+				deleteInputs,
+				context->canceller()
 			);
 			break;
 		case Mode::Quaternion :
@@ -959,7 +1004,8 @@ IECore::ConstObjectPtr Orientation::computeProcessedObject( const ScenePath &pat
 				result.get(),
 				inQuaternionPlug()->getValue(),
 				deleteInputs,
-				inMode == Mode::QuaternionXYZW
+				inMode == Mode::QuaternionXYZW,
+				context->canceller()
 			);
 			break;
 		case Mode::AxisAngle :
@@ -968,7 +1014,8 @@ IECore::ConstObjectPtr Orientation::computeProcessedObject( const ScenePath &pat
 				result.get(),
 				inAxisPlug()->getValue(),
 				inAnglePlug()->getValue(),
-				deleteInputs
+				deleteInputs,
+				context->canceller()
 			);
 			break;
 		case Mode::Aim :
@@ -978,7 +1025,8 @@ IECore::ConstObjectPtr Orientation::computeProcessedObject( const ScenePath &pat
 				inXAxisPlug()->getValue(),
 				inYAxisPlug()->getValue(),
 				inZAxisPlug()->getValue(),
-				deleteInputs
+				deleteInputs,
+				context->canceller()
 			);
 			break;
 		case Mode::Matrix :
@@ -986,7 +1034,8 @@ IECore::ConstObjectPtr Orientation::computeProcessedObject( const ScenePath &pat
 				inputPrimitive,
 				result.get(),
 				inMatrixPlug()->getValue(),
-				deleteInputs
+				deleteInputs,
+				context->canceller()
 			);
 			break;
 	}
@@ -1027,7 +1076,8 @@ IECore::ConstObjectPtr Orientation::computeProcessedObject( const ScenePath &pat
 				inOrientation,
 				result.get(),
 				outEulerPlug()->getValue(),
-				(Imath::Eulerf::Order)outOrderPlug()->getValue()
+				(Imath::Eulerf::Order)outOrderPlug()->getValue(),
+				context->canceller()
 			);
 			break;
 		case Mode::Quaternion :
@@ -1042,7 +1092,8 @@ IECore::ConstObjectPtr Orientation::computeProcessedObject( const ScenePath &pat
 				inOrientation,
 				result.get(),
 				outAxisPlug()->getValue(),
-				outAnglePlug()->getValue()
+				outAnglePlug()->getValue(),
+				context->canceller()
 			);
 			break;
 		case Mode::Aim :
@@ -1051,14 +1102,16 @@ IECore::ConstObjectPtr Orientation::computeProcessedObject( const ScenePath &pat
 				result.get(),
 				outXAxisPlug()->getValue(),
 				outYAxisPlug()->getValue(),
-				outZAxisPlug()->getValue()
+				outZAxisPlug()->getValue(),
+				context->canceller()
 			);
 			break;
 		case Mode::Matrix :
 			outMatrix(
 				inOrientation,
 				result.get(),
-				outMatrixPlug()->getValue()
+				outMatrixPlug()->getValue(),
+				context->canceller()
 			);
 			break;
 		case Mode::QuaternionXYZW :
@@ -1068,3 +1121,9 @@ IECore::ConstObjectPtr Orientation::computeProcessedObject( const ScenePath &pat
 
 	return result;
 }
+
+Gaffer::ValuePlug::CachePolicy Orientation::processedObjectComputeCachePolicy() const
+{
+	// The conversions are performed with `tbb::parallel_for()`.
+	return ValuePlug::CachePolicy::TaskCollaboration;
+}
@@ -42,6 +42,11 @@
 #include "IECoreScene/MeshPrimitive.h"
 #include "IECoreScene/PrimitiveEvaluator.h"
 
+#include "IECore/MessageHandler.h"
+#include "IECore/NullObject.h"
+
+#include "boost/pointer_cast.hpp"
+
 #include "tbb/parallel_for.h"
 
 using namespace std;
@@ -151,6 +156,104 @@ OutputVariableFunction addPrimitiveVariable( Primitive *outputPrimitive, const s
 
 } // namespace
 
+//////////////////////////////////////////////////////////////////////////
+// EvaluatorData
+//////////////////////////////////////////////////////////////////////////
+
+// Building a PrimitiveEvaluator can be as expensive as the queries themselves,
+// so we compute it on an internal plug, allowing it to be cached and reused.
+// We deliberately omit a custom TypeId etc because this is just a private class.
+class PrimitiveSampler::EvaluatorData : public Data
+{
+
+	public :
+
+		EvaluatorData( const Primitive *sourcePrimitive, const IECore::Canceller *canceller )
+		{
+			if( !sourcePrimitive )
+			{
+				return;
+			}
+
+			m_primitive = sourcePrimitive;
+			if( auto mesh = runTimeCast<const MeshPrimitive>( sourcePrimitive ) )
+			{
+				m_primitive = MeshAlgo::triangulate( mesh, canceller );
+			}
+			m_evaluator = PrimitiveEvaluator::create( m_primitive );
+		}
+
+		// The source primitive, after any preprocessing
+		// necessary for the evaluator.
+		const Primitive *primitive() const
+		{
+			return m_primitive.get();
+		}
+
+		// May be null if the source isn't a primitive,
+		// or has an unsupported type.
+		const PrimitiveEvaluator *evaluator() const
+		{
+			return m_evaluator.get();
+		}
+
+		bool isEqualTo( const Object *other ) const override
+		{
+			if( !Data::isEqualTo( other ) )
+			{
+				return false;
+			}
+			const EvaluatorData *otherEvaluatorData = static_cast<const EvaluatorData *>( other );
+			return m_primitive == otherEvaluatorData->m_primitive;
+		}
+
+		void hash( MurmurHash &h ) const override
+		{
+			Data::hash( h );
+			if( m_primitive )
+			{
+				m_primitive->hash( h );
+			}
+		}
+
+		void copyFrom( const Object *other, CopyContext *context ) override
+		{
+			Data::copyFrom( other, context );
+			msg( Msg::Warning, "EvaluatorData::copyFrom", "Not implemented" );
+		}
+
+		void save( SaveContext *context ) const override
+		{
+			Data::save( context );
+			msg( Msg::Warning, "EvaluatorData::save", "Not implemented" );
+		}
+
+		void load( LoadContextPtr context ) override
+		{
+			Data::load( context );
+			msg( Msg::Warning, "EvaluatorData::load", "Not implemented" );
+		}
+
+		void memoryUsage( Object::MemoryAccumulator &accumulator ) const override
+		{
+			Data::memoryUsage( accumulator );
+			if( m_primitive )
+			{
+				// We don't have access to the internals of the evaluator,
+				// but its acceleration structures are of a similar size
+				// to the primitive itself.
+				accumulator.accumulate( m_primitive.get() );
+				accumulator.accumulate( m_evaluator.get(), m_primitive->memoryUsage() );
+			}
+		}
+
+	private :
+
+		ConstPrimitivePtr m_primitive;
+		PrimitiveEvaluatorPtr m_evaluator;
+
+};
+
 //////////////////////////////////////////////////////////////////////////
 // Sampler
 //////////////////////////////////////////////////////////////////////////
@@ -169,6 +272,7 @@ PrimitiveSampler::PrimitiveSampler( const std::string &name )
 	addChild( new StringPlug( "primitiveVariables" ) );
 	addChild( new StringPlug( "prefix" ) );
 	addChild( new StringPlug( "status" ) );
+	addChild( new ObjectPlug( "__evaluator", Plug::Out, NullObject::defaultNullObject() ) );
 }
 
 PrimitiveSampler::~PrimitiveSampler()
@@ -225,6 +329,62 @@ const Gaffer::StringPlug *PrimitiveSampler::statusPlug() const
 	return getChild<StringPlug>( g_firstPlugIndex + 4 );
 }
 
+Gaffer::ObjectPlug *PrimitiveSampler::evaluatorPlug()
+{
+	return getChild<ObjectPlug>( g_firstPlugIndex + 5 );
+}
+
+const Gaffer::ObjectPlug *PrimitiveSampler::evaluatorPlug() const
+{
+	return getChild<ObjectPlug>( g_firstPlugIndex + 5 );
+}
+
+void PrimitiveSampler::affects( const Gaffer::Plug *input, AffectedPlugsContainer &outputs ) const
+{
+	Deformer::affects( input, outputs );
+
+	if( input == sourcePlug()->objectPlug() )
+	{
+		outputs.push_back( evaluatorPlug() );
+	}
+}
+
+void PrimitiveSampler::hash( const Gaffer::ValuePlug *output, const Gaffer::Context *context, IECore::MurmurHash &h ) const
+{
+	Deformer::hash( output, context, h );
+
+	if( output == evaluatorPlug() )
+	{
+		sourcePlug()->objectPlug()->hash( h );
+	}
+}
+
+void PrimitiveSampler::compute( Gaffer::ValuePlug *output, const Gaffer::Context *context ) const
+{
+	if( output == evaluatorPlug() )
+	{
+		ConstObjectPtr sourceObject = sourcePlug()->objectPlug()->getValue();
+		static_cast<ObjectPlug *>( output )->setValue(
+			new EvaluatorData( runTimeCast<const Primitive>( sourceObject.get() ), context->canceller() )
+		);
+		return;
+	}
+
+	Deformer::compute( output, context );
+}
+
+Gaffer::ValuePlug::CachePolicy PrimitiveSampler::computeCachePolicy( const Gaffer::ValuePlug *output ) const
+{
+	if( output == evaluatorPlug() )
+	{
+		// Many destination locations may request the same
+		// evaluator at once, and the construction of the
+		// evaluator may spawn TBB tasks.
+		return ValuePlug::CachePolicy::TaskCollaboration;
+	}
+	return Deformer::computeCachePolicy( output );
+}
+
 bool PrimitiveSampler::affectsProcessedObject( const Gaffer::Plug *input ) const
 {
 	return
@@ -234,7 +394,7 @@ bool PrimitiveSampler::affectsProcessedObject( const Gaffer::Plug *input ) const
 		input == prefixPlug() ||
 		input == statusPlug() ||
 		input == sourcePlug()->existsPlug() ||
-		input == sourcePlug()->objectPlug() ||
+		input == evaluatorPlug() ||
 		input == inPlug()->transformPlug() ||
 		input == sourcePlug()->transformPlug() ||
 		affectsSamplingFunction( input )
@@ -260,7 +420,10 @@ void PrimitiveSampler::hashProcessedObject( const ScenePath &path, const Gaffer:
 		return;
 	}
 
-	h.append( sourcePlug()->objectHash( sourcePath ) );
+	{
+		ScenePlug::PathScope sourcePathScope( context, &sourcePath );
+		evaluatorPlug()->hash( h );
+	}
 	h.append( primitiveVariables );
 	prefixPlug()->hash( h );
 	h.append( status );
@@ -299,23 +462,18 @@ IECore::ConstObjectPtr PrimitiveSampler::computeProcessedObject( const ScenePath
 		return inputObject;
 	}
 
-	ConstObjectPtr sourceObject = sourcePlug()->object( sourcePath );
-	const Primitive *sourcePrimitive = runTimeCast<const Primitive>( sourceObject.get() );
-	if( !sourcePrimitive )
+	ConstEvaluatorDataPtr evaluatorData;
 	{
-		return inputObject;
+		ScenePlug::PathScope sourcePathScope( context, &sourcePath );
+		evaluatorData = boost::static_pointer_cast<const EvaluatorData>( evaluatorPlug()->getValue() );
 	}
 
-	ConstPrimitivePtr preprocessedSourcePrimitive = sourcePrimitive;
-	if( auto mesh = runTimeCast<const MeshPrimitive>( preprocessedSourcePrimitive.get() ) )
-	{
-		preprocessedSourcePrimitive = MeshAlgo::triangulate( mesh, context->canceller() );
-	}
-	PrimitiveEvaluatorPtr evaluator = PrimitiveEvaluator::create( preprocessedSourcePrimitive );
+	const PrimitiveEvaluator *evaluator = evaluatorData->evaluator();
 	if( !evaluator )
 	{
 		return inputObject;
 	}
+	const Primitive *preprocessedSourcePrimitive = evaluatorData->primitive();
 
 	PrimitivePtr outputPrimitive = inputPrimitive->copy();
 	const size_t size = outputPrimitive->variableSize( outputInterpolation );
@@ -339,12 +497,12 @@ IECore::ConstObjectPtr PrimitiveSampler::computeProcessedObject( const ScenePath
 		}
 	}
 
-	BoolVectorDataPtr statusData;
+	// Elements of `vector<bool>` can't be written concurrently, so
+	// we record the status in a temporary `vector<char>` during sampling.
+	vector<char> sampled;
 	if( !status.empty() )
 	{
-		statusData = new BoolVectorData();
-		statusData->writable().resize( size, false );
-		outputPrimitive->variables[status] = PrimitiveVariable( outputInterpolation, statusData );
+		sampled.resize( size, 0 );
 	}
 
 	const M44f samplingTransform = transform * sourceTransform.inverse();
@@ -360,9 +518,9 @@ IECore::ConstObjectPtr PrimitiveSampler::computeProcessedObject( const ScenePath
 				{
 					o( i, *evaluatorResult );
 				}
-				if( statusData )
+				if( sampled.size() )
 				{
-					statusData->writable()[i] = true;
+					sampled[i] = 1;
 				}
 			}
 		}
@@ -371,6 +529,13 @@ IECore::ConstObjectPtr PrimitiveSampler::computeProcessedObject( const ScenePath
 	tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
 	parallel_for( blocked_range<size_t>( 0, size ), rangeSampler, taskGroupContext );
 
+	if( !status.empty() )
+	{
+		BoolVectorDataPtr statusData = new BoolVectorData();
+		statusData->writable().assign( sampled.begin(), sampled.end() );
+		outputPrimitive->variables[status] = PrimitiveVariable( outputInterpolation, statusData );
+	}
+
 	return outputPrimitive;
 }
 
@@ -68,6 +68,8 @@
 #include "tbb/parallel_for.h"
 #include "tbb/task.h"
 
+#include <atomic>
+
 using namespace std;
 using namespace Imath;
 using namespace IECore;
@@ -163,61 +165,115 @@ bool deformationMotionTimes( bool motionBlur, const V2f &shutter, const Compound
 	return motionTimes( motionBlur, shutter, attributes, g_deformationBlurAttributeName, g_deformationBlurSegmentsAttributeName, times );
 }
 
-bool transformSamples( const M44fPlug *transformPlug, const std::vector<float> &sampleTimes, std::vector<Imath::M44f> &samples, IECore::MurmurHash *hash )
+} // namespace RendererAlgo
+
+} // namespace Private
+
+} // namespace GafferScene
+
+namespace
+{
+
+std::atomic<uint64_t> g_collapsedMotionSamples( 0 );
+
+// Calls `f( i )` for each of the `sampleTimes`, with the current context
+// frame set to `sampleTimes[i]`. Calls are made concurrently, so that
+// the samples for a single location can be computed in parallel.
+template<typename F>
+void parallelForEachSampleTime( const std::vector<float> &sampleTimes, F &&f )
+{
+	const ThreadState &threadState = ThreadState::current();
+	tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+	tbb::parallel_for(
+		tbb::blocked_range<size_t>( 0, sampleTimes.size(), 1 ),
+		[&] ( const tbb::blocked_range<size_t> &range ) {
+			Context::EditableScope timeContext( threadState );
+			for( size_t i = range.begin(); i != range.end(); ++i )
+			{
+				timeContext.setFrame( sampleTimes[i] );
+				f( i );
+			}
+		},
+		taskGroupContext
+	);
+}
+
+// Computes the hashes for all samples in parallel. If the hashes are all
+// identical, then only a single hash is returned, so that the caller can
+// collapse the samples into one without evaluating them all.
+std::vector<IECore::MurmurHash> hashSamples( const ValuePlug *plug, const std::vector<float> &sampleTimes )
 {
-	std::vector< IECore::MurmurHash > sampleHashes;
 	if( !sampleTimes.size() )
 	{
-		sampleHashes.push_back( transformPlug->hash() );
+		return { plug->hash() };
 	}
-	else
-	{
-		Context::EditableScope timeContext( Context::current() );
 
-		bool moving = false;
-		sampleHashes.reserve( sampleTimes.size() );
-		for( const float sampleTime : sampleTimes )
-		{
-			timeContext.setFrame( sampleTime );
-			IECore::MurmurHash h = transformPlug->hash();
-			if( !moving && !sampleHashes.empty() && h != sampleHashes.front() )
-			{
-				moving = true;
-			}
-			sampleHashes.push_back( h );
+	std::vector<IECore::MurmurHash> result( sampleTimes.size() );
+	parallelForEachSampleTime(
+		sampleTimes,
+		[&] ( size_t i ) {
+			result[i] = plug->hash();
 		}
+	);
 
-		if( !moving )
-		{
-			sampleHashes.resize( 1 );
-		}
+	if( std::all_of( result.begin() + 1, result.end(), [&result] ( const IECore::MurmurHash &h ) { return h == result.front(); } ) )
+	{
+		result.resize( 1 );
 	}
 
-	if( hash )
+	return result;
+}
+
+// Updates `hash` to reflect `sampleHashes`, returning false if it was
+// already up to date.
+bool updateSamplesHash( const std::vector<IECore::MurmurHash> &sampleHashes, IECore::MurmurHash *hash )
+{
+	if( !hash )
 	{
-		IECore::MurmurHash combinedHash;
-		if( sampleHashes.size() == 1 )
-		{
-			combinedHash = sampleHashes[0];
-		}
-		else
-		{
-			for( const IECore::MurmurHash &h : sampleHashes )
-			{
-				combinedHash.append( h );
-			}
-		}
+		return true;
+	}
 
-		if( combinedHash == *hash )
-		{
-			return false;
-		}
-		else
+	IECore::MurmurHash combinedHash;
+	if( sampleHashes.size() == 1 )
+	{
+		combinedHash = sampleHashes[0];
+	}
+	else
+	{
+		for( const IECore::MurmurHash &h : sampleHashes )
 		{
-			*hash = combinedHash;
+			combinedHash.append( h );
 		}
 	}
 
+	if( combinedHash == *hash )
+	{
+		return false;
+	}
+
+	*hash = combinedHash;
+	return true;
+}
+
+} // namespace
+
+namespace GafferScene
+{
+
+namespace Private
+{
+
+namespace RendererAlgo
+{
+
+bool transformSamples( const M44fPlug *transformPlug, const std::vector<float> &sampleTimes, std::vector<Imath::M44f> &samples, IECore::MurmurHash *hash )
+{
+	const std::vector<IECore::MurmurHash> sampleHashes = hashSamples( transformPlug, sampleTimes );
+	if( !updateSamplesHash( sampleHashes, hash ) )
+	{
+		return false;
+	}
+
 	samples.clear();
 	if( !sampleTimes.size() )
 	{
@@ -226,92 +282,42 @@ bool transformSamples( const M44fPlug *transformPlug, const std::vector<float> &
 		return true;
 	}
 
-	Context::EditableScope timeContext( Context::current() );
 	if( sampleHashes.size() == 1 )
 	{
 		// We have a shutter, but all the samples hash the same, so just evaluate one
+		Context::EditableScope timeContext( Context::current() );
 		timeContext.setFrame( sampleTimes[0] );
 		samples.push_back( transformPlug->getValue( &sampleHashes[0]) );
+		g_collapsedMotionSamples += sampleTimes.size() - 1;
 		return true;
 	}
 
 	// Motion case
-	bool moving = false;
-	samples.reserve( sampleTimes.size() );
-	for( size_t i = 0; i < sampleTimes.size(); i++ )
-	{
-		timeContext.setFrame( sampleTimes[i] );
-		M44f m;
-		m = transformPlug->getValue( &sampleHashes[i] );
-		if( !moving && !samples.empty() && m != samples.front() )
-		{
-			moving = true;
+
+	samples.resize( sampleTimes.size() );
+	parallelForEachSampleTime(
+		sampleTimes,
+		[&] ( size_t i ) {
+			samples[i] = transformPlug->getValue( &sampleHashes[i] );
 		}
-		samples.push_back( m );
-	}
+	);
 
-	if( !moving )
+	if( std::all_of( samples.begin() + 1, samples.end(), [&samples] ( const M44f &m ) { return m == samples.front(); } ) )
 	{
+		// Different hashes, but identical values.
 		samples.resize( 1 );
+		g_collapsedMotionSamples += sampleTimes.size() - 1;
 	}
+
 	return true;
 }
 
 bool objectSamples( const ObjectPlug *objectPlug, const std::vector<float> &sampleTimes, std::vector<IECore::ConstObjectPtr> &samples, IECore::MurmurHash *hash )
 {
-	std::vector< IECore::MurmurHash > sampleHashes;
-	if( !sampleTimes.size() )
-	{
-		sampleHashes.push_back( objectPlug->hash() );
-	}
-	else
+	const std::vector<IECore::MurmurHash> sampleHashes = hashSamples( objectPlug, sampleTimes );
+	if( !updateSamplesHash( sampleHashes, hash ) )
 	{
-		const Context *frameContext = Context::current();
-		Context::EditableScope timeContext( frameContext );
-
-		bool moving = false;
-		sampleHashes.reserve( sampleTimes.size() );
-		for( const float sampleTime : sampleTimes )
-		{
-			timeContext.setFrame( sampleTime );
-
-			const MurmurHash objectHash = objectPlug->hash();
-			if( !moving && !sampleHashes.empty() && objectHash != sampleHashes.front() )
-			{
-				moving = true;
-			}
-			sampleHashes.push_back( objectHash );
-		}
-
-		if( !moving )
-		{
-			sampleHashes.resize( 1 );
-		}
-	}
-
-	if( hash )
-	{
-		IECore::MurmurHash combinedHash;
-		if( sampleHashes.size() == 1 )
-		{
-			combinedHash = sampleHashes[0];
-		}
-		else
-		{
-			for( const IECore::MurmurHash &h : sampleHashes )
-			{
-				combinedHash.append( h );
-			}
-		}
-
-		if( combinedHash == *hash )
-		{
-			return false;
-		}
-		else
-		{
-			*hash = combinedHash;
-		}
+		return false;
 	}
 
 	// Static case
@@ -330,6 +336,7 @@ bool objectSamples( const ObjectPlug *objectPlug, const std::vector<float> &samp
 			Context::EditableScope timeContext( Context::current() );
 			timeContext.setFrame( sampleTimes[0] );
 			object = objectPlug->getValue( &sampleHashes[0]);
+			g_collapsedMotionSamples += sampleTimes.size() - 1;
 		}
 
 		if(
@@ -347,15 +354,18 @@ bool objectSamples( const ObjectPlug *objectPlug, const std::vector<float> &samp
 	// Motion case
 
 	const Context *frameContext = Context::current();
-	Context::EditableScope timeContext( frameContext );
+
+	std::vector<ConstObjectPtr> objects( sampleTimes.size() );
+	parallelForEachSampleTime(
+		sampleTimes,
+		[&] ( size_t i ) {
+			objects[i] = objectPlug->getValue( &sampleHashes[i] );
+		}
+	);
 
 	samples.reserve( sampleTimes.size() );
-	for( size_t i = 0; i < sampleTimes.size(); i++ )
+	for( const auto &object : objects )
 	{
-		timeContext.setFrame( sampleTimes[i] );
-
-		ConstObjectPtr object = objectPlug->getValue( &sampleHashes[i] );
-
 		if(
 			runTimeCast<const Primitive>( object.get() ) ||
 			runTimeCast<const Camera>( object.get() )
@@ -404,6 +414,16 @@ bool objectSamples( const ObjectPlug *objectPlug, const std::vector<float> &samp
 	return true;
 }
 
+uint64_t collapsedMotionSamples()
+{
+	return g_collapsedMotionSamples;
+}
+
+void resetCollapsedMotionSamples()
+{
+	g_collapsedMotionSamples = 0;
+}
+
 } // namespace RendererAlgo
 
 } // namespace Private
@@ -644,7 +664,7 @@ namespace RendererAlgo
 {
 
 LightLinks::LightLinks()
-	:	m_lightLinksDirty( true ), m_lightFilterLinksDirty( true )
+	:	m_lightsVersion( 0 ), m_lightLinksDirty( true ), m_lightFilterLinksDirty( true )
 {
 }
 
@@ -753,7 +773,13 @@ void LightLinks::setsDirtied()
 	{
 		f.second.filteredLightsDirty = true;
 	}
-	clearLightLinks();
+	// Rather than clearing the light links, we just mark them as dirty. Then
+	// `linkedLights()` can avoid reevaluating expressions where the relevant
+	// sets haven't changed.
+	for( auto &l : m_lightLinks )
+	{
+		l.second.dirty = true;
+	}
 	m_lightLinksDirty = true;
 	m_lightFilterLinksDirty = true;
 }
@@ -780,6 +806,7 @@ void LightLinks::clearLightLinks()
 	// `clear()` is not threadsafe - hence the mutex.
 	tbb::spin_mutex::scoped_lock l( m_lightLinksClearMutex );
 	m_lightLinks.clear();
+	m_lightsVersion++;
 }
 
 std::string LightLinks::filteredLightsExpression( const IECore::CompoundObject *attributes ) const
@@ -798,36 +825,83 @@ void LightLinks::outputLightLinks( const ScenePlug *scene, const IECore::Compoun
 	const std::string linkedLightsExpression = linkedLightsExpressionData ? linkedLightsExpressionData->readable() : "defaultLights";
 	const std::string linkedShadowsExpression = linkedShadowsExpressionData ? linkedShadowsExpressionData->readable() : "__lights";
 
-	if( hash )
-	{
+	auto linksHash = [&] ( const IECore::MurmurHash &linkedLightsHash, const IECore::MurmurHash &linkedShadowsHash ) {
 		IECore::MurmurHash h;
 		h.append( linkedLightsExpression );
 		h.append( linkedShadowsExpression );
-		if( !m_lightLinksDirty && *hash == h )
+		h.append( linkedLightsHash );
+		h.append( linkedShadowsHash );
+		h.append( (uint64_t)m_lightsVersion );
+		return h;
+	};
+
+	if( hash )
+	{
+		// Check against the hashes of any links we've already evaluated before
+		// calling `linkedLights()`, which takes a write lock on the entry for
+		// the expression and may need to compute `setExpressionHash()`. Most
+		// objects share the same few expressions, so that would be contended.
+		IECore::MurmurHash cachedLightsHash, cachedShadowsHash;
+		if(
+			cachedLinkedLightsHash( linkedLightsExpression, cachedLightsHash ) &&
+			cachedLinkedLightsHash( linkedShadowsExpression, cachedShadowsHash ) &&
+			*hash == linksHash( cachedLightsHash, cachedShadowsHash )
+		)
+		{
+			// We're only being called because the attributes or sets have changed as a
+			// whole, but the specific attributes and sets we care about haven't changed.
+			// No need to relink anything.
+			return;
+		}
+	}
+
+	IECore::MurmurHash linkedLightsHash, linkedShadowsHash;
+	IECoreScenePreview::Renderer::ConstObjectSetPtr linkedLightsSet = linkedLights( linkedLightsExpression, scene, linkedLightsHash );
+	IECoreScenePreview::Renderer::ConstObjectSetPtr linkedShadowsSet = linkedLights( linkedShadowsExpression, scene, linkedShadowsHash );
+
+	if( hash )
+	{
+		const IECore::MurmurHash h = linksHash( linkedLightsHash, linkedShadowsHash );
+		if( *hash == h )
 		{
-			// We're only being called because the attributes have changed as a whole, but the
-			// specific attributes we care about haven't changed. No need to relink anything.
-			/// \todo Investigate other optimisations. Perhaps `setExpressionHash()` is fast enough
-			/// that we could use it to avoid editing links when sets have been dirtied but the
-			/// specific sets we care about haven't changed?
 			return;
 		}
 		*hash = h;
 	}
 
-	IECoreScenePreview::Renderer::ConstObjectSetPtr objectSet = linkedLights( linkedLightsExpression, scene );
-	object->link( g_lights, objectSet );
-	objectSet = linkedLights( linkedShadowsExpression, scene );
-	object->link( g_shadowGroupAttributeName, objectSet );
+	object->link( g_lights, linkedLightsSet );
+	object->link( g_shadowGroupAttributeName, linkedShadowsSet );
 }
 
-IECoreScenePreview::Renderer::ConstObjectSetPtr LightLinks::linkedLights( const std::string &linkedLightsExpression, const ScenePlug *scene ) const
+bool LightLinks::cachedLinkedLightsHash( const std::string &linkedLightsExpression, IECore::MurmurHash &hash ) const
+{
+	LightLinkMap::const_accessor a;
+	if( !m_lightLinks.find( a, linkedLightsExpression ) || a->second.dirty )
+	{
+		return false;
+	}
+	hash = a->second.hash;
+	return true;
+}
+
+IECoreScenePreview::Renderer::ConstObjectSetPtr LightLinks::linkedLights( const std::string &linkedLightsExpression, const ScenePlug *scene, IECore::MurmurHash &hash ) const
 {
 	LightLinkMap::accessor a;
-	if( !m_lightLinks.insert( a, linkedLightsExpression ) )
+	const bool inserted = m_lightLinks.insert( a, linkedLightsExpression );
+	if( !a->second.dirty )
 	{
 		// Already did the work
-		return a->second;
+		hash = a->second.hash;
+		return a->second.lights;
+	}
+
+	hash = SetAlgo::setExpressionHash( linkedLightsExpression, scene );
+	a->second.dirty = false;
+	if( !inserted && hash == a->second.hash )
+	{
+		// Sets have been dirtied, but not the ones
+		// we depend on.
+		return a->second.lights;
 	}
 
 	PathMatcher paths = SetAlgo::evaluateSetExpression( linkedLightsExpression, scene );
@@ -850,8 +924,9 @@ IECoreScenePreview::Renderer::ConstObjectSetPtr LightLinks::linkedLights( const
 		objectSet = nullptr;
 	}
 
-	a->second = objectSet;
-	return a->second;
+	a->second.lights = objectSet;
+	a->second.hash = hash;
+	return a->second.lights;
 }
 
 void LightLinks::outputLightFilterLinks( const ScenePlug *scene )
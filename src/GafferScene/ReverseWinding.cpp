@@ -36,13 +36,67 @@
 
 #include "GafferScene/ReverseWinding.h"
 
-#include "IECoreScene/MeshAlgo.h"
 #include "IECoreScene/MeshPrimitive.h"
 
+#include "IECore/DataAlgo.h"
+#include "IECore/TypeTraits.h"
+
+#include "tbb/parallel_for.h"
+
+#include <algorithm>
+
+using namespace std;
 using namespace IECore;
 using namespace IECoreScene;
 using namespace GafferScene;
 
+namespace
+{
+
+// Reverses the order of the face-varying values within each face,
+// processing ranges of faces in parallel.
+struct ReverseFaces
+{
+
+	ReverseFaces( const vector<int> &verticesPerFace, const vector<size_t> &faceOffsets, const Canceller *canceller )
+		:	m_verticesPerFace( verticesPerFace ), m_faceOffsets( faceOffsets ), m_canceller( canceller )
+	{
+	}
+
+	template<typename T>
+	void operator()( T *data, typename std::enable_if<TypeTraits::IsVectorTypedData<T>::value>::type *enabler = nullptr ) const
+	{
+		auto &values = data->writable();
+		tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+		tbb::parallel_for(
+			tbb::blocked_range<size_t>( 0, m_verticesPerFace.size() ),
+			[&] ( const tbb::blocked_range<size_t> &range ) {
+				Canceller::check( m_canceller );
+				for( size_t face = range.begin(); face != range.end(); ++face )
+				{
+					auto faceBegin = values.begin() + m_faceOffsets[face];
+					std::reverse( faceBegin, faceBegin + m_verticesPerFace[face] );
+				}
+			},
+			taskGroupContext
+		);
+	}
+
+	void operator()( Data *data ) const
+	{
+		// Not a vector, so there is nothing to reverse.
+	}
+
+	private :
+
+		const vector<int> &m_verticesPerFace;
+		const vector<size_t> &m_faceOffsets;
+		const Canceller *m_canceller;
+
+};
+
+} // namespace
+
 GAFFER_NODE_DEFINE_TYPE( ReverseWinding );
 
 ReverseWinding::ReverseWinding( const std::string &name )
@@ -72,7 +126,59 @@ IECore::ConstObjectPtr ReverseWinding::computeProcessedObject( const ScenePath &
 		return inputObject;
 	}
 
+	const vector<int> &verticesPerFace = mesh->verticesPerFace()->readable();
+	vector<size_t> faceOffsets;
+	faceOffsets.reserve( verticesPerFace.size() );
+	size_t faceOffset = 0;
+	for( int numVertices : verticesPerFace )
+	{
+		faceOffsets.push_back( faceOffset );
+		faceOffset += numVertices;
+	}
+
+	const ReverseFaces reverseFaces( verticesPerFace, faceOffsets, context->canceller() );
+
+	// The copy shares its data with the input until it is written to, so
+	// we only pay for copying the data that is actually reversed.
 	MeshPrimitivePtr meshCopy = mesh->copy();
-	MeshAlgo::reverseWinding( meshCopy.get(), context->canceller() );
+
+	IntVectorDataPtr vertexIds = mesh->vertexIds()->copy();
+	reverseFaces( vertexIds.get() );
+	meshCopy->setTopologyUnchecked(
+		mesh->verticesPerFace(), vertexIds, mesh->variableSize( PrimitiveVariable::Vertex ), mesh->interpolation()
+	);
+	// Setting the topology removes corners and creases, but since they are
+	// specified by vertex id rather than face-vertex they are unaffected by
+	// the reversal and can be restored directly.
+	meshCopy->setCorners( mesh->cornerIds(), mesh->cornerSharpnesses() );
+	meshCopy->setCreases( mesh->creaseLengths(), mesh->creaseIds(), mesh->creaseSharpnesses() );
+
+	for( auto &primitiveVariable : meshCopy->variables )
+	{
+		if( primitiveVariable.second.interpolation != PrimitiveVariable::FaceVarying )
+		{
+			continue;
+		}
+
+		if( primitiveVariable.second.indices )
+		{
+			IntVectorDataPtr indices = primitiveVariable.second.indices->copy();
+			reverseFaces( indices.get() );
+			primitiveVariable.second.indices = indices;
+		}
+		else
+		{
+			DataPtr data = primitiveVariable.second.data->copy();
+			dispatch( data.get(), reverseFaces );
+			primitiveVariable.second.data = data;
+		}
+	}
+
 	return meshCopy;
 }
+
+Gaffer::ValuePlug::CachePolicy ReverseWinding::processedObjectComputeCachePolicy() const
+{
+	// We spawn TBB tasks to reverse the faces in parallel.
+	return Gaffer::ValuePlug::CachePolicy::TaskCollaboration;
+}
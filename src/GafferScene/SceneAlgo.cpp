@@ -53,6 +53,7 @@
 #include "Gaffer/Context.h"
 #include "Gaffer/Monitor.h"
 #include "Gaffer/Private/IECorePreview/LRUCache.h"
+#include "Gaffer/Private/IECorePreview/TaskMutex.h"
 #include "Gaffer/Process.h"
 #include "Gaffer/ScriptNode.h"
 
@@ -65,14 +66,20 @@
 #include "IECore/MessageHandler.h"
 #include "IECore/NullObject.h"
 
+#include "OpenEXR/ImathBoxAlgo.h"
+#include "OpenEXR/ImathFrustumTest.h"
+
 #include "boost/algorithm/string/predicate.hpp"
 #include "boost/unordered_map.hpp"
 
-#include "tbb/concurrent_unordered_set.h"
 #include "tbb/enumerable_thread_specific.h"
 #include "tbb/parallel_for.h"
+#include "tbb/parallel_invoke.h"
 #include "tbb/spin_mutex.h"
 
+#include <numeric>
+#include <unordered_map>
+
 using namespace std;
 using namespace Imath;
 using namespace IECore;
@@ -377,6 +384,11 @@ struct CapturedProcess
 
 	PtrVector children;
 
+	// If non-null, then `memoised` computed the same plug in the same
+	// context, and its upstream history is shared rather than being
+	// captured again.
+	const CapturedProcess *memoised = nullptr;
+
 };
 
 /// \todo Perhaps add this to the Gaffer module as a
@@ -430,11 +442,32 @@ class CapturingMonitor : public Monitor
 				capturedProcess->type = process->type();
 				capturedProcess->plug = p;
 				capturedProcess->destinationPlug = process->destinationPlug();
-				capturedProcess->context = new Context( *process->context(), /* omitCanceller = */ true );
-				entry = capturedProcess.get();
 			}
 
+			const MurmurHash contextHash = capturedProcess ? process->context()->hash() : MurmurHash();
+
 			Mutex::scoped_lock lock( m_mutex );
+
+			if( capturedProcess )
+			{
+				auto inserted = m_capturedProcesses.insert( { { p, contextHash }, capturedProcess.get() } );
+				if( inserted.second )
+				{
+					capturedProcess->context = new Context( *process->context(), /* omitCanceller = */ true );
+					entry = capturedProcess.get();
+				}
+				else
+				{
+					// We've already captured this computation for another branch of
+					// the graph. Reference it instead of capturing all its upstream
+					// computations again, and turn off monitoring for them so that
+					// they can be retrieved from the hash cache.
+					capturedProcess->memoised = inserted.first->second;
+					capturedProcess->context = inserted.first->second->context;
+					entry = std::make_unique<Monitor::Scope>( this, false );
+				}
+			}
+
 			m_processMap[process] = std::move( entry );
 
 			if( capturedProcess )
@@ -492,61 +525,113 @@ class CapturingMonitor : public Monitor
 
 		ProcessMap m_processMap;
 		CapturedProcess::PtrVector m_rootProcesses;
+
+		using CapturedProcessMap = boost::unordered_map<std::pair<const Plug *, MurmurHash>, const CapturedProcess *>;
+		CapturedProcessMap m_capturedProcesses;
 		IECore::InternedString m_scenePlugChildName;
 
 };
 
 IE_CORE_DECLAREPTR( CapturingMonitor )
 
-SceneAlgo::History::Ptr historyWalk( const CapturedProcess *process, InternedString scenePlugChildName, SceneAlgo::History *parent )
+using ProcessHistories = boost::unordered_map<const CapturedProcess *, SceneAlgo::History::Ptr>;
+
+SceneAlgo::History::Ptr historyWalk( const CapturedProcess *process, InternedString scenePlugChildName, SceneAlgo::History *parent, ProcessHistories &processHistories, const IECore::Canceller *canceller )
 {
+	IECore::Canceller::check( canceller );
+
+	SceneAlgo::History::Ptr result;
+	auto addHistory = [&] ( const SceneAlgo::History::Ptr &history ) {
+		if( !result )
+		{
+			result = history;
+		}
+		if( parent )
+		{
+			parent->predecessors.push_back( history );
+		}
+		parent = history.get();
+	};
+
 	// Add a history item for each plug in the input chain
 	// between `process->destinationPlug()` and `process->plug()`
-	// (inclusive of each).
+	// (exclusive of the latter).
 
-	SceneAlgo::History::Ptr result;
 	Plug *plug = const_cast<Plug *>( process->destinationPlug.get() );
-	while( plug )
+	while( plug && plug != process->plug )
 	{
 		ScenePlug *scene = plug->parent<ScenePlug>();
 		if( scene && plug == scene->getChild( scenePlugChildName ) )
 		{
-			SceneAlgo::History::Ptr history = new SceneAlgo::History( scene, process->context );
-			if( !result )
-			{
-				result = history;
-			};
-			if( parent )
-			{
-				parent->predecessors.push_back( history );
-			}
-			parent = history.get();
+			addHistory( new SceneAlgo::History( scene, process->context ) );
 		}
-		plug = plug != process->plug ? plug->getInput() : nullptr;
+		plug = plug->getInput();
 	}
 
-	// Add history items for upstream processes.
+	// Add the history item for `process->plug()` itself, along with items for
+	// upstream processes. These are shared by all processes which computed the
+	// same plug in the same context.
 
-	for( const auto &p : process->children )
+	const CapturedProcess *source = process->memoised ? process->memoised : process;
+	SceneAlgo::History::Ptr &sourceHistory = processHistories[source];
+	if( !sourceHistory )
 	{
-		historyWalk( p.get(), scenePlugChildName, parent );
+		sourceHistory = new SceneAlgo::History(
+			const_cast<ScenePlug *>( source->plug->parent<ScenePlug>() ), source->context
+		);
+		for( const auto &p : source->children )
+		{
+			historyWalk( p.get(), scenePlugChildName, sourceHistory.get(), processHistories, canceller );
+		}
 	}
+	addHistory( sourceHistory );
 
 	return result;
 }
 
-void addGenericAttributePredecessors( const SceneAlgo::History::Predecessors &source, SceneAlgo::AttributeHistory *destination )
+// Builds AttributeHistories from a History, evaluating independent predecessors
+// in parallel. Results are memoised, so that History items shared by several
+// branches of the graph are only processed once.
+class AttributeHistoryBuilder
 {
-	for( auto &h : source )
+
+	public :
+
+		AttributeHistoryBuilder( const IECore::Canceller *canceller )
+			:	m_canceller( canceller )
+		{
+		}
+
+		SceneAlgo::AttributeHistory::Ptr attributeHistory( const SceneAlgo::History *attributesHistory, const InternedString &attribute );
+
+		// Returns the result of `attributeHistory()` for each item in `source`.
+		vector<SceneAlgo::AttributeHistory::Ptr> attributeHistories( const SceneAlgo::History::Predecessors &source, const InternedString &attribute );
+
+	private :
+
+		SceneAlgo::AttributeHistory::Ptr attributeHistoryInternal( const SceneAlgo::History *attributesHistory, const InternedString &attribute );
+
+		const IECore::Canceller *m_canceller;
+
+		using Key = std::pair<const SceneAlgo::History *, InternedString>;
+		using AttributeHistoryMap = std::map<Key, SceneAlgo::AttributeHistory::Ptr>;
+		tbb::spin_mutex m_mutex;
+		AttributeHistoryMap m_attributeHistories;
+
+};
+
+void addGenericAttributePredecessors( const SceneAlgo::History::Predecessors &source, SceneAlgo::AttributeHistory *destination, AttributeHistoryBuilder &builder )
+{
+	for( auto &ah : builder.attributeHistories( source, destination->attributeName ) )
 	{
-		if( auto ah = SceneAlgo::attributeHistory( h.get(), destination->attributeName ) )
+		if( ah )
 		{
 			destination->predecessors.push_back( ah );
 		}
 	}
 }
 
-void addCopyAttributesPredecessors( const CopyAttributes *copyAttributes, const SceneAlgo::History::Predecessors &source, SceneAlgo::AttributeHistory *destination )
+void addCopyAttributesPredecessors( const CopyAttributes *copyAttributes, const SceneAlgo::History::Predecessors &source, SceneAlgo::AttributeHistory *destination, AttributeHistoryBuilder &builder )
 {
 	const ScenePlug *sourceScene = copyAttributes->inPlug();
 	if(
@@ -581,12 +666,12 @@ void addCopyAttributesPredecessors( const CopyAttributes *copyAttributes, const
 	{
 		if( h->scene == sourceScene )
 		{
-			destination->predecessors.push_back( SceneAlgo::attributeHistory( h.get(), destination->attributeName ) );
+			destination->predecessors.push_back( builder.attributeHistory( h.get(), destination->attributeName ) );
 		}
 	}
 }
 
-void addShuffleAttributesPredecessors( const ShuffleAttributes *shuffleAttributes, const SceneAlgo::History::Predecessors &source, SceneAlgo::AttributeHistory *destination )
+void addShuffleAttributesPredecessors( const ShuffleAttributes *shuffleAttributes, const SceneAlgo::History::Predecessors &source, SceneAlgo::AttributeHistory *destination, AttributeHistoryBuilder &builder )
 {
 	// We have no way of introspecting the operation of a ShufflePlug, so we resort
 	// to shuffling	`name = name, value = name` pairs to figure out where the attribute
@@ -606,10 +691,10 @@ void addShuffleAttributesPredecessors( const ShuffleAttributes *shuffleAttribute
 	}
 
 	assert( source.size() == 1 );
-	destination->predecessors.push_back( SceneAlgo::attributeHistory( source[0].get(), sourceAttributeName ) );
+	destination->predecessors.push_back( builder.attributeHistory( source[0].get(), sourceAttributeName ) );
 }
 
-void addLocaliseAttributesPredecessors( const SceneAlgo::History::Predecessors &source, SceneAlgo::AttributeHistory *destination )
+void addLocaliseAttributesPredecessors( const SceneAlgo::History::Predecessors &source, SceneAlgo::AttributeHistory *destination, AttributeHistoryBuilder &builder )
 {
 	// No need to check if the node is filtered to this location.
 	// Filtered or unfiltered, it's all the same : the predecessor
@@ -625,7 +710,7 @@ void addLocaliseAttributesPredecessors( const SceneAlgo::History::Predecessors &
 		{
 			continue;
 		}
-		if( auto p = attributeHistory( h.get(), destination->attributeName ) )
+		if( auto p = builder.attributeHistory( h.get(), destination->attributeName ) )
 		{
 			predecessor = p;
 			longestPath = sourcePath.size();
@@ -640,15 +725,15 @@ void addLocaliseAttributesPredecessors( const SceneAlgo::History::Predecessors &
 	destination->predecessors.push_back( predecessor );
 }
 
-void addMergeScenesPredecessors( const MergeScenes *mergeScenes, const SceneAlgo::History::Predecessors &source, SceneAlgo::AttributeHistory *destination )
+void addMergeScenesPredecessors( const MergeScenes *mergeScenes, const SceneAlgo::History::Predecessors &source, SceneAlgo::AttributeHistory *destination, AttributeHistoryBuilder &builder )
 {
 	// MergeScenes only evaluates input locations that exist, and in an order
 	// whereby the last input with the attribute wins.
 
 	SceneAlgo::AttributeHistory::Ptr predecessor;
-	for( auto &h : source )
+	for( auto &p : builder.attributeHistories( source, destination->attributeName ) )
 	{
-		if( auto p = attributeHistory( h.get(), destination->attributeName ) )
+		if( p )
 		{
 			predecessor = p;
 		}
@@ -658,6 +743,109 @@ void addMergeScenesPredecessors( const MergeScenes *mergeScenes, const SceneAlgo
 	destination->predecessors.push_back( predecessor );
 }
 
+SceneAlgo::AttributeHistory::Ptr AttributeHistoryBuilder::attributeHistory( const SceneAlgo::History *attributesHistory, const InternedString &attribute )
+{
+	const Key key( attributesHistory, attribute );
+	{
+		tbb::spin_mutex::scoped_lock lock( m_mutex );
+		auto it = m_attributeHistories.find( key );
+		if( it != m_attributeHistories.end() )
+		{
+			return it->second;
+		}
+	}
+
+	// Compute without holding the lock, so that other branches can proceed
+	// in parallel. If two threads race to compute the same item, the first
+	// result to be stored wins.
+	SceneAlgo::AttributeHistory::Ptr result = attributeHistoryInternal( attributesHistory, attribute );
+
+	tbb::spin_mutex::scoped_lock lock( m_mutex );
+	return m_attributeHistories.insert( { key, result } ).first->second;
+}
+
+vector<SceneAlgo::AttributeHistory::Ptr> AttributeHistoryBuilder::attributeHistories( const SceneAlgo::History::Predecessors &source, const InternedString &attribute )
+{
+	vector<SceneAlgo::AttributeHistory::Ptr> result( source.size() );
+
+	tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+	tbb::parallel_for(
+		tbb::blocked_range<size_t>( 0, source.size() ),
+		[&] ( const tbb::blocked_range<size_t> &range ) {
+			for( size_t i = range.begin(); i != range.end(); ++i )
+			{
+				result[i] = attributeHistory( source[i].get(), attribute );
+			}
+		},
+		taskGroupContext
+	);
+
+	return result;
+}
+
+SceneAlgo::AttributeHistory::Ptr AttributeHistoryBuilder::attributeHistoryInternal( const SceneAlgo::History *attributesHistory, const InternedString &attribute )
+{
+	IECore::Canceller::check( m_canceller );
+
+	Context::EditableScope scopedContext( attributesHistory->context.get() );
+	scopedContext.setCanceller( m_canceller );
+
+	ConstCompoundObjectPtr attributes = attributesHistory->scene->attributesPlug()->getValue();
+	ConstObjectPtr attributeValue = attributes->member<Object>( attribute );
+
+	if( !attributeValue )
+	{
+		return nullptr;
+	}
+
+	SceneAlgo::AttributeHistory::Ptr result = new SceneAlgo::AttributeHistory(
+		attributesHistory->scene, attributesHistory->context,
+		attribute, attributeValue
+	);
+
+	// Filter the _attributes_ history to include only predecessors which
+	// contribute specifically to our single _attribute_. In the absence of
+	// a SceneNode-level API for querying attribute sources, we resort to
+	// special case code for backtracking through certain node types.
+	/// \todo Consider an official API that allows the nodes themselves to
+	/// take responsibility for this backtracking.
+
+	auto node = runTimeCast<const SceneNode>( attributesHistory->scene->node() );
+	if( node && node->enabledPlug()->getValue() && attributesHistory->scene == node->outPlug() )
+	{
+		if( auto copyAttributes = runTimeCast<const CopyAttributes>( node ) )
+		{
+			addCopyAttributesPredecessors( copyAttributes, attributesHistory->predecessors, result.get(), *this );
+		}
+		else if( auto shuffleAttributes = runTimeCast<const ShuffleAttributes>( node ) )
+		{
+			addShuffleAttributesPredecessors( shuffleAttributes, attributesHistory->predecessors, result.get(), *this );
+		}
+		else if( runTimeCast<const LocaliseAttributes>( node ) )
+		{
+			addLocaliseAttributesPredecessors( attributesHistory->predecessors, result.get(), *this );
+		}
+		else if( auto mergeScenes = runTimeCast<const MergeScenes>( node ) )
+		{
+			addMergeScenesPredecessors( mergeScenes, attributesHistory->predecessors, result.get(), *this );
+		}
+		else if( runTimeCast<const AttributeTweaks>( node ) )
+		{
+			addLocaliseAttributesPredecessors( attributesHistory->predecessors, result.get(), *this );
+		}
+		else
+		{
+			addGenericAttributePredecessors( attributesHistory->predecessors, result.get(), *this );
+		}
+	}
+	else
+	{
+		addGenericAttributePredecessors( attributesHistory->predecessors, result.get(), *this );
+	}
+
+	return result;
+}
+
 SceneProcessor *objectTweaksWalk( const SceneAlgo::History *h )
 {
 	if( auto tweaks = h->scene->parent<CameraTweaks>() )
@@ -722,6 +910,7 @@ SceneAlgo::History::Ptr SceneAlgo::history( const Gaffer::ValuePlug *scenePlugCh
 		) );
 	}
 
+	const IECore::Canceller *canceller = Context::current()->canceller();
 	CapturingMonitorPtr monitor = new CapturingMonitor( scenePlugChild->getName() );
 	{
 		ScenePlug::PathScope pathScope( Context::current(), &path );
@@ -738,66 +927,14 @@ SceneAlgo::History::Ptr SceneAlgo::history( const Gaffer::ValuePlug *scenePlugCh
 	}
 
 	assert( monitor->rootProcesses().size() == 1 );
-	return historyWalk( monitor->rootProcesses().front().get(), scenePlugChild->getName(), nullptr );
+	ProcessHistories processHistories;
+	return historyWalk( monitor->rootProcesses().front().get(), scenePlugChild->getName(), nullptr, processHistories, canceller );
 }
 
 SceneAlgo::AttributeHistory::Ptr SceneAlgo::attributeHistory( const SceneAlgo::History *attributesHistory, const IECore::InternedString &attribute )
 {
-	Context::Scope scopedContext( attributesHistory->context.get() );
-	ConstCompoundObjectPtr attributes = attributesHistory->scene->attributesPlug()->getValue();
-	ConstObjectPtr attributeValue = attributes->member<Object>( attribute );
-
-	if( !attributeValue )
-	{
-		return nullptr;
-	}
-
-	SceneAlgo::AttributeHistory::Ptr result = new AttributeHistory(
-		attributesHistory->scene, attributesHistory->context,
-		attribute, attributeValue
-	);
-
-	// Filter the _attributes_ history to include only predecessors which
-	// contribute specifically to our single _attribute_. In the absence of
-	// a SceneNode-level API for querying attribute sources, we resort to
-	// special case code for backtracking through certain node types.
-	/// \todo Consider an official API that allows the nodes themselves to
-	/// take responsibility for this backtracking.
-
-	auto node = runTimeCast<const SceneNode>( attributesHistory->scene->node() );
-	if( node && node->enabledPlug()->getValue() && attributesHistory->scene == node->outPlug() )
-	{
-		if( auto copyAttributes = runTimeCast<const CopyAttributes>( node ) )
-		{
-			addCopyAttributesPredecessors( copyAttributes, attributesHistory->predecessors, result.get() );
-		}
-		else if( auto shuffleAttributes = runTimeCast<const ShuffleAttributes>( node ) )
-		{
-			addShuffleAttributesPredecessors( shuffleAttributes, attributesHistory->predecessors, result.get() );
-		}
-		else if( runTimeCast<const LocaliseAttributes>( node ) )
-		{
-			addLocaliseAttributesPredecessors( attributesHistory->predecessors, result.get() );
-		}
-		else if( auto mergeScenes = runTimeCast<const MergeScenes>( node ) )
-		{
-			addMergeScenesPredecessors( mergeScenes, attributesHistory->predecessors, result.get() );
-		}
-		else if( runTimeCast<const AttributeTweaks>( node ) )
-		{
-			addLocaliseAttributesPredecessors( attributesHistory->predecessors, result.get() );
-		}
-		else
-		{
-			addGenericAttributePredecessors( attributesHistory->predecessors, result.get() );
-		}
-	}
-	else
-	{
-		addGenericAttributePredecessors( attributesHistory->predecessors, result.get() );
-	}
-
-	return result;
+	AttributeHistoryBuilder builder( Context::current()->canceller() );
+	return builder.attributeHistory( attributesHistory, attribute );
 }
 
 ScenePlug *SceneAlgo::source( const ScenePlug *scene, const ScenePlug::ScenePath &path )
@@ -900,85 +1037,204 @@ namespace
 InternedString g_lights( "__lights" );
 InternedString g_linkedLights( "linkedLights" );
 
-template<typename AttributesPredicate>
-struct AttributesFinder
+// Light link index
+// ================
+//
+// Answering queries in terms of objects requires a traversal of the entire scene,
+// so we do that only once, building an index from each distinct `linkedLights`
+// expression to the locations that use it. Each expression is then evaluated just
+// once, and reevaluated only when its hash changes, so that subsequent queries
+// remain cheap even after edits to sets.
+
+class LightLinkIndex : public IECore::RefCounted
 {
 
-	AttributesFinder( const AttributesPredicate &predicate, tbb::spin_mutex &resultMutex, IECore::PathMatcher &result )
-		:	m_predicate( predicate ), m_resultMutex( resultMutex ), m_result( result )
-	{
-	}
+	public :
 
-	bool operator()( const ScenePlug *scene, const ScenePlug::ScenePath &path )
-	{
-		bool inheritPredicateResult = false;
-		ConstCompoundObjectPtr attributes = scene->attributesPlug()->getValue();
-		if( path.empty() )
+		IE_CORE_DECLAREMEMBERPTR( LightLinkIndex );
+
+		LightLinkIndex( const ScenePlug *scene )
 		{
-			// Root
-			m_fullAttributes = attributes;
+			ThreadLocalExpressions threadLocalExpressions;
+			LinkedLightsGatherer gatherer( threadLocalExpressions );
+			SceneAlgo::parallelProcessLocations( scene, gatherer );
+
+			std::unordered_map<std::string, size_t> expressionIndices;
+			for( const auto &expressions : threadLocalExpressions )
+			{
+				for( const auto &e : expressions )
+				{
+					auto inserted = expressionIndices.insert( { e.first, m_expressions.size() } );
+					if( inserted.second )
+					{
+						m_expressions.push_back( Expression() );
+						m_expressions.back().expression = e.first;
+					}
+					m_expressions[inserted.first->second].objects.addPaths( e.second );
+				}
+			}
 		}
-		else
+
+		IECore::PathMatcher linkedObjects( const ScenePlug *scene, const IECore::PathMatcher &lights ) const
 		{
-			if( attributes->members().empty() )
+			PathMatcher result;
+
+			IECorePreview::TaskMutex::ScopedLock lock( m_mutex );
+			updateLinkedLights( scene, lock );
+			for( const auto &e : m_expressions )
 			{
-				inheritPredicateResult = true;
+				for( PathMatcher::Iterator lightIt = lights.begin(), eIt = lights.end(); lightIt != eIt; ++lightIt )
+				{
+					if( e.linkedLights.match( *lightIt ) & PathMatcher::ExactMatch )
+					{
+						result.addPaths( e.objects );
+						break;
+					}
+				}
 			}
-			else
+
+			return result;
+		}
+
+		IECore::PathMatcher linkedLights( const ScenePlug *scene, const IECore::PathMatcher &objects ) const
+		{
+			PathMatcher result;
+
+			IECorePreview::TaskMutex::ScopedLock lock( m_mutex );
+			updateLinkedLights( scene, lock );
+			for( const auto &e : m_expressions )
 			{
-				CompoundObjectPtr fullAttributes = new CompoundObject;
-				fullAttributes->members() = m_fullAttributes->members();
-				for( const auto &a : attributes->members() )
+				if( !e.objects.intersection( objects ).isEmpty() )
 				{
-					fullAttributes->members()[a.first] = a.second;
+					result.addPaths( e.linkedLights );
 				}
-				m_fullAttributes = fullAttributes;
 			}
+
+			return result;
 		}
 
-		if( !inheritPredicateResult )
+	private :
+
+		using ThreadLocalExpressions = tbb::enumerable_thread_specific<std::unordered_map<std::string, PathMatcher>>;
+
+		struct LinkedLightsGatherer
 		{
-			m_predicateResult = m_predicate( m_fullAttributes.get() );
-		}
-		else
+
+			LinkedLightsGatherer( ThreadLocalExpressions &expressions )
+				:	m_expressions( expressions )
+			{
+			}
+
+			bool operator()( const ScenePlug *scene, const ScenePlug::ScenePath &path )
+			{
+				ConstCompoundObjectPtr attributes = scene->attributesPlug()->getValue();
+				if( auto linkedLights = attributes->member<StringData>( g_linkedLights ) )
+				{
+					m_linkedLights = linkedLights;
+				}
+				else
+				{
+					// `m_linkedLights` is inherited automatically because `parallelProcessLocations()`
+					// copy-constructs child functors from the parent.
+				}
+
+				if( !path.empty() )
+				{
+					m_expressions.local()[m_linkedLights ? m_linkedLights->readable() : "defaultLights"].addPath( path );
+				}
+
+				return true;
+			}
+
+			private :
+
+				ThreadLocalExpressions &m_expressions;
+				ConstStringDataPtr m_linkedLights;
+
+		};
+
+		void updateLinkedLights( const ScenePlug *scene, IECorePreview::TaskMutex::ScopedLock &lock ) const
 		{
-			// `m_predicateResult` is inherited automatically because `parallelProcessLocations()`
-			// copy-constructs child functors from the parent.
+			lock.execute(
+				[this, scene] {
+					ScenePlug::GlobalScope globalScope( Context::current() );
+					const ThreadState &threadState = ThreadState::current();
+					tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+					tbb::parallel_for(
+						tbb::blocked_range<size_t>( 0, m_expressions.size() ),
+						[&]( const tbb::blocked_range<size_t> &r )
+						{
+							ThreadState::Scope threadStateScope( threadState );
+							for( size_t i = r.begin(); i != r.end(); ++i )
+							{
+								Expression &e = m_expressions[i];
+								const IECore::MurmurHash h = SetAlgo::setExpressionHash( e.expression, scene );
+								if( h != e.linkedLightsHash )
+								{
+									e.linkedLights = SetAlgo::evaluateSetExpression( e.expression, scene );
+									e.linkedLightsHash = h;
+								}
+							}
+						},
+						taskGroupContext
+					);
+				}
+			);
 		}
 
-		if( m_predicateResult && !path.empty() )
+		struct Expression
 		{
-			/// \todo We could avoid this locking if we added a `functor.gatherChildren()`
-			/// phase to `parallelProcessLocations()` and built the result recursively.
-			tbb::spin_mutex::scoped_lock lock( m_resultMutex );
-			m_result.addPath( path );
-		}
+			std::string expression;
+			// Locations using the expression.
+			IECore::PathMatcher objects;
+			// Lights matched by the expression, updated
+			// lazily by `updateLinkedLights()`.
+			IECore::MurmurHash linkedLightsHash;
+			IECore::PathMatcher linkedLights;
+		};
+
+		mutable std::vector<Expression> m_expressions;
+		mutable IECorePreview::TaskMutex m_mutex;
 
-		return true;
-	}
+};
 
-	private :
+IE_CORE_DECLAREPTR( LightLinkIndex );
 
-		const AttributesPredicate &m_predicate;
+struct LightLinkIndexCacheGetterKey
+{
 
-		ConstCompoundObjectPtr m_fullAttributes;
-		bool m_predicateResult;
+	LightLinkIndexCacheGetterKey( const ScenePlug *scene )
+		:	scene( scene )
+	{
+		// Computing an accurate hash for the entire scene would require a
+		// traversal, defeating the point of the index. Instead we use a
+		// "poor man's hash" in the same way as `Encapsulate::hashObject()`.
+		ScenePlug::GlobalScope globalScope( Context::current() );
+		hash.append( reinterpret_cast<uint64_t>( scene ) );
+		hash.append( scene->childNamesPlug()->dirtyCount() );
+		hash.append( scene->attributesPlug()->dirtyCount() );
+		hash.append( Context::current()->hash() );
+	}
+
+	operator const IECore::MurmurHash & () const
+	{
+		return hash;
+	}
 
-		tbb::spin_mutex &m_resultMutex;
-		IECore::PathMatcher &m_result;
+	const ScenePlug *scene;
+	IECore::MurmurHash hash;
 
 };
 
-/// \todo Perhaps this is worthy of inclusion in the public API?
-template<typename AttributesPredicate>
-IECore::PathMatcher findAttributes( const ScenePlug *scene, const AttributesPredicate &predicate )
-{
-	tbb::spin_mutex resultMutex;
-	IECore::PathMatcher result;
-	AttributesFinder<AttributesPredicate> attributesFinder( predicate, resultMutex, result );
-	SceneAlgo::parallelProcessLocations( scene, attributesFinder );
-	return result;
-}
+using LightLinkIndexCache = IECorePreview::LRUCache<IECore::MurmurHash, ConstLightLinkIndexPtr, IECorePreview::LRUCachePolicy::TaskParallel, LightLinkIndexCacheGetterKey>;
+
+LightLinkIndexCache g_lightLinkIndexCache(
+	[] ( const LightLinkIndexCacheGetterKey &key, size_t &cost, const IECore::Canceller *canceller ) {
+		cost = 1;
+		return new LightLinkIndex( key.scene );
+	},
+	4
+);
 
 } // namespace
 
@@ -991,37 +1247,8 @@ IECore::PathMatcher GafferScene::SceneAlgo::linkedObjects( const ScenePlug *scen
 
 GAFFERSCENE_API IECore::PathMatcher GafferScene::SceneAlgo::linkedObjects( const ScenePlug *scene, const IECore::PathMatcher &lights )
 {
-	// We expect many locations to have the exact same expression for `linkedLights`,
-	// and evaluating the expression is fairly expensive. So we cache the results for
-	// sharing between locations. The cache only lives for the lifetime of this query.
-	using QueryCache = IECorePreview::LRUCache<std::string, bool, IECorePreview::LRUCachePolicy::TaskParallel>;
-	const Context *context = Context::current();
-	QueryCache queryCache(
-		[&lights, scene, context]( const std::string &setExpression, size_t &cost, const IECore::Canceller *canceller )
-		{
-			cost = 1;
-			Context::Scope scopedContext( context );
-			const IECore::PathMatcher linkedLights = SetAlgo::evaluateSetExpression( setExpression, scene );
-			for( PathMatcher::Iterator lightIt = lights.begin(), eIt = lights.end(); lightIt != eIt; ++lightIt )
-			{
-				if( linkedLights.match( *lightIt ) & PathMatcher::ExactMatch )
-				{
-					return true;
-				}
-			}
-			return false;
-		},
-		10000
-	);
-
-	IECore::PathMatcher result = findAttributes(
-		scene,
-		[&queryCache] ( const CompoundObject *fullAttributes ) {
-			auto *linkedLights = fullAttributes->member<StringData>( g_linkedLights );
-			return queryCache.get( linkedLights ? linkedLights->readable() : "defaultLights" );
-		}
-	);
-
+	ConstLightLinkIndexPtr index = g_lightLinkIndexCache.get( LightLinkIndexCacheGetterKey( scene ) );
+	IECore::PathMatcher result = index->linkedObjects( scene, lights );
 	result.removePaths( scene->set( g_lights )->readable() );
 	return result;
 }
@@ -1037,26 +1264,386 @@ IECore::PathMatcher GafferScene::SceneAlgo::linkedLights( const ScenePlug *scene
 
 IECore::PathMatcher GafferScene::SceneAlgo::linkedLights( const ScenePlug *scene, const IECore::PathMatcher &objects )
 {
-	tbb::spin_mutex resultMutex;
-	IECore::PathMatcher result;
-	tbb::concurrent_unordered_set<std::string> processed;
+	ConstLightLinkIndexPtr index = g_lightLinkIndexCache.get( LightLinkIndexCacheGetterKey( scene ) );
+	IECore::PathMatcher result = index->linkedLights( scene, objects );
+	return result.intersection( scene->set( g_lights )->readable() );
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Bounds queries
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+// Bounding volume hierarchy
+// =========================
+//
+// Locations with few children are queried by visiting each child in turn,
+// since the child must compute its bound and transform to be tested anyway.
+// For locations with many children this becomes the dominant cost of a
+// query, so we build a BVH over the child bounds, and use it to visit only
+// the children which might intersect.
+
+const size_t g_minChildrenForBVH = 64;
+const size_t g_maxBVHLeafSize = 4;
+const size_t g_minChildrenForParallelBVHBuild = 10000;
+
+class ChildBoundsBVH : public IECore::RefCounted
+{
+
+	public :
 
-	auto functor = [&resultMutex, &result, &processed] ( const ScenePlug *scene, const ScenePlug::ScenePath &path ) {
-		IECore::ConstCompoundObjectPtr attributes = scene->fullAttributes( path );
-		auto *linkedLightsAttribute = attributes->member<StringData>( g_linkedLights );
-		const string linkedLights = linkedLightsAttribute ? linkedLightsAttribute->readable() : "defaultLights";
-		if( processed.insert( linkedLights ).second )
+		// `childBounds` are specified in the space of the parent
+		// location, so include the transform of each child.
+		ChildBoundsBVH( const vector<Box3f> &childBounds )
 		{
-			ScenePlug::GlobalScope globalScope( Context::current() );
-			IECore::PathMatcher linkedPaths = SetAlgo::evaluateSetExpression( linkedLights, scene );
-			tbb::spin_mutex::scoped_lock resultLock( resultMutex );
-			result.addPaths( linkedPaths );
+			vector<V3f> centres( childBounds.size() );
+			m_children.reserve( childBounds.size() );
+			for( size_t i = 0; i < childBounds.size(); ++i )
+			{
+				// Children with empty bounds can never intersect
+				// a query, so we omit them entirely.
+				if( !childBounds[i].isEmpty() )
+				{
+					m_children.push_back( i );
+					centres[i] = childBounds[i].center();
+				}
+			}
+
+			if( m_children.empty() )
+			{
+				return;
+			}
+
+			// A binary tree with leaves of at least one item has
+			// fewer than twice as many nodes as items, so we can
+			// preallocate and avoid resizing during the parallel
+			// build.
+			m_nodes.resize( 2 * m_children.size() );
+			std::atomic<uint32_t> numNodes( 1 );
+			tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+			build( 0, 0, m_children.size(), childBounds, centres, numNodes, taskGroupContext );
+			m_nodes.resize( numNodes );
+			m_nodes.shrink_to_fit();
+		}
+
+		// Calls `f( childIndex )` for each child whose bound might satisfy
+		// `predicate( bound )`. The predicate is not applied to the children
+		// themselves, only to the nodes of the hierarchy.
+		template<typename Predicate, typename F>
+		void query( const Predicate &predicate, F &&f ) const
+		{
+			if( m_nodes.empty() )
+			{
+				return;
+			}
+
+			// Nodes are split at the median, so the depth of the tree is
+			// logarithmic in the number of children, and this can't overflow.
+			uint32_t stack[128];
+			size_t stackSize = 0;
+			stack[stackSize++] = 0;
+			while( stackSize )
+			{
+				const Node &node = m_nodes[stack[--stackSize]];
+				if( !predicate( node.bound ) )
+				{
+					continue;
+				}
+				if( node.numChildren )
+				{
+					for( uint32_t i = node.first, e = node.first + node.numChildren; i < e; ++i )
+					{
+						f( m_children[i] );
+					}
+				}
+				else
+				{
+					stack[stackSize++] = node.first + 1;
+					stack[stackSize++] = node.first;
+				}
+			}
+		}
+
+		size_t memoryUsage() const
+		{
+			return sizeof( *this ) + m_nodes.capacity() * sizeof( Node ) + m_children.capacity() * sizeof( uint32_t );
+		}
+
+	private :
+
+		void build( uint32_t nodeIndex, size_t begin, size_t end, const vector<Box3f> &childBounds, const vector<V3f> &centres, std::atomic<uint32_t> &numNodes, tbb::task_group_context &taskGroupContext )
+		{
+			Node &node = m_nodes[nodeIndex];
+			Box3f centresBound;
+			for( size_t i = begin; i < end; ++i )
+			{
+				node.bound.extendBy( childBounds[m_children[i]] );
+				centresBound.extendBy( centres[m_children[i]] );
+			}
+
+			if( end - begin <= g_maxBVHLeafSize )
+			{
+				node.first = begin;
+				node.numChildren = end - begin;
+				return;
+			}
+
+			// Split at the median along the longest axis of the
+			// child centres. The two child nodes are allocated
+			// adjacently, so we need only store the first.
+			const int axis = centresBound.majorAxis();
+			const size_t middle = begin + ( end - begin ) / 2;
+			std::nth_element(
+				m_children.begin() + begin, m_children.begin() + middle, m_children.begin() + end,
+				[&] ( uint32_t a, uint32_t b ) {
+					return centres[a][axis] < centres[b][axis];
+				}
+			);
+
+			const uint32_t first = numNodes.fetch_add( 2 );
+			node.first = first;
+			node.numChildren = 0;
+
+			if( end - begin >= g_minChildrenForParallelBVHBuild )
+			{
+				tbb::parallel_invoke(
+					[&] { build( first, begin, middle, childBounds, centres, numNodes, taskGroupContext ); },
+					[&] { build( first + 1, middle, end, childBounds, centres, numNodes, taskGroupContext ); },
+					taskGroupContext
+				);
+			}
+			else
+			{
+				build( first, begin, middle, childBounds, centres, numNodes, taskGroupContext );
+				build( first + 1, middle, end, childBounds, centres, numNodes, taskGroupContext );
+			}
+		}
+
+		struct Node
+		{
+			Box3f bound;
+			// For leaf nodes, the index of the first entry in
+			// `m_children`. For interior nodes, the index of the
+			// first of the two child nodes.
+			uint32_t first = 0;
+			// Zero for interior nodes.
+			uint32_t numChildren = 0;
+		};
+
+		vector<Node> m_nodes;
+		// Indices into the child names, ordered so that
+		// the children of each leaf are contiguous.
+		vector<uint32_t> m_children;
+
+};
+
+IE_CORE_DECLAREPTR( ChildBoundsBVH );
+
+struct ChildBoundsBVHCacheGetterKey
+{
+
+	// Must be constructed with the context scoped
+	// for the parent location.
+	ChildBoundsBVHCacheGetterKey( const ScenePlug *scene, const ScenePlug::ScenePath &path, const vector<InternedString> &childNames )
+		:	scene( scene ), path( &path ), childNames( &childNames )
+	{
+		// The child bounds hash accounts for the bound and transform
+		// of every child, which is everything the BVH depends on.
+		hash = scene->childBoundsPlug()->hash();
+	}
+
+	operator const IECore::MurmurHash & () const
+	{
+		return hash;
+	}
+
+	const ScenePlug *scene;
+	const ScenePlug::ScenePath *path;
+	const vector<InternedString> *childNames;
+	IECore::MurmurHash hash;
+
+};
+
+using ChildBoundsBVHCache = IECorePreview::LRUCache<IECore::MurmurHash, ConstChildBoundsBVHPtr, IECorePreview::LRUCachePolicy::TaskParallel, ChildBoundsBVHCacheGetterKey>;
+
+ChildBoundsBVHCache g_childBoundsBVHCache(
+	[] ( const ChildBoundsBVHCacheGetterKey &key, size_t &cost, const IECore::Canceller *canceller ) {
+
+		const vector<InternedString> &childNames = *key.childNames;
+		vector<Box3f> childBounds( childNames.size() );
+
+		const ThreadState &threadState = ThreadState::current();
+		tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+		tbb::parallel_for(
+			tbb::blocked_range<size_t>( 0, childNames.size() ),
+			[&] ( const tbb::blocked_range<size_t> &range ) {
+				ScenePlug::ScenePath childPath = *key.path;
+				childPath.push_back( InternedString() );
+				ScenePlug::PathScope pathScope( threadState );
+				for( size_t i = range.begin(); i != range.end(); ++i )
+				{
+					childPath.back() = childNames[i];
+					pathScope.setPath( &childPath );
+					childBounds[i] = Imath::transform( key.scene->boundPlug()->getValue(), key.scene->transformPlug()->getValue() );
+				}
+			},
+			taskGroupContext
+		);
+
+		ConstChildBoundsBVHPtr result = new ChildBoundsBVH( childBounds );
+		cost = result->memoryUsage();
+		return result;
+	},
+	// 100 Mb
+	1024 * 1024 * 100
+);
+
+const bool g_childBoundsBVHCacheClearConnected = ( ValuePlug::cacheClearedSignal().connect( [] { g_childBoundsBVHCache.clear(); } ), true );
+
+// Predicates
+// ==========
+//
+// These are called as `predicate( bound, transform )`, and return true if the
+// bound might intersect the query once transformed into world space.
+
+struct FrustumPredicate
+{
+
+	FrustumPredicate( const Frustumf &frustum, const M44f &cameraTransform )
+		:	m_frustumTest( frustum, cameraTransform )
+	{
+	}
+
+	bool operator()( const Box3f &bound, const M44f &transform ) const
+	{
+		return !bound.isEmpty() && m_frustumTest.isVisible( Imath::transform( bound, transform ) );
+	}
+
+	private :
+
+		FrustumTest<float> m_frustumTest;
+
+};
+
+struct RayPredicate
+{
+
+	RayPredicate( const Line3f &ray )
+		:	m_ray( ray )
+	{
+	}
+
+	bool operator()( const Box3f &bound, const M44f &transform ) const
+	{
+		return !bound.isEmpty() && Imath::intersects( Imath::transform( bound, transform ), m_ray );
+	}
+
+	private :
+
+		Line3f m_ray;
+
+};
+
+template<typename Predicate>
+void boundsQueryWalk( const ScenePlug *scene, const ThreadState &threadState, const ScenePlug::ScenePath &path, const M44f &parentTransform, const Predicate &predicate, ThreadablePathAccumulator &result, tbb::task_group_context &taskGroupContext )
+{
+	ScenePlug::PathScope pathScope( threadState, &path );
+
+	const M44f fullTransform = scene->transformPlug()->getValue() * parentTransform;
+	if( !predicate( scene->boundPlug()->getValue(), fullTransform ) )
+	{
+		return;
+	}
+
+	result( scene, path );
+
+	IECore::ConstInternedStringVectorDataPtr childNamesData = scene->childNamesPlug()->getValue();
+	const vector<InternedString> &childNames = childNamesData->readable();
+	if( childNames.empty() )
+	{
+		return;
+	}
+
+	// Find the children which need to be visited. Without a BVH
+	// this is all of them.
+
+	vector<uint32_t> candidates;
+	if( childNames.size() >= g_minChildrenForBVH )
+	{
+		ConstChildBoundsBVHPtr bvh = g_childBoundsBVHCache.get( ChildBoundsBVHCacheGetterKey( scene, path, childNames ) );
+		bvh->query(
+			[&] ( const Box3f &bound ) {
+				return predicate( bound, fullTransform );
+			},
+			[&] ( uint32_t childIndex ) {
+				candidates.push_back( childIndex );
+			}
+		);
+	}
+	else
+	{
+		candidates.resize( childNames.size() );
+		std::iota( candidates.begin(), candidates.end(), 0 );
+	}
+
+	auto loopBody = [&] ( const tbb::blocked_range<size_t> &range ) {
+		ScenePlug::ScenePath childPath = path;
+		childPath.push_back( InternedString() );
+		for( size_t i = range.begin(); i != range.end(); ++i )
+		{
+			childPath.back() = childNames[candidates[i]];
+			boundsQueryWalk( scene, threadState, childPath, fullTransform, predicate, result, taskGroupContext );
 		}
-		return true;
 	};
 
-	filteredParallelTraverse( scene, objects, functor );
-	return result.intersection( scene->set( g_lights )->readable() );
+	const tbb::blocked_range<size_t> loopRange( 0, candidates.size() );
+	if( candidates.size() > 1 )
+	{
+		tbb::parallel_for( loopRange, loopBody, taskGroupContext );
+	}
+	else
+	{
+		loopBody( loopRange );
+	}
+}
+
+template<typename Predicate>
+IECore::PathMatcher boundsQuery( const ScenePlug *scene, const Predicate &predicate, const ScenePlug::ScenePath &root )
+{
+	M44f parentTransform;
+	if( root.size() )
+	{
+		parentTransform = scene->fullTransform( ScenePlug::ScenePath( root.begin(), root.end() - 1 ) );
+	}
+
+	ThreadablePathAccumulator result;
+	tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+	boundsQueryWalk( scene, ThreadState::current(), root, parentTransform, predicate, result, taskGroupContext );
+	return result.result();
+}
+
+} // namespace
+
+IECore::PathMatcher GafferScene::SceneAlgo::findInFrustum( const ScenePlug *scene, const Imath::Frustumf &frustum, const Imath::M44f &cameraTransform, const ScenePlug::ScenePath &root )
+{
+	return boundsQuery( scene, FrustumPredicate( frustum, cameraTransform ), root );
+}
+
+IECore::PathMatcher GafferScene::SceneAlgo::findIntersecting( const ScenePlug *scene, const Imath::Line3f &ray, const ScenePlug::ScenePath &root )
+{
+	return boundsQuery( scene, RayPredicate( ray ), root );
+}
+
+size_t GafferScene::SceneAlgo::getBoundsQueryCacheMemoryLimit()
+{
+	return g_childBoundsBVHCache.getMaxCost();
+}
+
+void GafferScene::SceneAlgo::setBoundsQueryCacheMemoryLimit( size_t bytes )
+{
+	g_childBoundsBVHCache.setMaxCost( bytes );
 }
 
 //////////////////////////////////////////////////////////////////////////
@@ -41,6 +41,7 @@
 
 #include "Gaffer/Context.h"
 #include "Gaffer/ContextAlgo.h"
+#include "Gaffer/Private/IECorePreview/LRUCache.h"
 
 #include "IECore/NullObject.h"
 #include "IECore/StringAlgo.h"
@@ -438,6 +439,152 @@ bool ScenePlug::exists( const ScenePath &scenePath ) const
 	return existsPlug()->getValue();
 }
 
+// Full attributes are computed top-down, with each location deriving its
+// result from the cached result for its parent. We cache in two stages :
+//
+// - The hash of the full attributes for each plug and location. This uses the
+//   same identity as the hash cache (source plug, dirty count and context), so
+//   entries are invalidated automatically by edits to the graph.
+// - The merged attributes for each hash. Locations with identical inherited
+//   attributes share a single object, and locations without attributes of their
+//   own share their parent's object, so memory usage doesn't grow with depth.
+//
+// Both caches are costed in bytes and are cleared along with the compute cache.
+
+namespace
+{
+
+struct FullAttributesHashCacheGetterKey
+{
+
+	FullAttributesHashCacheGetterKey( const ScenePlug *scene, const ScenePlug::ScenePath &path )
+		:	scene( scene ), path( path )
+	{
+		const ValuePlug *source = scene->attributesPlug()->source<ValuePlug>();
+		hash.append( reinterpret_cast<uint64_t>( source ) );
+		hash.append( source->dirtyCount() );
+		ScenePlug::PathScope pathScope( Context::current(), &path );
+		hash.append( Context::current()->hash() );
+	}
+
+	operator const IECore::MurmurHash & () const
+	{
+		return hash;
+	}
+
+	const ScenePlug *scene;
+	const ScenePlug::ScenePath &path;
+	IECore::MurmurHash hash;
+
+};
+
+struct FullAttributesCacheGetterKey
+{
+
+	FullAttributesCacheGetterKey( const ScenePlug *scene, const ScenePlug::ScenePath &path, const IECore::MurmurHash &hash )
+		:	scene( scene ), path( path ), hash( hash )
+	{
+	}
+
+	operator const IECore::MurmurHash & () const
+	{
+		return hash;
+	}
+
+	const ScenePlug *scene;
+	const ScenePlug::ScenePath &path;
+	IECore::MurmurHash hash;
+
+};
+
+IECore::MurmurHash fullAttributesHashGetter( const FullAttributesHashCacheGetterKey &key, size_t &cost, const IECore::Canceller *canceller );
+IECore::ConstCompoundObjectPtr fullAttributesGetter( const FullAttributesCacheGetterKey &key, size_t &cost, const IECore::Canceller *canceller );
+
+// Approximate cost of an entry in either cache, excluding the value itself.
+// This accounts for the key, the value pointer and the bookkeeping the
+// LRUCache keeps per entry.
+const size_t g_cacheEntryCost = 128;
+
+// Hash entries are small and fixed size, so 128Mb holds around a million
+// locations, enough to avoid recomputing the hashes of all ancestors
+// when visiting every location of a large scene. The limits of both caches
+// may be changed with `ScenePlug::setFullAttributesCacheMemoryLimit()`.
+using FullAttributesHashCache = IECorePreview::LRUCache<IECore::MurmurHash, IECore::MurmurHash, IECorePreview::LRUCachePolicy::TaskParallel, FullAttributesHashCacheGetterKey>;
+FullAttributesHashCache g_fullAttributesHashCache( fullAttributesHashGetter, 128 * 1024 * 1024 );
+
+// Attributes are deduplicated by hash, and most locations share an object
+// with their parent, so the number of entries grows with the number of
+// distinct attribute combinations rather than with the number of locations.
+// Only merged objects are charged for their contents, because shared objects
+// are also held by the compute cache.
+using FullAttributesCache = IECorePreview::LRUCache<IECore::MurmurHash, IECore::ConstCompoundObjectPtr, IECorePreview::LRUCachePolicy::TaskParallel, FullAttributesCacheGetterKey>;
+FullAttributesCache g_fullAttributesCache( fullAttributesGetter, 256 * 1024 * 1024 );
+
+const bool g_fullAttributesCacheClearConnected = (
+	ValuePlug::cacheClearedSignal().connect(
+		[] {
+			g_fullAttributesHashCache.clear();
+			g_fullAttributesCache.clear();
+		}
+	),
+	true
+);
+
+const IECore::ConstCompoundObjectPtr g_emptyAttributes = new IECore::CompoundObject;
+
+IECore::MurmurHash fullAttributesHashGetter( const FullAttributesHashCacheGetterKey &key, size_t &cost, const IECore::Canceller *canceller )
+{
+	cost = g_cacheEntryCost;
+	if( key.path.empty() )
+	{
+		// Attributes at the root are not inherited.
+		return IECore::MurmurHash();
+	}
+
+	const ScenePlug::ScenePath parentPath( key.path.begin(), key.path.end() - 1 );
+	IECore::MurmurHash result = g_fullAttributesHashCache.get( FullAttributesHashCacheGetterKey( key.scene, parentPath ) );
+
+	ScenePlug::PathScope pathScope( Context::current(), &key.path );
+	key.scene->attributesPlug()->hash( result );
+	return result;
+}
+
+IECore::ConstCompoundObjectPtr fullAttributesGetter( const FullAttributesCacheGetterKey &key, size_t &cost, const IECore::Canceller *canceller )
+{
+	cost = g_cacheEntryCost;
+	if( key.path.empty() )
+	{
+		return g_emptyAttributes;
+	}
+
+	const ScenePlug::ScenePath parentPath( key.path.begin(), key.path.end() - 1 );
+	const IECore::MurmurHash parentHash = g_fullAttributesHashCache.get( FullAttributesHashCacheGetterKey( key.scene, parentPath ) );
+	IECore::ConstCompoundObjectPtr parentAttributes = g_fullAttributesCache.get( FullAttributesCacheGetterKey( key.scene, parentPath, parentHash ) );
+
+	ScenePlug::PathScope pathScope( Context::current(), &key.path );
+	IECore::ConstCompoundObjectPtr attributes = key.scene->attributesPlug()->getValue();
+
+	if( attributes->members().empty() )
+	{
+		return parentAttributes;
+	}
+	else if( parentAttributes->members().empty() )
+	{
+		return attributes;
+	}
+
+	IECore::CompoundObjectPtr result = new IECore::CompoundObject;
+	result->members() = parentAttributes->members();
+	for( const auto &a : attributes->members() )
+	{
+		result->members()[a.first] = a.second;
+	}
+	cost += result->memoryUsage();
+	return result;
+}
+
+} // namespace
+
 Imath::Box3f ScenePlug::bound( const ScenePath &scenePath ) const
 {
 	PathScope scope( Context::current(), &scenePath );
@@ -474,29 +621,28 @@ IECore::ConstCompoundObjectPtr ScenePlug::attributes( const ScenePath &scenePath
 
 IECore::CompoundObjectPtr ScenePlug::fullAttributes( const ScenePath &scenePath ) const
 {
-	PathScope pathScope( Context::current() );
+	const IECore::MurmurHash h = g_fullAttributesHashCache.get( FullAttributesHashCacheGetterKey( this, scenePath ) );
+	IECore::ConstCompoundObjectPtr fullAttributes = g_fullAttributesCache.get( FullAttributesCacheGetterKey( this, scenePath, h ) );
 
+	// The cached result is shared, but we must return a non-const
+	// object, so make a shallow copy.
 	IECore::CompoundObjectPtr result = new IECore::CompoundObject;
-	IECore::CompoundObject::ObjectMap &resultMembers = result->members();
-	ScenePath path( scenePath );
-	while( path.size() )
-	{
-		pathScope.setPath( &path );
-		IECore::ConstCompoundObjectPtr a = attributesPlug()->getValue();
-		const IECore::CompoundObject::ObjectMap &aMembers = a->members();
-		for( IECore::CompoundObject::ObjectMap::const_iterator it = aMembers.begin(), eIt = aMembers.end(); it != eIt; it++ )
-		{
-			if( resultMembers.find( it->first ) == resultMembers.end() )
-			{
-				resultMembers.insert( *it );
-			}
-		}
-		path.pop_back();
-	}
-
+	result->members() = fullAttributes->members();
 	return result;
 }
 
+size_t ScenePlug::getFullAttributesCacheMemoryLimit()
+{
+	return g_fullAttributesHashCache.getMaxCost() + g_fullAttributesCache.getMaxCost();
+}
+
+void ScenePlug::setFullAttributesCacheMemoryLimit( size_t bytes )
+{
+	const size_t hashCacheLimit = bytes / 3;
+	g_fullAttributesHashCache.setMaxCost( hashCacheLimit );
+	g_fullAttributesCache.setMaxCost( bytes - hashCacheLimit );
+}
+
 IECore::ConstObjectPtr ScenePlug::object( const ScenePath &scenePath ) const
 {
 	PathScope scope( Context::current(), &scenePath );
@@ -563,18 +709,7 @@ IECore::MurmurHash ScenePlug::attributesHash( const ScenePath &scenePath ) const
 
 IECore::MurmurHash ScenePlug::fullAttributesHash( const ScenePath &scenePath ) const
 {
-	PathScope pathScope( Context::current() );
-
-	IECore::MurmurHash result;
-	ScenePath path( scenePath );
-	while( path.size() )
-	{
-		pathScope.setPath( &path );
-		attributesPlug()->hash( result );
-		path.pop_back();
-	}
-
-	return result;
+	return g_fullAttributesHashCache.get( FullAttributesHashCacheGetterKey( this, scenePath ) );
 }
 
 IECore::MurmurHash ScenePlug::objectHash( const ScenePath &scenePath ) const
@@ -37,17 +37,30 @@
 #include "GafferScene/SceneReader.h"
 
 #include "Gaffer/Context.h"
+#include "Gaffer/Private/IECorePreview/LRUCache.h"
 #include "Gaffer/StringPlug.h"
 #include "Gaffer/TransformPlug.h"
+#include "Gaffer/TypedObjectPlug.h"
 
 #include "IECoreScene/SceneCache.h"
 #include "IECoreScene/SharedSceneInterfaces.h"
 
 #include "IECore/InternedString.h"
+#include "IECore/NullObject.h"
 #include "IECore/StringAlgo.h"
 
 #include "boost/bind/bind.hpp"
 
+#include "tbb/concurrent_queue.h"
+#include "tbb/parallel_for.h"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <unordered_map>
+
 using namespace std;
 using namespace boost::placeholders;
 using namespace Imath;
@@ -58,6 +71,293 @@ using namespace GafferScene;
 
 using Tokenizer = boost::tokenizer<boost::char_separator<char> >;
 
+//////////////////////////////////////////////////////////////////////////
+// Set loading
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+const InternedString g_setNamesName( "setNames" );
+const InternedString g_setsName( "sets" );
+
+// Each thread accumulates paths into its own PathMatchers, which are
+// merged once the walk is complete.
+using SetMap = std::unordered_map<InternedString, PathMatcher>;
+using ThreadLocalSetMap = tbb::enumerable_thread_specific<SetMap>;
+
+void loadSetsWalk( const SceneInterface *s, const ScenePlug::ScenePath &path, const Canceller *canceller, ThreadLocalSetMap &sets, tbb::task_group_context &taskGroupContext )
+{
+	SceneInterface::NameList tags;
+	s->readTags( tags, SceneInterface::LocalTag );
+	if( tags.size() )
+	{
+		SetMap &localSets = sets.local();
+		for( const auto &tag : tags )
+		{
+			localSets[tag].addPath( path );
+		}
+	}
+
+	// Descendant tags tell us whether there is anything of interest
+	// below us, allowing us to prune the walk.
+
+	tags.clear();
+	s->readTags( tags, SceneInterface::DescendantTag );
+	if( tags.empty() )
+	{
+		return;
+	}
+
+	SceneInterface::NameList childNames;
+	s->childNames( childNames );
+
+	tbb::parallel_for(
+		tbb::blocked_range<size_t>( 0, childNames.size() ),
+		[&]( const tbb::blocked_range<size_t> &range )
+		{
+			ScenePlug::ScenePath childPath( path );
+			childPath.push_back( InternedString() ); // Room for the child name
+			for( size_t i = range.begin(); i != range.end(); ++i )
+			{
+				Canceller::check( canceller );
+				ConstSceneInterfacePtr child = s->child( childNames[i] );
+				childPath.back() = childNames[i];
+				loadSetsWalk( child.get(), childPath, canceller, sets, taskGroupContext );
+			}
+		},
+		taskGroupContext
+	);
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Prefetching
+//////////////////////////////////////////////////////////////////////////
+
+struct PrefetchedLocation
+{
+	bool hasBound = false;
+	Box3d bound;
+	M44d transform;
+	ConstObjectPtr object;
+};
+
+using ConstPrefetchedLocationPtr = std::shared_ptr<const PrefetchedLocation>;
+
+struct PrefetchKey
+{
+
+	PrefetchKey( const MurmurHash &hash, const ConstSceneInterfacePtr &scene = nullptr, double time = 0 )
+		:	hash( hash ), scene( scene ), time( time )
+	{
+	}
+
+	operator const MurmurHash & () const
+	{
+		return hash;
+	}
+
+	MurmurHash hash;
+	ConstSceneInterfacePtr scene;
+	double time;
+
+};
+
+using PrefetchCache = IECorePreview::LRUCache<MurmurHash, ConstPrefetchedLocationPtr, IECorePreview::LRUCachePolicy::TaskParallel, PrefetchKey>;
+
+PrefetchCache &prefetchCache()
+{
+	static PrefetchCache g_cache(
+		[] ( const PrefetchKey &key, size_t &cost, const IECore::Canceller *canceller ) {
+			auto result = std::make_shared<PrefetchedLocation>();
+			result->hasBound = key.scene->hasBound();
+			if( result->hasBound )
+			{
+				result->bound = key.scene->readBound( key.time );
+			}
+			result->transform = key.scene->readTransformAsMatrix( key.time );
+			if( key.scene->hasObject() )
+			{
+				result->object = key.scene->readObject( key.time, canceller );
+			}
+			cost = sizeof( PrefetchedLocation ) + ( result->object ? result->object->memoryUsage() : 0 );
+			return ConstPrefetchedLocationPtr( result );
+		},
+		// Objects are shared with the compute cache once consumed, so
+		// this only limits the data read ahead of the traversal.
+		500 * 1024 * 1024
+	);
+	return g_cache;
+}
+
+const bool g_prefetchCacheClearConnected = ( ValuePlug::cacheClearedSignal().connect( [] { prefetchCache().clear(); } ), true );
+
+MurmurHash prefetchHash( const std::string &fileName, int refreshCount, const ScenePlug::ScenePath &path, double time )
+{
+	MurmurHash h;
+	h.append( fileName );
+	h.append( refreshCount );
+	h.append( path.data(), path.size() );
+	h.append( time );
+	return h;
+}
+
+} // namespace
+
+//////////////////////////////////////////////////////////////////////////
+// SceneReader::Prefetcher
+//////////////////////////////////////////////////////////////////////////
+
+// Reads locations into the prefetch cache using a few dedicated threads.
+// The reads block on I/O, so performing them on TBB worker threads would
+// starve the computes of threads to run on. Each SceneReader has its own
+// Prefetcher, so the threads and the number of pending reads are bounded
+// per node. The threads are only started when the first reads are
+// scheduled, so there is no overhead for nodes that don't prefetch.
+class SceneReader::Prefetcher
+{
+
+	public :
+
+		Prefetcher()
+			:	m_canceller( std::make_shared<Canceller>() ), m_started( false )
+		{
+			m_queue.set_capacity( g_queueCapacity );
+		}
+
+		~Prefetcher()
+		{
+			std::atomic_load( &m_canceller )->cancel();
+			if( m_started )
+			{
+				// Pending requests are cancelled, so the threads
+				// will drain the queue quickly and then see these.
+				for( size_t i = 0; i < m_threads.size(); ++i )
+				{
+					m_queue.push( Request() );
+				}
+				for( auto &thread : m_threads )
+				{
+					thread.join();
+				}
+			}
+		}
+
+		// Schedules reads for the children of `scene`. May be called
+		// concurrently from any thread. Never blocks : if the queue is
+		// full then the remaining children are not prefetched.
+		void prefetchChildren( const ConstSceneInterfacePtr &scene, const vector<InternedString> &childNames, const std::string &fileName, int refreshCount, const ScenePlug::ScenePath &path, double time, const Canceller *contextCanceller )
+		{
+			std::call_once( m_startFlag, [this] { start(); } );
+
+			const std::shared_ptr<const Canceller> canceller = std::atomic_load( &m_canceller );
+			ScenePlug::ScenePath childPath( path );
+			childPath.push_back( InternedString() ); // Room for the child name
+			for( const auto &childName : childNames )
+			{
+				if( contextCanceller && contextCanceller->cancelled() )
+				{
+					return;
+				}
+
+				childPath.back() = childName;
+				if( !m_queue.try_push( Request{ scene, childName, prefetchHash( fileName, refreshCount, childPath, time ), time, canceller } ) )
+				{
+					return;
+				}
+			}
+		}
+
+		// Returns the prefetched data for a location, or null if it hasn't
+		// been read yet. Deliberately doesn't depend on `prefetchPlug()`,
+		// only on the file name, refresh count, path and time, all of
+		// which the regular computes hash.
+		ConstPrefetchedLocationPtr location( const SceneReader *reader, const ScenePlug::ScenePath &path, const Context *context ) const
+		{
+			if( !m_started || path.empty() )
+			{
+				return nullptr;
+			}
+
+			std::optional<ConstPrefetchedLocationPtr> result = prefetchCache().getIfCached(
+				prefetchHash( reader->fileNamePlug()->getValue(), reader->refreshCountPlug()->getValue(), path, context->getTime() )
+			);
+			return result ? *result : nullptr;
+		}
+
+		// Cancels all pending reads.
+		void cancel()
+		{
+			std::atomic_load( &m_canceller )->cancel();
+			std::atomic_store( &m_canceller, std::make_shared<Canceller>() );
+		}
+
+	private :
+
+		struct Request
+		{
+			// Null for the requests used to stop the threads.
+			ConstSceneInterfacePtr scene;
+			InternedString childName;
+			MurmurHash hash;
+			double time;
+			std::shared_ptr<const Canceller> canceller;
+		};
+
+		void start()
+		{
+			for( size_t i = 0; i < g_numThreads; ++i )
+			{
+				m_threads.emplace_back( &Prefetcher::run, this );
+			}
+			m_started = true;
+		}
+
+		void run()
+		{
+			Request request;
+			while( true )
+			{
+				m_queue.pop( request );
+				if( !request.scene )
+				{
+					break;
+				}
+
+				try
+				{
+					Canceller::check( request.canceller.get() );
+					ConstSceneInterfacePtr child = request.scene->child( request.childName, SceneInterface::NullIfMissing );
+					if( child )
+					{
+						prefetchCache().get( PrefetchKey( request.hash, child, request.time ), request.canceller.get() );
+					}
+				}
+				catch( ... )
+				{
+					// Any errors will be reported when the regular
+					// compute reads the same location, and cancellation
+					// just means the read is no longer wanted.
+				}
+
+				// Don't keep the file open while waiting for more work.
+				request = Request();
+			}
+		}
+
+		static const size_t g_numThreads = 4;
+		static const size_t g_queueCapacity = 4096;
+
+		// Replaced each time the pending reads are cancelled. Accessed
+		// with `std::atomic_load()` and `std::atomic_store()`.
+		std::shared_ptr<Canceller> m_canceller;
+		tbb::concurrent_bounded_queue<Request> m_queue;
+		std::once_flag m_startFlag;
+		std::atomic_bool m_started;
+		std::vector<std::thread> m_threads;
+
+};
+
 GAFFER_NODE_DEFINE_TYPE( SceneReader );
 
 //////////////////////////////////////////////////////////////////////////
@@ -76,9 +376,13 @@ SceneReader::SceneReader( const std::string &name )
 	addChild( new IntPlug( "refreshCount" ) );
 	addChild( new StringPlug( "tags" ) );
 	addChild( new TransformPlug( "transform" ) );
+	addChild( new ObjectPlug( "__sets", Plug::Out, NullObject::defaultNullObject() ) );
+	addChild( new BoolPlug( "prefetch" ) );
 
 	outPlug()->childBoundsPlug()->setFlags( Plug::AcceptsDependencyCycles, true );
 	plugSetSignal().connect( boost::bind( &SceneReader::plugSet, this, ::_1 ) );
+
+	m_prefetcher = std::make_unique<Prefetcher>();
 }
 
 SceneReader::~SceneReader()
@@ -125,6 +429,26 @@ const Gaffer::TransformPlug *SceneReader::transformPlug() const
 	return getChild<TransformPlug>( g_firstPlugIndex + 3 );
 }
 
+Gaffer::BoolPlug *SceneReader::prefetchPlug()
+{
+	return getChild<BoolPlug>( g_firstPlugIndex + 5 );
+}
+
+const Gaffer::BoolPlug *SceneReader::prefetchPlug() const
+{
+	return getChild<BoolPlug>( g_firstPlugIndex + 5 );
+}
+
+Gaffer::ObjectPlug *SceneReader::setsPlug()
+{
+	return getChild<ObjectPlug>( g_firstPlugIndex + 4 );
+}
+
+const Gaffer::ObjectPlug *SceneReader::setsPlug() const
+{
+	return getChild<ObjectPlug>( g_firstPlugIndex + 4 );
+}
+
 void SceneReader::affects( const Gaffer::Plug *input, AffectedPlugsContainer &outputs ) const
 {
 	SceneNode::affects( input, outputs );
@@ -154,17 +478,96 @@ void SceneReader::affects( const Gaffer::Plug *input, AffectedPlugsContainer &ou
 	{
 		outputs.push_back( outPlug()->attributesPlug() );
 		outputs.push_back( outPlug()->objectPlug() );
+		outputs.push_back( setsPlug() );
+	}
+
+	if( input == setsPlug() )
+	{
 		outputs.push_back( outPlug()->setNamesPlug() );
 		outputs.push_back( outPlug()->setPlug() );
 	}
 }
 
+void SceneReader::hash( const Gaffer::ValuePlug *output, const Gaffer::Context *context, IECore::MurmurHash &h ) const
+{
+	SceneNode::hash( output, context, h );
+
+	if( output == setsPlug() )
+	{
+		// Tags are not animated, so the sets depend only on the file.
+		fileNamePlug()->hash( h );
+		refreshCountPlug()->hash( h );
+	}
+}
+
+void SceneReader::compute( Gaffer::ValuePlug *output, const Gaffer::Context *context ) const
+{
+	if( output == setsPlug() )
+	{
+		CompoundObjectPtr result = new CompoundObject;
+		InternedStringVectorDataPtr setNamesData = new InternedStringVectorData;
+		CompoundObjectPtr setsData = new CompoundObject;
+		result->members()[g_setNamesName] = setNamesData;
+		result->members()[g_setsName] = setsData;
+
+		ConstSceneInterfacePtr rootScene = scene( ScenePath() );
+		if( rootScene )
+		{
+			rootScene->readTags( setNamesData->writable(), SceneInterface::LocalTag | SceneInterface::DescendantTag );
+
+			ThreadLocalSetMap threadLocalSets;
+			tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+			loadSetsWalk( rootScene.get(), ScenePath(), context->canceller(), threadLocalSets, taskGroupContext );
+
+			for( const auto &setName : setNamesData->readable() )
+			{
+				PathMatcherDataPtr setData = new PathMatcherData;
+				for( const auto &sets : threadLocalSets )
+				{
+					auto it = sets.find( setName );
+					if( it != sets.end() )
+					{
+						setData->writable().addPaths( it->second );
+					}
+				}
+				setsData->members()[setName] = setData;
+			}
+		}
+
+		static_cast<ObjectPlug *>( output )->setValue( result );
+		return;
+	}
+
+	SceneNode::compute( output, context );
+}
+
+Gaffer::ValuePlug::CachePolicy SceneReader::computeCachePolicy( const Gaffer::ValuePlug *output ) const
+{
+	if( output == setsPlug() )
+	{
+		// Computing the sets spawns TBB tasks, and all the set
+		// computes typically request it concurrently.
+		return ValuePlug::CachePolicy::TaskCollaboration;
+	}
+	return SceneNode::computeCachePolicy( output );
+}
+
 size_t SceneReader::supportedExtensions( std::vector<std::string> &extensions )
 {
 	extensions = SceneInterface::supportedExtensions();
 	return extensions.size();
 }
 
+size_t SceneReader::getPrefetchCacheMemoryLimit()
+{
+	return prefetchCache().getMaxCost();
+}
+
+void SceneReader::setPrefetchCacheMemoryLimit( size_t bytes )
+{
+	prefetchCache().setMaxCost( bytes );
+}
+
 void SceneReader::hashBound( const ScenePath &path, const Gaffer::Context *context, const ScenePlug *parent, IECore::MurmurHash &h ) const
 {
 	SceneNode::hashBound( path, context, parent, h );
@@ -204,10 +607,12 @@ Imath::Box3f SceneReader::computeBound( const ScenePath &path, const Gaffer::Con
 		return Box3f();
 	}
 
+	ConstPrefetchedLocationPtr prefetched = m_prefetcher->location( this, path, context );
+
 	Box3f result;
-	if( s->hasBound() )
+	if( prefetched ? prefetched->hasBound : s->hasBound() )
 	{
-		const Box3d b = s->readBound( context->getTime() );
+		const Box3d b = prefetched ? prefetched->bound : s->readBound( context->getTime() );
 		if( b.isEmpty() )
 		{
 			return Box3f();
@@ -254,7 +659,8 @@ Imath::M44f SceneReader::computeTransform( const ScenePath &path, const Gaffer::
 		return M44f();
 	}
 
-	const M44d t = s->readTransformAsMatrix( context->getTime() );
+	ConstPrefetchedLocationPtr prefetched = m_prefetcher->location( this, path, context );
+	const M44d t = prefetched ? prefetched->transform : s->readTransformAsMatrix( context->getTime() );
 	M44f result = M44f(
 		t[0][0], t[0][1], t[0][2], t[0][3],
 		t[1][0], t[1][1], t[1][2], t[1][3],
@@ -355,6 +761,12 @@ IECore::ConstObjectPtr SceneReader::computeObject( const ScenePath &path, const
 		return parent->objectPlug()->defaultValue();
 	}
 
+	ConstPrefetchedLocationPtr prefetched = m_prefetcher->location( this, path, context );
+	if( prefetched && prefetched->object )
+	{
+		return prefetched->object;
+	}
+
 	return s->readObject( context->getTime(), context->canceller() );
 }
 
@@ -428,6 +840,14 @@ IECore::ConstInternedStringVectorDataPtr SceneReader::computeChildNames( const S
 		result.erase( newResultEnd, result.end() );
 	}
 
+	if( prefetchPlug()->getValue() )
+	{
+		m_prefetcher->prefetchChildren(
+			s, result, fileNamePlug()->getValue(), refreshCountPlug()->getValue(), path, context->getTime(),
+			context->canceller()
+		);
+	}
+
 	return resultData;
 }
 
@@ -450,16 +870,8 @@ void SceneReader::hashSetNames( const Gaffer::Context *context, const ScenePlug
 
 IECore::ConstInternedStringVectorDataPtr SceneReader::computeSetNames( const Gaffer::Context *context, const ScenePlug *parent ) const
 {
-	ConstSceneInterfacePtr s = scene( ScenePath() );
-	if( !s )
-	{
-		return parent->setNamesPlug()->defaultValue();
-	}
-
-	InternedStringVectorDataPtr result = new InternedStringVectorData();
-	s->readTags( result->writable(), SceneInterface::LocalTag | SceneInterface::DescendantTag );
-
-	return result;
+	ConstCompoundObjectPtr sets = boost::static_pointer_cast<const CompoundObject>( setsPlug()->getValue() );
+	return sets->member<InternedStringVectorData>( g_setNamesName );
 }
 
 void SceneReader::hashSet( const IECore::InternedString &setName, const Gaffer::Context *context, const ScenePlug *parent, IECore::MurmurHash &h ) const
@@ -470,46 +882,21 @@ void SceneReader::hashSet( const IECore::InternedString &setName, const Gaffer::
 	h.append( setName );
 }
 
-static void loadSetWalk( const SceneInterface *s, const InternedString &setName, const Gaffer::Context *context, PathMatcher &set, const vector<InternedString> &path )
+IECore::ConstPathMatcherDataPtr SceneReader::computeSet( const IECore::InternedString &setName, const Gaffer::Context *context, const ScenePlug *parent ) const
 {
-	if( s->hasTag( setName, SceneInterface::LocalTag ) )
+	ConstCompoundObjectPtr sets;
 	{
-		set.addPath( path );
+		// Remove `scene:setName` so that all sets share a single
+		// compute of `setsPlug()`.
+		ScenePlug::GlobalScope globalScope( context );
+		sets = boost::static_pointer_cast<const CompoundObject>( setsPlug()->getValue() );
 	}
 
-	// Figure out if we need to recurse by querying descendant tags to see if they include
-	// anything we're interested in.
-
-	if( !s->hasTag( setName, SceneInterface::DescendantTag ) )
+	if( const PathMatcherData *set = sets->member<CompoundObject>( g_setsName )->member<PathMatcherData>( setName ) )
 	{
-		return;
+		return set;
 	}
-
-	// Recurse to the children.
-
-	SceneInterface::NameList childNames;
-	s->childNames( childNames );
-	vector<InternedString> childPath( path );
-	childPath.push_back( InternedString() ); // room for the child name
-	for( SceneInterface::NameList::const_iterator it = childNames.begin(), eIt = childNames.end(); it != eIt; ++it )
-	{
-		Canceller::check( context->canceller() );
-
-		ConstSceneInterfacePtr child = s->child( *it );
-		childPath.back() = *it;
-		loadSetWalk( child.get(), setName, context, set, childPath );
-	}
-}
-
-IECore::ConstPathMatcherDataPtr SceneReader::computeSet( const IECore::InternedString &setName, const Gaffer::Context *context, const ScenePlug *parent ) const
-{
-	PathMatcherDataPtr result = new PathMatcherData;
-	ConstSceneInterfacePtr rootScene = scene( ScenePath() );
-	if( rootScene )
-	{
-		loadSetWalk( rootScene.get(), setName, context, result->writable(), ScenePath() );
-	}
-	return result;
+	return outPlug()->setPlug()->defaultValue();
 }
 
 void SceneReader::plugSet( Gaffer::Plug *plug )
@@ -522,6 +909,9 @@ void SceneReader::plugSet( Gaffer::Plug *plug )
 	{
 		SharedSceneInterfaces::clear();
 		m_lastScene.clear();
+		// Stop any reads still pending for the old file contents.
+		m_prefetcher->cancel();
+		prefetchCache().clear();
 	}
 }
 
@@ -45,7 +45,18 @@
 
 #include "boost/filesystem.hpp"
 
+#include "tbb/concurrent_queue.h"
 #include "tbb/mutex.h"
+#include "tbb/pipeline.h"
+#include "tbb/task_arena.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
 
 using namespace std;
 using namespace IECore;
@@ -56,6 +67,97 @@ using namespace GafferScene;
 namespace
 {
 
+// Everything we need to write for a single location on a single frame.
+struct LocationSample
+{
+	ConstCompoundObjectPtr attributes;
+	ConstCompoundObjectPtr globals;
+	ConstObjectPtr object;
+	Imath::Box3f bound;
+	IECore::M44dDataPtr transformData;
+	SceneInterface::NameList locationSets;
+	ConstInternedStringVectorDataPtr childNames;
+};
+
+/// Reads the sample for the current location, without needing
+/// access to the output SceneInterface.
+LocationSample readLocation( const ScenePlug *scene, const ScenePlug::ScenePath &scenePath, const CompoundData *sets )
+{
+	LocationSample result;
+	result.attributes = scene->attributesPlug()->getValue();
+	result.object = scene->objectPlug()->getValue();
+	result.bound = scene->boundPlug()->getValue();
+
+	if( scenePath.empty() )
+	{
+		result.globals = scene->globals();
+	}
+	else
+	{
+		Imath::M44f t = scene->transformPlug()->getValue();
+		result.transformData = new IECore::M44dData( Imath::M44d (
+			t[0][0], t[0][1], t[0][2], t[0][3],
+			t[1][0], t[1][1], t[1][2], t[1][3],
+			t[2][0], t[2][1], t[2][2], t[2][3],
+			t[3][0], t[3][1], t[3][2], t[3][3]
+		) );
+	}
+
+	const CompoundDataMap &setsMap = sets->readable();
+	result.locationSets.reserve( setsMap.size() );
+
+	for( CompoundDataMap::const_iterator it = setsMap.begin(); it != setsMap.end(); ++it)
+	{
+		ConstPathMatcherDataPtr pathMatcher = IECore::runTimeCast<PathMatcherData>( it->second );
+
+		if( pathMatcher->readable().match( scenePath ) & IECore::PathMatcher::ExactMatch )
+		{
+			result.locationSets.push_back( it->first );
+		}
+	}
+
+	result.childNames = scene->childNamesPlug()->getValue();
+
+	return result;
+}
+
+void writeLocation( const LocationSample &sample, const ScenePlug::ScenePath &scenePath, SceneInterface *output, float time )
+{
+	if( sample.object->typeId() != IECore::NullObjectTypeId && scenePath.size() > 0 )
+	{
+		output->writeObject( sample.object.get(), time );
+	}
+
+	output->writeBound( Imath::Box3d( Imath::V3f( sample.bound.min ), Imath::V3f( sample.bound.max ) ), time );
+
+	if( sample.transformData )
+	{
+		output->writeTransform( sample.transformData.get(), time );
+	}
+
+	for( CompoundObject::ObjectMap::const_iterator it = sample.attributes->members().begin(), eIt = sample.attributes->members().end(); it != eIt; it++ )
+	{
+		output->writeAttribute( it->first, it->second.get(), time );
+	}
+
+	if( sample.globals && !sample.globals->members().empty() )
+	{
+		output->writeAttribute( "gaffer:globals", sample.globals.get(), time );
+	}
+
+	if( !sample.locationSets.empty() )
+	{
+		output->writeTags( sample.locationSets );
+	}
+
+	for( const auto &childName : sample.childNames->readable() )
+	{
+		// Locations may be visited in any order. Pre-create SceneInterface
+		// children here so that they are created in the correct order.
+		output->child( childName, SceneInterface::CreateIfMissing );
+	}
+}
+
 struct LocationWriter
 {
 	LocationWriter(SceneInterfacePtr output, ConstCompoundDataPtr sets, float time, tbb::mutex& mutex) : m_output( output ), m_sets(sets), m_time( time ), m_mutex( mutex )
@@ -75,97 +177,316 @@ struct LocationWriter
 	/// into the SceneInterface
 	bool operator()( const ScenePlug *scene, const ScenePlug::ScenePath &scenePath )
 	{
-		ConstCompoundObjectPtr attributes = scene->attributesPlug()->getValue();
+		const LocationSample sample = readLocation( scene, scenePath, m_sets.get() );
+
+		tbb::mutex::scoped_lock scopedLock( m_mutex );
+
+		if( !scenePath.empty() )
+		{
+			m_output = m_output->child( scenePath.back() );
+		}
 
-		ConstCompoundObjectPtr globals;
+		writeLocation( sample, scenePath, m_output.get(), m_time );
 
-		ConstObjectPtr object = scene->objectPlug()->getValue();
-		Imath::Box3f bound = scene->boundPlug()->getValue();
+		return true;
+	}
+
+	SceneInterfacePtr m_output;
+	ConstCompoundDataPtr m_sets;
+	float m_time;
+	tbb::mutex &m_mutex;
+};
 
-		IECore::M44dDataPtr transformData;
+// Receives samples from several frames being computed concurrently, and
+// writes them from a single dedicated thread. Samples may arrive in any
+// order, so they are buffered per location until they can be written
+// in the order that SceneInterface requires :
+//
+// - The samples for each location are written in frame order.
+// - A location is only written on a frame once its parent has been
+//   written on that frame, so that the parent has created it.
+//
+// Memory usage is bounded in two places :
+//
+// - Producers block when the queue is full.
+// - Producers for any frame other than the oldest incomplete one block
+//   while more than `maxPendingSamples` samples are buffered waiting for
+//   earlier frames. The oldest frame is never blocked, so it can always
+//   complete and allow buffered samples to be written.
+//
+// So at most `queueCapacity` samples are queued, and `maxPendingSamples`
+// (plus one per blocked producer) are buffered.
+class PipelinedWriter
+{
+
+	public :
 
-		if( scenePath.empty() )
+		PipelinedWriter( SceneInterfacePtr output, const std::vector<float> &times, size_t queueCapacity, size_t maxPendingSamples )
+			:	m_times( times ), m_frameComplete( times.size(), false ), m_maxPendingSamples( maxPendingSamples ),
+				m_pendingSamples( 0 ), m_oldestIncompleteFrame( 0 ), m_failed( false )
 		{
-			globals = scene->globals();
+			m_root.output = output;
+			m_queue.set_capacity( queueCapacity );
+			m_thread = std::thread( &PipelinedWriter::run, this );
 		}
-		else
+
+		~PipelinedWriter()
 		{
-			Imath::M44f t = scene->transformPlug()->getValue();
-			transformData = new IECore::M44dData( Imath::M44d (
-				t[0][0], t[0][1], t[0][2], t[0][3],
-				t[1][0], t[1][1], t[1][2], t[1][3],
-				t[2][0], t[2][1], t[2][2], t[2][3],
-				t[3][0], t[3][1], t[3][2], t[3][3]
-			) );
+			stop();
 		}
 
-		SceneInterface::NameList locationSets;
-		const CompoundDataMap &setsMap = m_sets->readable();
-		locationSets.reserve( setsMap.size() );
-
-		for( CompoundDataMap::const_iterator it = setsMap.begin(); it != setsMap.end(); ++it)
+		// May be called concurrently from any thread.
+		void push( size_t frameIndex, const ScenePlug::ScenePath &path, LocationSample &&sample )
 		{
-			ConstPathMatcherDataPtr pathMatcher = IECore::runTimeCast<PathMatcherData>( it->second );
+			if( frameIndex > m_oldestIncompleteFrame && m_pendingSamples >= m_maxPendingSamples )
+			{
+				std::unique_lock<std::mutex> lock( m_pendingMutex );
+				m_pendingCondition.wait(
+					lock,
+					[this, frameIndex] {
+						return m_failed || frameIndex <= m_oldestIncompleteFrame || m_pendingSamples < m_maxPendingSamples;
+					}
+				);
+			}
 
-			if( pathMatcher->readable().match( scenePath ) & IECore::PathMatcher::ExactMatch )
+			if( m_failed )
 			{
-				locationSets.push_back( it->first );
+				throw IECore::Exception( "Writing failed" );
 			}
+			m_queue.push( Message{ Message::Sample, frameIndex, path, std::move( sample ) } );
 		}
 
-		ConstInternedStringVectorDataPtr childNames = scene->childNamesPlug()->getValue();
-
-		tbb::mutex::scoped_lock scopedLock( m_mutex );
+		// Must be called once all samples for the frame have been pushed.
+		void frameComplete( size_t frameIndex )
+		{
+			m_queue.push( Message{ Message::FrameComplete, frameIndex, ScenePlug::ScenePath(), LocationSample() } );
+		}
 
-		if( !scenePath.empty() )
+		// Must be called if a producer fails, so that producers blocked
+		// waiting for it are released.
+		void cancel()
 		{
-			m_output = m_output->child( scenePath.back() );
+			m_failed = true;
+			notifyPending();
 		}
 
-		if( object->typeId() != IECore::NullObjectTypeId && scenePath.size() > 0 )
+		// Waits for all writes to complete, rethrowing any exception
+		// encountered while writing.
+		void finish()
 		{
-			m_output->writeObject( object.get(), m_time );
+			stop();
+			if( m_exception )
+			{
+				std::rethrow_exception( m_exception );
+			}
 		}
 
-		m_output->writeBound( Imath::Box3d( Imath::V3f( bound.min ), Imath::V3f( bound.max ) ), m_time );
+	private :
 
-		if( transformData )
+		void notifyPending()
 		{
-			m_output->writeTransform( transformData.get(), m_time );
+			std::lock_guard<std::mutex> lock( m_pendingMutex );
+			m_pendingCondition.notify_all();
 		}
 
-		for( CompoundObject::ObjectMap::const_iterator it = attributes->members().begin(), eIt = attributes->members().end(); it != eIt; it++ )
+		void stop()
 		{
-			m_output->writeAttribute( it->first, it->second.get(), m_time );
+			if( m_thread.joinable() )
+			{
+				m_queue.push( Message{ Message::Finish, 0, ScenePlug::ScenePath(), LocationSample() } );
+				m_thread.join();
+			}
 		}
 
-		if( globals && !globals->members().empty() )
+		struct Message
+		{
+			enum Type
+			{
+				Sample,
+				FrameComplete,
+				Finish
+			};
+
+			Type type;
+			size_t frameIndex;
+			ScenePlug::ScenePath path;
+			LocationSample sample;
+		};
+
+		struct Location
+		{
+			Location *parent = nullptr;
+			SceneInterfacePtr output;
+			// One past the last frame written.
+			size_t nextFrame = 0;
+			std::map<size_t, LocationSample> pending;
+			// True if in `m_blocked`.
+			bool blocked = false;
+			std::unordered_map<InternedString, std::unique_ptr<Location>> children;
+		};
+
+		void run()
 		{
-			m_output->writeAttribute( "gaffer:globals", globals.get(), m_time );
+			Message message;
+			while( true )
+			{
+				m_queue.pop( message );
+				if( message.type == Message::Finish )
+				{
+					break;
+				}
+				else if( m_failed )
+				{
+					// Keep draining the queue so that producers are
+					// not blocked indefinitely.
+					continue;
+				}
+
+				try
+				{
+					if( message.type == Message::Sample )
+					{
+						Location *location = &m_root;
+						for( const auto &name : message.path )
+						{
+							std::unique_ptr<Location> &child = location->children[name];
+							if( !child )
+							{
+								child.reset( new Location );
+								child->parent = location;
+							}
+							location = child.get();
+						}
+						location->pending.emplace( message.frameIndex, std::move( message.sample ) );
+						m_pendingSamples++;
+						writePending( location, message.path );
+					}
+					else
+					{
+						m_frameComplete[message.frameIndex] = true;
+						size_t oldest = m_oldestIncompleteFrame;
+						while( oldest < m_frameComplete.size() && m_frameComplete[oldest] )
+						{
+							oldest++;
+						}
+						if( oldest != m_oldestIncompleteFrame )
+						{
+							m_oldestIncompleteFrame = oldest;
+							notifyPending();
+						}
+						// Completing a frame may unblock locations that didn't
+						// exist on it.
+						std::vector<std::pair<Location *, ScenePlug::ScenePath>> blocked;
+						blocked.swap( m_blocked );
+						for( auto &b : blocked )
+						{
+							b.first->blocked = false;
+							writePending( b.first, b.second );
+						}
+					}
+				}
+				catch( ... )
+				{
+					m_exception = std::current_exception();
+					m_failed = true;
+					notifyPending();
+				}
+			}
+
+			// Some implementations of SceneInterface may perform writing
+			// when we release them, so we do that on this thread too.
+			m_blocked.clear();
+			m_root.children.clear();
+			m_root.output.reset();
 		}
 
-		if( !locationSets.empty() )
+		bool canWrite( const Location *location, size_t frameIndex ) const
 		{
-			m_output->writeTags( locationSets );
+			if( location->parent && location->parent->nextFrame <= frameIndex )
+			{
+				return false;
+			}
+
+			// Earlier frames that we haven't written must be complete,
+			// otherwise a sample for them may still arrive.
+			for( size_t f = location->nextFrame; f < frameIndex; ++f )
+			{
+				if( !m_frameComplete[f] )
+				{
+					return false;
+				}
+			}
+
+			return true;
 		}
 
-		for( const auto &childName : childNames->readable() )
+		void writePending( Location *location, const ScenePlug::ScenePath &path )
 		{
-			// `SceneAlgo::parallelProcessLocations()` may visit children in any
-			// order. Pre-create SceneInterface children here so that they are
-			// created in the correct order.
-			m_output->child( childName, SceneInterface::CreateIfMissing );
+			while( !location->pending.empty() )
+			{
+				auto it = location->pending.begin();
+				if( !canWrite( location, it->first ) )
+				{
+					if( !location->blocked )
+					{
+						location->blocked = true;
+						m_blocked.push_back( { location, path } );
+					}
+					return;
+				}
+
+				if( !location->output )
+				{
+					location->output = location->parent->output->child( path.back() );
+				}
+
+				writeLocation( it->second, path, location->output.get(), m_times[it->first] );
+				location->nextFrame = it->first + 1;
+				ConstInternedStringVectorDataPtr childNames = it->second.childNames;
+				location->pending.erase( it );
+				if( --m_pendingSamples == m_maxPendingSamples - 1 )
+				{
+					notifyPending();
+				}
+
+				// Children may have been waiting for us.
+				ScenePlug::ScenePath childPath( path );
+				childPath.push_back( InternedString() );
+				for( const auto &childName : childNames->readable() )
+				{
+					auto childIt = location->children.find( childName );
+					if( childIt != location->children.end() && !childIt->second->pending.empty() )
+					{
+						childPath.back() = childName;
+						writePending( childIt->second.get(), childPath );
+					}
+				}
+			}
 		}
 
-		return true;
-	}
+		const std::vector<float> m_times;
+		std::vector<bool> m_frameComplete;
+		Location m_root;
+		std::vector<std::pair<Location *, ScenePlug::ScenePath>> m_blocked;
+
+		const size_t m_maxPendingSamples;
+		std::atomic_size_t m_pendingSamples;
+		std::atomic_size_t m_oldestIncompleteFrame;
+		std::mutex m_pendingMutex;
+		std::condition_variable m_pendingCondition;
+
+		tbb::concurrent_bounded_queue<Message> m_queue;
+		std::atomic_bool m_failed;
+		std::exception_ptr m_exception;
+		std::thread m_thread;
 
-	SceneInterfacePtr m_output;
-	ConstCompoundDataPtr m_sets;
-	float m_time;
-	tbb::mutex &m_mutex;
 };
 
+// Number of samples queued between compute and writing, per concurrent frame.
+const size_t g_pipelineQueueCapacity = 1000;
+// Number of samples buffered waiting for earlier frames, per concurrent frame.
+const size_t g_pipelineMaxPendingSamples = 10000;
+
 }
 
 GAFFER_NODE_DEFINE_TYPE( SceneWriter );
@@ -179,6 +500,7 @@ SceneWriter::SceneWriter( const std::string &name )
 	addChild( new ScenePlug( "in", Plug::In ) );
 	addChild( new StringPlug( "fileName" ) );
 	addChild( new ScenePlug( "out", Plug::Out, Plug::Default & ~Plug::Serialisable ) );
+	addChild( new IntPlug( "concurrentFrames", Plug::In, 1, 1 ) );
 	outPlug()->setInput( inPlug() );
 }
 
@@ -216,6 +538,16 @@ const ScenePlug *SceneWriter::outPlug() const
 	return getChild<ScenePlug>( g_firstPlugIndex + 2 );
 }
 
+IntPlug *SceneWriter::concurrentFramesPlug()
+{
+	return getChild<IntPlug>( g_firstPlugIndex + 3 );
+}
+
+const IntPlug *SceneWriter::concurrentFramesPlug() const
+{
+	return getChild<IntPlug>( g_firstPlugIndex + 3 );
+}
+
 IECore::MurmurHash SceneWriter::hash( const Gaffer::Context *context ) const
 {
 	const ScenePlug *scenePlug = inPlug()->source<ScenePlug>();
@@ -247,6 +579,13 @@ void SceneWriter::executeSequence( const std::vector<float> &frames ) const
 		throw IECore::Exception( "No input scene" );
 	}
 
+	const int concurrentFrames = concurrentFramesPlug()->getValue();
+	if( concurrentFrames > 1 && frames.size() > 1 )
+	{
+		executePipelined( scene, frames, concurrentFrames );
+		return;
+	}
+
 	SceneInterfacePtr output;
 	tbb::mutex mutex;
 	ContextPtr context = new Context( *Context::current() );
@@ -270,6 +609,115 @@ void SceneWriter::executeSequence( const std::vector<float> &frames ) const
 	}
 }
 
+void SceneWriter::executePipelined( const ScenePlug *scene, const std::vector<float> &frames, int concurrentFrames ) const
+{
+	// Group consecutive frames that write to the same file.
+
+	struct FileFrames
+	{
+		std::string fileName;
+		std::vector<float> frames;
+		std::vector<float> times;
+	};
+	std::vector<FileFrames> files;
+
+	{
+		ContextPtr context = new Context( *Context::current() );
+		Context::Scope scopedContext( context.get() );
+		for( float frame : frames )
+		{
+			context->setFrame( frame );
+			const std::string fileName = fileNamePlug()->getValue();
+			if( files.empty() || files.back().fileName != fileName )
+			{
+				files.push_back( { fileName, {}, {} } );
+			}
+			files.back().frames.push_back( frame );
+			files.back().times.push_back( context->getTime() );
+		}
+	}
+
+	const ThreadState &threadState = ThreadState::current();
+
+	for( const auto &file : files )
+	{
+		createDirectories( file.fileName );
+		PipelinedWriter writer(
+			SceneInterface::create( file.fileName, IndexedIO::Write ),
+			file.times, g_pipelineQueueCapacity * concurrentFrames,
+			g_pipelineMaxPendingSamples * concurrentFrames
+		);
+
+		// Compute up to `concurrentFrames` frames at once, each
+		// feeding the writer as its locations are computed.
+
+		size_t nextFrameIndex = 0;
+		tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+		try
+		{
+			tbb::parallel_pipeline( concurrentFrames,
+
+				tbb::make_filter<void, size_t>(
+					tbb::filter::serial_in_order,
+					[&] ( tbb::flow_control &flowControl ) -> size_t {
+						if( nextFrameIndex == file.frames.size() )
+						{
+							flowControl.stop();
+							return 0;
+						}
+						return nextFrameIndex++;
+					}
+				) &
+
+				tbb::make_filter<size_t, void>(
+					tbb::filter::parallel,
+					[&] ( size_t frameIndex ) {
+						Context::EditableScope frameScope( threadState );
+						frameScope.setFrame( file.frames[frameIndex] );
+
+						try
+						{
+							// Isolated so that a thread waiting within this frame's
+							// computation can't pick up a task from a later frame and
+							// block in `push()`, which would prevent this frame from
+							// ever completing.
+							tbb::this_task_arena::isolate(
+								[&] {
+									ConstCompoundDataPtr sets = SceneAlgo::sets( scene );
+									auto locationReader = [&] ( const ScenePlug *scenePlug, const ScenePlug::ScenePath &path ) {
+										writer.push( frameIndex, path, readLocation( scenePlug, path, sets.get() ) );
+										return true;
+									};
+									SceneAlgo::parallelTraverse( scene, locationReader );
+								}
+							);
+						}
+						catch( ... )
+						{
+							writer.cancel();
+							throw;
+						}
+
+						writer.frameComplete( frameIndex );
+					}
+				),
+
+				taskGroupContext
+
+			);
+		}
+		catch( ... )
+		{
+			// Prefer reporting any exception from the writer, since
+			// it is likely to be the reason for the failure.
+			writer.finish();
+			throw;
+		}
+
+		writer.finish();
+	}
+}
+
 bool SceneWriter::requiresSequenceExecution() const
 {
 	return true;
@@ -40,6 +40,8 @@
 
 #include "GafferScene/SetAlgo.h"
 
+#include "Gaffer/Private/IECorePreview/LRUCache.h"
+
 #include "IECore/MessageHandler.h"
 
 #include "boost/algorithm/string/predicate.hpp"
@@ -51,6 +53,9 @@
 #include "boost/variant/apply_visitor.hpp"
 #include "boost/variant/recursive_variant.hpp"
 
+#include "tbb/parallel_for.h"
+#include "tbb/parallel_invoke.h"
+
 using namespace IECore;
 using namespace Gaffer;
 using namespace GafferScene;
@@ -187,202 +192,6 @@ std::ostream& operator<<( std::ostream& stream, const ExpressionAst& expr )
 }
 #endif
 
-// Evaluating the AST
-// ------------------
-struct AstEvaluator
-{
-	using result_type = PathMatcher;
-
-	AstEvaluator( const ScenePlug *scene )
-		: m_scene( scene )
-	{
-	}
-
-	result_type operator()( const std::string &identifier ) const
-	{
-		if( identifier[0] == '/' )
-		{
-			// Object name
-			PathMatcher result;
-			if( StringAlgo::hasWildcards( identifier ) )
-			{
-				throw IECore::Exception( boost::str( boost::format( "Object name \"%1%\" contains wildcards" ) % identifier ) );
-			}
-			result.addPath( identifier );
-			return result;
-		}
-		else
-		{
-			// Set name
-
-			if( !StringAlgo::hasWildcards( identifier ) )
-			{
-				return m_scene->set( identifier )->readable();
-			}
-
-			result_type result;
-
-			IECore::ConstInternedStringVectorDataPtr setNamesData = m_scene->setNamesPlug()->getValue();
-			const std::vector<IECore::InternedString> &setNames = setNamesData->readable();
-			if( setNames.empty() )
-			{
-				return result;
-			}
-
-			ScenePlug::SetScope setScope( Context::current() );
-			for( const IECore::InternedString &setName : setNames )
-			{
-				if( !StringAlgo::match( setName.string(), identifier ) )
-				{
-					continue;
-				}
-
-				setScope.setSetName( &setName );
-				ConstPathMatcherDataPtr setData = m_scene->setPlug()->getValue();
-				result.addPaths( setData->readable() );
-			}
-			return result;
-		}
-	}
-
-	result_type operator()( const ExpressionAst &ast ) const
-	{
-		return boost::apply_visitor( *this, ast.expr );
-	}
-
-	result_type operator()( const Nil &nil ) const
-	{
-		PathMatcher result;
-		return result;
-	}
-
-	result_type operator()( const BinaryOp &expr ) const
-	{
-		PathMatcher left = boost::apply_visitor( *this, expr.left.expr );
-		PathMatcher right = boost::apply_visitor( *this, expr.right.expr );
-
-		switch( expr.op )
-		{
-			case Or :
-			{
-				PathMatcher result = PathMatcher( left );
-				result.addPaths( right );
-				return result;
-			}
-			case And :
-			{
-				return left.intersection( right );
-			}
-			case AndNot :
-			{
-				PathMatcher result = PathMatcher( left );
-				result.removePaths( right );
-				return result;
-			}
-			case In :
-			{
-				PathMatcher result;
-				for( PathMatcher::Iterator it = right.begin(), eIt = right.end(); it != eIt; ++it )
-				{
-					result.addPaths( left.subTree( *it ), *it );
-					it.prune();
-				}
-				return result;
-			}
-			case Containing :
-			{
-				PathMatcher result;
-				for( PathMatcher::Iterator it = left.begin(), eIt = left.end(); it != eIt; ++it )
-				{
-					if( right.match( *it ) & ( PathMatcher::ExactMatch | PathMatcher::DescendantMatch ) )
-					{
-						result.addPath( *it );
-					}
-				}
-				return result;
-			}
-			default :
-				return PathMatcher();
-		}
-	}
-
-	const ScenePlug *m_scene;
-
-};
-
-// Hashing the AST
-// ---------------
-struct AstHasher
-{
-	using result_type = void;
-
-	AstHasher( const ScenePlug *scene, IECore::MurmurHash &h ) : m_scene( scene ), m_hash( h )
-	{
-	}
-
-	void operator()( const std::string &identifier )
-	{
-		if( identifier[0] == '/' )
-		{
-			// Object name
-			m_hash.append( identifier );
-		}
-		else
-		{
-			// Set name
-			if( !m_scene )
-			{
-				throw IECore::Exception( "SetAlgo: Invalid scene given. Can not hash set expression." );
-			}
-
-			if( !StringAlgo::hasWildcards( identifier ) )
-			{
-				m_hash.append( m_scene->setHash( identifier ) );
-				return;
-			}
-
-			IECore::ConstInternedStringVectorDataPtr setNamesData = m_scene->setNamesPlug()->getValue();
-			const std::vector<IECore::InternedString> &setNames = setNamesData->readable();
-			if( setNames.empty() )
-			{
-				return;
-			}
-
-			ScenePlug::SetScope setScope( Context::current() );
-			for( const IECore::InternedString &setName : setNames )
-			{
-				if( !StringAlgo::match( setName.string(), identifier ) )
-				{
-					continue;
-				}
-
-				setScope.setSetName( &setName );
-				m_hash.append( m_scene->setPlug()->hash() );
-			}
-		}
-	}
-
-	void operator()( const ExpressionAst &ast )
-	{
-		boost::apply_visitor( *this, ast.expr );
-	}
-
-	void operator()( const BinaryOp &expr )
-	{
-		m_hash.append( expr.op );
-		boost::apply_visitor( *this, expr.left.expr );
-		boost::apply_visitor( *this, expr.right.expr );
-	}
-
-	void operator()( const Nil &nil )
-	{
-	}
-
-	const ScenePlug* m_scene;
-	IECore::MurmurHash &m_hash;
-
-};
-
 template <typename Iterator>
 struct ExpressionGrammar : qi::grammar<Iterator, ExpressionAst(), ascii::space_type>
 {
@@ -509,6 +318,500 @@ void expressionToAST( const std::string &setExpression, ExpressionAst &ast)
 	}
 }
 
+// Compiling the AST
+// -----------------
+//
+// Parsing is relatively expensive, so we convert the AST into a flat list
+// of nodes which we cache per expression string. Nodes are stored in
+// post-order, so the children of a node always precede it and the root
+// is the last node in the list.
+
+struct CompiledExpression : public IECore::RefCounted
+{
+
+	IE_CORE_DECLAREMEMBERPTR( CompiledExpression );
+
+	struct Node
+	{
+		enum Type { Empty, ObjectName, SetName, SetNameWildcard, Operation };
+
+		Type type = Empty;
+		Op op = Or;
+		std::string identifier;
+		size_t left = 0;
+		size_t right = 0;
+	};
+
+	std::vector<Node> nodes;
+
+};
+
+IE_CORE_DECLAREPTR( CompiledExpression );
+
+struct AstCompiler
+{
+	using result_type = size_t;
+
+	AstCompiler( CompiledExpression &compiled )
+		: m_compiled( compiled )
+	{
+	}
+
+	size_t operator()( const std::string &identifier ) const
+	{
+		CompiledExpression::Node node;
+		node.identifier = identifier;
+		if( identifier[0] == '/' )
+		{
+			node.type = CompiledExpression::Node::ObjectName;
+		}
+		else
+		{
+			node.type = StringAlgo::hasWildcards( identifier ) ? CompiledExpression::Node::SetNameWildcard : CompiledExpression::Node::SetName;
+		}
+		return addNode( node );
+	}
+
+	size_t operator()( const ExpressionAst &ast ) const
+	{
+		return boost::apply_visitor( *this, ast.expr );
+	}
+
+	size_t operator()( const Nil &nil ) const
+	{
+		return addNode( CompiledExpression::Node() );
+	}
+
+	size_t operator()( const BinaryOp &expr ) const
+	{
+		CompiledExpression::Node node;
+		node.type = CompiledExpression::Node::Operation;
+		node.op = expr.op;
+		node.left = boost::apply_visitor( *this, expr.left.expr );
+		node.right = boost::apply_visitor( *this, expr.right.expr );
+		return addNode( node );
+	}
+
+	private :
+
+		size_t addNode( const CompiledExpression::Node &node ) const
+		{
+			m_compiled.nodes.push_back( node );
+			return m_compiled.nodes.size() - 1;
+		}
+
+		CompiledExpression &m_compiled;
+
+};
+
+ConstCompiledExpressionPtr compileExpression( const std::string &setExpression, size_t &cost, const IECore::Canceller *canceller )
+{
+	cost = 1;
+
+	ExpressionAst ast;
+	expressionToAST( setExpression, ast );
+
+	CompiledExpressionPtr result = new CompiledExpression;
+	AstCompiler compiler( *result );
+	compiler( ast );
+	return result;
+}
+
+using CompiledExpressionCache = IECorePreview::LRUCache<std::string, ConstCompiledExpressionPtr>;
+CompiledExpressionCache g_compiledExpressionCache( compileExpression, 10000 );
+
+// Evaluating PathMatcher operations
+// ---------------------------------
+
+PathMatcher applyOp( Op op, const PathMatcher &left, const PathMatcher &right )
+{
+	switch( op )
+	{
+		case Or :
+		{
+			PathMatcher result = PathMatcher( left );
+			result.addPaths( right );
+			return result;
+		}
+		case And :
+		{
+			return left.intersection( right );
+		}
+		case AndNot :
+		{
+			PathMatcher result = PathMatcher( left );
+			result.removePaths( right );
+			return result;
+		}
+		case In :
+		{
+			PathMatcher result;
+			for( PathMatcher::Iterator it = right.begin(), eIt = right.end(); it != eIt; ++it )
+			{
+				result.addPaths( left.subTree( *it ), *it );
+				it.prune();
+			}
+			return result;
+		}
+		case Containing :
+		{
+			PathMatcher result;
+			for( PathMatcher::Iterator it = left.begin(), eIt = left.end(); it != eIt; ++it )
+			{
+				if( right.match( *it ) & ( PathMatcher::ExactMatch | PathMatcher::DescendantMatch ) )
+				{
+					result.addPath( *it );
+				}
+			}
+			return result;
+		}
+		default :
+			return PathMatcher();
+	}
+}
+
+void appendChildNames( const PathMatcher &paths, std::vector<InternedString> &childNames )
+{
+	for( PathMatcher::RawIterator it = paths.begin(), eIt = paths.end(); it != eIt; ++it )
+	{
+		if( it->size() == 1 )
+		{
+			childNames.push_back( it->back() );
+			it.prune();
+		}
+	}
+}
+
+const std::vector<InternedString> g_root;
+
+// Equivalent to `applyOp()`, but applies the operation to each top-level
+// branch of the operands in parallel. All our operations are independent
+// between sibling branches, so the results can then be combined cheaply by
+// reference using `PathMatcher::addPaths( paths, prefix )`.
+PathMatcher parallelApplyOp( Op op, const PathMatcher &left, const PathMatcher &right )
+{
+	if( right.isEmpty() )
+	{
+		return op == Or || op == AndNot ? left : PathMatcher();
+	}
+	else if( left.isEmpty() )
+	{
+		return op == Or ? right : PathMatcher();
+	}
+
+	const bool leftRoot = left.match( g_root ) & PathMatcher::ExactMatch;
+	const bool rightRoot = right.match( g_root ) & PathMatcher::ExactMatch;
+
+	PathMatcher result;
+	bool resultRoot = false;
+	switch( op )
+	{
+		case Or :
+			resultRoot = leftRoot || rightRoot;
+			break;
+		case And :
+			resultRoot = leftRoot && rightRoot;
+			break;
+		case AndNot :
+			resultRoot = leftRoot && !rightRoot;
+			break;
+		case In :
+			if( rightRoot )
+			{
+				// Everything in `left` is in the root.
+				return left;
+			}
+			break;
+		case Containing :
+			resultRoot = leftRoot;
+			break;
+	}
+
+	if( resultRoot )
+	{
+		result.addPath( g_root );
+	}
+
+	// All operations except `Or` produce a subset of `left`, so
+	// we only need to visit the branches that exist there.
+	std::vector<InternedString> childNames;
+	appendChildNames( left, childNames );
+	if( op == Or )
+	{
+		appendChildNames( right, childNames );
+		std::sort( childNames.begin(), childNames.end() );
+		childNames.erase( std::unique( childNames.begin(), childNames.end() ), childNames.end() );
+	}
+
+	if( childNames.size() == 1 )
+	{
+		// Single branch. Recurse until we reach a location
+		// with enough children to be worth parallelising.
+		const std::vector<InternedString> childPath = { childNames[0] };
+		result.addPaths(
+			parallelApplyOp( op, left.subTree( childPath ), right.subTree( childPath ) ),
+			childPath
+		);
+		return result;
+	}
+
+	std::vector<PathMatcher> branchResults( childNames.size() );
+	tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+	tbb::parallel_for(
+		tbb::blocked_range<size_t>( 0, childNames.size() ),
+		[&]( const tbb::blocked_range<size_t> &r )
+		{
+			for( size_t i = r.begin(); i != r.end(); ++i )
+			{
+				const std::vector<InternedString> childPath = { childNames[i] };
+				branchResults[i] = applyOp( op, left.subTree( childPath ), right.subTree( childPath ) );
+			}
+		},
+		taskGroupContext
+	);
+
+	for( size_t i = 0; i < childNames.size(); ++i )
+	{
+		result.addPaths( branchResults[i], { childNames[i] } );
+	}
+
+	return result;
+}
+
+// Evaluating and hashing compiled expressions
+// -------------------------------------------
+
+class Evaluator;
+
+// Results for operations and wildcard set names are cached by hash, so that
+// subexpressions shared by different expressions (or by repeated evaluations
+// of the same expression) are computed only once.
+struct ResultCacheGetterKey
+{
+
+	ResultCacheGetterKey( const Evaluator *evaluator, size_t node, const IECore::MurmurHash &hash )
+		:	evaluator( evaluator ), node( node ), hash( hash )
+	{
+	}
+
+	operator const IECore::MurmurHash & () const
+	{
+		return hash;
+	}
+
+	const Evaluator *evaluator;
+	size_t node;
+	MurmurHash hash;
+
+};
+
+ConstPathMatcherDataPtr resultGetter( const ResultCacheGetterKey &key, size_t &cost, const IECore::Canceller *canceller );
+
+using ResultCache = IECorePreview::LRUCache<IECore::MurmurHash, ConstPathMatcherDataPtr, IECorePreview::LRUCachePolicy::TaskParallel, ResultCacheGetterKey>;
+// Costs are measured in bytes. The limit is generous enough to hold the
+// intermediate results for expressions over several very large sets.
+ResultCache g_resultCache( resultGetter, 250 * 1024 * 1024 );
+const bool g_resultCacheClearConnected = ( ValuePlug::cacheClearedSignal().connect( [] { g_resultCache.clear(); } ), true );
+
+class Evaluator
+{
+
+	public :
+
+		Evaluator( const CompiledExpression *compiled, const ScenePlug *scene )
+			:	m_compiled( compiled ), m_scene( scene )
+		{
+		}
+
+		PathMatcher evaluate()
+		{
+			const CompiledExpression::Node &root = m_compiled->nodes.back();
+			if( root.type == CompiledExpression::Node::Operation || root.type == CompiledExpression::Node::SetNameWildcard )
+			{
+				// We'll be using the cache, so need to compute
+				// the hashes for all our nodes up front.
+				computeHashes();
+			}
+			return evaluate( m_compiled->nodes.size() - 1 );
+		}
+
+		void hash( IECore::MurmurHash &h )
+		{
+			computeHashes();
+			const CompiledExpression::Node &root = m_compiled->nodes.back();
+			if( root.type != CompiledExpression::Node::Empty )
+			{
+				h.append( m_hashes.back() );
+			}
+		}
+
+		PathMatcher evaluate( size_t nodeIndex ) const
+		{
+			const CompiledExpression::Node &node = m_compiled->nodes[nodeIndex];
+			switch( node.type )
+			{
+				case CompiledExpression::Node::Empty :
+					return PathMatcher();
+				case CompiledExpression::Node::ObjectName :
+				{
+					if( StringAlgo::hasWildcards( node.identifier ) )
+					{
+						throw IECore::Exception( boost::str( boost::format( "Object name \"%1%\" contains wildcards" ) % node.identifier ) );
+					}
+					PathMatcher result;
+					result.addPath( node.identifier );
+					return result;
+				}
+				case CompiledExpression::Node::SetName :
+					return m_scene->set( node.identifier )->readable();
+				default :
+					return g_resultCache.get( ResultCacheGetterKey( this, nodeIndex, m_hashes[nodeIndex] ) )->readable();
+			}
+		}
+
+		PathMatcher compute( size_t nodeIndex ) const
+		{
+			const CompiledExpression::Node &node = m_compiled->nodes[nodeIndex];
+			if( node.type == CompiledExpression::Node::SetNameWildcard )
+			{
+				return computeSetNameWildcard( node.identifier );
+			}
+
+			assert( node.type == CompiledExpression::Node::Operation );
+
+			// Evaluate the operands in parallel, since they are independent.
+			PathMatcher left, right;
+			const ThreadState &threadState = ThreadState::current();
+			tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+			tbb::parallel_invoke(
+				[&] {
+					ThreadState::Scope scope( threadState );
+					left = evaluate( node.left );
+				},
+				[&] {
+					ThreadState::Scope scope( threadState );
+					right = evaluate( node.right );
+				},
+				taskGroupContext
+			);
+
+			return parallelApplyOp( node.op, left, right );
+		}
+
+	private :
+
+		void computeHashes()
+		{
+			if( m_hashes.size() )
+			{
+				return;
+			}
+
+			m_hashes.resize( m_compiled->nodes.size() );
+			for( size_t i = 0; i < m_hashes.size(); ++i )
+			{
+				const CompiledExpression::Node &node = m_compiled->nodes[i];
+				IECore::MurmurHash &h = m_hashes[i];
+				switch( node.type )
+				{
+					case CompiledExpression::Node::Empty :
+						break;
+					case CompiledExpression::Node::ObjectName :
+						h.append( node.identifier );
+						break;
+					case CompiledExpression::Node::SetName :
+						h.append( sceneForHashing()->setHash( node.identifier ) );
+						break;
+					case CompiledExpression::Node::SetNameWildcard :
+						hashSetNameWildcard( node.identifier, h );
+						break;
+					case CompiledExpression::Node::Operation :
+						h.append( node.op );
+						h.append( m_hashes[node.left] );
+						h.append( m_hashes[node.right] );
+						break;
+				}
+			}
+		}
+
+		const ScenePlug *sceneForHashing() const
+		{
+			if( !m_scene )
+			{
+				throw IECore::Exception( "SetAlgo: Invalid scene given. Can not hash set expression." );
+			}
+			return m_scene;
+		}
+
+		void hashSetNameWildcard( const std::string &identifier, IECore::MurmurHash &h ) const
+		{
+			h.append( (int)CompiledExpression::Node::SetNameWildcard );
+
+			IECore::ConstInternedStringVectorDataPtr setNamesData = sceneForHashing()->setNamesPlug()->getValue();
+			ScenePlug::SetScope setScope( Context::current() );
+			for( const IECore::InternedString &setName : setNamesData->readable() )
+			{
+				if( !StringAlgo::match( setName.string(), identifier ) )
+				{
+					continue;
+				}
+
+				setScope.setSetName( &setName );
+				h.append( m_scene->setPlug()->hash() );
+			}
+		}
+
+		PathMatcher computeSetNameWildcard( const std::string &identifier ) const
+		{
+			IECore::ConstInternedStringVectorDataPtr setNamesData = m_scene->setNamesPlug()->getValue();
+			std::vector<const IECore::InternedString *> setNames;
+			for( const IECore::InternedString &setName : setNamesData->readable() )
+			{
+				if( StringAlgo::match( setName.string(), identifier ) )
+				{
+					setNames.push_back( &setName );
+				}
+			}
+
+			// Sets are independent, so we compute them in parallel.
+			std::vector<ConstPathMatcherDataPtr> sets( setNames.size() );
+			const ThreadState &threadState = ThreadState::current();
+			tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+			tbb::parallel_for(
+				tbb::blocked_range<size_t>( 0, setNames.size() ),
+				[&]( const tbb::blocked_range<size_t> &r )
+				{
+					ScenePlug::SetScope setScope( threadState );
+					for( size_t i = r.begin(); i != r.end(); ++i )
+					{
+						setScope.setSetName( setNames[i] );
+						sets[i] = m_scene->setPlug()->getValue();
+					}
+				},
+				taskGroupContext
+			);
+
+			PathMatcher result;
+			for( const auto &set : sets )
+			{
+				result.addPaths( set->readable() );
+			}
+			return result;
+		}
+
+		const CompiledExpression *m_compiled;
+		const ScenePlug *m_scene;
+		std::vector<IECore::MurmurHash> m_hashes;
+
+};
+
+ConstPathMatcherDataPtr resultGetter( const ResultCacheGetterKey &key, size_t &cost, const IECore::Canceller *canceller )
+{
+	ConstPathMatcherDataPtr result = new PathMatcherData( key.evaluator->compute( key.node ) );
+	cost = result->memoryUsage();
+	return result;
+}
+
 } // namespace
 
 namespace GafferScene
@@ -519,20 +822,16 @@ namespace SetAlgo
 
 PathMatcher evaluateSetExpression( const std::string &setExpression, const ScenePlug *scene )
 {
-	ExpressionAst ast;
-	expressionToAST( setExpression, ast );
-
-	AstEvaluator eval( scene );
-	return eval( ast );
+	ConstCompiledExpressionPtr compiled = g_compiledExpressionCache.get( setExpression );
+	Evaluator evaluator( compiled.get(), scene );
+	return evaluator.evaluate();
 }
 
 void setExpressionHash( const std::string &setExpression, const ScenePlug* scene, IECore::MurmurHash &h )
 {
-	ExpressionAst ast;
-	expressionToAST( setExpression, ast );
-
-	AstHasher hasher = AstHasher( scene, h );
-	hasher(ast);
+	ConstCompiledExpressionPtr compiled = g_compiledExpressionCache.get( setExpression );
+	Evaluator evaluator( compiled.get(), scene );
+	evaluator.hash( h );
 }
 
 IECore::MurmurHash setExpressionHash( const std::string &setExpression, const ScenePlug* scene)
@@ -554,6 +853,16 @@ bool affectsSetExpression( const Plug *scenePlugChild )
 	return false;
 }
 
+size_t getCacheMemoryLimit()
+{
+	return g_resultCache.getMaxCost();
+}
+
+void setCacheMemoryLimit( size_t bytes )
+{
+	g_resultCache.setMaxCost( bytes );
+}
+
 } // namespace SetAlgo
 
 } // namespace Gaffer
@@ -42,6 +42,7 @@
 #include "GafferScene/AttributeQuery.h"
 
 #include "IECore/NullObject.h"
+#include "IECore/ObjectVector.h"
 
 #include "IECoreScene/ShaderNetwork.h"
 
@@ -57,6 +58,8 @@ namespace
 
 const size_t g_existsPlugIndex = 0;
 const size_t g_valuePlugIndex = 1;
+const size_t g_existsVectorPlugIndex = 2;
+const size_t g_valueVectorPlugIndex = 3;
 
 /// \todo: Can the next function be move to somewhere to be shared with `AttributeQuery`?
 
@@ -158,13 +161,25 @@ ShaderQuery::ShaderQuery( const std::string &name ) : Gaffer::ComputeNode( name
 	);
 	addChild( intermediateObjectPlug );
 
+	addChild( new StringVectorDataPlug( "locations", Plug::In, new StringVectorData() ) );
+
+	ObjectVectorPlugPtr intermediateObjectVectorPlug = new ObjectVectorPlug(
+		"__intermediateObjectVectorPlug",
+		Plug::In,
+		new ObjectVector(),
+		Plug::Default & ~Plug::Serialisable
+	);
+	addChild( intermediateObjectVectorPlug );
+
 	attributeQuery->scenePlug()->setInput( scenePlug() );
 	attributeQuery->locationPlug()->setInput( locationPlug() );
+	attributeQuery->locationsPlug()->setInput( locationsPlug() );
 	attributeQuery->attributePlug()->setInput( shaderPlug() );
 	attributeQuery->inheritPlug()->setInput( inheritPlug() );
 
 	attributeQuery->setup( intermediateObjectPlug.get() );
 	intermediateObjectPlug->setInput( attributeQuery->valuePlug() );
+	intermediateObjectVectorPlug->setInput( attributeQuery->valueVectorPlug() );
 }
 
 ShaderQuery::~ShaderQuery()
@@ -251,6 +266,26 @@ const ObjectPlug *ShaderQuery::intermediateObjectPlug() const
 	return getChild<ObjectPlug>( g_firstPlugIndex + 7 );
 }
 
+StringVectorDataPlug *ShaderQuery::locationsPlug()
+{
+	return getChild<StringVectorDataPlug>( g_firstPlugIndex + 8 );
+}
+
+const StringVectorDataPlug *ShaderQuery::locationsPlug() const
+{
+	return getChild<StringVectorDataPlug>( g_firstPlugIndex + 8 );
+}
+
+ObjectVectorPlug *ShaderQuery::intermediateObjectVectorPlug()
+{
+	return getChild<ObjectVectorPlug>( g_firstPlugIndex + 9 );
+}
+
+const ObjectVectorPlug *ShaderQuery::intermediateObjectVectorPlug() const
+{
+	return getChild<ObjectVectorPlug>( g_firstPlugIndex + 9 );
+}
+
 Gaffer::NameValuePlug *ShaderQuery::addQuery(
 	const Gaffer::ValuePlug *plug,
 	const std::string &parameter
@@ -273,6 +308,20 @@ Gaffer::NameValuePlug *ShaderQuery::addQuery(
 		)
 	);
 	newOutPlug->addChild( plug->createCounterpart( "value", Gaffer::Plug::Direction::Out ) );
+	newOutPlug->addChild(
+		new BoolVectorDataPlug(
+			"existsVector",
+			Gaffer::Plug::Direction::Out,
+			new BoolVectorData()
+		)
+	);
+	newOutPlug->addChild(
+		new ObjectVectorPlug(
+			"valueVector",
+			Gaffer::Plug::Direction::Out,
+			new ObjectVector()
+		)
+	);
 
 	outPlug()->addChild( newOutPlug );
 
@@ -297,7 +346,30 @@ void ShaderQuery::affects( const Gaffer::Plug *input, AffectedPlugsContainer &ou
 		input == intermediateObjectPlug()
 	)
 	{
-		addChildPlugsToAffectedOutputs( outPlug(), outputs );
+		for( const auto &oPlug : ValuePlug::Range( *outPlug() ) )
+		{
+			for( size_t i : { g_existsPlugIndex, g_valuePlugIndex } )
+			{
+				if( i < oPlug->children().size() )
+				{
+					addChildPlugsToAffectedOutputs( oPlug->getChild<Plug>( i ), outputs );
+				}
+			}
+		}
+	}
+
+	else if( input == intermediateObjectVectorPlug() )
+	{
+		for( const auto &oPlug : ValuePlug::Range( *outPlug() ) )
+		{
+			for( size_t i : { g_existsVectorPlugIndex, g_valueVectorPlugIndex } )
+			{
+				if( i < oPlug->children().size() )
+				{
+					outputs.push_back( oPlug->getChild<Plug>( i ) );
+				}
+			}
+		}
 	}
 
 	else if( queriesPlug()->isAncestorOf( input ) )
@@ -315,6 +387,8 @@ void ShaderQuery::affects( const Gaffer::Plug *input, AffectedPlugsContainer &ou
 			addChildPlugsToAffectedOutputs( vPlug, outputs );
 
 			outputs.push_back( existsPlugFromQuery( childQueryPlug ) );
+			outputs.push_back( existsVectorPlugFromQuery( childQueryPlug ) );
+			outputs.push_back( valueVectorPlugFromQuery( childQueryPlug ) );
 		}
 		else if( childQueryPlug->valuePlug() == input || childQueryPlug->valuePlug()->isAncestorOf( input ) )
 		{
@@ -359,6 +433,16 @@ void ShaderQuery::hash( const Gaffer::ValuePlug *output, const Gaffer::Context *
 				static_cast<const ValuePlug *>( childQueryPlug->valuePlug() )
 			)->hash( h );
 		}
+
+		else if(
+			output == oPlug->getChild( g_existsVectorPlugIndex ) ||
+			output == oPlug->getChild( g_valueVectorPlugIndex )
+		)
+		{
+			const NameValuePlug *childQueryPlug = queryPlug( output );
+			childQueryPlug->namePlug()->hash( h );
+			intermediateObjectVectorPlug()->hash( h );
+		}
 	}
 }
 
@@ -415,6 +499,53 @@ void ShaderQuery::compute( Gaffer::ValuePlug *output, const Gaffer::Context *con
 
 			return;
 		}
+
+		else if( output == oPlug->getChild( g_existsVectorPlugIndex ) )
+		{
+			const NameValuePlug *childQueryPlug = queryPlug( output );
+
+			const std::string parameterName = childQueryPlug->namePlug()->getValue();
+			const ConstObjectVectorPtr objects = intermediateObjectVectorPlug()->getValue();
+
+			BoolVectorDataPtr exists = new BoolVectorData();
+			exists->writable().reserve( objects->members().size() );
+			for( const auto &object : objects->members() )
+			{
+				exists->writable().push_back( parameterData( object.get(), parameterName ) != nullptr );
+			}
+
+			static_cast<BoolVectorDataPlug *>( output )->setValue( exists );
+
+			return;
+		}
+
+		else if( output == oPlug->getChild( g_valueVectorPlugIndex ) )
+		{
+			const NameValuePlug *childQueryPlug = queryPlug( output );
+
+			const std::string parameterName = childQueryPlug->namePlug()->getValue();
+			const ConstObjectVectorPtr objects = intermediateObjectVectorPlug()->getValue();
+
+			ObjectVectorPtr values = new ObjectVector();
+			values->members().reserve( objects->members().size() );
+			for( const auto &object : objects->members() )
+			{
+				if( const Data *data = parameterData( object.get(), parameterName ) )
+				{
+					// NOTE : The const_cast is OK because the result is stored on a
+					// plug, which will only provide const access to it.
+					values->members().push_back( const_cast<Data *>( data ) );
+				}
+				else
+				{
+					values->members().push_back( NullObject::defaultNullObject() );
+				}
+			}
+
+			static_cast<ObjectVectorPlug *>( output )->setValue( values );
+
+			return;
+		}
 	}
 
 	ComputeNode::compute( output, context );
@@ -480,6 +611,32 @@ const Gaffer::ValuePlug *ShaderQuery::valuePlugFromQuery( const Gaffer::NameValu
 	throw IECore::Exception( "ShaderQuery : \"value\" plug is missing." );
 }
 
+const Gaffer::BoolVectorDataPlug *ShaderQuery::existsVectorPlugFromQuery( const Gaffer::NameValuePlug *queryPlug ) const
+{
+	if( const ValuePlug *oPlug = outPlugFromQuery( queryPlug ) )
+	{
+		if( const auto result = oPlug->getChild<BoolVectorDataPlug>( g_existsVectorPlugIndex ) )
+		{
+			return result;
+		}
+	}
+
+	throw IECore::Exception( "ShaderQuery : \"existsVector\" plug is missing or of the wrong type." );
+}
+
+const Gaffer::ObjectVectorPlug *ShaderQuery::valueVectorPlugFromQuery( const Gaffer::NameValuePlug *queryPlug ) const
+{
+	if( const ValuePlug *oPlug = outPlugFromQuery( queryPlug ) )
+	{
+		if( const auto result = oPlug->getChild<ObjectVectorPlug>( g_valueVectorPlugIndex ) )
+		{
+			return result;
+		}
+	}
+
+	throw IECore::Exception( "ShaderQuery : \"valueVector\" plug is missing or of the wrong type." );
+}
+
 const Gaffer::ValuePlug *ShaderQuery::outPlugFromQuery( const Gaffer::NameValuePlug *queryPlug ) const
 {
 	size_t childIndex = getChildIndex( queriesPlug(), queryPlug );
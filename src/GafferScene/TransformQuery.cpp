@@ -36,6 +36,8 @@
 
 #include "GafferScene/TransformQuery.h"
 
+#include "GafferScene/Private/QueryAlgo.h"
+
 #include "OpenEXR/ImathMatrixAlgo.h"
 #include "OpenEXR/ImathEuler.h"
 
@@ -77,6 +79,93 @@ setV3fPlugComponentValue( Gaffer::V3fPlug const& parent, Gaffer::NumericPlug< fl
 	child.setValue( ensurePositiveZero( cv ) );
 }
 
+using Space = GafferScene::TransformQuery::Space;
+
+void matrixHash( GafferScene::ScenePlug const* const scene, GafferScene::ScenePlug::ScenePath const& path, Space const space, GafferScene::ScenePlug::ScenePath const* const relativePath, bool const invert, IECore::MurmurHash& h )
+{
+	if( ! scene->exists( path ) )
+	{
+		return;
+	}
+
+	switch( space )
+	{
+		case Space::Local:
+		{
+			if( invert )
+			{
+				h.append( scene->transformHash( path ) );
+			}
+			else
+			{
+				h = scene->transformHash( path );
+			}
+			break;
+		}
+		case Space::World:
+		{
+			h.append( scene->fullTransformHash( path ) );
+			h.append( invert );
+			break;
+		}
+		case Space::Relative:
+		{
+			if(
+				( relativePath != nullptr ) &&
+				( *relativePath != path ) &&
+				( scene->exists( *relativePath ) ) )
+			{
+				h.append( scene->fullTransformHash( path ) );
+				h.append( scene->fullTransformHash( *relativePath ) );
+				h.append( invert );
+			}
+			break;
+		}
+		default:
+			break;
+	}
+}
+
+Imath::M44f matrix( GafferScene::ScenePlug const* const scene, GafferScene::ScenePlug::ScenePath const& path, Space const space, GafferScene::ScenePlug::ScenePath const* const relativePath, bool const invert )
+{
+	Imath::M44f m;
+
+	if( ! scene->exists( path ) )
+	{
+		return m;
+	}
+
+	switch( space )
+	{
+		case Space::Local:
+			m = scene->transform( path );
+			break;
+		case Space::World:
+			m = scene->fullTransform( path );
+			break;
+		case Space::Relative:
+		{
+			if(
+				( relativePath != nullptr ) &&
+				( *relativePath != path ) &&
+				( scene->exists( *relativePath ) ) )
+			{
+				m = scene->fullTransform( path ) * scene->fullTransform( *relativePath ).inverse();
+			}
+			break;
+		}
+		default:
+			break;
+	}
+
+	if( invert )
+	{
+		m.invert();
+	}
+
+	return m;
+}
+
 } // namespace
 
 namespace GafferScene
@@ -101,6 +190,8 @@ TransformQuery::TransformQuery( std::string const& name )
 	addChild( new Gaffer::V3fPlug( "translate", Gaffer::Plug::Out ) );
 	addChild( new Gaffer::V3fPlug( "rotate", Gaffer::Plug::Out ) );
 	addChild( new Gaffer::V3fPlug( "scale", Gaffer::Plug::Out ) );
+	addChild( new Gaffer::StringVectorDataPlug( "locations", Gaffer::Plug::In, new IECore::StringVectorData() ) );
+	addChild( new Gaffer::M44fVectorDataPlug( "matrixVector", Gaffer::Plug::Out, new IECore::M44fVectorData() ) );
 }
 
 TransformQuery::~TransformQuery()
@@ -205,6 +296,28 @@ Gaffer::V3fPlug const* TransformQuery::scalePlug() const
 	return getChild< Gaffer::V3fPlug >( g_firstPlugIndex + 8 );
 }
 
+Gaffer::StringVectorDataPlug* TransformQuery::locationsPlug()
+{
+	return const_cast< Gaffer::StringVectorDataPlug* >(
+		static_cast< TransformQuery const* >( this )->locationsPlug() );
+}
+
+Gaffer::StringVectorDataPlug const* TransformQuery::locationsPlug() const
+{
+	return getChild< Gaffer::StringVectorDataPlug >( g_firstPlugIndex + 9 );
+}
+
+Gaffer::M44fVectorDataPlug* TransformQuery::matrixVectorPlug()
+{
+	return const_cast< Gaffer::M44fVectorDataPlug* >(
+		static_cast< TransformQuery const* >( this )->matrixVectorPlug() );
+}
+
+Gaffer::M44fVectorDataPlug const* TransformQuery::matrixVectorPlug() const
+{
+	return getChild< Gaffer::M44fVectorDataPlug >( g_firstPlugIndex + 10 );
+}
+
 void TransformQuery::affects( Gaffer::Plug const* const input, AffectedPlugsContainer& outputs ) const
 {
 	ComputeNode::affects( input, outputs );
@@ -224,12 +337,20 @@ void TransformQuery::affects( Gaffer::Plug const* const input, AffectedPlugsCont
 	else if(
 		( input == spacePlug() ) ||
 		( input == invertPlug() ) ||
-		( input == locationPlug() ) ||
 		( input == relativeLocationPlug() ) ||
 		( input == scenePlug()->existsPlug() ) ||
 		( input == scenePlug()->transformPlug() ) )
 	{
 		outputs.push_back( matrixPlug() );
+		outputs.push_back( matrixVectorPlug() );
+	}
+	else if( input == locationPlug() )
+	{
+		outputs.push_back( matrixPlug() );
+	}
+	else if( input == locationsPlug() )
+	{
+		outputs.push_back( matrixVectorPlug() );
 	}
 }
 
@@ -242,58 +363,30 @@ void TransformQuery::hash( Gaffer::ValuePlug const* const output, Gaffer::Contex
 		std::string const loc = locationPlug()->getValue();
 		if( ! loc.empty() )
 		{
-			ScenePlug const* const splug = scenePlug();
-			assert( splug != 0 );
+			std::string const rloc = relativeLocationPlug()->getValue();
+			ScenePlug::ScenePath const rpath = ScenePlug::stringToPath( rloc );
 
-			ScenePlug::ScenePath const path = ScenePlug::stringToPath( loc );
-
-			if( splug->exists( path ) )
-			{
-				switch( static_cast< Space >( spacePlug()->getValue() ) )
-				{
-					case Space::Local:
-					{
-						if( invertPlug()->getValue() )
-						{
-							h.append( splug->transformHash( path ) );
-						}
-						else
-						{
-							h = splug->transformHash( path );
-						}
-						break;
-					}
-					case Space::World:
-					{
-						h.append( splug->fullTransformHash( path ) );
-						h.append( invertPlug()->hash() );
-						break;
-					}
-					case Space::Relative:
-					{
-						std::string const rloc = relativeLocationPlug()->getValue();
-
-						if( ! rloc.empty() )
-						{
-							ScenePlug::ScenePath const rpath = ScenePlug::stringToPath( rloc );
-
-							if(
-								( rpath != path ) &&
-								( splug->exists( rpath ) ) )
-							{
-								h.append( splug->fullTransformHash( path ) );
-								h.append( splug->fullTransformHash( rpath ) );
-								invertPlug()->hash( h );
-							}
-						}
-						break;
-					}
-					default:
-						break;
-				}
-			}
+			matrixHash(
+				scenePlug(), ScenePlug::stringToPath( loc ), static_cast< Space >( spacePlug()->getValue() ),
+				rloc.empty() ? nullptr : & rpath, invertPlug()->getValue(), h
+			);
 		}
 	}
+	else if( output == matrixVectorPlug() )
+	{
+		IECore::ConstStringVectorDataPtr const locations = locationsPlug()->getValue();
+		Space const space = static_cast< Space >( spacePlug()->getValue() );
+		std::string const rloc = relativeLocationPlug()->getValue();
+		ScenePlug::ScenePath const rpath = ScenePlug::stringToPath( rloc );
+		bool const invert = invertPlug()->getValue();
+
+		h.append( Private::QueryAlgo::parallelLocationsHash(
+			locations->readable(),
+			[&] ( ScenePlug::ScenePath const& path, IECore::MurmurHash& locationHash ) {
+				matrixHash( scenePlug(), path, space, rloc.empty() ? nullptr : & rpath, invert, locationHash );
+			}
+		) );
+	}
 	else
 	{
 		Gaffer::GraphComponent const* const parent = output->parent();
@@ -317,51 +410,38 @@ void TransformQuery::compute( Gaffer::ValuePlug* const output, Gaffer::Context c
 		std::string const loc = locationPlug()->getValue();
 		if( ! loc.empty() )
 		{
-			ScenePlug const* const splug = scenePlug();
-			assert( splug != 0 );
-
-			ScenePlug::ScenePath const path = ScenePlug::stringToPath( loc );
+			std::string const rloc = relativeLocationPlug()->getValue();
+			ScenePlug::ScenePath const rpath = ScenePlug::stringToPath( rloc );
 
-			if( splug->exists( path ) )
-			{
-				switch( static_cast< Space >( spacePlug()->getValue() ) )
-				{
-					case Space::Local:
-						m = splug->transform( path );
-						break;
-					case Space::World:
-						m = splug->fullTransform( path );
-						break;
-					case Space::Relative:
-					{
-						std::string const rloc = relativeLocationPlug()->getValue();
-
-						if( ! rloc.empty() )
-						{
-							ScenePlug::ScenePath const rpath = ScenePlug::stringToPath( rloc );
-
-							if(
-								( rpath != path ) &&
-								( splug->exists( rpath ) ) )
-							{
-								m = splug->fullTransform( path ) * splug->fullTransform( rpath ).inverse();
-							}
-						}
-						break;
-					}
-					default:
-						break;
-				}
-
-				if( invertPlug()->getValue() )
-				{
-					m.invert();
-				}
-			}
+			m = matrix(
+				scenePlug(), ScenePlug::stringToPath( loc ), static_cast< Space >( spacePlug()->getValue() ),
+				rloc.empty() ? nullptr : & rpath, invertPlug()->getValue()
+			);
 		}
 
 		IECore::assertedStaticCast< Gaffer::M44fPlug >( output )->setValue( m );
 	}
+	else if( output == matrixVectorPlug() )
+	{
+		IECore::ConstStringVectorDataPtr const locations = locationsPlug()->getValue();
+		Space const space = static_cast< Space >( spacePlug()->getValue() );
+		std::string const rloc = relativeLocationPlug()->getValue();
+		ScenePlug::ScenePath const rpath = ScenePlug::stringToPath( rloc );
+		bool const invert = invertPlug()->getValue();
+
+		IECore::M44fVectorDataPtr const matrices = new IECore::M44fVectorData();
+		std::vector< Imath::M44f >& m = matrices->writable();
+		m.resize( locations->readable().size() );
+
+		Private::QueryAlgo::parallelForLocations(
+			locations->readable(),
+			[&] ( ScenePlug::ScenePath const& path, size_t i ) {
+				m[ i ] = matrix( scenePlug(), path, space, rloc.empty() ? nullptr : & rpath, invert );
+			}
+		);
+
+		IECore::assertedStaticCast< Gaffer::M44fVectorDataPlug >( output )->setValue( matrices );
+	}
 	else
 	{
 		Gaffer::GraphComponent* const parent = output->parent();
@@ -397,4 +477,24 @@ void TransformQuery::compute( Gaffer::ValuePlug* const output, Gaffer::Context c
 	ComputeNode::compute( output, context );
 }
 
+Gaffer::ValuePlug::CachePolicy TransformQuery::hashCachePolicy( Gaffer::ValuePlug const* const output ) const
+{
+	if( output == matrixVectorPlug() )
+	{
+		return Gaffer::ValuePlug::CachePolicy::TaskCollaboration;
+	}
+
+	return ComputeNode::hashCachePolicy( output );
+}
+
+Gaffer::ValuePlug::CachePolicy TransformQuery::computeCachePolicy( Gaffer::ValuePlug const* const output ) const
+{
+	if( output == matrixVectorPlug() )
+	{
+		return Gaffer::ValuePlug::CachePolicy::TaskCollaboration;
+	}
+
+	return ComputeNode::computeCachePolicy( output );
+}
+
 } // GafferScene
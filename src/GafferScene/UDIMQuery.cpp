@@ -43,6 +43,8 @@
 #include "IECore/StringAlgo.h"
 
 #include "tbb/concurrent_vector.h"
+#include "tbb/enumerable_thread_specific.h"
+#include "tbb/parallel_for.h"
 #include "boost/algorithm/string/replace.hpp"
 #include "boost/container/flat_set.hpp"
 
@@ -65,6 +67,7 @@ UDIMQuery::UDIMQuery( const std::string &name )
 	addChild( new StringPlug( "attributes", Plug::In, "" ) );
 	addChild( new FilterPlug( "filter" ) );
 	addChild( new CompoundObjectPlug( "out", Plug::Out, new IECore::CompoundObject(), Plug::Flags::Default ) );
+	addChild( new IntVectorDataPlug( "__udims", Plug::Out, new IntVectorData ) );
 }
 
 UDIMQuery::~UDIMQuery()
@@ -121,17 +124,36 @@ const Gaffer::CompoundObjectPlug *UDIMQuery::outPlug() const
 	return getChild<CompoundObjectPlug>( g_firstPlugIndex + 4 );
 }
 
+Gaffer::IntVectorDataPlug *UDIMQuery::udimsPlug()
+{
+	return getChild<IntVectorDataPlug>( g_firstPlugIndex + 5 );
+}
+
+const Gaffer::IntVectorDataPlug *UDIMQuery::udimsPlug() const
+{
+	return getChild<IntVectorDataPlug>( g_firstPlugIndex + 5 );
+}
+
 void UDIMQuery::affects( const Plug *input, AffectedPlugsContainer &outputs ) const
 {
 	ComputeNode::affects( input, outputs );
 
+	if(
+		input == uvSetPlug() ||
+		input == inPlug()->objectPlug()
+	)
+	{
+		outputs.push_back( udimsPlug() );
+	}
+
 	if(
 		input == uvSetPlug() ||
 		input == attributesPlug() ||
 		input == filterPlug() ||
 		input == inPlug()->objectPlug() ||
 		input == inPlug()->attributesPlug() ||
-		input == inPlug()->childNamesPlug()
+		input == inPlug()->childNamesPlug() ||
+		input == udimsPlug()
 	)
 	{
 		outputs.push_back( outPlug() );
@@ -181,102 +203,130 @@ void UDIMQuery::hash( const Gaffer::ValuePlug *output, const Gaffer::Context *co
 		GafferScene::SceneAlgo::filteredParallelTraverse( inPlug(), filterPlug(), f );
 		f.appendHash( h );
 	}
+	else if( output == udimsPlug() )
+	{
+		inPlug()->objectPlug()->hash( h );
+		uvSetPlug()->hash( h );
+	}
 }
 
 namespace {
 
-struct BakeInfoData
+// Returns the sorted UDIMs used by `meshPrimitive`, or null if it
+// doesn't have suitable UVs.
+IECore::IntVectorDataPtr meshUDIMs( const IECoreScene::MeshPrimitive *meshPrimitive, const std::string &uvSet, const IECore::Canceller *canceller )
 {
-	std::string mesh;
-	boost::container::flat_set<int> udims;
-	CompoundObjectPtr attributes;
-};
-
-struct InfoDataAccumulator
-{
-	InfoDataAccumulator( std::string uvSet, std::string attributeNames )
-		: m_uvSet( uvSet ), m_attributeNames( attributeNames )
+	// First check if there are face-varying UVs
+	bool faceVarying = true;
+	auto uvs = meshPrimitive->variableIndexedView<IECore::V2fVectorData>( uvSet,  IECoreScene::PrimitiveVariable::FaceVarying );
+	if( !uvs )
 	{
+		// Next check for vertex UVs
+		faceVarying = false;
+		uvs = meshPrimitive->variableIndexedView<IECore::V2fVectorData>( uvSet,  IECoreScene::PrimitiveVariable::Vertex );
 	}
 
-	bool operator()( const GafferScene::ScenePlug *in, const GafferScene::ScenePlug::ScenePath &path )
+	if( !uvs )
 	{
-		IECore::CompoundObjectPtr locationDict;
-
-		IECore::ConstObjectPtr object = in->objectPlug()->getValue();
-		const IECoreScene::MeshPrimitive *meshPrimitive = runTimeCast<const IECoreScene::MeshPrimitive>( object.get() );
-		if( !meshPrimitive )
-		{
-			return true;
-		}
-
-		// First check if there are face-varying UVs
-		bool faceVarying = true;
-		auto uvs = meshPrimitive->variableIndexedView<IECore::V2fVectorData>( m_uvSet,  IECoreScene::PrimitiveVariable::FaceVarying );
-		if( !uvs )
-		{
-			// Next check for vertex UVs
-			faceVarying = false;
-			uvs = meshPrimitive->variableIndexedView<IECore::V2fVectorData>( m_uvSet,  IECoreScene::PrimitiveVariable::Vertex );
-		}
-
-		if( !uvs )
-		{
-			// No face-varying or vertex UVs
-			return true;
-		}
+		// No face-varying or vertex UVs
+		return nullptr;
+	}
 
-		std::string pathString;
-		ScenePlug::pathToString( path, pathString );
-		unsigned int targetSize = meshPrimitive->variableSize( faceVarying ? IECoreScene::PrimitiveVariable::FaceVarying : IECoreScene::PrimitiveVariable::Vertex );
-		if( uvs->size() != targetSize )
+	unsigned int targetSize = meshPrimitive->variableSize( faceVarying ? IECoreScene::PrimitiveVariable::FaceVarying : IECoreScene::PrimitiveVariable::Vertex );
+	if( uvs->size() != targetSize )
+	{
+		std::string pathString = "<unknown>";
+		if( const auto path = Context::current()->getIfExists<ScenePlug::ScenePath>( ScenePlug::scenePathContextName ) )
 		{
-			throw IECore::Exception(
-				boost::str(
-					boost::format(
-						"Cannot query UDIMs.  Bad uvs at location %s.  Required count %i but found %i."
-					) % pathString % targetSize % uvs->size()
-				)
-			);
+			ScenePlug::pathToString( *path, pathString );
 		}
+		throw IECore::Exception(
+			boost::str(
+				boost::format(
+					"Cannot query UDIMs.  Bad uvs at location %s.  Required count %i but found %i."
+				) % pathString % targetSize % uvs->size()
+			)
+		);
+	}
 
-		const IntVectorData *vertsPerFaceData = meshPrimitive->verticesPerFace();
-		const std::vector<int> &vertsPerFace = vertsPerFaceData->readable();
+	const std::vector<int> &vertsPerFace = meshPrimitive->verticesPerFace()->readable();
+	const std::vector<int> &vertexIds = meshPrimitive->vertexIds()->readable();
 
-		BakeInfoData &info = *m_data.grow_by( 1 );
-		info.mesh = pathString;
+	std::vector<int> faceOffsets;
+	faceOffsets.reserve( vertsPerFace.size() );
+	int offset = 0;
+	for( int numVerts : vertsPerFace )
+	{
+		faceOffsets.push_back( offset );
+		offset += numVerts;
+	}
 
-		// We check the center UVs of each face, because the edge uvs could lie directly on a UDIM boundary,
-		// and without checking adjacency information, it would be impossible to tell which UDIM the edge
-		// belongs to.  Checking face centers is fairly simple, and is completely accurate except in extreme
-		// cases of polygons spanning multiple UDIMs, which is not done according to UDIM conventions.
-		int faceVertId = 0;
-		for( int numVerts : vertsPerFace )
-		{
-			Imath::V2f accum = Imath::V2f(0);
-			if( faceVarying )
+	// We check the center UVs of each face, because the edge uvs could lie directly on a UDIM boundary,
+	// and without checking adjacency information, it would be impossible to tell which UDIM the edge
+	// belongs to.  Checking face centers is fairly simple, and is completely accurate except in extreme
+	// cases of polygons spanning multiple UDIMs, which is not done according to UDIM conventions.
+
+	using UDIMSet = boost::container::flat_set<int>;
+	tbb::enumerable_thread_specific<UDIMSet> threadUDIMs;
+
+	tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+	tbb::parallel_for(
+		tbb::blocked_range<size_t>( 0, vertsPerFace.size(), 10000 ),
+		[&]( const tbb::blocked_range<size_t> &range ) {
+			IECore::Canceller::check( canceller );
+			UDIMSet &udims = threadUDIMs.local();
+			for( size_t face = range.begin(); face != range.end(); ++face )
 			{
+				const int numVerts = vertsPerFace[face];
+				int faceVertId = faceOffsets[face];
+				Imath::V2f accum = Imath::V2f(0);
 				for( int i = 0; i < numVerts; i++ )
 				{
-					accum += (*uvs)[faceVertId];
+					accum += faceVarying ? (*uvs)[faceVertId] : (*uvs)[vertexIds[faceVertId]];
 					faceVertId++;
 				}
+				Imath::V2f centerUV = accum / numVerts;
+				udims.insert( 1001 + int( floor( centerUV[0] ) ) + 10 * int( floor( centerUV[1] ) ) );
 			}
-			else
-			{
-				for( int i = 0; i < numVerts; i++ )
-				{
-					accum += (*uvs)[ meshPrimitive->vertexIds()->readable()[faceVertId] ];
-					faceVertId++;
-				}
-			}
-			Imath::V2f centerUV = accum / numVerts;
-			int udim = 1001 + int( floor( centerUV[0] ) ) + 10 * int( floor( centerUV[1] ) );
+		},
+		taskGroupContext
+	);
+
+	UDIMSet udims;
+	for( const auto &u : threadUDIMs )
+	{
+		udims.insert( u.begin(), u.end() );
+	}
+
+	IntVectorDataPtr result = new IntVectorData;
+	result->writable().assign( udims.begin(), udims.end() );
+	return result;
+}
 
-			info.udims.insert( udim );
+// Accumulates a partial result per thread, mapping from UDIM to the
+// meshes using it. These are merged once the traversal is complete.
+using UDIMMap = std::map<int, CompoundObjectPtr>;
+
+struct InfoDataAccumulator
+{
+	InfoDataAccumulator( const IntVectorDataPlug *udimsPlug, std::string attributeNames )
+		: m_udimsPlug( udimsPlug ), m_attributeNames( attributeNames )
+	{
+	}
+
+	bool operator()( const GafferScene::ScenePlug *in, const GafferScene::ScenePlug::ScenePath &path )
+	{
+		ConstIntVectorDataPtr udimsData = m_udimsPlug->getValue();
+		const std::vector<int> &udims = udimsData->readable();
+		if( udims.empty() )
+		{
+			return true;
 		}
 
-		info.attributes = new CompoundObject();
+		std::string pathString;
+		ScenePlug::pathToString( path, pathString );
+
+		CompoundObjectPtr attributes = new CompoundObject();
 		if( m_attributeNames.size() )
 		{
 			IECore::ConstCompoundObjectPtr inAttributes = in->fullAttributes( path );
@@ -284,17 +334,28 @@ struct InfoDataAccumulator
 			{
 				if( StringAlgo::matchMultiple( i.first, m_attributeNames ) )
 				{
-					info.attributes->members()[ i.first ] = i.second;
+					attributes->members()[ i.first ] = i.second;
 				}
 			}
 		}
 
+		UDIMMap &udimMap = m_udimMaps.local();
+		for( int udim : udims )
+		{
+			CompoundObjectPtr &udimEntry = udimMap[udim];
+			if( !udimEntry )
+			{
+				udimEntry = new CompoundObject;
+			}
+			udimEntry->members()[pathString] = attributes;
+		}
+
 		return true;
 	}
 
-	std::string m_uvSet;
+	const IntVectorDataPlug *m_udimsPlug;
 	IECore::StringAlgo::MatchPattern m_attributeNames;
-	tbb::concurrent_vector< BakeInfoData > m_data;
+	tbb::enumerable_thread_specific<UDIMMap> m_udimMaps;
 };
 
 } // namespace
@@ -303,27 +364,39 @@ void UDIMQuery::compute( Gaffer::ValuePlug *output, const Gaffer::Context *conte
 {
 	if( output == outPlug() )
 	{
-		InfoDataAccumulator f( uvSetPlug()->getValue(), attributesPlug()->getValue() );
+		InfoDataAccumulator f( udimsPlug(), attributesPlug()->getValue() );
 		GafferScene::SceneAlgo::filteredParallelTraverse( inPlug(), filterPlug(), f );
 
 		IECore::CompoundObjectPtr result = new IECore::CompoundObject();
 
-		for( const auto &i : f.m_data )
+		for( auto &udimMap : f.m_udimMaps )
 		{
-			for( int udim : i.udims )
+			for( auto &udim : udimMap )
 			{
-				std::string udimStr = std::to_string( udim );
-
-				CompoundObjectPtr udimEntry = result->member<CompoundObject>(
-					udimStr, /* throwExceptions = */ false, /* createIfMissing = */ true
-				);
-
-				// Result treated as const anyway, so this is safe.
-				udimEntry->members()[i.mesh] = const_cast<CompoundObject*>( i.attributes.get() );
+				ObjectPtr &udimEntry = result->members()[std::to_string( udim.first )];
+				if( !udimEntry )
+				{
+					udimEntry = udim.second;
+				}
+				else
+				{
+					const CompoundObject::ObjectMap &meshes = udim.second->members();
+					static_cast<CompoundObject *>( udimEntry.get() )->members().insert( meshes.begin(), meshes.end() );
+				}
 			}
 		}
 		static_cast<CompoundObjectPlug *>( output )->setValue( result );
 	}
+	else if( output == udimsPlug() )
+	{
+		IntVectorDataPtr result;
+		ConstObjectPtr object = inPlug()->objectPlug()->getValue();
+		if( auto meshPrimitive = runTimeCast<const MeshPrimitive>( object.get() ) )
+		{
+			result = meshUDIMs( meshPrimitive, uvSetPlug()->getValue(), context->canceller() );
+		}
+		static_cast<IntVectorDataPlug *>( output )->setValue( result ? result : udimsPlug()->defaultValue() );
+	}
 	else
 	{
 		ComputeNode::compute( output, context );
@@ -332,7 +405,7 @@ void UDIMQuery::compute( Gaffer::ValuePlug *output, const Gaffer::Context *conte
 
 Gaffer::ValuePlug::CachePolicy UDIMQuery::computeCachePolicy( const Gaffer::ValuePlug *output ) const
 {
-	if( output == outPlug() )
+	if( output == outPlug() || output == udimsPlug() )
 	{
 		return ValuePlug::CachePolicy::TaskCollaboration;
 	}
@@ -43,9 +43,9 @@
 
 #include "IECore/DataAlgo.h"
 
-#include "boost/functional/hash.hpp"
-
-#include <unordered_set>
+#include "tbb/parallel_for.h"
+#include "tbb/parallel_scan.h"
+#include "tbb/parallel_sort.h"
 
 using namespace std;
 using namespace Imath;
@@ -64,17 +64,17 @@ namespace
 struct MakeWireframe
 {
 
-	CurvesPrimitivePtr operator() ( const V2fVectorData *data, const MeshPrimitive *mesh, const string &name, const PrimitiveVariable &primitiveVariable )
+	CurvesPrimitivePtr operator() ( const V2fVectorData *data, const MeshPrimitive *mesh, const string &name, const PrimitiveVariable &primitiveVariable, const Canceller *canceller )
 	{
-		return makeWireframe<V2fVectorData>( data, mesh, name, primitiveVariable );
+		return makeWireframe<V2fVectorData>( data, mesh, name, primitiveVariable, canceller );
 	}
 
-	CurvesPrimitivePtr operator() ( const V3fVectorData *data, const MeshPrimitive *mesh, const string &name, const PrimitiveVariable &primitiveVariable )
+	CurvesPrimitivePtr operator() ( const V3fVectorData *data, const MeshPrimitive *mesh, const string &name, const PrimitiveVariable &primitiveVariable, const Canceller *canceller )
 	{
-		return makeWireframe<V3fVectorData>( data, mesh, name, primitiveVariable );
+		return makeWireframe<V3fVectorData>( data, mesh, name, primitiveVariable, canceller );
 	}
 
-	CurvesPrimitivePtr operator() ( const Data *data, const MeshPrimitive *mesh, const string &name, const PrimitiveVariable &primitiveVariable )
+	CurvesPrimitivePtr operator() ( const Data *data, const MeshPrimitive *mesh, const string &name, const PrimitiveVariable &primitiveVariable, const Canceller *canceller )
 	{
 		throw IECore::Exception( boost::str(
 			boost::format( "PrimitiveVariable \"%1%\" has unsupported type \"%2%\"" ) % name % data->typeName()
@@ -83,8 +83,22 @@ struct MakeWireframe
 
 	private :
 
+		// An occurrence of an edge within a face. The key encodes the
+		// two vertex indices, with the lowest first, so that the same
+		// edge has the same key in every face that uses it.
+		struct EdgeOccurrence
+		{
+			uint64_t key;
+			uint32_t faceVertex;
+
+			bool operator < ( const EdgeOccurrence &rhs ) const
+			{
+				return key < rhs.key || ( key == rhs.key && faceVertex < rhs.faceVertex );
+			}
+		};
+
 		template<typename T>
-		CurvesPrimitivePtr makeWireframe( const T *data, const MeshPrimitive *mesh, const string &name, const PrimitiveVariable &primitiveVariable )
+		CurvesPrimitivePtr makeWireframe( const T *data, const MeshPrimitive *mesh, const string &name, const PrimitiveVariable &primitiveVariable, const Canceller *canceller )
 		{
 			using Vec = typename T::ValueType::value_type;
 			using DataView = PrimitiveVariable::IndexedView<Vec>;
@@ -108,47 +122,124 @@ struct MakeWireframe
 					) );
 			}
 
-			IECore::V3fVectorDataPtr pData = new V3fVectorData;
-			pData->setInterpretation( GeometricData::Point );
-			vector<V3f> &p = pData->writable();
-			// We don't know upfront how many edges we will generate.
-			// `mesh->variableSize( PrimitiveVariable::FaceVarying )` gives us
-			// an upper bound, but edges can be shared by faces in which case
-			// we only add the edge once. For a fully closed mesh without border
-			// edges, we will only generate half of the edges from this upper bound.
-			// (For non-manifold meshes we could generate even fewer, but we assume
-			// we will not be given those).
-			const size_t minExpectedEdges = mesh->variableSize( PrimitiveVariable::FaceVarying ) / 2;
-			// Each edge we add will add 2 points to `p`.
-			p.reserve( minExpectedEdges * 2 );
-
-			using Edge = std::pair<int, int>;
-			using EdgeSet = unordered_set<Edge, boost::hash<Edge>>;
-			EdgeSet edgesVisited;
-			edgesVisited.reserve( mesh->variableSize( PrimitiveVariable::FaceVarying ) );
-
-			int vertexIdsIndex = 0;
-			for( int numVertices : mesh->verticesPerFace()->readable() )
+			// We output each edge only once, even if it is shared by several faces,
+			// and in the order in which the edges are first visited. For this we
+			// need to identify the first occurrence of each edge, which we do in
+			// parallel by sorting all occurrences by edge and position. A prefix sum
+			// over the first occurrences then gives the output position of each edge.
+
+			const vector<int> &verticesPerFace = mesh->verticesPerFace()->readable();
+			const size_t numFaceVertices = mesh->variableSize( PrimitiveVariable::FaceVarying );
+
+			vector<uint32_t> faceOffsets( verticesPerFace.size() );
+			uint32_t faceOffset = 0;
+			for( size_t i = 0; i < verticesPerFace.size(); ++i )
 			{
-				for( int i = 0; i < numVertices; ++i )
+				faceOffsets[i] = faceOffset;
+				faceOffset += verticesPerFace[i];
+			}
+
+			auto edgeIndices = [&] ( size_t face, int i ) {
+				const int numVertices = verticesPerFace[face];
+				int index0 = faceOffsets[face] + i;
+				int index1 = faceOffsets[face] + ( i + 1 ) % numVertices;
+				if( vertexIds )
 				{
-					int index0 = vertexIdsIndex + i;
-					int index1 = vertexIdsIndex + (i + 1) % numVertices;
-					if( vertexIds )
+					index0 = (*vertexIds)[index0];
+					index1 = (*vertexIds)[index1];
+				}
+				return std::make_pair( index0, index1 );
+			};
+
+			using FaceRange = tbb::blocked_range<size_t>;
+			tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+
+			vector<char> firstOccurrence( numFaceVertices, 0 );
+			{
+				vector<EdgeOccurrence> occurrences( numFaceVertices );
+				tbb::parallel_for(
+					FaceRange( 0, verticesPerFace.size() ),
+					[&] ( const FaceRange &range ) {
+						Canceller::check( canceller );
+						for( size_t face = range.begin(); face != range.end(); ++face )
+						{
+							for( int i = 0; i < verticesPerFace[face]; ++i )
+							{
+								const auto indices = edgeIndices( face, i );
+								const uint32_t faceVertex = faceOffsets[face] + i;
+								occurrences[faceVertex] = {
+									( uint64_t( min( indices.first, indices.second ) ) << 32 ) | uint32_t( max( indices.first, indices.second ) ),
+									faceVertex
+								};
+							}
+						}
+					},
+					taskGroupContext
+				);
+
+				Canceller::check( canceller );
+				tbb::parallel_sort( occurrences.begin(), occurrences.end() );
+
+				tbb::parallel_for(
+					tbb::blocked_range<size_t>( 0, occurrences.size() ),
+					[&] ( const tbb::blocked_range<size_t> &range ) {
+						for( size_t i = range.begin(); i != range.end(); ++i )
+						{
+							if( i == 0 || occurrences[i].key != occurrences[i-1].key )
+							{
+								firstOccurrence[occurrences[i].faceVertex] = 1;
+							}
+						}
+					},
+					taskGroupContext
+				);
+			}
+
+			Canceller::check( canceller );
+			vector<uint32_t> outputEdge( numFaceVertices );
+			const size_t numEdges = tbb::parallel_scan(
+				tbb::blocked_range<size_t>( 0, numFaceVertices ),
+				size_t( 0 ),
+				[&] ( const tbb::blocked_range<size_t> &range, size_t sum, bool isFinalScan ) {
+					for( size_t i = range.begin(); i != range.end(); ++i )
 					{
-						index0 = (*vertexIds)[index0];
-						index1 = (*vertexIds)[index1];
+						if( isFinalScan )
+						{
+							outputEdge[i] = sum;
+						}
+						sum += firstOccurrence[i];
 					}
+					return sum;
+				},
+				std::plus<size_t>()
+			);
+
+			IECore::V3fVectorDataPtr pData = new V3fVectorData;
+			pData->setInterpretation( GeometricData::Point );
+			vector<V3f> &p = pData->writable();
+			p.resize( numEdges * 2 );
 
-					Edge edge( min( index0, index1 ), max( index0, index1 ) );
-					if( edgesVisited.insert( edge ).second )
+			tbb::parallel_for(
+				FaceRange( 0, verticesPerFace.size() ),
+				[&] ( const FaceRange &range ) {
+					Canceller::check( canceller );
+					for( size_t face = range.begin(); face != range.end(); ++face )
 					{
-						p.push_back( v3f( dataView[index0] ) );
-						p.push_back( v3f( dataView[index1] ) );
+						for( int i = 0; i < verticesPerFace[face]; ++i )
+						{
+							const uint32_t faceVertex = faceOffsets[face] + i;
+							if( firstOccurrence[faceVertex] )
+							{
+								const auto indices = edgeIndices( face, i );
+								V3f *edgeP = p.data() + outputEdge[faceVertex] * 2;
+								edgeP[0] = v3f( dataView[indices.first] );
+								edgeP[1] = v3f( dataView[indices.second] );
+							}
+						}
 					}
-				}
-				vertexIdsIndex += numVertices;
-			}
+				},
+				taskGroupContext
+			);
 
 			IECore::IntVectorDataPtr vertsPerCurveData = new IntVectorData;
 			vertsPerCurveData->writable().resize( p.size() / 2, 2 );
@@ -171,7 +262,7 @@ struct MakeWireframe
 };
 
 /// \todo Perhaps this could go in IECoreScene::MeshAlgo
-CurvesPrimitivePtr wireframe( const MeshPrimitive *mesh, const std::string &position )
+CurvesPrimitivePtr wireframe( const MeshPrimitive *mesh, const std::string &position, const Canceller *canceller )
 {
 	auto it = mesh->variables.find( position );
 	if( it == mesh->variables.end() )
@@ -181,7 +272,7 @@ CurvesPrimitivePtr wireframe( const MeshPrimitive *mesh, const std::string &posi
 		) );
 	}
 
-	CurvesPrimitivePtr result = dispatch( it->second.data.get(), MakeWireframe(), mesh, it->first, it->second );
+	CurvesPrimitivePtr result = dispatch( it->second.data.get(), MakeWireframe(), mesh, it->first, it->second, canceller );
 	return result;
 }
 
@@ -250,7 +341,7 @@ IECore::ConstObjectPtr Wireframe::computeProcessedObject( const ScenePath &path,
 		return inputObject;
 	}
 
-	CurvesPrimitivePtr result = wireframe( mesh, positionPlug()->getValue() );
+	CurvesPrimitivePtr result = wireframe( mesh, positionPlug()->getValue(), context->canceller() );
 	for( const auto &pv : mesh->variables )
 	{
 		if( pv.second.interpolation == PrimitiveVariable::Constant )
@@ -264,6 +355,11 @@ IECore::ConstObjectPtr Wireframe::computeProcessedObject( const ScenePath &path,
 	return result;
 }
 
+Gaffer::ValuePlug::CachePolicy Wireframe::processedObjectComputeCachePolicy() const
+{
+	return ValuePlug::CachePolicy::TaskCollaboration;
+}
+
 bool Wireframe::adjustBounds() const
 {
 	if( !Deformer::adjustBounds() )
@@ -47,6 +47,7 @@
 #include "GafferScene/DeleteAttributes.h"
 #include "GafferScene/LocaliseAttributes.h"
 #include "GafferScene/OpenGLAttributes.h"
+#include "GafferScene/Private/AttributeInterning.h"
 #include "GafferScene/SetVisualiser.h"
 #include "GafferScene/ShaderAssignment.h"
 #include "GafferScene/ShuffleAttributes.h"
@@ -83,4 +84,27 @@ void GafferSceneModule::bindAttributes()
 			.value( "ShaderNodeColor", AttributeVisualiser::ShaderNodeColor )
 		;
 	}
+
+	{
+		object privateModule( borrowed( PyImport_AddModule( "GafferScene.Private" ) ) );
+		scope().attr( "Private" ) = privateModule;
+
+		object attributeInterningModule( borrowed( PyImport_AddModule( "GafferScene.Private.AttributeInterning" ) ) );
+		scope().attr( "Private" ).attr( "AttributeInterning" ) = attributeInterningModule;
+
+		scope attributeInterningScope( attributeInterningModule );
+
+		using Statistics = GafferScene::Private::AttributeInterning::Statistics;
+		class_<Statistics>( "Statistics" )
+			.def_readonly( "internedObjects", &Statistics::internedObjects )
+			.def_readonly( "sharedObjects", &Statistics::sharedObjects )
+			.def_readonly( "memorySaved", &Statistics::memorySaved )
+		;
+
+		def( "statistics", &GafferScene::Private::AttributeInterning::statistics );
+		def( "resetStatistics", &GafferScene::Private::AttributeInterning::resetStatistics );
+		def( "clear", &GafferScene::Private::AttributeInterning::clear );
+		def( "getMemoryLimit", &GafferScene::Private::AttributeInterning::getMemoryLimit );
+		def( "setMemoryLimit", &GafferScene::Private::AttributeInterning::setMemoryLimit );
+	}
 }
@@ -385,6 +385,11 @@ void GafferSceneModule::bindCore()
 		.staticmethod( "stringToPath" )
 		.def( "pathToString", &pathToStringWrapper )
 		.staticmethod( "pathToString" )
+		// cache management
+		.def( "getFullAttributesCacheMemoryLimit", &ScenePlug::getFullAttributesCacheMemoryLimit )
+		.staticmethod( "getFullAttributesCacheMemoryLimit" )
+		.def( "setFullAttributesCacheMemoryLimit", &ScenePlug::setFullAttributesCacheMemoryLimit )
+		.staticmethod( "setFullAttributesCacheMemoryLimit" )
 	;
 
 	ScenePathFromInternedStringVectorData();
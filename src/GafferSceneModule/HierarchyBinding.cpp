@@ -43,6 +43,7 @@
 #include "GafferScene/Duplicate.h"
 #include "GafferScene/Encapsulate.h"
 #include "GafferScene/Group.h"
+#include "GafferScene/InstanceArray.h"
 #include "GafferScene/Instancer.h"
 #include "GafferScene/Isolate.h"
 #include "GafferScene/MergeScenes.h"
@@ -82,6 +83,38 @@ ContextPtr context( const Capsule &c )
 	return const_cast<Context *>( c.context() );
 }
 
+ScenePlugPtr prototypes( const InstanceArray &a )
+{
+	return const_cast<ScenePlug *>( a.prototypes() );
+}
+
+std::string prototypeRoot( const InstanceArray &a )
+{
+	std::string result;
+	ScenePlug::pathToString( a.prototypeRoot(), result );
+	return result;
+}
+
+IECore::InternedStringVectorDataPtr names( const InstanceArray &a )
+{
+	return a.names()->copy();
+}
+
+IECore::M44fVectorDataPtr transforms( const InstanceArray &a )
+{
+	return a.transforms()->copy();
+}
+
+IECore::UInt64VectorDataPtr attributeIndices( const InstanceArray &a )
+{
+	return a.attributeIndices() ? a.attributeIndices()->copy() : nullptr;
+}
+
+IECore::CompoundDataPtr attributes( const InstanceArray &a )
+{
+	return a.attributes() ? a.attributes()->copy() : nullptr;
+}
+
 } // namespace
 
 void GafferSceneModule::bindHierarchy()
@@ -102,6 +135,16 @@ void GafferSceneModule::bindHierarchy()
 		.def( "context", &context )
 	;
 
+	IECorePython::RunTimeTypedClass<InstanceArray>()
+		.def( "numInstances", &InstanceArray::numInstances )
+		.def( "prototypes", &prototypes )
+		.def( "prototypeRoot", &prototypeRoot )
+		.def( "names", &names )
+		.def( "transforms", &transforms )
+		.def( "attributeIndices", &attributeIndices )
+		.def( "attributes", &attributes )
+	;
+
 	GafferBindings::DependencyNodeClass<Group>()
 		.def( "nextInPlug", (ScenePlug *(Group::*)())&Group::nextInPlug, return_value_policy<CastToIntrusivePtr>() )
 	;
@@ -72,6 +72,10 @@ void GafferSceneModule::bindIO()
 	GafferBindings::DependencyNodeClass<SceneReader>()
 		.def( "supportedExtensions", &supportedExtensions )
 		.staticmethod( "supportedExtensions" )
+		.def( "getPrefetchCacheMemoryLimit", &SceneReader::getPrefetchCacheMemoryLimit )
+		.staticmethod( "getPrefetchCacheMemoryLimit" )
+		.def( "setPrefetchCacheMemoryLimit", &SceneReader::setPrefetchCacheMemoryLimit )
+		.staticmethod( "setPrefetchCacheMemoryLimit" )
 	;
 
 	using SceneWriterWrapper = GafferDispatchBindings::TaskNodeWrapper<SceneWriter>;
@@ -134,6 +134,16 @@ const ValuePlugPtr outPlugFromQuery( const GafferScene::ShaderQuery &q, const Na
 	return const_cast<ValuePlug *>( q.outPlugFromQuery( &p ) );
 }
 
+const BoolVectorDataPlugPtr existsVectorPlugFromQuery( const GafferScene::ShaderQuery &q, const NameValuePlug &p )
+{
+	return const_cast<BoolVectorDataPlug *>( q.existsVectorPlugFromQuery( &p ) );
+}
+
+const ObjectVectorPlugPtr valueVectorPlugFromQuery( const GafferScene::ShaderQuery &q, const NameValuePlug &p )
+{
+	return const_cast<ObjectVectorPlug *>( q.valueVectorPlugFromQuery( &p ) );
+}
+
 const NameValuePlugPtr queryPlug( const GafferScene::ShaderQuery &q, const ValuePlug &p )
 {
 	return const_cast<NameValuePlug *>( q.queryPlug( &p ) );
@@ -179,6 +189,8 @@ void GafferSceneModule::bindQueries()
 		.def( "existsPlugFromQuery", &existsPlugFromQuery )
 		.def( "valuePlugFromQuery", &valuePlugFromQuery )
 		.def( "outPlugFromQuery", &outPlugFromQuery )
+		.def( "existsVectorPlugFromQuery", &existsVectorPlugFromQuery )
+		.def( "valueVectorPlugFromQuery", &valueVectorPlugFromQuery )
 		.def( "queryPlug", &queryPlug )
 	;
 
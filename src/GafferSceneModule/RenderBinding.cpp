@@ -405,6 +405,8 @@ void GafferSceneModule::bindRender()
 			scope rendererAlgomoduleScope( rendererAlgoModule );
 
 			def( "objectSamples", &objectSamplesWrapper, ( arg( "objectPlug" ), arg( "sampleTimes" ), arg( "_copy" ) = true ) );
+			def( "collapsedMotionSamples", &GafferScene::Private::RendererAlgo::collapsedMotionSamples );
+			def( "resetCollapsedMotionSamples", &GafferScene::Private::RendererAlgo::resetCollapsedMotionSamples );
 
 			class_<GafferScene::Private::RendererAlgo::RenderSets, boost::noncopyable>( "RenderSets" )
 				.def( init<const ScenePlug *>() )
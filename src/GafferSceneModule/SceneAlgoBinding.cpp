@@ -265,6 +265,18 @@ IECore::PathMatcher linkedLightsWrapper2( const GafferScene::ScenePlug &scene, c
 	return SceneAlgo::linkedLights( &scene, objects );
 }
 
+IECore::PathMatcher findInFrustumWrapper( const GafferScene::ScenePlug &scene, const Imath::Frustumf &frustum, const Imath::M44f &cameraTransform, const ScenePlug::ScenePath &root )
+{
+	IECorePython::ScopedGILRelease r;
+	return SceneAlgo::findInFrustum( &scene, frustum, cameraTransform, root );
+}
+
+IECore::PathMatcher findIntersectingWrapper( const GafferScene::ScenePlug &scene, const Imath::Line3f &ray, const ScenePlug::ScenePath &root )
+{
+	IECorePython::ScopedGILRelease r;
+	return SceneAlgo::findIntersecting( &scene, ray, root );
+}
+
 struct RenderAdaptorWrapper
 {
 
@@ -372,6 +384,13 @@ void bindSceneAlgo()
 	def( "linkedLights", &linkedLightsWrapper1 );
 	def( "linkedLights", &linkedLightsWrapper2 );
 
+	// Bounds queries
+
+	def( "findInFrustum", &findInFrustumWrapper, ( arg( "scene" ), arg( "frustum" ), arg( "cameraTransform" ), arg( "root" ) = "/" ) );
+	def( "findIntersecting", &findIntersectingWrapper, ( arg( "scene" ), arg( "ray" ), arg( "root" ) = "/" ) );
+	def( "getBoundsQueryCacheMemoryLimit", &SceneAlgo::getBoundsQueryCacheMemoryLimit );
+	def( "setBoundsQueryCacheMemoryLimit", &SceneAlgo::setBoundsQueryCacheMemoryLimit );
+
 	// Render adaptors
 
 	def( "registerRenderAdaptor", &registerRenderAdaptorWrapper );
@@ -95,6 +95,8 @@ void bindSetAlgo()
 	);
 
 	def( "affectsSetExpression", &SetAlgo::affectsSetExpression );
+	def( "getCacheMemoryLimit", &SetAlgo::getCacheMemoryLimit );
+	def( "setCacheMemoryLimit", &SetAlgo::setCacheMemoryLimit );
 
 }
 
@@ -0,0 +1,215 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2022, Cinesite VFX Ltd. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#include "GafferSceneTest/ChildNamesMapTest.h"
+
+#include "GafferScene/Private/ChildNamesMap.h"
+
+#include "IECore/StringAlgo.h"
+
+#include "boost/format.hpp"
+
+#include <random>
+#include <unordered_set>
+
+using namespace std;
+using namespace IECore;
+using namespace GafferScene::Private;
+
+namespace
+{
+
+using Inputs = vector<ConstInternedStringVectorDataPtr>;
+
+ConstInternedStringVectorDataPtr names( const vector<InternedString> &names )
+{
+	return new InternedStringVectorData( names );
+}
+
+// The original serial implementation of the renaming performed
+// by ChildNamesMap, to compare against.
+vector<InternedString> expectedOutputNames( const Inputs &inputs )
+{
+	vector<InternedString> result;
+	unordered_set<InternedString> allNames;
+	for( const auto &childNamesData : inputs )
+	{
+		for( const auto &inputChildName : childNamesData->readable() )
+		{
+			InternedString outputChildName = inputChildName;
+			if( allNames.find( inputChildName ) != allNames.end() )
+			{
+				string prefix;
+				int suffix = IECore::StringAlgo::numericSuffix( inputChildName.string(), 1, &prefix );
+				do
+				{
+					outputChildName = boost::str( boost::format( "%s%d" ) % prefix % suffix );
+					suffix++;
+				} while( allNames.find( outputChildName ) != allNames.end() );
+			}
+
+			allNames.insert( outputChildName );
+			result.push_back( outputChildName );
+		}
+	}
+	return result;
+}
+
+void check( const Inputs &inputs )
+{
+	ConstChildNamesMapPtr map = new ChildNamesMap( inputs );
+	const vector<InternedString> &outputNames = map->outputChildNames()->readable();
+	if( outputNames != expectedOutputNames( inputs ) )
+	{
+		throw IECore::Exception( "Unexpected output names" );
+	}
+
+	size_t outputIndex = 0;
+	vector<ConstPathMatcherDataPtr> inputSets;
+	for( size_t inputIndex = 0; inputIndex < inputs.size(); ++inputIndex )
+	{
+		PathMatcherDataPtr inputSet = new PathMatcherData;
+		for( const auto &name : inputs[inputIndex]->readable() )
+		{
+			const InternedString &outputName = outputNames[outputIndex++];
+			const ChildNamesMap::Input &input = map->input( outputName );
+			if( input.name != name || input.index != inputIndex )
+			{
+				throw IECore::Exception( boost::str( boost::format( "Unexpected input for \"%1%\"" ) % outputName ) );
+			}
+			inputSet->writable().addPath( vector<InternedString>( { name } ) );
+		}
+		inputSets.push_back( inputSet );
+	}
+
+	PathMatcher expectedSet;
+	for( const auto &outputName : outputNames )
+	{
+		expectedSet.addPath( vector<InternedString>( { outputName } ) );
+	}
+
+	if( map->set( inputSets ) != expectedSet )
+	{
+		throw IECore::Exception( "Unexpected set" );
+	}
+}
+
+} // namespace
+
+void GafferSceneTest::testChildNamesMap()
+{
+	check( {} );
+	check( { names( {} ) } );
+	check( { names( { "a", "b" } ) } );
+	check( { names( { "a", "b" } ), names( { "a", "b" } ), names( { "b", "a" } ) } );
+
+	// Generated names which clash with names from later inputs,
+	// so that the later children must be renamed instead.
+	check( { names( { "a" } ), names( { "a" } ), names( { "a1" } ) } );
+	check( { names( { "a", "a1" } ), names( { "a" } ), names( { "a1", "a2" } ), names( { "a3" } ) } );
+	check( { names( { "a0", "a01", "a10" } ), names( { "a0", "a1" } ), names( { "a01", "a" } ), names( { "a2", "a11" } ) } );
+
+	// Many children sharing the same names.
+	Inputs inputs;
+	for( int i = 0; i < 5; ++i )
+	{
+		InternedStringVectorDataPtr inputNames = new InternedStringVectorData;
+		for( int j = 0; j < 1000; ++j )
+		{
+			inputNames->writable().push_back( "child" + std::to_string( j ) );
+		}
+		inputs.push_back( inputNames );
+	}
+	check( inputs );
+
+	// Random names, in sufficient quantity to be
+	// processed in parallel.
+	std::mt19937 generator( 1 );
+	std::uniform_int_distribution<int> distribution( 0, 200000 );
+	for( int t = 0; t < 10; ++t )
+	{
+		inputs.clear();
+		for( int i = 0; i < 10; ++i )
+		{
+			InternedStringVectorDataPtr inputNames = new InternedStringVectorData;
+			unordered_set<InternedString> uniqueNames;
+			for( int j = 0; j < 2000; ++j )
+			{
+				const int n = distribution( generator );
+				const InternedString name = n % 10 ? "n" + std::to_string( n / 10 ) : "n";
+				if( uniqueNames.insert( name ).second )
+				{
+					inputNames->writable().push_back( name );
+				}
+			}
+			inputs.push_back( inputNames );
+		}
+		check( inputs );
+	}
+}
+
+IECore::ObjectVectorPtr GafferSceneTest::childNamesMapBenchmarkInputs( size_t numInputs, size_t childrenPerInput, bool clashing )
+{
+	ObjectVectorPtr result = new ObjectVector;
+	for( size_t i = 0; i < numInputs; ++i )
+	{
+		const string prefix = clashing ? "child" : "input" + std::to_string( i ) + "child";
+		InternedStringVectorDataPtr inputNames = new InternedStringVectorData;
+		inputNames->writable().reserve( childrenPerInput );
+		for( size_t j = 0; j < childrenPerInput; ++j )
+		{
+			inputNames->writable().push_back( prefix + std::to_string( j ) );
+		}
+		result->members().push_back( inputNames );
+	}
+	return result;
+}
+
+size_t GafferSceneTest::childNamesMapBenchmark( const IECore::ObjectVector *inputs )
+{
+	Inputs inputNames;
+	for( const auto &m : inputs->members() )
+	{
+		inputNames.push_back( runTimeCast<const InternedStringVectorData>( m.get() ) );
+		if( !inputNames.back() )
+		{
+			throw IECore::Exception( "Expected InternedStringVectorData" );
+		}
+	}
+
+	ConstChildNamesMapPtr map = new ChildNamesMap( inputNames );
+	return map->outputChildNames()->readable().size();
+}
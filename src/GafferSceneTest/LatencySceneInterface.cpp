@@ -0,0 +1,293 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2022, Cinesite VFX Ltd. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#include "GafferSceneTest/LatencySceneInterface.h"
+
+#include "boost/algorithm/string/predicate.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+using namespace std;
+using namespace Imath;
+using namespace IECore;
+using namespace IECoreScene;
+using namespace GafferSceneTest;
+
+namespace
+{
+
+const std::string g_extension = ".latency";
+
+std::atomic<double> g_latency( 0.0 );
+std::atomic_size_t g_readCount( 0 );
+
+SceneInterface::FileFormatDescription<LatencySceneInterface> g_description( g_extension, IndexedIO::Read );
+
+} // namespace
+
+IE_CORE_DEFINERUNTIMETYPED( LatencySceneInterface );
+
+LatencySceneInterface::LatencySceneInterface( const std::string &fileName, IECore::IndexedIO::OpenMode mode )
+	:	m_fileName( fileName )
+{
+	if( mode != IndexedIO::Read )
+	{
+		throw IECore::Exception( "LatencySceneInterface only supports reading" );
+	}
+
+	if( !boost::ends_with( fileName, g_extension ) )
+	{
+		throw IECore::Exception( "LatencySceneInterface : Expected file name ending with \"" + g_extension + "\"" );
+	}
+
+	m_scene = SceneInterface::create( fileName.substr( 0, fileName.size() - g_extension.size() ), mode );
+}
+
+LatencySceneInterface::LatencySceneInterface( const std::string &fileName, const IECoreScene::SceneInterfacePtr &scene )
+	:	m_fileName( fileName ), m_scene( scene )
+{
+}
+
+LatencySceneInterface::~LatencySceneInterface()
+{
+}
+
+void LatencySceneInterface::setLatency( double latency )
+{
+	g_latency = latency;
+}
+
+double LatencySceneInterface::getLatency()
+{
+	return g_latency;
+}
+
+size_t LatencySceneInterface::readCount()
+{
+	return g_readCount;
+}
+
+void LatencySceneInterface::resetReadCount()
+{
+	g_readCount = 0;
+}
+
+std::string LatencySceneInterface::fileName() const
+{
+	return m_fileName;
+}
+
+SceneInterface::Name LatencySceneInterface::name() const
+{
+	return m_scene->name();
+}
+
+void LatencySceneInterface::path( Path &p ) const
+{
+	m_scene->path( p );
+}
+
+bool LatencySceneInterface::hasBound() const
+{
+	return m_scene->hasBound();
+}
+
+Imath::Box3d LatencySceneInterface::readBound( double time ) const
+{
+	simulateLatency();
+	return m_scene->readBound( time );
+}
+
+void LatencySceneInterface::writeBound( const Imath::Box3d &bound, double time )
+{
+	m_scene->writeBound( bound, time );
+}
+
+IECore::ConstDataPtr LatencySceneInterface::readTransform( double time ) const
+{
+	simulateLatency();
+	return m_scene->readTransform( time );
+}
+
+Imath::M44d LatencySceneInterface::readTransformAsMatrix( double time ) const
+{
+	simulateLatency();
+	return m_scene->readTransformAsMatrix( time );
+}
+
+void LatencySceneInterface::writeTransform( const IECore::Data *transform, double time )
+{
+	m_scene->writeTransform( transform, time );
+}
+
+bool LatencySceneInterface::hasAttribute( const Name &name ) const
+{
+	return m_scene->hasAttribute( name );
+}
+
+void LatencySceneInterface::attributeNames( NameList &attrs ) const
+{
+	m_scene->attributeNames( attrs );
+}
+
+IECore::ConstObjectPtr LatencySceneInterface::readAttribute( const Name &name, double time ) const
+{
+	simulateLatency();
+	return m_scene->readAttribute( name, time );
+}
+
+void LatencySceneInterface::writeAttribute( const Name &name, const IECore::Object *attribute, double time )
+{
+	m_scene->writeAttribute( name, attribute, time );
+}
+
+bool LatencySceneInterface::hasTag( const Name &name, int filter ) const
+{
+	return m_scene->hasTag( name, filter );
+}
+
+void LatencySceneInterface::readTags( NameList &tags, int filter ) const
+{
+	m_scene->readTags( tags, filter );
+}
+
+void LatencySceneInterface::writeTags( const NameList &tags )
+{
+	m_scene->writeTags( tags );
+}
+
+SceneInterface::NameList LatencySceneInterface::setNames( bool includeDescendantSets ) const
+{
+	return m_scene->setNames( includeDescendantSets );
+}
+
+IECore::PathMatcher LatencySceneInterface::readSet( const Name &name, bool includeDescendantSets, const IECore::Canceller *canceller ) const
+{
+	return m_scene->readSet( name, includeDescendantSets, canceller );
+}
+
+void LatencySceneInterface::writeSet( const Name &name, const IECore::PathMatcher &set )
+{
+	m_scene->writeSet( name, set );
+}
+
+void LatencySceneInterface::hashSet( const Name &setName, IECore::MurmurHash &h ) const
+{
+	m_scene->hashSet( setName, h );
+}
+
+bool LatencySceneInterface::hasObject() const
+{
+	return m_scene->hasObject();
+}
+
+IECore::ConstObjectPtr LatencySceneInterface::readObject( double time, const IECore::Canceller *canceller ) const
+{
+	simulateLatency();
+	return m_scene->readObject( time, canceller );
+}
+
+IECoreScene::PrimitiveVariableMap LatencySceneInterface::readObjectPrimitiveVariables( const std::vector<IECore::InternedString> &primVarNames, double time ) const
+{
+	simulateLatency();
+	return m_scene->readObjectPrimitiveVariables( primVarNames, time );
+}
+
+void LatencySceneInterface::writeObject( const IECore::Object *object, double time )
+{
+	m_scene->writeObject( object, time );
+}
+
+bool LatencySceneInterface::hasChild( const Name &name ) const
+{
+	return m_scene->hasChild( name );
+}
+
+void LatencySceneInterface::childNames( NameList &childNames ) const
+{
+	m_scene->childNames( childNames );
+}
+
+IECoreScene::SceneInterfacePtr LatencySceneInterface::child( const Name &name, MissingBehaviour missingBehaviour )
+{
+	return wrap( m_scene->child( name, missingBehaviour ) );
+}
+
+IECoreScene::ConstSceneInterfacePtr LatencySceneInterface::child( const Name &name, MissingBehaviour missingBehaviour ) const
+{
+	return wrap( m_scene->child( name, missingBehaviour ) );
+}
+
+IECoreScene::SceneInterfacePtr LatencySceneInterface::createChild( const Name &name )
+{
+	return wrap( m_scene->createChild( name ) );
+}
+
+IECoreScene::SceneInterfacePtr LatencySceneInterface::scene( const Path &path, MissingBehaviour missingBehaviour )
+{
+	return wrap( m_scene->scene( path, missingBehaviour ) );
+}
+
+IECoreScene::ConstSceneInterfacePtr LatencySceneInterface::scene( const Path &path, MissingBehaviour missingBehaviour ) const
+{
+	return wrap( m_scene->scene( path, missingBehaviour ) );
+}
+
+void LatencySceneInterface::hash( HashType hashType, double time, IECore::MurmurHash &h ) const
+{
+	m_scene->hash( hashType, time, h );
+}
+
+IECoreScene::SceneInterfacePtr LatencySceneInterface::wrap( const IECoreScene::SceneInterfacePtr &scene ) const
+{
+	if( !scene )
+	{
+		return nullptr;
+	}
+	return new LatencySceneInterface( m_fileName, scene );
+}
+
+void LatencySceneInterface::simulateLatency() const
+{
+	g_readCount++;
+	const double latency = g_latency;
+	if( latency > 0 )
+	{
+		std::this_thread::sleep_for( std::chrono::duration<double>( latency ) );
+	}
+}
@@ -0,0 +1,141 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2022, Cinesite VFX Ltd. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#include "GafferSceneTest/SceneTranslationBenchmark.h"
+
+#include "GafferScene/SceneAlgo.h"
+
+#include "GafferScene/Private/RendererAlgo.h"
+
+#include "tbb/parallel_for.h"
+
+#include <atomic>
+#include <chrono>
+
+using namespace std;
+using namespace IECore;
+using namespace GafferScene;
+using namespace GafferScene::Private;
+
+namespace
+{
+
+struct LocationCounter
+{
+
+	LocationCounter( std::atomic<size_t> &count )
+		:	m_count( count )
+	{
+	}
+
+	bool operator()( const ScenePlug *scene, const ScenePlug::ScenePath &path )
+	{
+		m_count++;
+		return true;
+	}
+
+	private :
+
+		std::atomic<size_t> &m_count;
+
+};
+
+} // namespace
+
+size_t GafferSceneTest::countLocations( const GafferScene::ScenePlug *scene )
+{
+	std::atomic<size_t> count( 0 );
+	LocationCounter counter( count );
+	SceneAlgo::parallelTraverse( scene, counter );
+	return count;
+}
+
+GafferSceneTest::PhaseTimings GafferSceneTest::outputScene( const GafferScene::ScenePlug *scene, IECoreScenePreview::Renderer *renderer )
+{
+	PhaseTimings result;
+
+	// Each phase is timed individually, from the end of the previous one.
+	auto phaseStart = std::chrono::steady_clock::now();
+	auto endPhase = [&phaseStart, &result] ( const std::string &name ) {
+		const auto now = std::chrono::steady_clock::now();
+		result.push_back( { name, std::chrono::duration<double>( now - phaseStart ).count() } );
+		phaseStart = now;
+	};
+
+	ConstCompoundObjectPtr globals = scene->globalsPlug()->getValue();
+	RendererAlgo::outputOptions( globals.get(), renderer );
+	RendererAlgo::outputOutputs( scene, globals.get(), renderer );
+	endPhase( "Globals" );
+
+	RendererAlgo::RenderSets renderSets( scene );
+	RendererAlgo::LightLinks lightLinks;
+	endPhase( "Sets" );
+
+	RendererAlgo::outputCameras( scene, globals.get(), renderSets, renderer );
+	endPhase( "Cameras" );
+
+	RendererAlgo::outputLights( scene, globals.get(), renderSets, &lightLinks, renderer );
+	endPhase( "Lights" );
+
+	RendererAlgo::outputLightFilters( scene, globals.get(), renderSets, &lightLinks, renderer );
+	lightLinks.outputLightFilterLinks( scene );
+	endPhase( "Light filters" );
+
+	RendererAlgo::outputObjects( scene, globals.get(), renderSets, &lightLinks, renderer );
+	endPhase( "Objects" );
+
+	return result;
+}
+
+void GafferSceneTest::expandProcedurals( const std::vector<const IECoreScenePreview::Procedural *> &procedurals, const std::vector<IECoreScenePreview::Renderer *> &renderers )
+{
+	if( procedurals.size() != renderers.size() )
+	{
+		throw IECore::Exception( "Expected one renderer per procedural" );
+	}
+
+	tbb::task_group_context taskGroupContext( tbb::task_group_context::isolated );
+	tbb::parallel_for(
+		tbb::blocked_range<size_t>( 0, procedurals.size(), 1 ),
+		[&] ( const tbb::blocked_range<size_t> &range ) {
+			for( size_t i = range.begin(); i != range.end(); ++i )
+			{
+				procedurals[i]->render( renderers[i] );
+			}
+		},
+		taskGroupContext
+	);
+}
@@ -37,15 +37,19 @@
 
 #include "boost/python.hpp"
 
+#include "GafferSceneTest/ChildNamesMapTest.h"
 #include "GafferSceneTest/ContextSanitiser.h"
 #include "GafferSceneTest/CompoundObjectSource.h"
+#include "GafferSceneTest/LatencySceneInterface.h"
 #include "GafferSceneTest/ScenePlugTest.h"
+#include "GafferSceneTest/SceneTranslationBenchmark.h"
 #include "GafferSceneTest/TestLight.h"
 #include "GafferSceneTest/TestShader.h"
 #include "GafferSceneTest/TraverseScene.h"
 
 #include "GafferBindings/DependencyNodeBinding.h"
 
+#include "IECorePython/RunTimeTypedBinding.h"
 #include "IECorePython/ScopedGILRelease.h"
 
 using namespace boost::python;
@@ -57,6 +61,48 @@ static void traverseSceneWrapper( const GafferScene::ScenePlug *scenePlug )
 	traverseScene( scenePlug );
 }
 
+static size_t countLocationsWrapper( const GafferScene::ScenePlug *scenePlug )
+{
+	IECorePython::ScopedGILRelease gilRelease;
+	return countLocations( scenePlug );
+}
+
+static list outputSceneWrapper( const GafferScene::ScenePlug *scenePlug, IECoreScenePreview::Renderer *renderer )
+{
+	PhaseTimings timings;
+	{
+		IECorePython::ScopedGILRelease gilRelease;
+		timings = outputScene( scenePlug, renderer );
+	}
+
+	list result;
+	for( const auto &t : timings )
+	{
+		result.append( make_tuple( t.first, t.second ) );
+	}
+	return result;
+}
+
+static void expandProceduralsWrapper( object pythonProcedurals, object pythonRenderers )
+{
+	std::vector<const IECoreScenePreview::Procedural *> procedurals;
+	std::vector<IECoreScenePreview::Renderer *> renderers;
+	for( size_t i = 0, e = len( pythonProcedurals ); i < e; ++i )
+	{
+		procedurals.push_back( extract<const IECoreScenePreview::Procedural *>( pythonProcedurals[i] ) );
+		renderers.push_back( extract<IECoreScenePreview::Renderer *>( pythonRenderers[i] ) );
+	}
+
+	IECorePython::ScopedGILRelease gilRelease;
+	expandProcedurals( procedurals, renderers );
+}
+
+static size_t childNamesMapBenchmarkWrapper( const IECore::ObjectVector *inputs )
+{
+	IECorePython::ScopedGILRelease gilRelease;
+	return childNamesMapBenchmark( inputs );
+}
+
 BOOST_PYTHON_MODULE( _GafferSceneTest )
 {
 
@@ -68,11 +114,24 @@ BOOST_PYTHON_MODULE( _GafferSceneTest )
 	GafferBindings::NodeClass<TestShader>();
 	GafferBindings::NodeClass<TestLight>();
 
+	IECorePython::RunTimeTypedClass<LatencySceneInterface>()
+		.def( "setLatency", &LatencySceneInterface::setLatency ).staticmethod( "setLatency" )
+		.def( "getLatency", &LatencySceneInterface::getLatency ).staticmethod( "getLatency" )
+		.def( "readCount", &LatencySceneInterface::readCount ).staticmethod( "readCount" )
+		.def( "resetReadCount", &LatencySceneInterface::resetReadCount ).staticmethod( "resetReadCount" )
+	;
+
 	def( "traverseScene", &traverseSceneWrapper );
 	def( "connectTraverseSceneToPlugDirtiedSignal", &connectTraverseSceneToPlugDirtiedSignal );
 	def( "connectTraverseSceneToContextChangedSignal", &connectTraverseSceneToContextChangedSignal );
 	def( "connectTraverseSceneToPreDispatchSignal", &connectTraverseSceneToPreDispatchSignal );
+	def( "countLocations", &countLocationsWrapper );
+	def( "outputScene", &outputSceneWrapper );
+	def( "expandProcedurals", &expandProceduralsWrapper );
 
 	def( "testManyStringToPathCalls", &testManyStringToPathCalls );
+	def( "testChildNamesMap", &testChildNamesMap );
+	def( "childNamesMapBenchmarkInputs", &childNamesMapBenchmarkInputs );
+	def( "childNamesMapBenchmark", &childNamesMapBenchmarkWrapper );
 
 }